@@ -0,0 +1,199 @@
+﻿#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include <zeus/foundation/byte/byte_utils.h>
+#include <zeus/foundation/hardware/cpu_feature.h>
+
+using namespace zeus;
+
+//位计数和位扫描，与逐位循环的实现对比，缓冲区的CountOne标注运行时选择的实现
+namespace
+{
+std::vector<uint8_t> RandomBytes(size_t size, unsigned density = 50)
+{
+    std::mt19937_64      engine(size);
+    std::vector<uint8_t> data(size);
+    for (auto& byte : data)
+    {
+        for (size_t bit = 0; bit < 8; ++bit)
+        {
+            byte |= static_cast<uint8_t>((engine() % 100 < density) << bit);
+        }
+    }
+    return data;
+}
+
+const char* CountOneKernel()
+{
+#if defined(__x86_64__) || defined(_M_X64)
+    const auto& feature = Hardware::GetCpuFeature();
+    if (feature.avx512vpopcntdq)
+    {
+        return "avx512vpopcntdq";
+    }
+    if (feature.avx2 && feature.popcnt)
+    {
+        return "avx2";
+    }
+    if (feature.popcnt)
+    {
+        return "popcnt";
+    }
+#endif
+    return "scalar";
+}
+
+//原来的逐位实现，作为对比的基准
+size_t CountOneBitLoop(uint8_t value)
+{
+    size_t count = 0;
+    while (value)
+    {
+        count += value & 0x01;
+        value >>= 1;
+    }
+    return count;
+}
+
+size_t CountLeftZeroBitLoop(uint32_t value)
+{
+    if (0 == value)
+    {
+        return 32;
+    }
+    size_t count = 0;
+    while (!(value & 0x80000000))
+    {
+        ++count;
+        value <<= 1;
+    }
+    return count;
+}
+
+void BM_CountOneBuffer(benchmark::State& state)
+{
+    const auto data = RandomBytes(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(CountOne(ByteBufferView(data)));
+    }
+    state.SetLabel(CountOneKernel());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+
+//逐个64位字调用CountOne，单条popcnt指令但没有向量化
+void BM_CountOneWords(benchmark::State& state)
+{
+    const auto data = RandomBytes(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        size_t count = 0;
+        for (size_t index = 0; index + 8 <= data.size(); index += 8)
+        {
+            uint64_t word = 0;
+            std::memcpy(&word, data.data() + index, sizeof(word));
+            count += CountOne(word);
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+
+void BM_CountOneBitLoop(benchmark::State& state)
+{
+    const auto data = RandomBytes(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        size_t count = 0;
+        for (auto byte : data)
+        {
+            count += CountOneBitLoop(byte);
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+
+std::vector<uint32_t> RandomWords()
+{
+    //前导0的个数均匀分布
+    std::mt19937          engine(1);
+    std::vector<uint32_t> words(4096);
+    for (auto& word : words)
+    {
+        word = static_cast<uint32_t>(engine()) >> (engine() % 32);
+    }
+    return words;
+}
+
+void BM_CountLeftZero(benchmark::State& state)
+{
+    const auto words = RandomWords();
+    for (auto _ : state)
+    {
+        size_t count = 0;
+        for (auto word : words)
+        {
+            count += CountLeftZero(word);
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * words.size()));
+}
+
+void BM_CountLeftZeroBitLoop(benchmark::State& state)
+{
+    const auto words = RandomWords();
+    for (auto _ : state)
+    {
+        size_t count = 0;
+        for (auto word : words)
+        {
+            count += CountLeftZeroBitLoop(word);
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * words.size()));
+}
+
+//1MiB的位图，range(0)是为1的位所占的百分比
+void BM_ForEachSetBit(benchmark::State& state)
+{
+    const auto data = RandomBytes(1 << 20, static_cast<unsigned>(state.range(0)));
+    for (auto _ : state)
+    {
+        size_t sum = 0;
+        ForEachSetBit(data.data(), data.size(), [&sum](size_t bit) { sum += bit; });
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+
+void BM_ForEachSetBitBitTest(benchmark::State& state)
+{
+    const auto data = RandomBytes(1 << 20, static_cast<unsigned>(state.range(0)));
+    for (auto _ : state)
+    {
+        size_t sum = 0;
+        for (size_t bit = 0; bit < data.size() * 8; ++bit)
+        {
+            if (data[bit / 8] & (1 << (bit % 8)))
+            {
+                sum += bit;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+} // namespace
+
+BENCHMARK(BM_CountOneBuffer)->RangeMultiplier(16)->Range(64, 16 << 20);
+BENCHMARK(BM_CountOneWords)->RangeMultiplier(16)->Range(64, 16 << 20);
+BENCHMARK(BM_CountOneBitLoop)->RangeMultiplier(16)->Range(64, 16 << 20);
+BENCHMARK(BM_CountLeftZero);
+BENCHMARK(BM_CountLeftZeroBitLoop);
+BENCHMARK(BM_ForEachSetBit)->ArgName("density")->Arg(1)->Arg(10)->Arg(50);
+BENCHMARK(BM_ForEachSetBitBitTest)->ArgName("density")->Arg(1)->Arg(10)->Arg(50);
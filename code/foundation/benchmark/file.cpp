@@ -0,0 +1,216 @@
+﻿#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include <benchmark/benchmark.h>
+#include <zeus/foundation/file/file_wrapper.h>
+#include <zeus/foundation/memory/aligned_buffer_pool.h>
+
+namespace fs = std::filesystem;
+using namespace zeus;
+
+//大文件顺序读写在各种模式下的吞吐量，以及读写之后文件留在页缓存中的比例(cachedRatio，只在Linux上统计)
+//直接读写需要文件系统支持O_DIRECT，tmpfs不支持，可以通过环境变量ZEUS_BENCHMARK_DIR指定目录
+namespace
+{
+constexpr size_t kFileSize  = 256 << 20;
+constexpr size_t kBlockSize = 1 << 20;
+//DontNeed模式每写入这么多数据刷新一次并丢弃已经写入部分的页缓存
+constexpr size_t kDropSize  = 16 << 20;
+
+enum class Mode
+{
+    kBuffered,
+    kSequential,
+    kDontNeed,
+    kDirect,
+};
+
+fs::path BenchmarkPath(const char* name)
+{
+    const char* directory = std::getenv("ZEUS_BENCHMARK_DIR");
+    return (directory && *directory ? fs::path(directory) : fs::temp_directory_path()) / name;
+}
+
+FileWrapper::OpenFlag ModeFlag(Mode mode)
+{
+    switch (mode)
+    {
+    case Mode::kSequential:
+        return FileWrapper::OpenFlag::kSequential;
+    case Mode::kDirect:
+        return FileWrapper::OpenFlag::kDirect;
+    default:
+        return FileWrapper::OpenFlag::kNone;
+    }
+}
+
+//文件在页缓存中的页面比例，无法统计时返回负数
+double CachedRatio(const fs::path& path)
+{
+#ifdef __linux__
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        return -1;
+    }
+    double      ratio = -1;
+    struct stat info {};
+    if (0 == fstat(fd, &info) && info.st_size > 0)
+    {
+        const auto size    = static_cast<size_t>(info.st_size);
+        const auto page    = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        void*      address = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        if (MAP_FAILED != address)
+        {
+            std::vector<unsigned char> pages((size + page - 1) / page);
+            if (0 == mincore(address, size, pages.data()))
+            {
+                size_t cached = 0;
+                for (auto flag : pages)
+                {
+                    cached += flag & 1;
+                }
+                ratio = static_cast<double>(cached) / static_cast<double>(pages.size());
+            }
+            munmap(address, size);
+        }
+    }
+    close(fd);
+    return ratio;
+#else
+    (void) path;
+    return -1;
+#endif
+}
+
+void SetCachedRatio(benchmark::State& state, const fs::path& path)
+{
+    if (const auto ratio = CachedRatio(path); ratio >= 0)
+    {
+        state.counters["cachedRatio"] = ratio;
+    }
+}
+
+//把文件从页缓存中清除，读取测试每次都从设备读取
+bool DropCache(const fs::path& path)
+{
+    auto file = FileWrapper::Open(path, FileWrapper::OpenMode::kRead);
+    return file.has_value() && file->Advise(FileWrapper::Advice::kDontNeed).has_value();
+}
+
+//写入kFileSize的数据，range(0)不为0时先预分配空间
+void BM_FileWrite(benchmark::State& state, Mode mode)
+{
+    const auto path        = BenchmarkPath("zeus_benchmark_write.bin");
+    const bool preallocate = state.range(0);
+    for (auto _ : state)
+    {
+        auto file = FileWrapper::Truncate(path, FileWrapper::OpenMode::kWrite, ModeFlag(mode));
+        if (!file.has_value())
+        {
+            state.SkipWithError(file.error().message().c_str());
+            return;
+        }
+        if (preallocate && !file->Preallocate(0, kFileSize).has_value())
+        {
+            state.SkipWithError("preallocate failed");
+            return;
+        }
+        //直接写入要求缓冲区按设备块大小对齐，缓冲式写入使用同样的缓冲区便于比较
+        const auto        alignment = Mode::kDirect == mode ? file->DirectIoAlignment().value_or(4096) : 4096;
+        AlignedBufferPool pool(kBlockSize, alignment, 1);
+        auto              buffer = pool.Acquire();
+        std::memset(buffer.Data(), 'z', buffer.Size());
+        for (uint64_t offset = 0; offset < kFileSize; offset += kBlockSize)
+        {
+            if (!file->WriteAt(buffer.Data(), kBlockSize, offset).has_value())
+            {
+                state.SkipWithError("write failed");
+                return;
+            }
+            //脏页不能被丢弃，先刷新再丢弃已经写入的部分
+            if (Mode::kDontNeed == mode && 0 == (offset + kBlockSize) % kDropSize)
+            {
+                file->Flush();
+                file->Advise(FileWrapper::Advice::kDontNeed, offset + kBlockSize - kDropSize, kDropSize);
+            }
+        }
+        file->Flush();
+    }
+    SetCachedRatio(state, path);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * kFileSize));
+    fs::remove(path);
+}
+
+//顺序读取kFileSize的文件，range(0)不为0时每次读取前清除页缓存，否则读取已经在页缓存中的文件
+void BM_FileRead(benchmark::State& state, Mode mode)
+{
+    const auto path = BenchmarkPath("zeus_benchmark_read.bin");
+    {
+        auto file = FileWrapper::Truncate(path, FileWrapper::OpenMode::kWrite);
+        if (!file.has_value())
+        {
+            state.SkipWithError(file.error().message().c_str());
+            return;
+        }
+        const std::vector<char> data(kBlockSize, 'z');
+        for (uint64_t offset = 0; offset < kFileSize; offset += kBlockSize)
+        {
+            file->WriteAt(data.data(), data.size(), offset);
+        }
+        file->Flush();
+    }
+    const bool cold = state.range(0);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        if (cold && !DropCache(path))
+        {
+            state.SkipWithError("drop cache failed");
+            return;
+        }
+        state.ResumeTiming();
+        auto file = FileWrapper::Open(path, FileWrapper::OpenMode::kRead, ModeFlag(mode));
+        if (!file.has_value())
+        {
+            state.SkipWithError(file.error().message().c_str());
+            return;
+        }
+        const auto        alignment = Mode::kDirect == mode ? file->DirectIoAlignment().value_or(4096) : 4096;
+        AlignedBufferPool pool(kBlockSize, alignment, 1);
+        auto              buffer = pool.Acquire();
+        for (uint64_t offset = 0; offset < kFileSize; offset += kBlockSize)
+        {
+            if (!file->ReadAt(buffer.Data(), kBlockSize, offset).has_value())
+            {
+                state.SkipWithError("read failed");
+                return;
+            }
+            //读取之后不再需要，丢弃已经读取的部分
+            if (Mode::kDontNeed == mode && 0 == (offset + kBlockSize) % kDropSize)
+            {
+                file->Advise(FileWrapper::Advice::kDontNeed, offset + kBlockSize - kDropSize, kDropSize);
+            }
+        }
+        benchmark::DoNotOptimize(buffer.Bytes()[0]);
+    }
+    SetCachedRatio(state, path);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * kFileSize));
+    fs::remove(path);
+}
+} // namespace
+
+BENCHMARK_CAPTURE(BM_FileWrite, buffered, Mode::kBuffered)->ArgName("preallocate")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_FileWrite, dontNeed, Mode::kDontNeed)->ArgName("preallocate")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_FileWrite, direct, Mode::kDirect)->ArgName("preallocate")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_FileRead, buffered, Mode::kBuffered)->ArgName("cold")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_FileRead, sequential, Mode::kSequential)->ArgName("cold")->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_FileRead, dontNeed, Mode::kDontNeed)->ArgName("cold")->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_CAPTURE(BM_FileRead, direct, Mode::kDirect)->ArgName("cold")->Arg(1)->Unit(benchmark::kMillisecond)->UseRealTime();
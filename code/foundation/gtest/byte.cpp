@@ -1,14 +1,42 @@
 ﻿#include <array>
+#include <bitset>
 #include <cstring>
 #include <gtest/gtest.h>
+#include <zeus/foundation/byte/bit_utils.h>
 #include <zeus/foundation/byte/byte_order.h>
 #include <zeus/foundation/byte/byte_utils.h>
+#include <zeus/foundation/byte/byte_searcher.h>
+#include <zeus/foundation/byte/byte_stream.h>
+#include <zeus/foundation/byte/hex.h>
 #include <zeus/foundation/string/charset_utils.h>
 #include <zeus/foundation/string/string_utils.h>
 #include <zeus/foundation/core/random.h>
 
 using namespace zeus;
 
+TEST(Byte, View)
+{
+    static constexpr uint8_t kData[] = {1, 2, 3, 4, 5};
+    constexpr ByteBufferView kView(kData, sizeof(kData));
+    static_assert(5 == kView.Size());
+    static_assert(3 == kView[2]);
+    static_assert(kView.SubView(1, 2) == ByteBufferView(kData + 1, 2));
+    static_assert(kView.SubView(3).Size() == 2);
+    static_assert(kView.SubView(10).Empty());
+    static_assert(kView.First(2) < kView.Last(2));
+    static_assert(kView.StartWith(kView.First(3)) && kView.EndWith(kView.Last(1)));
+
+    const std::vector<uint8_t> bytes = {'a', 'b', 'c'};
+    const ByteBufferView       view  = bytes;
+    EXPECT_EQ("abc", view.AsStringView());
+    EXPECT_EQ(view, ByteBufferView(std::string_view("abc")));
+    EXPECT_NE(view, ByteBufferView(std::string_view("abd")));
+    EXPECT_LT(view, ByteBufferView(std::string_view("abcd")));
+    EXPECT_EQ(bytes, view.SubView(0, 100).ToVector());
+    EXPECT_FALSE(ByteBufferView());
+    EXPECT_FALSE(view.SubView(3));
+}
+
 TEST(Byte, Find)
 {
     uint8_t data[] = {'t', 'e', 's', 't', 0, 1, 1, 2, 3, 4};
@@ -419,6 +447,83 @@ TEST(Byte, Replace2)
     EXPECT_EQ(0, std::memcmp(ret.data() + sizeof(data1) + 0 + sizeof(data2) + 0 + sizeof(data1) + 0, data2, sizeof(data2)));
 }
 
+TEST(Byte, Searcher)
+{
+    //与逐个位置比较的结果对照，覆盖SIMD块边界和标量尾部
+    std::string data;
+    for (size_t index = 0; index < 300; ++index)
+    {
+        data.push_back(static_cast<char>('a' + index % 3));
+    }
+    data += "needle";
+    for (const std::string pattern : {"a", "abc", "cab", "ab", "needle", "bcabcabcabcabcabcabcabcabcabcabcabcabcn", "x", "needlex"})
+    {
+        const ByteSearcher searcher(pattern);
+        for (size_t offset = 0; offset < data.size(); offset += 7)
+        {
+            EXPECT_EQ(data.find(pattern, offset), searcher.Find(data, offset)) << pattern << " " << offset;
+        }
+    }
+    EXPECT_EQ(ByteSearcher::npos, ByteSearcher("").Find(data));
+    EXPECT_EQ(ByteSearcher::npos, ByteSearcher("a").Find(data, data.size()));
+
+    //stride只接受与offset对齐的位置
+    const uint8_t wide[] = {'a', 0, 0, 'b', 0, 0, 0, 0};
+    const uint8_t zero[] = {0, 0};
+    EXPECT_EQ(4, ByteSearcher(ByteBufferView(zero, sizeof(zero))).Find(wide, sizeof(wide), 0, 2));
+    EXPECT_EQ(1, ByteSearcher(ByteBufferView(zero, sizeof(zero))).Find(wide, sizeof(wide), 1, 2));
+
+    const ByteSearcher delim("\r\n");
+    const std::string  lines = "first\r\nsecond\r\n\r\nthird";
+    auto               split = ByteSplit({reinterpret_cast<const uint8_t *>(lines.data()), lines.size()}, delim);
+    ASSERT_EQ(3, split.size());
+    EXPECT_EQ("third", std::string(reinterpret_cast<const char *>(split[2].Data()), split[2].Size()));
+}
+
+TEST(Byte, MultiSearcher)
+{
+    const ByteMultiSearcher searcher(std::vector<std::string_view> {"he", "she", "his", "hers", "", "he"});
+    EXPECT_EQ(6, searcher.PatternCount());
+
+    //最左最长：ushers中she和hers重叠，she起始位置更靠前
+    auto match = searcher.Find("ushers");
+    ASSERT_TRUE(match);
+    EXPECT_EQ(1, match->offset);
+    EXPECT_EQ(3, match->length);
+    EXPECT_EQ(1, match->pattern);
+
+    match = searcher.Find("ushers", 2);
+    ASSERT_TRUE(match);
+    EXPECT_EQ(2, match->offset);
+    EXPECT_EQ(4, match->length);
+    EXPECT_EQ(3, match->pattern);
+
+    EXPECT_FALSE(searcher.Find("nothing to see"));
+
+    const auto matches = searcher.FindAll("this is hershe he");
+    ASSERT_EQ(4, matches.size());
+    EXPECT_EQ(1, matches[0].offset);
+    EXPECT_EQ(2, matches[0].pattern);
+    EXPECT_EQ(8, matches[1].offset);
+    EXPECT_EQ(3, matches[1].pattern);
+    EXPECT_EQ(12, matches[2].offset);
+    EXPECT_EQ(0, matches[2].pattern);
+    EXPECT_EQ(15, matches[3].offset);
+    EXPECT_EQ(0, matches[3].pattern);
+
+    const uint8_t     marker1[] = {0xFF, 0x00};
+    const uint8_t     marker2[] = {0x00, 0xFF, 0x00};
+    const uint8_t     data[]    = {1, 0xFF, 0x00, 0xFF, 0x00, 2};
+    const uint8_t     first[]   = {'A'};
+    const uint8_t     second[]  = {'B', 'B'};
+    ByteMultiSearcher markers({
+        {marker1, sizeof(marker1)},
+        {marker2, sizeof(marker2)}
+    });
+    const auto        replaced = ByteReplace({data, sizeof(data)}, markers, {{first, sizeof(first)}, {second, sizeof(second)}});
+    EXPECT_EQ((std::vector<uint8_t> {1, 'A', 'A', 2}), replaced);
+}
+
 TEST(Byte, StartWith)
 {
     uint8_t data1[] = {'t', 'e', 's', 't', 0, 1, 2, 3, 4};
@@ -455,6 +560,36 @@ TEST(Byte, HexTobyte)
     }
 }
 
+TEST(Byte, Hex)
+{
+    uint8_t data[1000];
+    RandBytes(data, sizeof(data));
+    for (size_t length = 0; length < sizeof(data); length += 7)
+    {
+        char buffer[Hex::EncodedLength(sizeof(data))];
+        ASSERT_EQ(length * 2, Hex::Encode(data, length, buffer, true));
+        const std::string hex(buffer, length * 2);
+        EXPECT_EQ(BytesToHexString(data, length, true), hex);
+        EXPECT_EQ(ToLowerCopy(hex), Hex::Encode(data, length));
+
+        uint8_t output[sizeof(data)];
+        auto    size = Hex::Decode(hex.data(), hex.size(), output);
+        ASSERT_TRUE(size.has_value());
+        ASSERT_EQ(length, *size);
+        EXPECT_EQ(0, std::memcmp(data, output, length));
+    }
+
+    auto hex    = Hex::Encode(data, sizeof(data));
+    hex[777]    = 'g';
+    auto result = Hex::Decode(hex);
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(777, result.error().offset);
+    result = Hex::Decode("0aF");
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(2, result.error().offset);
+    EXPECT_EQ(std::vector<uint8_t>({0x0A, 0xBC, 0xEF}), *Hex::Decode("0aBcEf"));
+}
+
 TEST(Byte, Count)
 {
     uint32_t num = 0b11111111111111110000000000000000;
@@ -511,6 +646,52 @@ TEST(Byte, Count)
     EXPECT_EQ(CountZero({reinterpret_cast<const uint8_t*>(bytes.data()), 16}), 79);
 }
 
+TEST(Byte, Count64)
+{
+    EXPECT_EQ(64, CountLeftZero(static_cast<uint64_t>(0)));
+    EXPECT_EQ(63, CountLeftZero(static_cast<uint64_t>(1)));
+    EXPECT_EQ(32, CountRightZero(static_cast<uint64_t>(0x100000000ULL)));
+    EXPECT_EQ(64, CountRightOne(~static_cast<uint64_t>(0)));
+    EXPECT_EQ(4, CountLeftOne(static_cast<uint64_t>(0xF000000000000001ULL)));
+    EXPECT_EQ(33, CountOne(static_cast<uint64_t>(0xFFFFFFFF00000001ULL)));
+    EXPECT_EQ(16, CountLeftZero(static_cast<uint16_t>(0)));
+    EXPECT_EQ(15, CountRightOne(static_cast<uint16_t>(0x7FFF)));
+
+    //覆盖各个SIMD版本的整块和尾部
+    std::vector<uint8_t> data(1000);
+    RandBytes(data.data(), data.size());
+    for (size_t size = 0; size <= data.size(); size += 37)
+    {
+        size_t expect = 0;
+        for (size_t index = 0; index < size; ++index)
+        {
+            expect += std::bitset<8>(data[index]).count();
+        }
+        EXPECT_EQ(expect, CountOne({data.data(), size}));
+        EXPECT_EQ(size * 8 - expect, CountZero({data.data(), size}));
+    }
+}
+
+TEST(Byte, SetBits)
+{
+    std::vector<size_t> bits;
+    for (auto bit : SetBits(0x8000000000000005ULL))
+    {
+        bits.emplace_back(bit);
+    }
+    EXPECT_EQ((std::vector<size_t> {0, 2, 63}), bits);
+
+    bits.clear();
+    const uint64_t words[] = {0, 0x10, 0x8000000000000000ULL};
+    ForEachSetBit(words, 3, [&bits](size_t bit) { bits.emplace_back(bit); });
+    EXPECT_EQ((std::vector<size_t> {68, 191}), bits);
+
+    bits.clear();
+    const uint8_t bitmap[] = {0x01, 0, 0, 0, 0, 0, 0, 0x80, 0x02, 0x40};
+    ForEachSetBit(bitmap, sizeof(bitmap), [&bits](size_t bit) { bits.emplace_back(bit); });
+    EXPECT_EQ((std::vector<size_t> {0, 63, 65, 78}), bits);
+}
+
 TEST(Bytes, FlipBytes16)
 {
     EXPECT_EQ((uint16_t) 0x3412, FlipBytes((uint16_t) 0x1234));
@@ -524,4 +705,81 @@ TEST(Bytes, FlipBytes32)
 TEST(Bytes, FlipBytes64)
 {
     EXPECT_EQ((uint64_t) 0x2143658778563412, FlipBytes((uint64_t) 0x1234567887654321));
+}
+
+TEST(Bytes, FlipBytesBulk)
+{
+    static_assert(0x3412 == FlipBytes(static_cast<uint16_t>(0x1234)));
+    static_assert(0x78563412 == HostToBigEndian(0x12345678U) || ByteOrder::kBigEndian == kNativeByteOrder);
+    static_assert(0x12345678 == HostToLittleEndian(0x12345678U) || ByteOrder::kBigEndian == kNativeByteOrder);
+
+    //覆盖SIMD块和尾部
+    for (const size_t count : {0, 1, 7, 16, 33, 100})
+    {
+        std::vector<uint16_t> u16(count);
+        std::vector<uint32_t> u32(count);
+        std::vector<uint64_t> u64(count);
+        RandBytes(reinterpret_cast<uint8_t*>(u16.data()), u16.size() * sizeof(uint16_t));
+        RandBytes(reinterpret_cast<uint8_t*>(u32.data()), u32.size() * sizeof(uint32_t));
+        RandBytes(reinterpret_cast<uint8_t*>(u64.data()), u64.size() * sizeof(uint64_t));
+        auto flip16 = u16;
+        auto flip32 = u32;
+        auto flip64 = u64;
+        FlipBytes(flip16.data(), flip16.size());
+        FlipBytes(flip32.data(), flip32.size());
+        FlipBytes(flip64.data(), flip64.size());
+        std::vector<uint32_t> copy32(count);
+        FlipBytes(u32.data(), copy32.data(), count);
+        EXPECT_EQ(flip32, copy32);
+        for (size_t index = 0; index < count; ++index)
+        {
+            EXPECT_EQ(FlipBytes(u16[index]), flip16[index]);
+            EXPECT_EQ(FlipBytes(u32[index]), flip32[index]);
+            EXPECT_EQ(FlipBytes(u64[index]), flip64[index]);
+        }
+    }
+}
+
+TEST(Bytes, ByteWriterReader)
+{
+    const uint32_t array[] = {1, 2, 0x01020304};
+    ByteWriter     writer(ByteOrder::kBigEndian);
+    writer.Put<uint16_t>(0x0102);
+    const size_t lengthOffset = writer.Skip(sizeof(uint32_t));
+    writer.Put<uint32_t>(0x0A0B0C0D, ByteOrder::kLittleEndian);
+    writer.Put(1.5);
+    writer.PutArray(array, 3);
+    writer.PutBytes(ByteBufferView("tail"));
+    EXPECT_TRUE(writer.PutAt<uint32_t>(lengthOffset, static_cast<uint32_t>(writer.Size())));
+    EXPECT_FALSE(writer.PutAt<uint32_t>(writer.Size() - 2, 0));
+
+    const auto& buffer = writer.Buffer();
+    ASSERT_EQ(2 + 4 + 4 + 8 + 12 + 4, buffer.size());
+    EXPECT_EQ((std::vector<uint8_t> {0x01, 0x02, 0, 0, 0, 34, 0x0D, 0x0C, 0x0B, 0x0A}), std::vector<uint8_t>(buffer.begin(), buffer.begin() + 10));
+    EXPECT_EQ((std::vector<uint8_t> {0x01, 0x02, 0x03, 0x04}), std::vector<uint8_t>(buffer.begin() + 26, buffer.begin() + 30));
+
+    ByteReader reader(writer.View(), ByteOrder::kBigEndian);
+    EXPECT_EQ(0x0102, reader.Peek<uint16_t>());
+    EXPECT_EQ(0x0102, reader.Get<uint16_t>());
+    EXPECT_EQ(34U, reader.Get<uint32_t>());
+    EXPECT_EQ(0x0A0B0C0DU, reader.Get<uint32_t>(ByteOrder::kLittleEndian));
+    EXPECT_EQ(1.5, reader.Get<double>());
+    uint32_t values[3] = {};
+    EXPECT_TRUE(reader.GetArray(values, 3));
+    EXPECT_TRUE(std::equal(std::begin(array), std::end(array), std::begin(values)));
+    EXPECT_FALSE(reader.Get<uint64_t>().has_value());
+    EXPECT_EQ(30, reader.Offset());
+    const auto tail = reader.GetBytes(4);
+    ASSERT_TRUE(tail.has_value());
+    EXPECT_EQ("tail", tail->AsStringView());
+    EXPECT_EQ(writer.View().Data() + 30, tail->Data());
+    EXPECT_TRUE(reader.AtEnd());
+    EXPECT_FALSE(reader.GetBytes(1).has_value());
+    EXPECT_FALSE(reader.Skip(1));
+    EXPECT_TRUE(reader.Seek(2));
+    EXPECT_EQ(34U, reader.Get<uint32_t>());
+
+    const auto released = writer.Release();
+    EXPECT_EQ(34, released.size());
+    EXPECT_EQ(0, writer.Size());
 }
\ No newline at end of file
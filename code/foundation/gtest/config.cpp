@@ -1015,6 +1015,13 @@ TEST(Config, Null)
     EXPECT_FALSE(config.GetConfigKeys("a").empty());
     EXPECT_TRUE(config.GetConfigKeys("a").front() == "b");
     EXPECT_TRUE(config.GetConfigKeys("a.b").empty());
+    StringPool                       pool;
+    SmallVector<std::string_view, 4> keys;
+    config.GetConfigKeys("a", pool, keys);
+    ASSERT_EQ(1, keys.size());
+    EXPECT_EQ("b", keys.front());
+    config.GetConfigKeys("a.b", pool, keys);
+    EXPECT_TRUE(keys.empty());
 
     EXPECT_FALSE(view.Has(key));
     ASSERT_FALSE(view.Get<std::nullptr_t>(key).has_value());
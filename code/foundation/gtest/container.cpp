@@ -19,6 +19,13 @@
 #include <zeus/foundation/container/cache_manager.hpp>
 #include <zeus/foundation/container/filter_manager.hpp>
 #include <zeus/foundation/container/fixed_buffer_queue.hpp>
+#include <zeus/foundation/container/hash.hpp>
+#include <zeus/foundation/container/case_map.hpp>
+#include <zeus/foundation/container/dynamic_bitset.h>
+#include <zeus/foundation/container/roaring_bitmap.h>
+#include <zeus/foundation/container/small_vector.hpp>
+#include <zeus/foundation/memory/monotonic_arena.h>
+#include <zeus/foundation/memory/pool_resource.h>
 #include <zeus/foundation/time/time.h>
 #include "move_test.hpp"
 using namespace std;
@@ -1061,6 +1068,329 @@ TEST(Container, unordered_map)
     }
 }
 
+TEST(Container, hash)
+{
+    const std::string kKey = TEST1_DATA;
+    EXPECT_EQ(zeus::Hash<std::string>()(kKey), zeus::Hash<std::string>()(std::string_view(kKey)));
+    EXPECT_EQ(zeus::Hash<std::string>()(kKey), zeus::Hash<std::string_view>()(kKey));
+    EXPECT_NE(zeus::Hash<std::string>()(TEST1_DATA), zeus::Hash<std::string>()(TEST2_DATA));
+    EXPECT_EQ(zeus::Hash<int>()(100), zeus::Hash<int>()(100));
+
+    ConcurrentUnorderedMap<string, string, false, zeus::Hash<string>> container;
+    EXPECT_TRUE(container.Set(TEST1_DATA, TEST2_DATA));
+    EXPECT_TRUE(container.Set(TEST3_DATA, TEST4_DATA));
+    EXPECT_EQ(TEST2_DATA, container.Get(TEST1_DATA));
+    EXPECT_EQ(TEST4_DATA, container.Get(TEST3_DATA));
+    EXPECT_TRUE(container.Remove(TEST1_DATA));
+    EXPECT_FALSE(container.Has(TEST1_DATA));
+
+    ConcurrentUnorderedMap<int, string, true, zeus::Hash<int>> shared;
+    EXPECT_TRUE(shared.Set(1, TEST1_DATA));
+    EXPECT_EQ(TEST1_DATA, *shared.Get(1));
+
+    ConcurrentUnorderedMultiMap<string, int, false, zeus::Hash<string>> multi;
+    multi.Set(TEST1_DATA, 1);
+    multi.Set(TEST1_DATA, 2);
+    EXPECT_EQ(2, multi.Get(TEST1_DATA).size());
+}
+
+TEST(Container, caseMap)
+{
+    const std::string longKey(1000, 'K');
+    EXPECT_EQ(zeus::StringICaseHash()("Content-Type"), zeus::StringICaseHash()("content-type"));
+    EXPECT_EQ(zeus::StringICaseHash()(longKey), zeus::StringICaseHash()(zeus::ToLowerCopy(longKey)));
+    EXPECT_NE(zeus::StringICaseHash()("Content-Type"), zeus::StringICaseHash()("Content-Length"));
+    EXPECT_EQ(zeus::WStringICaseHash()(L"Content-Type"), zeus::WStringICaseHash()(L"CONTENT-TYPE"));
+
+    zeus::CaseUnorderedMap<int> unordered;
+    unordered["Content-Type"] = 1;
+    unordered["CONTENT-TYPE"] = 2;
+    unordered[longKey]        = 3;
+    EXPECT_EQ(2, unordered.size());
+    EXPECT_EQ(2, unordered.at("content-type"));
+    EXPECT_EQ(3, unordered.at(zeus::ToLowerCopy(longKey)));
+
+    zeus::WCaseUnorderedMap<int> wideUnordered;
+    wideUnordered[L"Ethernet"] = 1;
+    EXPECT_EQ(1, wideUnordered.count(L"ETHERNET"));
+
+    zeus::CaseMap<int> ordered;
+    ordered["b"] = 2;
+    ordered["A"] = 1;
+    ordered["B"] = 3;
+    EXPECT_EQ(2, ordered.size());
+    EXPECT_EQ("A", ordered.begin()->first);
+    EXPECT_EQ(3, ordered.find(std::string_view("b"))->second);
+}
+
+TEST(Container, dynamicBitset)
+{
+    DynamicBitset bits(1000);
+    std::vector<size_t> expect;
+    for (size_t index = 3; index < 1000; index += 7)
+    {
+        bits.Set(index);
+        expect.emplace_back(index);
+    }
+    bits.Set(1000); //超出长度被忽略
+    EXPECT_EQ(expect.size(), bits.Count());
+    EXPECT_TRUE(bits.Test(3));
+    EXPECT_FALSE(bits.Test(4));
+    EXPECT_EQ(3, bits.FindFirst());
+    EXPECT_EQ(10, bits.FindNext(3));
+    EXPECT_EQ(DynamicBitset::npos, bits.FindNext(expect.back()));
+
+    std::vector<size_t> visited;
+    bits.ForEach([&visited](size_t index) { visited.emplace_back(index); });
+    EXPECT_EQ(expect, visited);
+
+    for (const bool withIndex : {false, true})
+    {
+        if (withIndex)
+        {
+            bits.BuildRankIndex();
+            EXPECT_TRUE(bits.HasRankIndex());
+        }
+        for (size_t rank = 0; rank < expect.size(); ++rank)
+        {
+            EXPECT_EQ(expect[rank], bits.Select(rank));
+            EXPECT_EQ(rank, bits.Rank(expect[rank]));
+            EXPECT_EQ(rank + 1, bits.Rank(expect[rank] + 1));
+        }
+        EXPECT_EQ(DynamicBitset::npos, bits.Select(expect.size()));
+        EXPECT_EQ(expect.size(), bits.Rank(bits.Size()));
+    }
+    bits.Reset(3);
+    EXPECT_FALSE(bits.HasRankIndex());
+    EXPECT_EQ(0, bits.Rank(10));
+
+    DynamicBitset all(1000, true);
+    EXPECT_TRUE(all.All());
+    EXPECT_EQ(1000, all.Count());
+    EXPECT_EQ(bits.Count(), (all & bits).Count());
+    EXPECT_EQ(1000, (all | bits).Count());
+    EXPECT_EQ(1000 - bits.Count(), (all ^ bits).Count());
+    EXPECT_EQ(all ^ bits, DynamicBitset(all).AndNot(bits));
+    EXPECT_EQ(~bits, all ^ bits);
+    EXPECT_TRUE((~all).None());
+
+    all.Resize(1100, true);
+    EXPECT_EQ(1100, all.Count());
+    all.Resize(70);
+    EXPECT_EQ(70, all.Count());
+    DynamicBitset shorter(70);
+    shorter.Set(69);
+    bits = all;
+    bits &= shorter;
+    EXPECT_EQ(1, bits.Count());
+    EXPECT_EQ(69, bits.FindFirst());
+}
+
+namespace
+{
+class MemorySerializer : public Serializer
+{
+public:
+    zeus::expected<std::vector<uint8_t>, SerializerError> Load() override { return _data; }
+    zeus::expected<void, SerializerError>                 Save(const void* buffer, size_t bufferSize) override
+    {
+        _data.assign(static_cast<const uint8_t*>(buffer), static_cast<const uint8_t*>(buffer) + bufferSize);
+        return {};
+    }
+    std::vector<uint8_t>& Data() { return _data; }
+private:
+    std::vector<uint8_t> _data;
+};
+} // namespace
+
+TEST(Container, roaringBitmap)
+{
+    std::set<uint32_t> expect;
+    RoaringBitmap      bitmap;
+    for (uint32_t index = 0; index < 10000; ++index)
+    {
+        //稀疏块、稠密块和跨块的值
+        const uint32_t value = index % 3 ? index * 97 : (1U << 20) + index;
+        bitmap.Add(value);
+        expect.emplace(value);
+    }
+    bitmap.AddRange(0xFFFF0000ULL, 0x100000000ULL);
+    bitmap.AddRange((20 << 16) + 5, (22 << 16) + 100);
+    for (uint64_t value = 0xFFFF0000ULL; value < 0x100000000ULL; ++value)
+    {
+        expect.emplace(static_cast<uint32_t>(value));
+    }
+    for (uint32_t value = (20 << 16) + 5; value < (22 << 16) + 100; ++value)
+    {
+        expect.emplace(value);
+    }
+    EXPECT_EQ(expect.size(), bitmap.Cardinality());
+    EXPECT_EQ(std::vector<uint32_t>(expect.begin(), expect.end()), bitmap.ToVector());
+    EXPECT_EQ(*expect.begin(), bitmap.Minimum());
+    EXPECT_EQ(0xFFFFFFFF, bitmap.Maximum());
+    EXPECT_TRUE(bitmap.Contains(97));
+    EXPECT_FALSE(bitmap.Contains(98));
+    EXPECT_TRUE(bitmap.Contains(0xFFFFFFFF));
+
+    size_t rank = 0;
+    for (auto iter = expect.begin(); iter != expect.end(); std::advance(iter, 977), rank += 977)
+    {
+        EXPECT_EQ(rank, bitmap.Rank(*iter));
+        EXPECT_EQ(*iter, bitmap.Select(rank));
+        if (expect.size() - rank <= 977)
+        {
+            break;
+        }
+    }
+    EXPECT_FALSE(bitmap.Select(expect.size()).has_value());
+
+    const size_t before = bitmap.MemoryUsage();
+    EXPECT_TRUE(bitmap.RunOptimize());
+    EXPECT_LT(bitmap.MemoryUsage(), before);
+    EXPECT_EQ(std::vector<uint32_t>(expect.begin(), expect.end()), bitmap.ToVector());
+
+    EXPECT_TRUE(bitmap.Remove(97));
+    EXPECT_FALSE(bitmap.Remove(97));
+    EXPECT_TRUE(bitmap.Remove(0xFFFF0001));
+    expect.erase(97);
+    expect.erase(0xFFFF0001);
+    EXPECT_EQ(expect.size(), bitmap.Cardinality());
+
+    RoaringBitmap other;
+    for (uint32_t value = 0; value < 2000000; value += 5)
+    {
+        other.Add(value);
+    }
+    std::vector<uint32_t> andExpect;
+    std::vector<uint32_t> orExpect;
+    std::vector<uint32_t> xorExpect;
+    std::vector<uint32_t> andNotExpect;
+    const auto            lhs = bitmap.ToVector();
+    const auto            rhs = other.ToVector();
+    std::set_intersection(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(andExpect));
+    std::set_union(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(orExpect));
+    std::set_symmetric_difference(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(xorExpect));
+    std::set_difference(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(andNotExpect));
+    EXPECT_EQ(andExpect, (bitmap & other).ToVector());
+    EXPECT_EQ(orExpect, (bitmap | other).ToVector());
+    EXPECT_EQ(xorExpect, (bitmap ^ other).ToVector());
+    EXPECT_EQ(andNotExpect, RoaringBitmap(bitmap).AndNot(other).ToVector());
+    EXPECT_TRUE((bitmap ^ bitmap).Empty());
+    EXPECT_EQ(RoaringBitmap(orExpect.data(), orExpect.size()), bitmap | other);
+
+    MemorySerializer serializer;
+    ASSERT_TRUE(bitmap.Save(serializer).has_value());
+    auto loaded = RoaringBitmap::Load(serializer);
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(bitmap, loaded.value());
+    EXPECT_EQ(bitmap.Containers().size(), loaded->Containers().size());
+
+    serializer.Data().pop_back();
+    EXPECT_EQ(SerializerError::kDataFormatError, RoaringBitmap::Load(serializer).error());
+    EXPECT_FALSE(RoaringBitmap::Deserialize("bad", 3).has_value());
+    EXPECT_TRUE(RoaringBitmap::Deserialize(RoaringBitmap().Serialize().data(), 8)->Empty());
+}
+
+TEST(Container, smallVector)
+{
+    SmallVector<std::string, 4> vector {"a", "b"};
+    EXPECT_TRUE(vector.IsInline());
+    EXPECT_EQ(4, vector.capacity());
+    vector.emplace_back("c");
+    vector.push_back(vector.front()); //引用自身元素
+    EXPECT_TRUE(vector.IsInline());
+    vector.push_back(vector.back()); //扩容时引用自身元素
+    EXPECT_FALSE(vector.IsInline());
+    EXPECT_EQ((std::vector<std::string> {"a", "b", "c", "a", "a"}), std::vector<std::string>(vector.begin(), vector.end()));
+
+    vector.insert(vector.begin() + 1, "x");
+    vector.erase(vector.end() - 2, vector.end());
+    EXPECT_EQ((SmallVector<std::string, 4> {"a", "x", "b", "c"}), vector);
+    vector.shrink_to_fit();
+    EXPECT_TRUE(vector.IsInline());
+
+    //对象内部的数据逐个移动，堆上的数据转移指针
+    SmallVector<std::string, 4> moved(std::move(vector));
+    EXPECT_TRUE(vector.empty());
+    EXPECT_TRUE(moved.IsInline());
+    EXPECT_EQ(4, moved.size());
+    moved.resize(10, "y");
+    const auto* data = moved.data();
+    SmallVector<std::string, 4> stolen;
+    stolen = std::move(moved);
+    EXPECT_EQ(data, stolen.data());
+    EXPECT_EQ(10, stolen.size());
+    EXPECT_TRUE(moved.IsInline());
+
+    SmallVector<std::string, 4> copy(stolen);
+    EXPECT_EQ(stolen, copy);
+    copy.resize(2);
+    copy.swap(stolen);
+    EXPECT_EQ(2, stolen.size());
+    EXPECT_EQ(10, copy.size());
+
+    SmallVector<MoveTest, 2> moves(3);
+    EXPECT_EQ(3, moves.size());
+    SmallVector<MoveTest, 2> target(std::move(moves));
+    EXPECT_FALSE(target[0].Moved()); //堆上的数据直接转移
+}
+
+TEST(Container, pmrConcurrent)
+{
+    {
+        MonotonicArena                 arena;
+        PmrConcurrentVector<string>    vector(&arena);
+        PmrConcurrentVector<int, true> shared(&arena);
+        for (int index = 0; index < 100; ++index)
+        {
+            vector.EmplaceBack(std::to_string(index));
+            shared.EmplaceBack(index);
+        }
+        EXPECT_EQ(100, vector.Size());
+        EXPECT_EQ("99", vector.Back());
+        EXPECT_EQ(99, *shared.Back());
+        EXPECT_EQ(&arena, vector.GetAllocator().resource());
+        EXPECT_EQ(&arena, vector.Data().get_allocator().resource());
+        //元素和控制块都从arena分配
+        const size_t allocated = arena.BytesAllocated();
+        shared.PushBack(100);
+        EXPECT_GT(arena.BytesAllocated(), allocated);
+    }
+    {
+        PoolResource                     pool;
+        PmrConcurrentList<string>        list(&pool);
+        PmrConcurrentQueue<string>       queue(&pool);
+        PmrConcurrentQueue<string, true> sharedQueue(&pool);
+        zeus::ThreadPool                 threadPool(4);
+        zeus::Latch                      latch(4);
+        for (size_t thread = 0; thread < 4; ++thread)
+        {
+            threadPool.CommitTask(
+                [&]()
+                {
+                    for (size_t index = 0; index < 1000; ++index)
+                    {
+                        list.PushBack(std::to_string(index));
+                        queue.Push(std::to_string(index));
+                        sharedQueue.Emplace(std::to_string(index));
+                    }
+                    latch.CountDown();
+                });
+        }
+        latch.Wait();
+        EXPECT_EQ(4000, list.Size());
+        EXPECT_EQ(4000, queue.Size());
+        EXPECT_EQ(4000, sharedQueue.Size());
+        EXPECT_EQ(&pool, queue.GetAllocator().resource());
+        EXPECT_GT(pool.BytesReserved(), 0);
+        while (!queue.Empty())
+        {
+            queue.Pop();
+        }
+        list.Clear();
+    }
+}
+
 TEST(Container, multimap)
 {
     {
@@ -1,6 +1,16 @@
-﻿#include <gtest/gtest.h>
+﻿#include <array>
+#include <chrono>
+#include <cstring>
+#include <set>
+#include <type_traits>
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/wait.h>
+#endif
+#include <gtest/gtest.h>
 #include <zeus/foundation/core/random.h>
 #include <zeus/foundation/crypt/uuid.h>
+#include <zeus/foundation/crypt/uuid_value.h>
 #include <zeus/foundation/crypt/md5_digest.h>
 #include <zeus/foundation/crypt/raw_md5_digest.h>
 #include <zeus/foundation/crypt/crc32_digest.h>
@@ -8,14 +18,19 @@
 #include <zeus/foundation/crypt/sha224_digest.h>
 #include <zeus/foundation/crypt/sha384_digest.h>
 #include <zeus/foundation/crypt/sha256_digest.h>
+#include <zeus/foundation/crypt/sha256.h>
+#include <zeus/foundation/crypt/fast_hash.h>
 #include <zeus/foundation/crypt/sha512_digest.h>
 #include <zeus/foundation/crypt/crc64_ecma182_digest.h>
 #include <zeus/foundation/crypt/base64_encrypt.h>
 #include <zeus/foundation/crypt/base64_decrypt.h>
+#include <zeus/foundation/crypt/base64.h>
 #include <zeus/foundation/crypt/aes_encrypt.h>
 #include <zeus/foundation/crypt/aes_decrypt.h>
+#include <zeus/foundation/crypt/aes_gcm.h>
 #include <zeus/foundation/crypt/hmac_digest.h>
 #include <zeus/foundation/string/string_utils.h>
+#include <zeus/foundation/byte/byte_utils.h>
 #include <zeus/foundation/system/current_exe.h>
 #include <zeus/foundation/file/file_wrapper.h>
 #include "base64_longstring.h"
@@ -94,6 +109,90 @@ TEST(UUID, generate)
     EXPECT_EQ(32, uuid.toString("").size());
 }
 
+TEST(UUID, value)
+{
+    static_assert(std::is_trivially_copyable_v<UuidValue>);
+    static_assert(sizeof(UuidValue) == UuidValue::kSize);
+    constexpr UuidValue kNil;
+    constexpr UuidValue kMax({0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF});
+    static_assert(kNil.IsNil() && !kMax.IsNil());
+    static_assert(kNil < kMax && kNil != kMax && kMax.Hash() == std::hash<UuidValue>()(kMax));
+
+    const std::string kText = "f81d4fae-7dec-11d0-a765-00a0c91e6bf6";
+    auto              value = UuidValue::Parse(kText);
+    ASSERT_TRUE(value.has_value());
+    EXPECT_EQ(1, value->Version());
+    EXPECT_EQ(kText, value->ToString());
+    EXPECT_EQ("F81D4FAE7DEC11D0A76500A0C91E6BF6", value->ToString(true, false));
+    EXPECT_EQ(value, UuidValue::Parse("F81D4FAE7DEC11D0A76500A0C91E6BF6"));
+    EXPECT_EQ(value, UuidValue::Parse("{" + kText + "}"));
+    EXPECT_FALSE(UuidValue::Parse("f81d4fae-7dec-11d0-a765_00a0c91e6bf6").has_value());
+    EXPECT_FALSE(UuidValue::Parse("f81d4fae-7dec-11d0-a765-00a0c91e6bfg").has_value());
+    EXPECT_FALSE(UuidValue::Parse("f81d4fae7dec11d0a76500a0c91e6bf").has_value());
+
+    Uuid uuid = Uuid::FromValue(*value);
+    EXPECT_EQ(kText, uuid.toString("-", false));
+    EXPECT_EQ(*value, uuid.ToValue());
+
+    std::array<UuidValue, 100> values;
+    UuidValue::GenerateRandom(values.data(), values.size());
+    std::set<UuidValue> unique(values.begin(), values.end());
+    unique.insert(UuidValue::GenerateRandom());
+    EXPECT_EQ(values.size() + 1, unique.size());
+    for (const auto& item : unique)
+    {
+        EXPECT_EQ(4, item.Version());
+        EXPECT_EQ(0x80, item.Data()[8] & 0xC0);
+        EXPECT_EQ(item, UuidValue::Parse(item.ToString()));
+    }
+}
+
+TEST(UUID, timeOrdered)
+{
+    const auto begin =
+        static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+    UuidValue last;
+    for (size_t index = 0; index < 10000; ++index)
+    {
+        auto value = UuidValue::GenerateTimeOrdered();
+        EXPECT_EQ(7, value.Version());
+        EXPECT_EQ(0x80, value.Data()[8] & 0xC0);
+        EXPECT_LT(last, value);
+        last = value;
+    }
+    EXPECT_GE(last.Timestamp(), begin);
+    EXPECT_LT(last.Timestamp(), begin + 60 * 1000);
+}
+
+#ifdef __linux__
+TEST(UUID, fork)
+{
+    //先生成一个，线程的随机数缓冲区中留下未使用的部分
+    UuidValue::GenerateRandom();
+    int fds[2];
+    ASSERT_EQ(0, pipe(fds));
+    const pid_t pid = fork();
+    ASSERT_NE(-1, pid);
+    if (0 == pid)
+    {
+        std::array<UuidValue, 2> values = {UuidValue::GenerateRandom(), UuidValue::GenerateTimeOrdered()};
+        const auto               size   = write(fds[1], values.data(), sizeof(values));
+        _exit(sizeof(values) == size ? 0 : 1);
+    }
+    close(fds[1]);
+    const std::array<UuidValue, 2> parent = {UuidValue::GenerateRandom(), UuidValue::GenerateTimeOrdered()};
+    std::array<UuidValue, 2>       child;
+    EXPECT_EQ(static_cast<ssize_t>(sizeof(child)), read(fds[0], child.data(), sizeof(child)));
+    close(fds[0]);
+    int status = 0;
+    ASSERT_EQ(pid, waitpid(pid, &status, 0));
+    EXPECT_TRUE(WIFEXITED(status) && 0 == WEXITSTATUS(status));
+    EXPECT_NE(parent[0], child[0]);
+    //时间戳和计数器可能相同，随机部分必须不同
+    EXPECT_NE(0, std::memcmp(parent[1].Data() + 8, child[1].Data() + 8, UuidValue::kSize - 8));
+}
+#endif
+
 TEST(Crypt, Digest)
 {
     const std::string kDigit      = "0123456789";
@@ -217,6 +316,172 @@ TEST(Crypt, Digest)
     TEST_HMAC_DIGEST(SHA512);
 }
 
+TEST(Crypt, DigestHash)
+{
+    const std::string kAbc = "abc";
+    auto              hash = [&kAbc](void (*function)(const void *, size_t, void *), size_t size)
+    {
+        std::vector<uint8_t> digest(size);
+        function(kAbc.data(), kAbc.size(), digest.data());
+        return digest;
+    };
+    EXPECT_EQ(*HexStringToBytes("900150983cd24fb0d6963f7d28e17f72"), hash(Md5Digest::Hash, Md5Digest::kDigestSize));
+    EXPECT_EQ(*HexStringToBytes("a9993e364706816aba3e25717850c26c9cd0d89d"), hash(SHA1Digest::Hash, SHA1Digest::kDigestSize));
+    EXPECT_EQ(*HexStringToBytes("23097d223405d8228642a477bda255b32aadbce4bda0b3f7e36c9da7"), hash(SHA224Digest::Hash, SHA224Digest::kDigestSize));
+    EXPECT_EQ(
+        *HexStringToBytes("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"), hash(SHA256Digest::Hash, SHA256Digest::kDigestSize)
+    );
+    EXPECT_EQ(
+        *HexStringToBytes("cb00753f45a35e8bb5a03d699ac65007272c32ab0eded1631a8b605a43ff5bed8086072ba1e7cc2358baeca134c825a7"),
+        hash(SHA384Digest::Hash, SHA384Digest::kDigestSize)
+    );
+    EXPECT_EQ(
+        *HexStringToBytes(
+            "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f"
+        ),
+        hash(SHA512Digest::Hash, SHA512Digest::kDigestSize)
+    );
+
+    const std::string    kKey  = "Jefe";
+    const std::string    kData = "what do ya want for nothing?";
+    std::vector<uint8_t> digest(SHA512Digest::kDigestSize);
+    HMACDigest::Hash(kData.data(), kData.size(), kKey.data(), kKey.size(), digest.data(), HMACDigestType::SHA512);
+    EXPECT_EQ(
+        *HexStringToBytes(
+            "164b7a7bfcf819e2e395fbe73b56e0a387bd64222e831fd610270cd7ea2505549758bf75c05a994a6d034f65f8f0e6fdcaeab1a34d4a6b4b636e070a38bce737"
+        ),
+        digest
+    );
+    digest.resize(SHA256Digest::kDigestSize);
+    HMACDigest::Hash(kData.data(), kData.size(), kKey.data(), kKey.size(), digest.data());
+    EXPECT_EQ(*HexStringToBytes("5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843"), digest);
+}
+
+static std::vector<uint8_t> ToVector(const Sha256::DigestBytes &digest)
+{
+    return std::vector<uint8_t>(reinterpret_cast<const uint8_t *>(digest.data()), reinterpret_cast<const uint8_t *>(digest.data()) + digest.size());
+}
+
+TEST(Crypt, Sha256)
+{
+    EXPECT_EQ(*HexStringToBytes("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"), ToVector(Sha256::Hash("")));
+    EXPECT_EQ(*HexStringToBytes("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"), ToVector(Sha256::Hash("abc")));
+    EXPECT_EQ(
+        *HexStringToBytes("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"),
+        ToVector(Sha256::Hash("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"))
+    );
+
+    //分段计算和一次计算结果一致，Final之后上下文可以直接复用
+    const std::string data = RandString(1000);
+    Sha256            context;
+    for (size_t length = 0; length <= data.size(); length += 37)
+    {
+        const std::string_view view(data.data(), length);
+        for (size_t offset = 0; offset < view.size(); offset += 13)
+        {
+            context.Update(view.substr(offset, 13));
+        }
+        auto digest = context.Final();
+        EXPECT_EQ(SHA256Digest(view.data(), view.size()).ToString(), BytesToHexString(digest.data(), digest.size(), false));
+        EXPECT_EQ(digest, Sha256::Hash(view));
+    }
+}
+
+TEST(Crypt, Sha256HashMany)
+{
+    std::vector<std::string> messages;
+    for (size_t index = 0; index < 37; ++index)
+    {
+        messages.emplace_back(RandString(index * 11 % 300));
+    }
+    std::vector<const void *>        inputs;
+    std::vector<size_t>              lengths;
+    std::vector<Sha256::DigestBytes> digests(messages.size());
+    for (const auto &message : messages)
+    {
+        inputs.emplace_back(message.data());
+        lengths.emplace_back(message.size());
+    }
+    Sha256::HashMany(inputs.data(), lengths.data(), messages.size(), digests.data());
+    for (size_t index = 0; index < messages.size(); ++index)
+    {
+        EXPECT_EQ(Sha256::Hash(messages[index]), digests[index]);
+    }
+}
+
+TEST(Crypt, HmacSha256)
+{
+    const std::string kKey  = "Jefe";
+    const std::string kData = "what do ya want for nothing?";
+    EXPECT_EQ(
+        *HexStringToBytes("5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843"),
+        ToVector(HmacSha256::Hash(kKey.data(), kKey.size(), kData.data(), kData.size()))
+    );
+    //超过块长度的密钥先做散列
+    const std::string kLongKey(131, '\xaa');
+    const std::string kLongKeyData = "Test Using Larger Than Block-Size Key - Hash Key First";
+    HmacSha256        context(kLongKey.data(), kLongKey.size());
+    for (size_t index = 0; index < 2; ++index)
+    {
+        context.Update(kLongKeyData);
+        EXPECT_EQ(*HexStringToBytes("60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54"), ToVector(context.Final()));
+    }
+    EXPECT_EQ(
+        *HexStringToBytes("b613679a0814d9ec772f95d778c35fc5ff1697c493715653c6c712144292c5ad"), ToVector(HmacSha256::Hash(nullptr, 0, nullptr, 0))
+    );
+
+    const std::string kSalt = "zeusZeusZEUSzEuszEUszEUZS";
+    const std::string data  = RandString(300);
+    HMACDigest        digest(data, kSalt.data(), kSalt.size());
+    auto              hash  = HmacSha256::Hash(kSalt.data(), kSalt.size(), data.data(), data.size());
+    EXPECT_EQ(digest.ToString(), BytesToHexString(hash.data(), hash.size(), false));
+}
+
+TEST(Crypt, FastHash)
+{
+    const std::string kShort = "zeus fast hash";
+    std::string       longData(1000, '\0');
+    for (size_t index = 0; index < longData.size(); ++index)
+    {
+        longData[index] = static_cast<char>(index * 131 + 7);
+    }
+    //与XXH3的结果一致
+    EXPECT_EQ(0x2d06800538d394c2ULL, FastHash::Hash64(nullptr, 0));
+    EXPECT_EQ(0x09b146142e3ff1c3ULL, FastHash::Hash64(kShort));
+    EXPECT_EQ(0x571d5cbfef44331bULL, FastHash::Hash64(longData));
+    EXPECT_EQ(0xda71bc4aec3fbef0ULL, FastHash::Hash64(nullptr, 0, 0x1234));
+    EXPECT_EQ(0x62318285c7c326baULL, FastHash::Hash64(kShort, 0x1234));
+    EXPECT_EQ(0xfe72162f08820e8aULL, FastHash::Hash64(longData, 0x1234));
+    EXPECT_EQ((Hash128Value {0x383a0d59dbe450a6ULL, 0x7bfe2c627ff4d813ULL}), FastHash::Hash128(kShort));
+    EXPECT_EQ((Hash128Value {0x571d5cbfef44331bULL, 0x622239c5c47a6910ULL}), FastHash::Hash128(longData));
+    EXPECT_EQ((Hash128Value {0xd43bd24ab603a7caULL, 0xda4b72fc01687cd9ULL}), FastHash::Hash128(kShort, 0x1234));
+    EXPECT_EQ((Hash128Value {0xfe72162f08820e8aULL, 0x7cb9454c5eb9fb47ULL}), FastHash::Hash128(longData, 0x1234));
+
+    //流式计算与一次性计算结果一致，覆盖短数据、缓冲区边界和多个块
+    const std::string data = RandString(5000);
+    for (const uint64_t seed : {static_cast<uint64_t>(0), FastHash::RandomSeed()})
+    {
+        for (const size_t length : {0, 1, 16, 128, 240, 241, 256, 257, 1024, 1025, 5000})
+        {
+            for (const size_t chunk : {1, 7, 64, 256, 1000})
+            {
+                FastHash context(seed);
+                for (size_t offset = 0; offset < length; offset += chunk)
+                {
+                    context.Update(data.data() + offset, std::min(chunk, length - offset));
+                }
+                EXPECT_EQ(FastHash::Hash64(data.data(), length, seed), context.Digest64());
+                EXPECT_EQ(FastHash::Hash128(data.data(), length, seed), context.Digest128());
+            }
+        }
+    }
+    FastHash context;
+    context.Update(kShort);
+    context.Reset(0x1234);
+    context.Update(kShort);
+    EXPECT_EQ(0x62318285c7c326baULL, context.Digest64());
+}
+
 static void DoCryptoGTest(BaseEncrypt &encrypt, BaseDecrypt &decrypt, const string &expectPlanText, const string &expectCipherText)
 {
     {
@@ -440,6 +705,56 @@ TEST(Base64, BigLong)
     DoCryptoGTest(encryptUrl, decryptUrl, planText, expectCipherUrlText);
 }
 
+TEST(Base64, codec)
+{
+    const string planText            = Repeat(string(BASE64_LONGSTRING_THREE, sizeof(BASE64_LONGSTRING_THREE) - 1), 16);
+    const string expectCipherText    = Repeat(string(BASE64_LONGSTRING_THREE_CIPHERTEXT, sizeof(BASE64_LONGSTRING_THREE_CIPHERTEXT) - 1), 16);
+    const string expectCipherUrlText = Repeat(string(BASE64_LONGSTRING_THREE_CIPHERTEXTURL, sizeof(BASE64_LONGSTRING_THREE_CIPHERTEXTURL) - 1), 16);
+    EXPECT_EQ(expectCipherText, Base64::Encode(planText.data(), planText.size()));
+    EXPECT_EQ(expectCipherUrlText, Base64::Encode(planText.data(), planText.size(), Base64::Alphabet::kUrlSafe));
+    auto plain = Base64::Decode(expectCipherText);
+    ASSERT_TRUE(plain.has_value());
+    EXPECT_EQ(planText, string(plain->begin(), plain->end()));
+    plain = Base64::Decode(expectCipherUrlText, Base64::Alphabet::kUrlSafe);
+    ASSERT_TRUE(plain.has_value());
+    EXPECT_EQ(planText, string(plain->begin(), plain->end()));
+
+    //各种长度的尾部处理和Crypto++实现保持一致
+    for (size_t length = 0; length < 100; ++length)
+    {
+        const auto data = RandString(length);
+        const auto text = Base64Encrypt(data).GetString();
+        char       buffer[Base64::EncodedLength(100)];
+        ASSERT_EQ(text.size(), Base64::Encode(data.data(), data.size(), buffer));
+        EXPECT_EQ(text, string(buffer, text.size()));
+
+        const auto unpadded = Base64::Encode(data.data(), data.size(), Base64::Alphabet::kStandard, false);
+        EXPECT_EQ(text.substr(0, text.find('=')), unpadded);
+        for (const auto& input : {text, unpadded})
+        {
+            uint8_t output[100];
+            auto    size = Base64::Decode(input.data(), input.size(), output);
+            ASSERT_TRUE(size.has_value());
+            EXPECT_EQ(data, string(reinterpret_cast<const char*>(output), *size));
+        }
+    }
+
+    string invalid(expectCipherText);
+    invalid[1000] = '-';
+    auto result   = Base64::Decode(invalid);
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(1000, result.error().offset);
+    result = Base64::Decode(expectCipherText, Base64::Alphabet::kUrlSafe);
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(expectCipherText.find_first_of("+/"), result.error().offset);
+    result = Base64::Decode("QUJD\n");
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(4, result.error().offset);
+    result = Base64::Decode("QUJDR");
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(4, result.error().offset);
+}
+
 TEST(AES, base)
 {
     const std::string kASCII   = R"(!"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\]^_`abcdefghijklmnopqrstuvwxyz{|}~)";
@@ -549,6 +864,65 @@ TEST(AES, base)
     }
 }
 
+TEST(AES, gcm)
+{
+    //NIST GCM spec test case 4
+    auto key        = *HexStringToBytes("feffe9928665731c6d6a8f9467308308");
+    auto iv         = *HexStringToBytes("cafebabefacedbaddecaf888");
+    auto aad        = *HexStringToBytes("feedfacedeadbeeffeedfacedeadbeefabaddad2");
+    auto planText   = *HexStringToBytes(
+        "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a721c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39"
+    );
+    auto cipherText = *HexStringToBytes(
+        "42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091"
+    );
+    auto expectTag  = *HexStringToBytes("5bc94fbc3221a5db94fae95ae7121a47");
+
+    AesGcm gcm(key.data(), key.size());
+    {
+        std::vector<uint8_t>                  output(planText.size());
+        std::array<uint8_t, AesGcm::kTagSize> tag {};
+        gcm.Encrypt(iv.data(), iv.size(), aad.data(), aad.size(), planText.data(), planText.size(), output.data(), tag.data());
+        EXPECT_EQ(cipherText, output);
+        EXPECT_EQ(0, std::memcmp(expectTag.data(), tag.data(), tag.size()));
+    }
+    {
+        //原地加解密
+        auto                                  buffer = planText;
+        std::array<uint8_t, AesGcm::kTagSize> tag {};
+        gcm.Encrypt(iv.data(), iv.size(), aad.data(), aad.size(), buffer.data(), buffer.size(), buffer.data(), tag.data());
+        EXPECT_EQ(cipherText, buffer);
+        EXPECT_TRUE(gcm.Decrypt(iv.data(), iv.size(), aad.data(), aad.size(), buffer.data(), buffer.size(), buffer.data(), tag.data()));
+        EXPECT_EQ(planText, buffer);
+    }
+    {
+        auto                       buffer = cipherText;
+        auto                       tag    = expectTag;
+        std::vector<uint8_t>       output(buffer.size(), 0xff);
+        const std::vector<uint8_t> zero(buffer.size());
+        tag[0] ^= 1;
+        EXPECT_FALSE(gcm.Decrypt(iv.data(), iv.size(), aad.data(), aad.size(), buffer.data(), buffer.size(), output.data(), tag.data()));
+        EXPECT_EQ(zero, output);
+        auto inplace = cipherText;
+        EXPECT_FALSE(gcm.Decrypt(iv.data(), iv.size(), aad.data(), aad.size(), inplace.data(), inplace.size(), inplace.data(), tag.data()));
+        EXPECT_EQ(zero, inplace);
+        buffer[0] ^= 1;
+        EXPECT_FALSE(gcm.Decrypt(iv.data(), iv.size(), aad.data(), aad.size(), buffer.data(), buffer.size(), output.data(), expectTag.data()));
+        EXPECT_FALSE(gcm.Decrypt(iv.data(), iv.size(), buffer.data(), buffer.size(), output.data(), expectTag.data()));
+    }
+    {
+        const std::string                     kASCII = R"(!"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\]^_`abcdefghijklmnopqrstuvwxyz{|}~)";
+        std::string                           text   = Repeat(kASCII, 100);
+        std::string                           buffer = text;
+        std::array<uint8_t, AesGcm::kTagSize> tag {};
+        AesGcm                                gcm256("9x38fy2138ebda5)da2am3ea008d86z9");
+        gcm256.Encrypt(iv.data(), iv.size(), buffer.data(), buffer.size(), buffer.data(), tag.data());
+        EXPECT_NE(text, buffer);
+        EXPECT_TRUE(gcm256.Decrypt(iv.data(), iv.size(), buffer.data(), buffer.size(), buffer.data(), tag.data()));
+        EXPECT_EQ(text, buffer);
+    }
+}
+
 TEST(Digest, Name)
 {
     const std::string kSalt = "ZeusZEUS";
@@ -633,6 +1007,10 @@ TEST(Crypt, Name)
         auto crypt = std::make_shared<AesDecrypt>(AESMode::CFB, AESPadding::ANSI_X_923, key, iv);
         EXPECT_EQ("AES(CFB|ANSI_X_923)", crypt->Name());
     }
+    {
+        auto crypt = std::make_shared<AesGcm>(key);
+        EXPECT_EQ("AES(GCM)", crypt->Name());
+    }
     {
         auto crypt = std::make_shared<Base64Encrypt>();
         EXPECT_EQ("BASE64", crypt->Name());
@@ -1,5 +1,13 @@
 ﻿#include <filesystem>
 #include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
 #include <gtest/gtest.h>
 #include <zeus/foundation/core/random.h>
 #include <zeus/foundation/string/string_utils.h>
@@ -8,9 +16,16 @@
 #include <zeus/foundation/file/file_utils.h>
 #include <zeus/foundation/file/kv_file_utils.h>
 #include <zeus/foundation/file/ini_file_utils.h>
+#include <zeus/foundation/file/parsed_file_cache.h>
 #include <zeus/foundation/file/file_utils.h>
 #include <zeus/foundation/file/backup_file.h>
 #include <zeus/foundation/file/file_wrapper.h>
+#include <zeus/foundation/file/io_ring.h>
+#include <zeus/foundation/file/line_reader.h>
+#include <zeus/foundation/file/directory_walker.h>
+#include <zeus/foundation/file/write_ahead_log.h>
+#include <zeus/foundation/memory/aligned_buffer_pool.h>
+#include <zeus/foundation/thread/thread_pool.h>
 #include <zeus/foundation/system/win/file_attributes.h>
 #include <zeus/foundation/security/win/token.h>
 #include <zeus/foundation/time/time.h>
@@ -110,6 +125,233 @@ TEST(file, iniTrim)
     EXPECT_EQ(u8"应用名abc中文", GetIniFileValue(filename, "Desktop Entry", "Name[zh_CN]"));
 }
 
+TEST(file, parsedFileCache)
+{
+    ParsedFileCache cache(2);
+    //解析结果和逐行读取的函数一致
+    fs::path iniFilename = zeus::CurrentExe::GetAppDir() / fs::u8path(u8"ini_test.txt");
+    auto     iniValues   = cache.GetIniValues(iniFilename, "INI_SECTION_1", {"ini_section_1_key_2", "missing", "ini_section_1_key_1"}).value();
+    ASSERT_EQ(3, iniValues.size());
+    EXPECT_EQ(GetIniFileValue(iniFilename, "INI_SECTION_1", "ini_section_1_key_2").value(), iniValues[0]);
+    EXPECT_FALSE(iniValues[1].has_value());
+    EXPECT_EQ(GetIniFileValue(iniFilename, "INI_SECTION_1", "ini_section_1_key_1").value(), iniValues[2]);
+    EXPECT_EQ("310473107007619072", cache.GetIniValues(iniFilename, "INI_SECTION_4", {"key_twice"}).value()[0]);
+    EXPECT_EQ(GetIniFileSections(iniFilename).value().size(), cache.GetIniTable(iniFilename).value()->size());
+    fs::path kvFilename = zeus::CurrentExe::GetAppDir() / fs::u8path(u8"cpuinfo_kv.txt");
+    EXPECT_EQ(GetKVFileValue(kvFilename, "core id\t\t", ": ").value(), cache.GetKVValues(kvFilename, {"core id\t\t"}, ": ").value()[0]);
+    EXPECT_EQ(GetKVFileData(kvFilename, ": ").value().size(), cache.GetKVTable(kvFilename, ": ").value()->size());
+
+    //文件没有变化时返回同一个解析结果，变化后重新解析
+    auto filename = zeus::CurrentExe::GetAppDir() / "parsed_cache.txt";
+    {
+        std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+        file << "#comment\nkey1=value1\nkey2=value2\nkey1=again\n";
+    }
+    auto table = cache.GetKVTable(filename).value();
+    ASSERT_EQ(3, table->size());
+    EXPECT_EQ(table, cache.GetKVTable(filename).value());
+    EXPECT_NE(table, cache.GetKVTable(filename, ":").value());
+    auto values = cache.GetKVValues(filename, {"key1", "key2", "key3"}).value();
+    EXPECT_EQ("value1", values[0]);
+    EXPECT_EQ("value2", values[1]);
+    EXPECT_FALSE(values[2].has_value());
+    {
+        std::ofstream file(filename, std::ios::binary | std::ios::app);
+        file << "key3=value3\n";
+    }
+    auto changed = cache.GetKVTable(filename).value();
+    EXPECT_NE(table, changed);
+    EXPECT_EQ(4, changed->size());
+    EXPECT_EQ(3, table->size());
+    EXPECT_EQ("value3", cache.GetKVValues(filename, {"key3"}).value()[0]);
+    cache.Invalidate(filename);
+    EXPECT_NE(changed, cache.GetKVTable(filename).value());
+
+    fs::remove(filename);
+    EXPECT_FALSE(cache.GetKVTable(filename).has_value());
+#ifdef __linux__
+    //procfs的文件每次都重新读取
+    auto status = cache.GetKVTable("/proc/self/status", ":").value();
+    EXPECT_NE(status, cache.GetKVTable("/proc/self/status", ":").value());
+    EXPECT_TRUE(cache.GetKVValues("/proc/self/status", {"Name", "Pid"}, ":").value()[1].has_value());
+#endif
+}
+
+TEST(file, writeAheadLog)
+{
+    auto directory = zeus::CurrentExe::GetAppDir() / "wal_test";
+    fs::remove_all(directory);
+    WriteAheadLog::Options options;
+    options.segmentSize = 1024;
+    const auto record   = [](uint64_t sequence) { return std::string(static_cast<size_t>(sequence % 300), static_cast<char>('a' + sequence % 26)); };
+    const auto collect  = [](std::vector<std::pair<uint64_t, std::string>>& records)
+    {
+        return [&records](uint64_t sequence, std::string_view data)
+        {
+            records.emplace_back(sequence, data);
+            return true;
+        };
+    };
+    {
+        std::vector<std::pair<uint64_t, std::string>> records;
+        auto                                          wal = WriteAheadLog::Open(directory, options, collect(records)).value();
+        EXPECT_TRUE(records.empty());
+        EXPECT_EQ(0, wal.LastSequence());
+        for (uint64_t sequence = 1; sequence <= 100; ++sequence)
+        {
+            EXPECT_EQ(sequence, wal.Append(record(sequence)).value());
+        }
+        EXPECT_EQ(100, wal.DurableSequence());
+        EXPECT_GT(wal.SegmentCount(), 3);
+    }
+    //重新打开时按顺序回放所有记录
+    {
+        std::vector<std::pair<uint64_t, std::string>> records;
+        auto                                          wal = WriteAheadLog::Open(directory, options, collect(records)).value();
+        ASSERT_EQ(100, records.size());
+        for (uint64_t sequence = 1; sequence <= 100; ++sequence)
+        {
+            EXPECT_EQ(sequence, records[sequence - 1].first);
+            EXPECT_EQ(record(sequence), records[sequence - 1].second);
+        }
+        EXPECT_EQ(100, wal.LastSequence());
+        EXPECT_EQ(101, wal.Append(record(101)).value());
+    }
+
+    //最后一个段结尾写了一半的记录被截掉，之后的写入接在有效记录后面
+    fs::path lastSegment;
+    for (const auto& entry : fs::directory_iterator(directory))
+    {
+        if (entry.path().extension() == ".wal" && entry.path() > lastSegment)
+        {
+            lastSegment = entry.path();
+        }
+    }
+    const auto validSize = fs::file_size(lastSegment);
+    {
+        std::ofstream file(lastSegment, std::ios::binary | std::ios::app);
+        file << std::string(10, 'x');
+    }
+    {
+        uint64_t last = 0;
+        auto     wal  = WriteAheadLog::Open(directory, options, [&last](uint64_t sequence, std::string_view) { return last = sequence, true; }).value();
+        EXPECT_EQ(101, last);
+        EXPECT_EQ(validSize, fs::file_size(lastSegment));
+        EXPECT_EQ(102, wal.Append(record(102)).value());
+    }
+    //损坏最后一条记录的内容，校验失败的记录被丢弃
+    fs::resize_file(lastSegment, fs::file_size(lastSegment) - 1);
+    {
+        std::vector<std::pair<uint64_t, std::string>> records;
+        auto                                          wal = WriteAheadLog::Open(directory, options, collect(records)).value();
+        EXPECT_EQ(101, records.back().first);
+        EXPECT_EQ(101, wal.LastSequence());
+        EXPECT_EQ(validSize, fs::file_size(lastSegment));
+    }
+    //中间的段损坏时返回错误
+    const auto firstSegment = directory / "0000000000000001.wal";
+    {
+        std::fstream file(firstSegment, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(40);
+        file.put('!');
+    }
+    EXPECT_FALSE(WriteAheadLog::Open(directory, options, nullptr).has_value());
+    EXPECT_FALSE(WriteAheadLog::Read(directory, 0, nullptr).has_value());
+
+    //检查点之前的段被删除，之后打开时不再回放检查点之前的记录
+    fs::remove_all(directory);
+    {
+        uint64_t compactions       = 0;
+        options.compactionSegments = 4;
+        options.compactionHook     = [&compactions](uint64_t lastSequence) -> std::optional<uint64_t>
+        {
+            ++compactions;
+            return lastSequence;
+        };
+        auto wal = WriteAheadLog::Open(directory, options, nullptr).value();
+        for (uint64_t sequence = 1; sequence <= 100; ++sequence)
+        {
+            wal.Append(record(sequence)).value();
+        }
+        EXPECT_GT(compactions, 0);
+        EXPECT_LE(wal.SegmentCount(), 5);
+        EXPECT_GT(wal.CheckpointSequence(), 0);
+        EXPECT_FALSE(fs::exists(firstSegment));
+        EXPECT_FALSE(wal.Checkpoint(101).has_value());
+        EXPECT_TRUE(wal.Checkpoint(90).has_value());
+        EXPECT_EQ(90, wal.CheckpointSequence());
+    }
+    options.compactionHook = nullptr;
+    {
+        std::vector<std::pair<uint64_t, std::string>> records;
+        auto                                          wal = WriteAheadLog::Open(directory, options, collect(records)).value();
+        ASSERT_EQ(10, records.size());
+        EXPECT_EQ(91, records.front().first);
+        EXPECT_EQ(record(100), records.back().second);
+    }
+    //只读遍历，回调返回false时停止
+    std::vector<uint64_t> sequences;
+    EXPECT_TRUE(WriteAheadLog::Read(
+                    directory, 95,
+                    [&sequences](uint64_t sequence, std::string_view)
+                    {
+                        sequences.push_back(sequence);
+                        return sequence < 98;
+                    }
+    )
+                    .has_value());
+    EXPECT_EQ(std::vector<uint64_t>({96, 97, 98}), sequences);
+
+    //多个线程同时写入，序号不重复，全部记录都能回放
+    fs::remove_all(directory);
+    {
+        options.syncMode = WriteAheadLog::SyncMode::kAlways;
+        auto                     wal = WriteAheadLog::Open(directory, options, nullptr).value();
+        std::vector<std::thread> threads;
+        std::atomic<size_t>      failed = 0;
+        for (size_t index = 0; index < 4; ++index)
+        {
+            threads.emplace_back(
+                [&wal, &failed, index]()
+                {
+                    for (size_t count = 0; count < 50; ++count)
+                    {
+                        if (!wal.Append(std::to_string(index * 1000 + count)).has_value())
+                        {
+                            ++failed;
+                        }
+                    }
+                }
+            );
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        EXPECT_EQ(0, failed);
+        EXPECT_EQ(200, wal.LastSequence());
+        EXPECT_EQ(200, wal.DurableSequence());
+    }
+    {
+        options.syncMode = WriteAheadLog::SyncMode::kNone;
+        std::set<std::string> values;
+        auto                  wal = WriteAheadLog::Open(
+            directory, options,
+            [&values](uint64_t, std::string_view data)
+            {
+                values.emplace(data);
+                return true;
+            }
+        );
+        ASSERT_TRUE(wal.has_value());
+        EXPECT_EQ(200, values.size());
+        EXPECT_EQ(201, wal->Append("none").value());
+        EXPECT_TRUE(wal->Sync().has_value());
+        EXPECT_EQ(201, wal->DurableSequence());
+    }
+    fs::remove_all(directory);
+}
+
 TEST(BackupFile, base)
 {
     fs::path filename = zeus::CurrentExe::GetAppPath();
@@ -204,6 +446,87 @@ TEST(file, Compare)
     EXPECT_FALSE(FileEQ(path1, path2));
 }
 
+TEST(file, Copy)
+{
+    auto dir = zeus::CurrentExe::GetAppDir() / "fileCopyTemp";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    auto source = dir / "source.bin";
+    auto target = dir / "target.bin";
+
+    // 跨越多个比较窗口
+    static constexpr size_t kBlockSize = 1024 * 1024;
+    static constexpr size_t kFileSize  = 150 * kBlockSize + 12345;
+    {
+        auto        fileWrapper = FileWrapper::Truncate(source, FileWrapper::OpenMode::kWrite).value();
+        std::string block(kBlockSize, '\0');
+        for (size_t offset = 0; offset < kFileSize; offset += kBlockSize)
+        {
+            for (size_t index = 0; index < block.size(); ++index)
+            {
+                block[index] = static_cast<char>((offset / kBlockSize) * 31 + index);
+            }
+            const size_t size = std::min(kBlockSize, kFileSize - offset);
+            ASSERT_EQ(size, fileWrapper.WriteAt(block.data(), size, offset).value());
+        }
+    }
+    uint64_t lastCopied = 0;
+    size_t   callCount  = 0;
+    auto     result     = FileCopy(
+        source, target, false,
+        [&](uint64_t copied, uint64_t total)
+        {
+            EXPECT_EQ(kFileSize, total);
+            EXPECT_GT(copied, lastCopied);
+            lastCopied = copied;
+            ++callCount;
+            return true;
+        }
+    );
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(kFileSize, lastCopied);
+    EXPECT_GT(callCount, 0);
+    EXPECT_EQ(fs::status(source).permissions(), fs::status(target).permissions());
+    EXPECT_TRUE(FileEqual(source, target).value());
+    EXPECT_TRUE(FileEqual(source, target, 4).value());
+
+    // 目标已经存在
+    result = FileCopy(source, target);
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(std::errc::file_exists, result.error());
+    // 不能覆盖自身
+    EXPECT_FALSE(FileCopy(source, source, true).has_value());
+    EXPECT_EQ(kFileSize, fs::file_size(source));
+
+    // 取消后删除目标文件
+    result = FileCopy(source, dir / "canceled.bin", false, [](uint64_t, uint64_t) { return false; });
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(std::errc::operation_canceled, result.error());
+    EXPECT_FALSE(fs::exists(dir / "canceled.bin"));
+
+    // 第一个和最后一个窗口中的差异
+    for (uint64_t offset : {uint64_t(0), uint64_t(kFileSize - 1)})
+    {
+        auto fileWrapper = FileWrapper::Open(target, FileWrapper::OpenMode::kReadWrite).value();
+        char byte        = 0;
+        ASSERT_EQ(1, fileWrapper.ReadAt(&byte, 1, offset).value());
+        byte = static_cast<char>(~byte);
+        ASSERT_EQ(1, fileWrapper.WriteAt(&byte, 1, offset).value());
+        EXPECT_FALSE(FileEqual(source, target).value());
+        EXPECT_FALSE(FileEqual(source, target, 4).value());
+        ASSERT_TRUE(FileCopy(source, target, true).has_value());
+        EXPECT_TRUE(FileEqual(source, target, 4).value());
+    }
+
+    // 空文件
+    {
+        FileWrapper::Truncate(source, FileWrapper::OpenMode::kWrite).value();
+    }
+    ASSERT_TRUE(FileCopy(source, target, true).has_value());
+    EXPECT_EQ(0, fs::file_size(target));
+    fs::remove_all(dir);
+}
+
 TEST(file, Enumerate)
 {
 #ifdef _WIN32
@@ -417,6 +740,98 @@ TEST(file, Filter)
     );
 }
 
+TEST(file, directoryWalker)
+{
+    auto main = zeus::CurrentExe::GetAppDir() / "walkTemp";
+    fs::remove_all(main);
+
+    //三层目录，每层10个文件
+    std::set<fs::path>    allFiles;
+    std::set<fs::path>    topFiles;
+    uint64_t              totalSize   = 0;
+    std::vector<fs::path> directories = {main};
+    for (size_t level = 0; level < 3; ++level)
+    {
+        std::vector<fs::path> next;
+        for (const auto& directory : directories)
+        {
+            for (const auto& [path, size] : RandomFiles(directory, 10))
+            {
+                allFiles.emplace(path);
+                totalSize += size;
+                if (0 == level)
+                {
+                    topFiles.emplace(path);
+                }
+            }
+            for (size_t index = 0; index < 3; ++index)
+            {
+                next.emplace_back(directory / ("sub" + std::to_string(index)));
+            }
+        }
+        directories = std::move(next);
+    }
+    //loop指回根目录，跟随链接时被跳过；link指向另一个分支，跟随时多出10个文件
+    fs::create_directory_symlink(main, main / "sub0" / "loop");
+    fs::create_directory_symlink(main / "sub0" / "sub0", main / "sub1" / "link");
+
+    for (size_t parallelism : {1, 4})
+    {
+        DirectoryWalker::Options options;
+        options.parallelism = parallelism;
+        auto files          = DirectoryWalker::Collect(main, options).value();
+        EXPECT_EQ(allFiles, std::set<fs::path>(files.begin(), files.end()));
+        EXPECT_EQ(totalSize, DirectoryWalker::TotalSize(main, options).value());
+
+        options.followSymbolLinkDirectory = true;
+        files                             = DirectoryWalker::Collect(main, options).value();
+        std::set<fs::path> followed(files.begin(), files.end());
+        EXPECT_EQ(allFiles.size() + 10, followed.size());
+        EXPECT_TRUE(std::includes(followed.begin(), followed.end(), allFiles.begin(), allFiles.end()));
+
+        options.followSymbolLinkDirectory = false;
+        options.maxDepth                  = 1;
+        files                             = DirectoryWalker::Collect(main, options).value();
+        EXPECT_EQ(topFiles, std::set<fs::path>(files.begin(), files.end()));
+
+        //过滤器在回调之前生效，被剪掉的目录不会列出
+        options.maxDepth        = 2;
+        options.directoryFilter = [](const fs::path& path, size_t depth)
+        {
+            EXPECT_EQ(1, depth);
+            return path.filename() != "sub1";
+        };
+        std::atomic<size_t> count = 0;
+        auto                ret   = DirectoryWalker::Walk(
+            main, options,
+            [&count](const DirectoryWalker::Entry& entry)
+            {
+                EXPECT_LE(entry.depth, 2);
+                EXPECT_EQ(std::string::npos, entry.path.u8string().find("sub1"));
+                ++count;
+                return true;
+            }
+        );
+        EXPECT_TRUE(ret.has_value());
+        EXPECT_EQ(30, count.load());
+
+        options.directoryFilter = nullptr;
+        options.maxDepth        = std::numeric_limits<size_t>::max();
+        options.fileFilter      = [](const fs::path& path) { return path.parent_path().filename() == "sub2"; };
+        files                   = DirectoryWalker::Collect(main, options).value();
+        EXPECT_EQ(10 + 30, files.size());
+
+        options.fileFilter = nullptr;
+        count              = 0;
+        ret                = DirectoryWalker::Walk(main, options, [&count](const DirectoryWalker::Entry&) { return ++count < 5; });
+        EXPECT_TRUE(ret.has_value());
+        EXPECT_LE(5, count.load());
+        EXPECT_GT(allFiles.size(), count.load());
+    }
+    EXPECT_FALSE(DirectoryWalker::Walk(main / "nonexistent", {}, [](const DirectoryWalker::Entry&) { return true; }).has_value());
+    fs::remove_all(main);
+}
+
 TEST(file, wrapper)
 {
     const auto kRepeatMemoryCheck = [](std::string_view expect, size_t count, const void* data)
@@ -584,6 +999,547 @@ TEST(file, wrapper)
     }
 }
 
+TEST(file, wrapperPositional)
+{
+    auto dir = zeus::CurrentExe::GetAppDir() / "filePositionalTemp";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    auto filePath = dir / "test.bin";
+
+    static constexpr size_t kRecordCount = 64;
+    static constexpr size_t kRecordSize  = 4096;
+    // 多个线程同时按位置写入不同的记录，记录头和内容来自不同的缓冲区
+    {
+        auto fileWrapper = FileWrapper::Truncate(filePath, FileWrapper::OpenMode::kReadWrite).value();
+        ASSERT_TRUE(fileWrapper);
+        std::vector<std::thread> threads;
+        for (size_t thread = 0; thread < 4; ++thread)
+        {
+            threads.emplace_back(
+                [&fileWrapper, thread]()
+                {
+                    for (size_t index = thread; index < kRecordCount; index += 4)
+                    {
+                        const uint64_t          header = index;
+                        const std::vector<char> payload(kRecordSize - sizeof(header), static_cast<char>('a' + index % 26));
+                        auto                    result = fileWrapper.WriteV(
+                            {{&header, sizeof(header)}, {payload.data(), payload.size()}}, static_cast<uint64_t>(index * kRecordSize)
+                        );
+                        ASSERT_TRUE(result.has_value());
+                        EXPECT_EQ(kRecordSize, result.value());
+                    }
+                });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        EXPECT_EQ(kRecordCount * kRecordSize, fileWrapper.FileSize().value());
+        //定位读写不移动文件偏移
+        EXPECT_EQ(0, fileWrapper.Tell().value());
+        EXPECT_TRUE(fileWrapper.FlushData().has_value());
+    }
+    // 多个线程同时按位置读取
+    {
+        auto fileWrapper = FileWrapper::Open(filePath, FileWrapper::OpenMode::kRead).value();
+        ASSERT_TRUE(fileWrapper);
+        std::vector<std::thread> threads;
+        for (size_t thread = 0; thread < 4; ++thread)
+        {
+            threads.emplace_back(
+                [&fileWrapper, thread]()
+                {
+                    for (size_t index = thread; index < kRecordCount; index += 4)
+                    {
+                        std::vector<char> record(kRecordSize);
+                        auto              result = fileWrapper.ReadAt(record.data(), record.size(), index * kRecordSize);
+                        ASSERT_TRUE(result.has_value());
+                        ASSERT_EQ(kRecordSize, result.value());
+                        uint64_t header = 0;
+                        std::memcpy(&header, record.data(), sizeof(header));
+                        EXPECT_EQ(index, header);
+                        EXPECT_EQ(static_cast<char>('a' + index % 26), record.back());
+                    }
+                });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        //分散读取，读到文件结尾时返回实际长度
+        uint64_t          header = 0;
+        std::vector<char> payload(kRecordSize * 2);
+        auto              result = fileWrapper.ReadV({{&header, sizeof(header)}, {payload.data(), payload.size()}}, (kRecordCount - 1) * kRecordSize);
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(kRecordSize, result.value());
+        EXPECT_EQ(kRecordCount - 1, header);
+        EXPECT_EQ(0, fileWrapper.ReadAt(payload.data(), payload.size(), kRecordCount * kRecordSize).value());
+    }
+    // 按当前偏移聚集写入和分散读取
+    {
+        auto fileWrapper = FileWrapper::Truncate(filePath, FileWrapper::OpenMode::kReadWrite).value();
+        ASSERT_TRUE(fileWrapper);
+        const std::string first(100, 'x');
+        const std::string second(1000, 'y');
+        std::vector<FileWrapper::WriteBuffer> buffers;
+        for (size_t index = 0; index < 2000; ++index)
+        {
+            buffers.push_back({first.data(), first.size()});
+            buffers.push_back({second.data(), second.size()});
+        }
+        auto result = fileWrapper.WriteV(buffers.data(), buffers.size());
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(2000 * (first.size() + second.size()), result.value());
+        EXPECT_EQ(result.value(), fileWrapper.Tell().value());
+
+        ASSERT_TRUE(fileWrapper.Seek(0, FileWrapper::OffsetType::kBegin).has_value());
+        std::string readFirst(first.size(), '\0');
+        std::string readSecond(second.size(), '\0');
+        for (size_t index = 0; index < 2000; ++index)
+        {
+            auto readResult = fileWrapper.ReadV({{readFirst.data(), readFirst.size()}, {readSecond.data(), readSecond.size()}});
+            ASSERT_TRUE(readResult.has_value());
+            ASSERT_EQ(first.size() + second.size(), readResult.value());
+            ASSERT_EQ(first, readFirst);
+            ASSERT_EQ(second, readSecond);
+        }
+        EXPECT_EQ(0, fileWrapper.ReadV({{readFirst.data(), readFirst.size()}}).value());
+    }
+    fs::remove_all(dir);
+}
+
+TEST(file, wrapperDirectIo)
+{
+    auto dir = zeus::CurrentExe::GetAppDir() / "fileDirectIoTemp";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    auto filePath = dir / "test.bin";
+
+    // 预分配和修改长度
+    {
+        auto fileWrapper = FileWrapper::Truncate(filePath, FileWrapper::OpenMode::kReadWrite, FileWrapper::OpenFlag::kSequential).value();
+        ASSERT_TRUE(fileWrapper);
+        ASSERT_TRUE(fileWrapper.Preallocate(0, 1024 * 1024, true).has_value());
+        EXPECT_EQ(0, fileWrapper.FileSize().value());
+        ASSERT_TRUE(fileWrapper.Preallocate(0, 1024 * 1024).has_value());
+        EXPECT_EQ(1024 * 1024, fileWrapper.FileSize().value());
+        ASSERT_TRUE(fileWrapper.Resize(100).has_value());
+        EXPECT_EQ(100, fileWrapper.FileSize().value());
+        EXPECT_TRUE(fileWrapper.Advise(FileWrapper::Advice::kWillNeed).has_value());
+        EXPECT_TRUE(fileWrapper.Advise(FileWrapper::Advice::kDontNeed, 0, 100).has_value());
+    }
+
+    // 直接读写，按对齐的块写入后截去结尾的填充
+    static constexpr size_t kDataSize = 1024 * 1024 + 123;
+    std::string             content(kDataSize, '\0');
+    for (size_t index = 0; index < content.size(); ++index)
+    {
+        content[index] = static_cast<char>('a' + index % 26);
+    }
+    {
+        // tmpfs等文件系统不支持直接读写
+        auto direct =
+            FileWrapper::Truncate(filePath, FileWrapper::OpenMode::kReadWrite, FileWrapper::OpenFlag::kDirect | FileWrapper::OpenFlag::kSequential);
+        if (!direct.has_value())
+        {
+            EXPECT_EQ(std::errc::invalid_argument, direct.error());
+            fs::remove_all(dir);
+            return;
+        }
+        auto&        fileWrapper = direct.value();
+        const size_t alignment   = fileWrapper.DirectIoAlignment().value();
+        EXPECT_GE(alignment, 512);
+        EXPECT_FALSE(alignment & (alignment - 1));
+        AlignedBufferPool pool(64 * 1024, alignment);
+        ASSERT_TRUE(fileWrapper.Preallocate(0, kDataSize, true).has_value());
+        uint64_t offset = 0;
+        while (offset < content.size())
+        {
+            auto         buffer = pool.Acquire();
+            const size_t size   = std::min(buffer.Size(), content.size() - offset);
+            std::memcpy(buffer.Data(), content.data() + offset, size);
+            std::memset(buffer.Bytes() + size, 0, buffer.Size() - size);
+            const size_t aligned = AlignedBufferPool::AlignUp(size, alignment);
+            ASSERT_EQ(aligned, fileWrapper.WriteAt(buffer.Data(), aligned, offset).value());
+            offset += size;
+        }
+        ASSERT_TRUE(fileWrapper.Resize(kDataSize).has_value());
+        EXPECT_EQ(kDataSize, fileWrapper.FileSize().value());
+
+        // 结尾不足一块时读取返回实际长度
+        std::string readContent;
+        offset = 0;
+        while (offset < content.size())
+        {
+            auto buffer = pool.Acquire();
+            auto result = fileWrapper.ReadAt(buffer.Data(), buffer.Size(), offset);
+            ASSERT_TRUE(result.has_value());
+            ASSERT_GT(result.value(), 0);
+            readContent.append(reinterpret_cast<const char*>(buffer.Data()), result.value());
+            offset += result.value();
+        }
+        EXPECT_EQ(content, readContent);
+    }
+    EXPECT_EQ(content, FileWrapper::Open(filePath, FileWrapper::OpenMode::kRead).value().ReadString(kDataSize).value());
+    fs::remove_all(dir);
+}
+
+TEST(file, ioRing)
+{
+    auto dir = zeus::CurrentExe::GetAppDir() / "fileIoRingTemp";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    auto filePath = dir / "test.bin";
+
+    static constexpr size_t kBlockCount = 128;
+    static constexpr size_t kBlockSize  = 4096;
+    for (auto forceFallback : {false, true})
+    {
+        IoRing::Options options;
+        options.queueDepth    = 32;
+        options.forceFallback = forceFallback;
+        IoRing ring(options);
+        if (forceFallback)
+        {
+            EXPECT_EQ(IoRing::Backend::kThreadPool, ring.GetBackend());
+        }
+        auto fileWrapper = FileWrapper::Truncate(filePath, FileWrapper::OpenMode::kReadWrite).value();
+        ASSERT_TRUE(fileWrapper);
+        // 批量写入，请求数量超过队列长度
+        std::vector<std::vector<char>> blocks;
+        for (size_t index = 0; index < kBlockCount; ++index)
+        {
+            blocks.emplace_back(kBlockSize, static_cast<char>('a' + index % 26));
+        }
+        std::atomic<size_t> completed = 0;
+        std::atomic<size_t> failed    = 0;
+        auto                callback  = [&](const IoRing::Result& result)
+        {
+            if (result.has_value() && kBlockSize == result.value())
+            {
+                ++completed;
+            }
+            else
+            {
+                ++failed;
+            }
+        };
+        for (size_t index = 0; index < kBlockCount; ++index)
+        {
+            ring.Write(fileWrapper, blocks[index].data(), kBlockSize, index * kBlockSize, callback);
+        }
+        EXPECT_EQ(kBlockCount, ring.Submit());
+        ring.Drain();
+        EXPECT_EQ(0, ring.InFlight());
+        EXPECT_EQ(kBlockCount, completed.load());
+        EXPECT_EQ(0, failed.load());
+        EXPECT_EQ(kBlockCount * kBlockSize, fileWrapper.FileSize().value());
+
+        // 批量读取
+        completed = 0;
+        std::vector<std::vector<char>> readBlocks(kBlockCount, std::vector<char>(kBlockSize));
+        for (size_t index = 0; index < kBlockCount; ++index)
+        {
+            ring.Read(fileWrapper, readBlocks[index].data(), kBlockSize, index * kBlockSize, callback);
+        }
+        ring.Submit();
+        ring.Drain();
+        EXPECT_EQ(kBlockCount, completed.load());
+        EXPECT_EQ(blocks, readBlocks);
+
+        // 注册文件和缓冲区
+        std::vector<char> fixed(kBlockSize * 2);
+        ASSERT_TRUE(ring.RegisterFiles({&fileWrapper}).has_value());
+        ASSERT_TRUE(ring.RegisterBuffers({{fixed.data(), fixed.size()}}).has_value());
+        completed = 0;
+        ring.ReadFixed(fileWrapper, 0, 0, kBlockSize, 0, callback);
+        ring.ReadFixed(fileWrapper, 0, kBlockSize, kBlockSize, kBlockSize, callback);
+        ring.Submit();
+        ring.Drain();
+        EXPECT_EQ(2, completed.load());
+        EXPECT_TRUE(std::equal(blocks[0].begin(), blocks[0].end(), fixed.begin()));
+        EXPECT_TRUE(std::equal(blocks[1].begin(), blocks[1].end(), fixed.begin() + kBlockSize));
+        std::fill(fixed.begin(), fixed.end(), 'z');
+        ring.WriteFixed(fileWrapper, 0, 0, kBlockSize * 2, 0, nullptr);
+        // 超出注册的缓冲区
+        std::error_code error;
+        ring.ReadFixed(fileWrapper, 1, 0, kBlockSize, 0, [&error](const IoRing::Result& result) { error = result.error(); });
+        ring.Submit();
+        ring.Drain();
+        EXPECT_EQ(std::errc::invalid_argument, error);
+        std::vector<char> check(kBlockSize * 2);
+        EXPECT_EQ(check.size(), fileWrapper.ReadAt(check.data(), check.size(), 0).value());
+        EXPECT_EQ(fixed, check);
+        ASSERT_TRUE(ring.RegisterBuffers({}).has_value());
+        ASSERT_TRUE(ring.RegisterFiles({}).has_value());
+
+        // 回调投递到线程池，写入和刷新链接提交
+        ThreadPool pool(2);
+        ring.SetCallbackExecutor(pool);
+        AsyncFile   asyncFile(ring, std::move(fileWrapper));
+        std::string content(10000, 'q');
+        auto        writeResult = asyncFile.WriteAndSync(content.data(), content.size(), 0, true).get();
+        ASSERT_TRUE(writeResult.has_value());
+        EXPECT_EQ(content.size(), writeResult.value());
+        std::string readContent(content.size(), '\0');
+        EXPECT_EQ(content.size(), asyncFile.Read(readContent.data(), readContent.size(), 0).get().value());
+        EXPECT_EQ(content, readContent);
+        EXPECT_TRUE(asyncFile.Sync().get().has_value());
+        // 读取到文件结尾
+        EXPECT_EQ(0, asyncFile.Read(readContent.data(), readContent.size(), kBlockCount * kBlockSize).get().value());
+        ring.Drain();
+        ring.SetCallbackExecutor(nullptr);
+    }
+    fs::remove_all(dir);
+}
+
+TEST(file, ioRingLink)
+{
+    auto dir = zeus::CurrentExe::GetAppDir() / "fileIoRingLinkTemp";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    auto filePath = dir / "test.bin";
+    {
+        auto file = FileWrapper::Truncate(filePath, FileWrapper::OpenMode::kWrite).value();
+        EXPECT_EQ(100, file.Write(std::string(100, 'a')).value());
+    }
+    for (auto forceFallback : {false, true})
+    {
+        IoRing::Options options;
+        options.forceFallback = forceFallback;
+        IoRing                       ring(options);
+        std::mutex                   mutex;
+        std::vector<std::error_code> errors(5);
+        std::vector<size_t>          lengths(5);
+        auto                         record = [&](size_t index)
+        {
+            return [&, index](const IoRing::Result& result)
+            {
+                std::lock_guard lock(mutex);
+                errors[index]  = result.has_value() ? std::error_code() : result.error();
+                lengths[index] = result.has_value() ? result.value() : 0;
+            };
+        };
+        // 链接中的第一个请求失败，后续请求取消
+        auto        readOnly = FileWrapper::Open(filePath, FileWrapper::OpenMode::kRead).value();
+        std::string data(10, 'b');
+        ring.Write(readOnly, data.data(), data.size(), 0, record(0), true);
+        ring.Fsync(readOnly, record(1));
+        ring.Read(readOnly, data.data(), data.size(), 0, record(2));
+        EXPECT_EQ(3, ring.Submit());
+        ring.Drain();
+        EXPECT_TRUE(errors[0]);
+        EXPECT_EQ(std::errc::operation_canceled, errors[1]);
+        EXPECT_FALSE(errors[2]);
+        EXPECT_EQ(std::string(10, 'a'), data);
+
+        // 链接中有无效的注册缓冲区请求时整个链接都不执行，之后没有链接的请求不受影响
+        auto              file = FileWrapper::Open(filePath, FileWrapper::OpenMode::kReadWrite).value();
+        std::vector<char> fixed(64);
+        ASSERT_TRUE(ring.RegisterBuffers({{fixed.data(), fixed.size()}}).has_value());
+        ring.Write(file, data.data(), data.size(), 200, record(0), true);
+        ring.ReadFixed(file, 3, 0, 10, 0, record(1));
+        ring.Read(file, fixed.data(), 10, 0, record(2));
+        ring.Write(file, data.data(), data.size(), 300, record(3), true);
+        ring.WriteFixed(file, 0, 60, 10, 0, record(4));
+        ring.Submit();
+        ring.Drain();
+        EXPECT_EQ(std::errc::operation_canceled, errors[0]);
+        EXPECT_EQ(std::errc::invalid_argument, errors[1]);
+        EXPECT_FALSE(errors[2]);
+        EXPECT_EQ(std::errc::operation_canceled, errors[3]);
+        EXPECT_EQ(std::errc::invalid_argument, errors[4]);
+        EXPECT_EQ(100, file.FileSize().value());
+
+        // 读取到文件结尾时长度不足，链接中断
+        ring.Read(file, data.data(), data.size(), 95, record(0), true);
+        ring.Read(file, data.data(), data.size(), 0, record(1));
+        ring.Submit();
+        ring.Drain();
+        EXPECT_FALSE(errors[0]);
+        EXPECT_EQ(5, lengths[0]);
+        EXPECT_EQ(std::errc::operation_canceled, errors[1]);
+
+        // 其他线程未结束的链接不会被Submit拆开，也不会接上当前线程的请求
+        std::thread([&]() { ring.Write(readOnly, data.data(), data.size(), 0, record(0), true); }).join();
+        ring.Read(file, data.data(), data.size(), 0, record(2));
+        EXPECT_EQ(1, ring.Submit());
+        ring.Drain();
+        EXPECT_FALSE(errors[2]);
+        std::thread(
+            [&]()
+            {
+                ring.Fsync(readOnly, record(1));
+                EXPECT_EQ(2, ring.Submit());
+            }
+        ).join();
+        ring.Drain();
+        EXPECT_TRUE(errors[0]);
+        EXPECT_EQ(std::errc::operation_canceled, errors[1]);
+
+        // AsyncFile的写入和刷新链接在一起，不受当前线程未结束的链接影响
+        AsyncFile asyncFile(ring, FileWrapper::Open(filePath, FileWrapper::OpenMode::kReadWrite).value());
+        ring.Write(readOnly, data.data(), data.size(), 0, record(0), true);
+        auto future = asyncFile.WriteAndSync(data.data(), data.size(), 0, true);
+        ring.Drain();
+        EXPECT_EQ(data.size(), future.get().value());
+        EXPECT_TRUE(errors[0]);
+        ASSERT_TRUE(ring.RegisterBuffers({}).has_value());
+    }
+    fs::remove_all(dir);
+}
+
+TEST(file, lineReader)
+{
+    auto dir = zeus::CurrentExe::GetAppDir() / "fileLineReaderTemp";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    auto filePath = dir / "lines.txt";
+
+    // 各种长度的行，包括空行和超过块大小的行，最后一行没有换行符
+    std::vector<std::string> lines;
+    std::string              content;
+    for (size_t index = 0; index < 2000; ++index)
+    {
+        const size_t length = index % 97 ? index % 37 : 1000 + index;
+        lines.emplace_back(length, static_cast<char>('a' + index % 26));
+        content += lines.back();
+        if (index + 1 < 2000)
+        {
+            content += '\n';
+        }
+    }
+    {
+        auto fileWrapper = FileWrapper::Truncate(filePath, FileWrapper::OpenMode::kWrite).value();
+        ASSERT_TRUE(fileWrapper.Write(content).has_value());
+    }
+    for (size_t blockSize : {size_t(16), size_t(1000), LineReader::kDefaultBlockSize})
+    {
+        LineReader::Options options;
+        options.blockSize = blockSize;
+        auto reader       = LineReader::Open(filePath, options);
+        ASSERT_TRUE(reader.has_value());
+        std::vector<std::string> readLines;
+        auto                     result = reader->ForEach(
+            [&readLines](std::string_view line)
+            {
+                readLines.emplace_back(line);
+                return true;
+            }
+        );
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(lines, readLines);
+        EXPECT_EQ(lines.size(), reader->LineCount());
+    }
+
+    // 和getline的结果一致
+    {
+        std::vector<std::string> expected;
+        std::ifstream            stream(filePath);
+        std::string              line;
+        while (std::getline(stream, line))
+        {
+            expected.emplace_back(line);
+        }
+        std::vector<std::string> readLines;
+        auto                     result = FileEachLine(
+            filePath,
+            [&readLines](std::string_view line)
+            {
+                readLines.emplace_back(line);
+                return true;
+            }
+        );
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(expected, readLines);
+    }
+
+    // 自定义分隔符和CRLF
+    {
+        auto fileWrapper = FileWrapper::Truncate(filePath, FileWrapper::OpenMode::kWrite).value();
+        ASSERT_TRUE(fileWrapper.Write(std::string_view("a\r\n\r\nbc\r\n")).has_value());
+    }
+    {
+        LineReader::Options options;
+        options.stripCarriageReturn = true;
+        auto             reader     = LineReader::Open(filePath, options).value();
+        std::string_view line;
+        EXPECT_TRUE(reader.Next(line).value());
+        EXPECT_EQ("a", line);
+        EXPECT_TRUE(reader.Next(line).value());
+        EXPECT_EQ("", line);
+        EXPECT_TRUE(reader.Next(line).value());
+        EXPECT_EQ("bc", line);
+        EXPECT_FALSE(reader.Next(line).value());
+        EXPECT_FALSE(reader.Next(line).value());
+
+        options.delimiter           = '\r';
+        options.stripCarriageReturn = false;
+        reader                      = LineReader::Open(filePath, options).value();
+        std::vector<std::string> readLines;
+        reader.ForEach(
+            [&readLines](std::string_view line)
+            {
+                readLines.emplace_back(line);
+                return true;
+            }
+        );
+        EXPECT_EQ((std::vector<std::string> {"a", "\n", "\nbc", "\n"}), readLines);
+    }
+
+    // 按行边界切分后并行处理
+    {
+        auto fileWrapper = FileWrapper::Truncate(filePath, FileWrapper::OpenMode::kWrite).value();
+        ASSERT_TRUE(fileWrapper.Write(content).has_value());
+    }
+    {
+        auto fileWrapper = FileWrapper::Open(filePath, FileWrapper::OpenMode::kRead).value();
+        auto ranges      = LineReader::SplitRanges(fileWrapper, 8).value();
+        ASSERT_FALSE(ranges.empty());
+        EXPECT_LE(ranges.size(), 8);
+        uint64_t offset = 0;
+        for (const auto& range : ranges)
+        {
+            EXPECT_EQ(offset, range.offset);
+            if (range.offset)
+            {
+                EXPECT_EQ('\n', content[range.offset - 1]);
+            }
+            offset += range.length;
+        }
+        EXPECT_EQ(content.size(), offset);
+        EXPECT_EQ(1, LineReader::SplitRanges(fileWrapper, 1).value().size());
+    }
+    {
+        std::mutex                                 mutex;
+        std::map<size_t, std::vector<std::string>> segments;
+        auto                                       result = LineReader::ParallelForEach(
+            filePath, 4,
+            [&](size_t segment, std::string_view line)
+            {
+                std::lock_guard lock(mutex);
+                segments[segment].emplace_back(line);
+                return true;
+            }
+        );
+        ASSERT_TRUE(result.has_value());
+        EXPECT_GT(segments.size(), 1);
+        std::vector<std::string> readLines;
+        for (auto& [segment, segmentLines] : segments)
+        {
+            readLines.insert(readLines.end(), segmentLines.begin(), segmentLines.end());
+        }
+        EXPECT_EQ(lines, readLines);
+
+        // 回调返回false时停止
+        std::atomic<size_t> count = 0;
+        ASSERT_TRUE(LineReader::ParallelForEach(filePath, 4, [&count](size_t, std::string_view) { return ++count < 10; }).has_value());
+        EXPECT_LT(count.load(), lines.size());
+    }
+    EXPECT_FALSE(LineReader::Open(dir / "notExist.txt").has_value());
+    fs::remove_all(dir);
+}
+
 TEST(file, CreateDirectory)
 {
     EXPECT_FALSE(CreateWriteableDirectory(zeus::CurrentExe::GetAppPath()).has_value());
@@ -4,6 +4,7 @@
 #include <zeus/foundation/hardware/storage.h>
 #include <zeus/foundation/hardware/hard_disk.h>
 #include <zeus/foundation/hardware/monitor.h>
+#include <zeus/foundation/hardware/cpu_feature.h>
 
 TEST(Hardware, CpuPerformance)
 {
@@ -70,4 +71,19 @@ TEST(Hardware, RemovableStorage)
 TEST(Hardware, Monitor)
 {
     auto infos = zeus::Hardware::Monitor::ListAll();
-}
\ No newline at end of file
+}
+TEST(Hardware, CpuFeature)
+{
+    const auto& feature = zeus::Hardware::GetCpuFeature();
+    EXPECT_EQ(&feature, &zeus::Hardware::GetCpuFeature());
+#ifdef ZEUS_ARCH_X64
+    EXPECT_TRUE(feature.sse2);
+    EXPECT_FALSE(feature.neon);
+    //高级指令集一定同时支持低级指令集
+    EXPECT_TRUE(!feature.avx2 || feature.avx);
+    EXPECT_TRUE(!feature.avx512bw || feature.avx512f);
+#endif
+#ifdef ZEUS_ARCH_ARM64
+    EXPECT_TRUE(feature.neon);
+#endif
+}
@@ -6,6 +6,7 @@
 #include <zeus/foundation/ipc/global_mutex.h>
 #include <zeus/foundation/ipc/shared_memory.h>
 #include <zeus/foundation/ipc/global_event.h>
+#include <zeus/foundation/resource/auto_release.h>
 #include <zeus/foundation/sync/event.h>
 #include <zeus/foundation/system/process.h>
 
@@ -152,6 +153,13 @@ TEST(SharedMemory, base)
     std::memcpy(mapping2->Data(), data.data(), data.size());
     EXPECT_EQ(std::memcmp(mapping1->Data(), data.data(), data.size()), 0);
     EXPECT_EQ(std::memcmp(mapping->Data(), data.data(), data.size()), 0);
+
+    MemoryMapping::Options options;
+    options.populate = true;
+    options.lock     = true;
+    auto mapping3    = memory2->Map(kSize, 0, true, options);
+    ASSERT_TRUE(mapping3.has_value());
+    EXPECT_EQ(std::memcmp(mapping3->Data(), data.data(), data.size()), 0);
 }
 
 TEST(SharedMemory, offset)
@@ -196,6 +204,67 @@ TEST(SharedMemory, offset)
     EXPECT_EQ(std::memcmp(static_cast<char*>(mapping->Data()) + offset2, data.data(), data.size()), 0);
 }
 
+TEST(SharedMemory, hugeTlb)
+{
+    static constexpr size_t  kSize       = 1024;
+    static const std::string kSharedName = "zeus_shared_memory_huge_test";
+    SharedMemory::Options    options;
+    options.hugeTlb = true;
+    MemoryMapping::Options mappingOptions;
+    mappingOptions.hugeTlb = true;
+#ifdef __linux__
+    static const std::string kNormalName = "zeus_shared_memory_huge_normal_test";
+    SharedMemory::Clear(kSharedName, options);
+    SharedMemory::Clear(kNormalName);
+    //断言失败提前返回时也要删除创建的共享内存
+    AutoRelease autoClear(
+        [options]()
+        {
+            SharedMemory::Clear(kSharedName, options);
+            SharedMemory::Clear(kNormalName);
+        });
+#endif
+
+    //没有挂载hugetlbfs、没有预留大页或者没有权限时跳过
+    auto memory = SharedMemory::OpenOrCreate(kSharedName, kSize, false, options);
+    if (!memory.has_value())
+    {
+        GTEST_SKIP() << memory.error().message();
+    }
+    EXPECT_EQ(memory->Name(), kSharedName);
+    EXPECT_GE(memory->Size(), kSize);
+    auto mapping = memory->Map(memory->Size(), 0, false, mappingOptions);
+    if (!mapping.has_value())
+    {
+        GTEST_SKIP() << mapping.error().message();
+    }
+    auto data = RandString(kSize);
+    std::memcpy(mapping->Data(), data.data(), data.size());
+
+    auto memory1 = SharedMemory::Open(kSharedName, false, options);
+    ASSERT_TRUE(memory1.has_value());
+    EXPECT_EQ(memory1->Size(), memory->Size());
+    auto mapping1 = memory1->Map(memory1->Size(), 0, true, mappingOptions);
+    ASSERT_TRUE(mapping1.has_value());
+    EXPECT_EQ(std::memcmp(mapping1->Data(), data.data(), data.size()), 0);
+
+    auto memory2 = SharedMemory::OpenOrCreate(kSharedName, kSize, false, options);
+    ASSERT_TRUE(memory2.has_value());
+    auto mapping2 = memory2->Map(memory2->Size(), 0, false, mappingOptions);
+    ASSERT_TRUE(mapping2.has_value());
+    data = RandString(kSize);
+    std::memcpy(mapping2->Data(), data.data(), data.size());
+    EXPECT_EQ(std::memcmp(mapping->Data(), data.data(), data.size()), 0);
+#ifdef __linux__
+    //普通的共享内存不能以大页映射
+    auto normal = SharedMemory::OpenOrCreate(kNormalName, kSize);
+    ASSERT_TRUE(normal.has_value());
+    EXPECT_FALSE(normal->Map(kSize, 0, false, mappingOptions).has_value());
+    EXPECT_TRUE(SharedMemory::Clear(kNormalName).has_value());
+    EXPECT_TRUE(SharedMemory::Clear(kSharedName, options).has_value());
+#endif
+}
+
 TEST(GlobalEvent, WaitNotify)
 {
     auto event = GlobalEvent::OpenOrCreate(kEventName, false);
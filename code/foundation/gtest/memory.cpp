@@ -0,0 +1,327 @@
+﻿#include <gtest/gtest.h>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <limits>
+#include <memory_resource>
+#include <zeus/foundation/memory/monotonic_arena.h>
+#include <zeus/foundation/memory/pool_resource.h>
+#include <zeus/foundation/memory/aligned_buffer_pool.h>
+
+using namespace zeus;
+
+namespace
+{
+//统计上游申请和释放的次数
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+    size_t allocateCount   = 0;
+    size_t deallocateCount = 0;
+    size_t outstanding     = 0;
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        ++allocateCount;
+        outstanding += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override
+    {
+        ++deallocateCount;
+        outstanding -= bytes;
+        std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+bool IsAligned(const void* pointer, size_t alignment)
+{
+    return !(reinterpret_cast<uintptr_t>(pointer) % alignment);
+}
+} // namespace
+
+TEST(Memory, monotonicArena)
+{
+    CountingResource upstream;
+    {
+        MonotonicArena arena(256, &upstream);
+        EXPECT_EQ(0, arena.ChunkCount());
+        std::vector<void*> pointers;
+        for (size_t index = 1; index <= 200; ++index)
+        {
+            const size_t alignment = size_t(1) << (index % 7);
+            auto*        pointer   = arena.Allocate(index, alignment);
+            ASSERT_TRUE(IsAligned(pointer, alignment));
+            std::memset(pointer, static_cast<int>(index), index);
+            pointers.emplace_back(pointer);
+        }
+        for (size_t index = 1; index <= 200; ++index)
+        {
+            EXPECT_EQ(static_cast<uint8_t>(index), *static_cast<uint8_t*>(pointers[index - 1]));
+        }
+        EXPECT_GE(arena.BytesAllocated(), 200 * 201 / 2);
+        EXPECT_EQ(upstream.outstanding, arena.BytesReserved());
+        //块按倍数增长，块数量远小于分配次数
+        EXPECT_LT(arena.ChunkCount(), 10);
+        EXPECT_EQ(arena.ChunkCount(), upstream.allocateCount);
+
+        //超过块大小的请求单独分配
+        auto* large = arena.Allocate(1024 * 1024);
+        EXPECT_NE(nullptr, large);
+        std::memset(large, 0, 1024 * 1024);
+
+        //Reset只保留最大的块，再次分配不需要向上游申请
+        arena.Reset();
+        EXPECT_EQ(0, arena.BytesAllocated());
+        EXPECT_EQ(1, arena.ChunkCount());
+        const size_t allocateCount = upstream.allocateCount;
+        for (size_t index = 0; index < 1000; ++index)
+        {
+            arena.Allocate<uint64_t>(8);
+        }
+        EXPECT_EQ(allocateCount, upstream.allocateCount);
+
+        //长度加上对齐和块头溢出时不向上游申请
+        EXPECT_THROW(arena.Allocate(std::numeric_limits<size_t>::max() - 8, 64), std::bad_alloc);
+        EXPECT_THROW(arena.Allocate<uint64_t>(std::numeric_limits<size_t>::max() / 4), std::bad_alloc);
+        EXPECT_EQ(allocateCount, upstream.allocateCount);
+
+        arena.Release();
+        EXPECT_EQ(0, arena.ChunkCount());
+        EXPECT_EQ(0, upstream.outstanding);
+    }
+    EXPECT_EQ(upstream.allocateCount, upstream.deallocateCount);
+
+    //先使用外部缓冲区
+    {
+        alignas(std::max_align_t) uint8_t buffer[512];
+        MonotonicArena                    arena(buffer, sizeof(buffer), &upstream);
+        const size_t                      allocateCount = upstream.allocateCount;
+        auto*                             first         = arena.Allocate(100);
+        EXPECT_GE(static_cast<uint8_t*>(first), buffer);
+        EXPECT_LT(static_cast<uint8_t*>(first), buffer + sizeof(buffer));
+        EXPECT_EQ(allocateCount, upstream.allocateCount);
+        arena.Allocate(1000);
+        EXPECT_EQ(allocateCount + 1, upstream.allocateCount);
+        arena.Reset();
+        EXPECT_EQ(buffer, arena.Allocate(1));
+    }
+    EXPECT_EQ(0, upstream.outstanding);
+
+    //作为pmr容器的内存资源
+    {
+        MonotonicArena                arena(1024, &upstream);
+        std::pmr::vector<std::string> values(&arena);
+        for (size_t index = 0; index < 100; ++index)
+        {
+            values.emplace_back(std::to_string(index));
+        }
+        std::pmr::vector<std::pmr::string> strings(&arena);
+        strings.emplace_back("a string that is long enough to need a heap allocation");
+        EXPECT_EQ(&arena, strings.back().get_allocator().resource());
+        EXPECT_EQ("99", values.back());
+        EXPECT_GT(arena.BytesAllocated(), 0);
+    }
+    EXPECT_EQ(0, upstream.outstanding);
+}
+
+TEST(Memory, poolResource)
+{
+    EXPECT_EQ(16, PoolResource::BlockSize(1));
+    EXPECT_EQ(16, PoolResource::BlockSize(16));
+    EXPECT_EQ(32, PoolResource::BlockSize(17));
+    EXPECT_EQ(64, PoolResource::BlockSize(8, 64));
+    EXPECT_EQ(4096, PoolResource::BlockSize(4096));
+    EXPECT_EQ(0, PoolResource::BlockSize(4097));
+
+    CountingResource upstream;
+    {
+        PoolResource        pool(&upstream);
+        std::vector<void*> pointers;
+        for (size_t index = 0; index < 1000; ++index)
+        {
+            const size_t size    = 1 + index % 300;
+            auto*        pointer = pool.Allocate(size, 8);
+            ASSERT_TRUE(IsAligned(pointer, 8));
+            std::memset(pointer, 0xCC, size);
+            pointers.emplace_back(pointer);
+        }
+        const size_t reserved = pool.BytesReserved();
+        EXPECT_GT(reserved, 0);
+        for (size_t index = 0; index < pointers.size(); ++index)
+        {
+            pool.Deallocate(pointers[index], 1 + index % 300, 8);
+        }
+        //释放后再分配复用空闲块
+        for (size_t index = 0; index < 1000; ++index)
+        {
+            pointers[index] = pool.Allocate(1 + index % 300, 8);
+        }
+        EXPECT_EQ(reserved, pool.BytesReserved());
+        for (size_t index = 0; index < pointers.size(); ++index)
+        {
+            pool.Deallocate(pointers[index], 1 + index % 300, 8);
+        }
+
+        //大块直接转给上游
+        const size_t allocateCount = upstream.allocateCount;
+        auto*        large         = pool.Allocate(10000);
+        EXPECT_EQ(allocateCount + 1, upstream.allocateCount);
+        pool.Deallocate(large, 10000);
+        EXPECT_EQ(reserved, upstream.outstanding);
+    }
+    EXPECT_EQ(0, upstream.outstanding);
+
+    //生产者线程分配，消费者线程释放，消费者归还的块被生产者复用
+    {
+        PoolResource      pool;
+        constexpr size_t  kCount = 100000;
+        std::vector<int*> pointers(kCount);
+        for (size_t round = 0; round < 3; ++round)
+        {
+            std::thread producer(
+                [&]()
+                {
+                    for (size_t index = 0; index < kCount; ++index)
+                    {
+                        pointers[index]  = static_cast<int*>(pool.Allocate(sizeof(int), alignof(int)));
+                        *pointers[index] = static_cast<int>(index);
+                    }
+                });
+            producer.join();
+            std::thread consumer(
+                [&]()
+                {
+                    for (size_t index = 0; index < kCount; ++index)
+                    {
+                        EXPECT_EQ(static_cast<int>(index), *pointers[index]);
+                        pool.Deallocate(pointers[index], sizeof(int), alignof(int));
+                    }
+                });
+            consumer.join();
+        }
+        //消费者缓存的块超过上限后归还到共享链表，后续轮次不需要再申请新的块
+        EXPECT_LT(pool.BytesReserved(), kCount * PoolResource::kMinBlockSize * 2);
+    }
+
+    //线程退出时缓存中的块归还到共享链表，其他线程可以继续使用
+    {
+        PoolResource       pool;
+        constexpr size_t   kCount = 512;
+        std::vector<void*> pointers(kCount);
+        std::thread        worker(
+            [&]()
+            {
+                for (auto& pointer : pointers)
+                {
+                    pointer = pool.Allocate(64);
+                }
+                for (auto* pointer : pointers)
+                {
+                    pool.Deallocate(pointer, 64);
+                }
+            }
+        );
+        worker.join();
+        const size_t reserved = pool.BytesReserved();
+        for (auto& pointer : pointers)
+        {
+            pointer = pool.Allocate(64);
+        }
+        EXPECT_EQ(reserved, pool.BytesReserved());
+        for (auto* pointer : pointers)
+        {
+            pool.Deallocate(pointer, 64);
+        }
+    }
+
+    //多线程同时使用
+    {
+        PoolResource             pool;
+        std::vector<std::thread> threads;
+        for (size_t thread = 0; thread < 4; ++thread)
+        {
+            threads.emplace_back(
+                [&pool]()
+                {
+                    std::pmr::vector<std::pmr::string> values(&pool);
+                    for (size_t index = 0; index < 10000; ++index)
+                    {
+                        values.emplace_back(std::string(index % 100, 'x'));
+                        if (values.size() > 64)
+                        {
+                            values.erase(values.begin(), values.begin() + 32);
+                        }
+                    }
+                });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+}
+
+TEST(Memory, alignedBufferPool)
+{
+    EXPECT_EQ(4096, AlignedBufferPool::AlignUp(1, 4096));
+    EXPECT_EQ(8192, AlignedBufferPool::AlignUp(4097, 4096));
+    EXPECT_EQ(4096, AlignedBufferPool::AlignDown(8191, 4096));
+
+    AlignedBufferPool pool(10000, 4096, 2);
+    EXPECT_EQ(12288, pool.BufferSize());
+    {
+        auto first  = pool.Acquire();
+        auto second = pool.Acquire();
+        auto third  = pool.Acquire();
+        for (auto* buffer : {&first, &second, &third})
+        {
+            ASSERT_TRUE(*buffer);
+            EXPECT_TRUE(IsAligned(buffer->Data(), 4096));
+            EXPECT_EQ(pool.BufferSize(), buffer->Size());
+            std::memset(buffer->Data(), 0xAB, buffer->Size());
+        }
+        //移动后原对象为空，不会重复归还
+        auto moved = std::move(first);
+        EXPECT_FALSE(first);
+        EXPECT_EQ(0, first.Size());
+        second.Release();
+        EXPECT_FALSE(second);
+        EXPECT_EQ(1, pool.CachedCount());
+    }
+    //最多缓存2个
+    EXPECT_EQ(2, pool.CachedCount());
+    void* cached = nullptr;
+    {
+        auto buffer = pool.Acquire();
+        cached      = buffer.Data();
+        EXPECT_EQ(1, pool.CachedCount());
+    }
+    //归还后再获取复用同一块内存
+    EXPECT_EQ(cached, pool.Acquire().Data());
+    pool.Trim();
+    EXPECT_EQ(0, pool.CachedCount());
+
+    //多线程同时获取和归还
+    std::vector<std::thread> threads;
+    for (size_t thread = 0; thread < 4; ++thread)
+    {
+        threads.emplace_back(
+            [&pool]()
+            {
+                for (size_t index = 0; index < 1000; ++index)
+                {
+                    auto buffer = pool.Acquire();
+                    ASSERT_TRUE(IsAligned(buffer.Data(), pool.Alignment()));
+                    buffer.Bytes()[index % buffer.Size()] = 1;
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_LE(pool.CachedCount(), 2);
+}
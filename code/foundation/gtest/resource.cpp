@@ -1,4 +1,5 @@
-﻿#include <atomic>
+﻿#include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <filesystem>
 #include <cstring>
@@ -164,4 +165,87 @@ TEST(FileMapping, base)
         EXPECT_EQ(0, std::memcmp(buffer.get() + offset, data.data() + offset, kSize - offset));
         file.close();
     }
+}
+
+TEST(FileMapping, options)
+{
+    static constexpr size_t kSize    = 1024 * 1024;
+    auto                    filePath = fs::temp_directory_path() / "FileMapping_options_test";
+    auto                    data     = RandString(kSize);
+    {
+        std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+        file.write(data.data(), data.size());
+    }
+    auto fileMapping = FileMapping::Create(filePath, false);
+    ASSERT_TRUE(fileMapping.has_value());
+    EXPECT_FALSE(fileMapping->Advise(MemoryMapping::Advice::kWillNeed).has_value());
+
+    MemoryMapping::Options options;
+    options.populate = true;
+    options.advice   = MemoryMapping::Advice::kSequential;
+    const auto offset = MemoryMapping::SystemMemoryAlign() + 7;
+    ASSERT_TRUE(fileMapping->Map(offset, kSize / 2, options).has_value());
+    EXPECT_EQ(offset, fileMapping->Offset());
+    EXPECT_EQ(kSize / 2, fileMapping->Size());
+    EXPECT_EQ(0, std::memcmp(fileMapping->Data(), data.data() + offset, kSize / 2));
+    EXPECT_TRUE(fileMapping->Advise(MemoryMapping::Advice::kRandom).has_value());
+    EXPECT_TRUE(fileMapping->Advise(MemoryMapping::Advice::kWillNeed, 100, 4096).has_value());
+    EXPECT_TRUE(fileMapping->Advise(MemoryMapping::Advice::kNormal, kSize / 2 - 1).has_value());
+    EXPECT_FALSE(fileMapping->Advise(MemoryMapping::Advice::kNormal, kSize / 2 + 1).has_value());
+
+    //锁定的大小受系统限制，只锁定一页
+    options.lock = true;
+    ASSERT_TRUE(fileMapping->Map(0, 16, options).has_value());
+    EXPECT_EQ(0, std::memcmp(fileMapping->Data(), data.data(), 16));
+    ASSERT_TRUE(fileMapping->MapAll(kSize - 16).has_value());
+    EXPECT_EQ(16, fileMapping->Size());
+    EXPECT_EQ(0, std::memcmp(fileMapping->Data(), data.data() + kSize - 16, 16));
+#ifdef __linux__
+    //普通文件不在hugetlbfs上，不能使用MAP_HUGETLB
+    MemoryMapping::Options hugeTlb;
+    hugeTlb.hugeTlb = true;
+    EXPECT_FALSE(fileMapping->MapAll(0, hugeTlb).has_value());
+#endif
+    fileMapping = FileMapping::Create(filePath, false);
+    fs::remove(filePath);
+}
+
+TEST(FileMapping, window)
+{
+    static constexpr size_t kSize    = 1024 * 1024 + 123;
+    auto                    filePath = fs::temp_directory_path() / "FileMapping_window_test";
+    auto                    data     = RandString(kSize);
+    {
+        std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+        file.write(data.data(), data.size());
+    }
+    auto fileMapping = FileMapping::Create(filePath, false);
+    ASSERT_TRUE(fileMapping.has_value());
+    MemoryMapping::Options options;
+    options.advice                  = MemoryMapping::Advice::kSequential;
+    static constexpr size_t kWindow = 200 * 1024;
+    static constexpr size_t kStep   = kWindow - 100;
+    uint64_t                expect  = 0;
+    auto                    ret     = fileMapping->ForEachWindow(
+        kWindow, 100, options,
+        [&](uint64_t offset, void* window, uint64_t size)
+        {
+            EXPECT_EQ(expect, offset);
+            EXPECT_EQ(std::min<uint64_t>(kWindow, kSize - offset), size);
+            EXPECT_EQ(0, std::memcmp(window, data.data() + offset, size));
+            expect += kStep;
+            return true;
+        }
+    );
+    EXPECT_TRUE(ret.has_value());
+    EXPECT_EQ((kSize - 100 + kStep - 1) / kStep * kStep, expect);
+    EXPECT_TRUE(fileMapping->Empty());
+
+    size_t count = 0;
+    ret          = fileMapping->ForEachWindow(kWindow, 0, options, [&count](uint64_t, void*, uint64_t) { return ++count < 2; });
+    EXPECT_TRUE(ret.has_value());
+    EXPECT_EQ(2, count);
+    EXPECT_FALSE(fileMapping->ForEachWindow(kWindow, kWindow, options, [](uint64_t, void*, uint64_t) { return true; }).has_value());
+    fileMapping = FileMapping::Create(filePath, false);
+    fs::remove(filePath);
 }
\ No newline at end of file
@@ -1,8 +1,13 @@
 ﻿#ifdef __linux__
 #include <unistd.h>
 #include <fcntl.h>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <thread>
 #include <gtest/gtest.h>
 #include <zeus/foundation/resource/linux/file_descriptor.h>
+#include <zeus/foundation/resource/pipe_stream_buffer.h>
 
 using namespace zeus;
 TEST(LinuxFileDescriptor, base)
@@ -27,4 +32,102 @@ TEST(LinuxFileDescriptor, CloseOnExec)
     EXPECT_TRUE(duplicate.IsCloseOnExec().value());
 }
 
+TEST(PipeStreamBuffer, base)
+{
+    int pipes[2] = {-1, -1};
+    ASSERT_EQ(0, pipe2(pipes, O_CLOEXEC));
+    LinuxFileDescriptor readEnd(pipes[0]);
+    LinuxFileDescriptor writeEnd(pipes[1]);
+    //缓冲区和管道的容量一致
+    const auto capacity = PipeStreamBuffer::PipeCapacity(readEnd.Fd()).value();
+    EXPECT_GE(capacity, 4096);
+    EXPECT_EQ(capacity * 2, PipeStreamBuffer::SetPipeCapacity(writeEnd.Fd(), capacity * 2).value());
+    EXPECT_EQ(capacity * 2, PipeStreamBuffer::PipeCapacity(readEnd.Fd()).value());
+
+    //批量读写和逐个字符读写的结果一致
+    std::string data(1024 * 1024 + 123, '\0');
+    for (size_t index = 0; index < data.size(); ++index)
+    {
+        data[index] = static_cast<char>(index * 7 + index / 4096);
+    }
+    std::thread writer(
+        [&writeEnd, &data]()
+        {
+            PipeStreamBuffer buffer(writeEnd.Fd(), BasicStreamBuffer::BufferMode::Write);
+            std::ostream     stream(&buffer);
+            stream.put(data[0]);
+            stream.write(data.data() + 1, 99);
+            stream.write(data.data() + 100, static_cast<std::streamsize>(data.size() - 100));
+            stream.flush();
+            EXPECT_TRUE(stream.good());
+            writeEnd.Close();
+        }
+    );
+    PipeStreamBuffer buffer(readEnd.Fd(), BasicStreamBuffer::BufferMode::Read);
+    std::istream     stream(&buffer);
+    std::string      result(data.size(), '\0');
+    EXPECT_EQ(data[0], stream.get());
+    stream.read(result.data() + 1, 10);
+    stream.unget();
+    EXPECT_EQ(data[10], stream.get());
+    stream.read(result.data() + 11, static_cast<std::streamsize>(result.size() - 11));
+    EXPECT_EQ(static_cast<std::streamsize>(result.size() - 11), stream.gcount());
+    result[0] = data[0];
+    EXPECT_EQ(data, result);
+    EXPECT_EQ(std::char_traits<char>::eof(), stream.get());
+    writer.join();
+}
+
+TEST(PipeStreamBuffer, transfer)
+{
+    int pipes[2] = {-1, -1};
+    ASSERT_EQ(0, pipe2(pipes, O_CLOEXEC));
+    LinuxFileDescriptor readEnd(pipes[0]);
+    LinuxFileDescriptor writeEnd(pipes[1]);
+    int                 copies[2] = {-1, -1};
+    ASSERT_EQ(0, pipe2(copies, O_CLOEXEC));
+    LinuxFileDescriptor copyRead(copies[0]);
+    LinuxFileDescriptor copyWrite(copies[1]);
+
+    const std::string data(300 * 1024, 'z');
+    std::thread       writer(
+        [&writeEnd, &data]()
+        {
+            EXPECT_EQ(static_cast<ssize_t>(data.size()), write(writeEnd.Fd(), data.data(), data.size()));
+            writeEnd.Close();
+        }
+    );
+    PipeStreamBuffer buffer(readEnd.Fd(), BasicStreamBuffer::BufferMode::Read);
+    std::istream     stream(&buffer);
+    EXPECT_EQ('z', stream.get());
+    //tee不消耗管道中的数据
+    size_t copied = 0;
+    while (!copied)
+    {
+        copied = PipeStreamBuffer::Tee(readEnd.Fd(), copyWrite.Fd(), 100).value();
+    }
+    std::string copy(copied, '\0');
+    EXPECT_EQ(static_cast<ssize_t>(copied), read(copyRead.Fd(), copy.data(), copy.size()));
+    EXPECT_EQ(std::string(copied, 'z'), copy);
+
+    //已经读入缓冲区的数据和管道中剩余的数据都写入文件
+    LinuxFileDescriptor file(open("/tmp", O_TMPFILE | O_RDWR | O_CLOEXEC, 0600));
+    ASSERT_FALSE(file.Empty());
+    EXPECT_EQ(data.size() - 1, buffer.TransferTo(file.Fd()).value());
+    EXPECT_EQ(static_cast<off_t>(data.size() - 1), lseek(file.Fd(), 0, SEEK_END));
+    writer.join();
+
+    //不支持splice的输出改为读写
+    ASSERT_EQ(0, pipe2(pipes, O_CLOEXEC));
+    readEnd  = pipes[0];
+    writeEnd = pipes[1];
+    LinuxFileDescriptor appendFile(open(("/proc/self/fd/" + std::to_string(file.Fd())).c_str(), O_WRONLY | O_APPEND | O_CLOEXEC));
+    ASSERT_FALSE(appendFile.Empty());
+    EXPECT_EQ(5, write(writeEnd.Fd(), "hello", 5));
+    writeEnd.Close();
+    PipeStreamBuffer appendBuffer(readEnd.Fd(), BasicStreamBuffer::BufferMode::Read);
+    EXPECT_EQ(5, appendBuffer.TransferTo(appendFile.Fd()).value());
+    EXPECT_EQ(static_cast<off_t>(data.size() + 4), lseek(file.Fd(), 0, SEEK_END));
+}
+
 #endif
\ No newline at end of file
@@ -2,6 +2,10 @@
 #include <zeus/foundation/core/random.h>
 #include <zeus/foundation/string/charset_utils.h>
 #include <zeus/foundation/string/string_utils.h>
+#include <zeus/foundation/string/inline_string.hpp>
+#include <zeus/foundation/string/string_pool.h>
+#include <zeus/foundation/byte/byte_searcher.h>
+#include <zeus/foundation/string/split_iterator.hpp>
 #include <zeus/foundation/string/url_utils.h>
 #include <zeus/foundation/string/version.h>
 #include "charsetutils_string.h"
@@ -51,6 +55,61 @@ TEST(CharsetUtils, UTF8Count)
     EXPECT_EQ(5, *CharsetUtils::UTF8CharPrintCount(std::string(5, 110)));
 }
 
+TEST(CharsetUtils, UTF8Validate)
+{
+    const std::string kText = std::string(u8"zeus阿斯蒂芬\U0001F600") + std::string(100, 'a') + u8"刚刚好";
+    EXPECT_TRUE(CharsetUtils::IsValidUTF8(""));
+    EXPECT_TRUE(CharsetUtils::IsValidUTF8(kText));
+    EXPECT_EQ(112, *CharsetUtils::UTF8CodePointCount(kText));
+    EXPECT_EQ(8, *CharsetUtils::UTF8CharPrintCount(std::string("ab\0cd", 5) + u8"阿斯蒂芬"));
+    //续字节不合法、过长编码、代理区、超过U+10FFFF、截断
+    const std::string kInvalid[] = {"\xE9\x98\x41", "\xC0\xAF", "\xE0\x80\xAF", "\xED\xA0\x80", "\xF4\x90\x80\x80", "\xE9\x98", "\x80"};
+    for (const auto& item : kInvalid)
+    {
+        const std::string data = kText + item + kText;
+        EXPECT_FALSE(CharsetUtils::IsValidUTF8(data));
+        EXPECT_FALSE(CharsetUtils::UTF8CharPrintCount(data).has_value());
+        auto count = CharsetUtils::UTF8CodePointCount(data);
+        ASSERT_FALSE(count.has_value());
+        EXPECT_EQ(kText.size(), count.error().offset);
+    }
+}
+
+TEST(CharsetUtils, UTF8Transcode)
+{
+    const std::string    kText    = std::string(u8"zeus阿斯蒂芬\U0001F600\u00e9") + std::string(40, 'a') + u8"刚刚好";
+    const std::u16string kText16  = std::u16string(u"zeus阿斯蒂芬\U0001F600\u00e9") + std::u16string(40, u'a') + u"刚刚好";
+    const std::u32string kText32  = std::u32string(U"zeus阿斯蒂芬\U0001F600\u00e9") + std::u32string(40, U'a') + U"刚刚好";
+    std::u16string       utf16(CharsetUtils::UTF16LengthFromUTF8(kText), u'\0');
+    std::u32string       utf32(CharsetUtils::UTF32LengthFromUTF8(kText), U'\0');
+    EXPECT_EQ(kText16.size(), utf16.size());
+    EXPECT_EQ(kText32.size(), utf32.size());
+    EXPECT_EQ(utf16.size(), *CharsetUtils::UTF8ToUTF16(kText, utf16.data()));
+    EXPECT_EQ(utf32.size(), *CharsetUtils::UTF8ToUTF32(kText, utf32.data()));
+    EXPECT_EQ(kText16, utf16);
+    EXPECT_EQ(kText32, utf32);
+
+    EXPECT_EQ(kText.size(), CharsetUtils::UTF8LengthFromUTF16(kText16));
+    EXPECT_EQ(kText.size(), CharsetUtils::UTF8LengthFromUTF32(kText32));
+    std::string utf8(kText.size(), '\0');
+    EXPECT_EQ(kText.size(), *CharsetUtils::UTF16ToUTF8(kText16, utf8.data()));
+    EXPECT_EQ(kText, utf8);
+    EXPECT_EQ(kText.size(), *CharsetUtils::UTF32ToUTF8(kText32, utf8.data()));
+    EXPECT_EQ(kText, utf8);
+
+    //未配对的代理、非法码点
+    const std::u16string kBad16 = kText16.substr(0, 10) + u'\xDC00' + kText16;
+    auto                 result = CharsetUtils::UTF16ToUTF8(kBad16, utf8.data());
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(10, result.error().offset);
+    const std::u32string kBad32 = kText32 + U'\x110000';
+    std::string          bad8(CharsetUtils::UTF8LengthFromUTF32(kBad32), '\0');
+    result = CharsetUtils::UTF32ToUTF8(kBad32, bad8.data());
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(kText32.size(), result.error().offset);
+    EXPECT_THROW(CharsetUtils::UTF8ToUnicode("\xE9\x98"), std::range_error);
+}
+
 TEST(StringOperation, Icompare)
 {
     const string a = "aaa";
@@ -94,6 +153,55 @@ TEST(StringOperation, IEqual)
     EXPECT_FALSE(zeus::IEqual(wa, wc));
 }
 
+TEST(StringOperation, CaseFold)
+{
+    //覆盖SIMD块内、块边界以及标量尾部
+    for (size_t size = 0; size < 100; ++size)
+    {
+        string upper;
+        string lower;
+        for (size_t index = 0; index < size; ++index)
+        {
+            upper.push_back(static_cast<char>('A' + index % 26));
+            lower.push_back(static_cast<char>('a' + index % 26));
+        }
+        EXPECT_EQ(lower, zeus::ToLowerCopy(upper));
+        EXPECT_EQ(upper, zeus::ToUpperCopy(lower));
+        EXPECT_EQ(0, zeus::Icompare(upper, lower));
+        EXPECT_TRUE(zeus::IEqual(lower, upper));
+        if (size)
+        {
+            string changed = upper;
+            changed.back() = '~';
+            EXPECT_EQ(-1, zeus::Icompare(upper, changed));
+            EXPECT_EQ(1, zeus::Icompare(changed, lower));
+            EXPECT_FALSE(zeus::IEqual(changed, lower));
+        }
+    }
+    //只有字母翻转，边界字符和UTF-8多字节字符不变
+    EXPECT_EQ("@az[`az{\xC3\x89", zeus::ToLowerCopy("@AZ[`az{\xC3\x89"));
+    EXPECT_EQ("@AZ[`AZ{\xC3\xA9", zeus::ToUpperCopy("@AZ[`az{\xC3\xA9"));
+    //非ASCII字节按无符号值比较，排在所有ASCII字符之后，0xFF最大，不受char是否有符号影响
+    EXPECT_EQ(1, zeus::Icompare("a\xC3", "AZ"));
+    EXPECT_EQ(-1, zeus::Icompare("Z", "\xC3"));
+    EXPECT_EQ(1, zeus::Icompare("\x80", "\x7F"));
+    EXPECT_EQ(-1, zeus::Icompare("\x80", "\xFF"));
+    EXPECT_EQ(1, zeus::Icompare("\xFF", "z"));
+
+    const wstring wide = L"Hello\u4F60\u597D World 0123456789 ABCDEFGHIJKLMNOPQRSTUVWXYZ \u4F60";
+    EXPECT_EQ(L"hello\u4F60\u597D world 0123456789 abcdefghijklmnopqrstuvwxyz \u4F60", zeus::ToLowerCopy(wide));
+    EXPECT_EQ(L"HELLO\u4F60\u597D WORLD 0123456789 ABCDEFGHIJKLMNOPQRSTUVWXYZ \u4F60", zeus::ToUpperCopy(wide));
+    EXPECT_TRUE(zeus::IEqual(wide, zeus::ToLowerCopy(wide)));
+    EXPECT_EQ(-1, zeus::Icompare(L"abcdefghijklmnopqrstuvwxyz\u4F60", L"ABCDEFGHIJKLMNOPQRSTUVWXYZ\u597D"));
+    EXPECT_EQ(1, zeus::Icompare(L"ABCDEFGHIJKLMNOPQRSTUVWXYZb", L"abcdefghijklmnopqrstuvwxyzA"));
+
+    string inPlace = "MiXeD CaSe StRiNg ThAt SpAnS MoRe ThAn OnE BlOcK";
+    zeus::ToLower(inPlace);
+    EXPECT_EQ("mixed case string that spans more than one block", inPlace);
+    zeus::ToUpper(inPlace);
+    EXPECT_EQ("MIXED CASE STRING THAT SPANS MORE THAN ONE BLOCK", inPlace);
+}
+
 TEST(StringOperation, IsNumber)
 {
     const string a = "546464646";
@@ -146,6 +254,66 @@ TEST(StringOperation, SplitString1)
     EXPECT_TRUE(res);
 }
 
+TEST(StringOperation, Splitter)
+{
+    using Fields = std::vector<std::string_view>;
+    auto collect = [](const auto& range)
+    {
+        Fields result;
+        for (const auto item : range)
+        {
+            result.emplace_back(item);
+        }
+        return result;
+    };
+    EXPECT_EQ((Fields {"A", "B", "C"}), collect(Splitter("++A+B++C++", "+")));
+    EXPECT_EQ((Fields {"", "", "A", "B", "", "C", "", ""}), collect(Splitter("++A+B++C++", "+", {true})));
+    EXPECT_EQ((Fields {"A", "B+C++"}), collect(Splitter("++A+B+C++", "+", {false, 1})));
+    EXPECT_EQ((Fields {"", "+A+B"}), collect(Splitter("++A+B", "+", {true, 1})));
+    EXPECT_EQ((Fields {"key", "value=1"}), collect(Splitter("key==value=1", "==")));
+    EXPECT_EQ((Fields {"a", "=b", "c="}), collect(Splitter("==a===b==c=", "==")));
+    EXPECT_EQ((Fields {"abc"}), collect(Splitter("abc", "")));
+    EXPECT_EQ(Fields {}, collect(Splitter("", ",")));
+    EXPECT_EQ((Fields {""}), collect(Splitter("", ",", {true})));
+
+    Splitter splitter("a,b,c", ",");
+    auto     iter = splitter.begin();
+    EXPECT_EQ("a", *iter);
+    EXPECT_EQ("b,c", iter.Rest());
+    EXPECT_EQ(3, std::distance(splitter.begin(), splitter.end()));
+
+    std::vector<std::wstring_view> wide;
+    for (const auto item : WSplitter(L"你::大::爷", L"::"))
+    {
+        wide.emplace_back(item);
+    }
+    EXPECT_EQ((std::vector<std::wstring_view> {L"你", L"大", L"爷"}), wide);
+}
+
+TEST(StringOperation, Tokenizer)
+{
+    std::vector<std::string_view> fields;
+    for (const auto item : Tokenizer("  1234 (bash) S\t1 1234\n", " \t\n"))
+    {
+        fields.emplace_back(item);
+    }
+    EXPECT_EQ((std::vector<std::string_view> {"1234", "(bash)", "S", "1", "1234"}), fields);
+
+    fields.clear();
+    for (const auto item : Tokenizer("a, b;;c", ",; ", {true}))
+    {
+        fields.emplace_back(item);
+    }
+    EXPECT_EQ((std::vector<std::string_view> {"a", "", "b", "", "c"}), fields);
+
+    std::vector<std::wstring_view> wide;
+    for (const auto item : WTokenizer(L"你，大 爷", L"， "))
+    {
+        wide.emplace_back(item);
+    }
+    EXPECT_EQ((std::vector<std::wstring_view> {L"你", L"大", L"爷"}), wide);
+}
+
 TEST(StringOperation, SplitWString)
 {
     wstring strB = L"++你大爷+我大爷++C++";
@@ -194,6 +362,78 @@ TEST(StringOperation, SplitMultiString)
         auto result = SplitMultiString(multiData2, sizeof(multiData2));
         EXPECT_EQ(expect, result);
     }
+    {
+        SmallVector<std::string_view, 4> result;
+        SplitMultiString(multiData1, sizeof(multiData1), result);
+        EXPECT_TRUE(result.IsInline());
+        EXPECT_EQ(expect, vector<string>(result.begin(), result.end()));
+        EXPECT_EQ(multiData1, result.front().data());
+    }
+    {
+        wchar_t                           multiData[] = L"ab\0\0cd\0";
+        SmallVector<std::wstring_view, 4> result;
+        SplitMultiString(multiData, sizeof(multiData), result);
+        EXPECT_EQ((vector<wstring> {L"ab", L"cd"}), vector<wstring>(result.begin(), result.end()));
+    }
+}
+
+TEST(StringOperation, InlineString)
+{
+    constexpr InlineString<8> constant("abc");
+    static_assert(3 == constant.size());
+    InlineString<8> value("0123456789");
+    EXPECT_EQ("01234567", value);
+    EXPECT_TRUE(value.full());
+    EXPECT_FALSE(value.Append('x'));
+    EXPECT_FALSE(value.Assign("012345678"));
+    EXPECT_EQ("01234567", value.View());
+    EXPECT_TRUE(value.Assign("ab"));
+    EXPECT_TRUE(value.Append("cd"));
+    EXPECT_EQ(std::string("abcd"), value.c_str());
+    EXPECT_EQ("abcd", value.ToString());
+    value.pop_back();
+    EXPECT_TRUE(value.resize(5, 'z'));
+    EXPECT_EQ("abczz", value);
+    EXPECT_TRUE(constant < value);
+    EXPECT_EQ(std::hash<std::string_view>()("abczz"), std::hash<InlineString<8>>()(value));
+    InlineWString<4> wide(L"wide");
+    EXPECT_EQ(L"wide", wide.View());
+}
+
+TEST(StringOperation, StringPool)
+{
+    StringPool pool(64);
+    const auto first  = pool.Intern("hello");
+    const auto second = pool.Intern(std::string("hello"));
+    EXPECT_EQ(first.data(), second.data());
+    EXPECT_EQ('\0', first.data()[first.size()]);
+    EXPECT_NE(first.data(), pool.Store("hello").data());
+    EXPECT_EQ(1, pool.InternedCount());
+    EXPECT_EQ(first.data(), pool.Find("hello")->data());
+    EXPECT_FALSE(pool.Find("world").has_value());
+
+    //大字符串单独分配，之前返回的视图保持有效
+    const std::string large(100, 'L');
+    EXPECT_EQ(large, pool.Intern(large));
+    vector<std::string_view> views;
+    for (int index = 0; index < 100; ++index)
+    {
+        views.emplace_back(pool.Intern(std::to_string(index)));
+    }
+    EXPECT_EQ("hello", first);
+    for (int index = 0; index < 100; ++index)
+    {
+        EXPECT_EQ(std::to_string(index), views[index]);
+    }
+    EXPECT_EQ(102, pool.InternedCount());
+    EXPECT_GE(pool.BytesReserved(), pool.BytesUsed());
+
+    StringPool moved(std::move(pool));
+    EXPECT_EQ(first.data(), moved.Intern("hello").data());
+    moved.Clear();
+    EXPECT_EQ(0, moved.InternedCount());
+    EXPECT_EQ(64, moved.BytesReserved());
+    EXPECT_EQ("again", moved.Intern("again"));
 }
 
 TEST(StringOperation, JoinString)
@@ -290,6 +530,16 @@ TEST(StringOperation, Replace1)
     EXPECT_EQ(std::wstring(L"aaAbcXyz"), zeus::Replace(wstr, L"aadasdasdasdsdadadasdadsdasdad", L"bbbb"));
 }
 
+TEST(StringOperation, ReplaceSearcher)
+{
+    const zeus::ByteSearcher searcher("{name}");
+    EXPECT_EQ("hello world, world", zeus::Replace("hello {name}, {name}", searcher, "world"));
+    EXPECT_EQ("abc", zeus::Replace("abc", "", "x"));
+
+    const zeus::ByteMultiSearcher patterns(std::vector<std::string_view> {"&", "<", ">", "&lt;"});
+    EXPECT_EQ("&amp;lt;&lt;a&gt;&amp;", zeus::Replace("&lt;<a>&", patterns, {"&amp;", "&lt;", "&gt;", "&amp;lt;"}));
+}
+
 TEST(StringOperation, Replace2)
 {
     std::string str("aaAbcXyz");
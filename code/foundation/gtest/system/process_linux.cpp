@@ -8,6 +8,9 @@
 #include <gtest/gtest.h>
 #include <zeus/foundation/system/current_exe.h>
 #include <zeus/foundation/system/process.h>
+#include <zeus/foundation/system/child_process.h>
+#include <zeus/foundation/string/string_pool.h>
+#include <zeus/foundation/container/small_vector.hpp>
 #include <zeus/foundation/resource/auto_release.h>
 #include <zeus/foundation/file/kv_file_utils.h>
 
@@ -131,6 +134,24 @@ TEST(Process, EnvironmentVariable)
     }
 }
 
+TEST(Process, EmptyCmdlineArgument)
+{
+    //shell的read阻塞在标准输入上，参数中有一个空字符串
+    auto child = ChildProcessExecutor().EnableRedirectStdin(true).ExecuteProcess("/bin/sh", {"-c", "read -r line", "", "x"});
+    ASSERT_TRUE(child.has_value());
+    //argv[0]由ChildProcessExecutor决定，只比较之后的参数
+    const std::vector<std::string> expect = {"-c", "read -r line", "x"};
+    auto                           args   = Process::GetProcessCmdlineArguments(child->GetPID());
+    ASSERT_TRUE(args.has_value());
+    ASSERT_EQ(expect.size() + 1, args->size());
+    EXPECT_EQ(expect, std::vector<std::string>(args->begin() + 1, args->end()));
+    StringPool                        pool;
+    SmallVector<std::string_view, 16> arguments;
+    ASSERT_TRUE(Process::GetProcessCmdlineArguments(child->GetPID(), pool, arguments).has_value());
+    EXPECT_EQ(args.value(), std::vector<std::string>(arguments.begin(), arguments.end()));
+    child->Kill();
+}
+
 TEST(Process, Find)
 {
     auto targets = Process::FindProcessByName("bash");
@@ -85,6 +85,12 @@ TEST(Process, Cmdline)
     {
         auto cmd = Process::GetProcessCmdlineArguments(item.Id());
     }
+    StringPool                        pool;
+    SmallVector<std::string_view, 16> arguments;
+    auto                              expect = Process::GetProcessCmdlineArguments(Process::GetCurrentId());
+    ASSERT_TRUE(expect.has_value());
+    ASSERT_TRUE(Process::GetProcessCmdlineArguments(Process::GetCurrentId(), pool, arguments).has_value());
+    EXPECT_EQ(expect.value(), std::vector<std::string>(arguments.begin(), arguments.end()));
 }
 
 TEST(Process, SpecialCmdline)
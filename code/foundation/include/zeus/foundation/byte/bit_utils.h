@@ -0,0 +1,270 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace zeus
+{
+//位计数和位扫描，GCC/Clang使用内建函数，编译目标支持时直接生成popcnt/lzcnt/tzcnt指令，否则由编译器生成等价的指令序列
+//MSVC使用_BitScanForward/_BitScanReverse，popcnt指令需要/arch:AVX以上才会使用
+namespace bit_impl
+{
+template<typename T>
+constexpr size_t kBits = sizeof(T) * 8;
+
+inline size_t PopCount64(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_popcountll(value));
+#elif defined(_MSC_VER) && defined(_M_X64) && defined(__AVX__)
+    return static_cast<size_t>(__popcnt64(value));
+#else
+    value = value - ((value >> 1) & 0x5555555555555555ULL);
+    value = (value & 0x3333333333333333ULL) + ((value >> 2) & 0x3333333333333333ULL);
+    value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<size_t>((value * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+//value不能为0
+inline size_t LeadingZero64(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_clzll(value));
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+    unsigned long index = 0;
+    _BitScanReverse64(&index, value);
+    return 63 - static_cast<size_t>(index);
+#else
+    size_t count = 0;
+    while (!(value & 0x8000000000000000ULL))
+    {
+        ++count;
+        value <<= 1;
+    }
+    return count;
+#endif
+}
+
+//value不能为0
+inline size_t TrailingZero64(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<size_t>(__builtin_ctzll(value));
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+    unsigned long index = 0;
+    _BitScanForward64(&index, value);
+    return static_cast<size_t>(index);
+#else
+    size_t count = 0;
+    while (!(value & 1))
+    {
+        ++count;
+        value >>= 1;
+    }
+    return count;
+#endif
+}
+
+template<typename T>
+inline size_t CountLeftZero(T value)
+{
+    static_assert(std::is_unsigned_v<T>);
+    return value ? LeadingZero64(value) - (64 - kBits<T>) : kBits<T>;
+}
+
+template<typename T>
+inline size_t CountRightZero(T value)
+{
+    static_assert(std::is_unsigned_v<T>);
+    return value ? TrailingZero64(value) : kBits<T>;
+}
+} // namespace bit_impl
+
+inline size_t CountLeftZero(uint64_t x)
+{
+    return bit_impl::CountLeftZero(x);
+}
+inline size_t CountLeftOne(uint64_t x)
+{
+    return bit_impl::CountLeftZero(static_cast<uint64_t>(~x));
+}
+inline size_t CountRightZero(uint64_t x)
+{
+    return bit_impl::CountRightZero(x);
+}
+inline size_t CountRightOne(uint64_t x)
+{
+    return bit_impl::CountRightZero(static_cast<uint64_t>(~x));
+}
+
+inline size_t CountLeftZero(uint32_t x)
+{
+    return bit_impl::CountLeftZero(x);
+}
+inline size_t CountLeftOne(uint32_t x)
+{
+    return bit_impl::CountLeftZero(static_cast<uint32_t>(~x));
+}
+inline size_t CountRightZero(uint32_t x)
+{
+    return bit_impl::CountRightZero(x);
+}
+inline size_t CountRightOne(uint32_t x)
+{
+    return bit_impl::CountRightZero(static_cast<uint32_t>(~x));
+}
+
+inline size_t CountLeftZero(uint16_t x)
+{
+    return bit_impl::CountLeftZero(x);
+}
+inline size_t CountLeftOne(uint16_t x)
+{
+    return bit_impl::CountLeftZero(static_cast<uint16_t>(~x));
+}
+inline size_t CountRightZero(uint16_t x)
+{
+    return bit_impl::CountRightZero(x);
+}
+inline size_t CountRightOne(uint16_t x)
+{
+    return bit_impl::CountRightZero(static_cast<uint16_t>(~x));
+}
+
+inline size_t CountLeftZero(uint8_t x)
+{
+    return bit_impl::CountLeftZero(x);
+}
+inline size_t CountLeftOne(uint8_t x)
+{
+    return bit_impl::CountLeftZero(static_cast<uint8_t>(~x));
+}
+inline size_t CountRightZero(uint8_t x)
+{
+    return bit_impl::CountRightZero(x);
+}
+inline size_t CountRightOne(uint8_t x)
+{
+    return bit_impl::CountRightZero(static_cast<uint8_t>(~x));
+}
+
+inline size_t CountOne(uint8_t x)
+{
+    return bit_impl::PopCount64(x);
+}
+inline size_t CountZero(uint8_t x)
+{
+    return 8 - CountOne(x);
+}
+inline size_t CountOne(uint16_t x)
+{
+    return bit_impl::PopCount64(x);
+}
+inline size_t CountZero(uint16_t x)
+{
+    return 16 - CountOne(x);
+}
+inline size_t CountOne(uint32_t x)
+{
+    return bit_impl::PopCount64(x);
+}
+inline size_t CountZero(uint32_t x)
+{
+    return 32 - CountOne(x);
+}
+inline size_t CountOne(uint64_t x)
+{
+    return bit_impl::PopCount64(x);
+}
+inline size_t CountZero(uint64_t x)
+{
+    return 64 - CountOne(x);
+}
+
+//按从低到高的顺序遍历一个64位字中为1的位，每次取最低位的1后清除，循环次数等于1的个数
+class SetBitIterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = size_t;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = const size_t *;
+    using reference         = size_t;
+public:
+    constexpr SetBitIterator() noexcept = default;
+    constexpr explicit SetBitIterator(uint64_t word) noexcept : _word(word) {}
+    size_t          operator*() const noexcept { return bit_impl::TrailingZero64(_word); }
+    SetBitIterator &operator++() noexcept
+    {
+        _word &= _word - 1;
+        return *this;
+    }
+    SetBitIterator operator++(int) noexcept
+    {
+        auto temp = *this;
+        ++*this;
+        return temp;
+    }
+    constexpr bool operator==(const SetBitIterator &other) const noexcept { return _word == other._word; }
+    constexpr bool operator!=(const SetBitIterator &other) const noexcept { return _word != other._word; }
+private:
+    uint64_t _word = 0;
+};
+
+//for (auto bit : SetBits(word))
+class SetBits
+{
+public:
+    constexpr explicit SetBits(uint64_t word) noexcept : _word(word) {}
+    constexpr SetBitIterator begin() const noexcept { return SetBitIterator(_word); }
+    constexpr SetBitIterator end() const noexcept { return SetBitIterator(); }
+private:
+    uint64_t _word;
+};
+
+//遍历位图中为1的位，位序号为word下标*64+字内位序号，全0的字只需要一次比较
+template<typename Function>
+void ForEachSetBit(const uint64_t *words, size_t count, Function &&function)
+{
+    for (size_t index = 0; index < count; ++index)
+    {
+        for (uint64_t word = words[index]; word; word &= word - 1)
+        {
+            function(index * 64 + bit_impl::TrailingZero64(word));
+        }
+    }
+}
+
+//字节形式的位图，第n位是第n/8个字节的第n%8位(低位在前)，只支持小端架构
+template<typename Function>
+void ForEachSetBit(const void *bitmap, size_t size, Function &&function)
+{
+    const auto *bytes = static_cast<const uint8_t *>(bitmap);
+    size_t      index = 0;
+    for (; index + 8 <= size; index += 8)
+    {
+        uint64_t word = 0;
+        std::memcpy(&word, bytes + index, sizeof(word));
+        for (; word; word &= word - 1)
+        {
+            function(index * 8 + bit_impl::TrailingZero64(word));
+        }
+    }
+    for (; index < size; ++index)
+    {
+        for (uint32_t word = bytes[index]; word; word &= word - 1)
+        {
+            function(index * 8 + bit_impl::TrailingZero64(word));
+        }
+    }
+}
+} // namespace zeus
+
+#include "zeus/foundation/core/zeus_compatible.h"
@@ -1,31 +1,92 @@
 ﻿#pragma once
 // Package: Utils
 
-#include <memory>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
 namespace zeus
 {
-struct ByteBufferViewImpl;
+//不拥有数据的字节视图，只有一个指针和一个长度，可以按值传递，拷贝和切片都不会分配内存
+//视图引用的数据需要在使用期间保持有效
 class ByteBufferView
 {
 public:
-    ByteBufferView(const uint8_t *data, size_t size);
-    ~ByteBufferView();
-    ByteBufferView(const ByteBufferView &other) noexcept;
-    ByteBufferView(ByteBufferView &&other) noexcept;
-    ByteBufferView &operator=(const ByteBufferView &other) noexcept;
-    ByteBufferView &operator=(ByteBufferView &&other) noexcept;
-    const uint8_t  &operator[](size_t index) const;
-    uint8_t        &operator[](size_t index);
-    operator bool() const noexcept;
-    const uint8_t *Data() const;
-    uint8_t       *Data();
-    size_t         Size() const;
-    ByteBufferView SubView(size_t offset, size_t size) const;
+    static constexpr size_t npos = std::string::npos;
+public:
+    constexpr ByteBufferView() noexcept = default;
+    constexpr ByteBufferView(const uint8_t *data, size_t size) noexcept : _data(const_cast<uint8_t *>(data)), _size(size) {}
+    ByteBufferView(const std::vector<uint8_t> &data) noexcept : ByteBufferView(data.data(), data.size()) {}
+    explicit ByteBufferView(std::string_view data) noexcept : ByteBufferView(reinterpret_cast<const uint8_t *>(data.data()), data.size()) {}
+
+    constexpr const uint8_t &operator[](size_t index) const
+    {
+        assert(_data && index < _size);
+        return _data[index];
+    }
+    constexpr uint8_t &operator[](size_t index)
+    {
+        assert(_data && index < _size);
+        return _data[index];
+    }
+    //数据为空或者长度为0时为false
+    constexpr operator bool() const noexcept { return _data != nullptr && _size; }
+    constexpr const uint8_t *Data() const noexcept { return _data; }
+    constexpr uint8_t       *Data() noexcept { return _data; }
+    constexpr size_t         Size() const noexcept { return _size; }
+    constexpr bool           Empty() const noexcept { return !_size; }
+    constexpr const uint8_t *begin() const noexcept { return _data; }
+    constexpr const uint8_t *end() const noexcept { return _data + _size; }
+    //offset超出范围时返回空视图，size超出剩余长度时截断到末尾
+    constexpr ByteBufferView SubView(size_t offset, size_t size = npos) const noexcept
+    {
+        if (offset >= _size)
+        {
+            return {_data ? _data + _size : nullptr, 0};
+        }
+        return {_data + offset, size < _size - offset ? size : _size - offset};
+    }
+    constexpr ByteBufferView First(size_t size) const noexcept { return SubView(0, size); }
+    constexpr ByteBufferView Last(size_t size) const noexcept { return size < _size ? SubView(_size - size) : *this; }
+    constexpr bool           StartWith(ByteBufferView other) const noexcept { return other._size <= _size && First(other._size) == other; }
+    constexpr bool           EndWith(ByteBufferView other) const noexcept { return other._size <= _size && Last(other._size) == other; }
+    std::string_view         AsStringView() const noexcept { return {reinterpret_cast<const char *>(_data), _size}; }
+    std::vector<uint8_t>     ToVector() const { return {begin(), end()}; }
+
+    //按字节的字典序比较
+    static constexpr int Compare(ByteBufferView lhs, ByteBufferView rhs) noexcept
+    {
+        const size_t size = lhs._size < rhs._size ? lhs._size : rhs._size;
+        for (size_t index = 0; index < size; ++index)
+        {
+            if (lhs._data[index] != rhs._data[index])
+            {
+                return lhs._data[index] < rhs._data[index] ? -1 : 1;
+            }
+        }
+        if (lhs._size == rhs._size)
+        {
+            return 0;
+        }
+        return lhs._size < rhs._size ? -1 : 1;
+    }
+    friend constexpr bool operator==(ByteBufferView lhs, ByteBufferView rhs) noexcept { return lhs._size == rhs._size && 0 == Compare(lhs, rhs); }
+    friend constexpr bool operator!=(ByteBufferView lhs, ByteBufferView rhs) noexcept { return !(lhs == rhs); }
+    friend constexpr bool operator<(ByteBufferView lhs, ByteBufferView rhs) noexcept { return Compare(lhs, rhs) < 0; }
+    friend constexpr bool operator<=(ByteBufferView lhs, ByteBufferView rhs) noexcept { return Compare(lhs, rhs) <= 0; }
+    friend constexpr bool operator>(ByteBufferView lhs, ByteBufferView rhs) noexcept { return Compare(lhs, rhs) > 0; }
+    friend constexpr bool operator>=(ByteBufferView lhs, ByteBufferView rhs) noexcept { return Compare(lhs, rhs) >= 0; }
 private:
-    std::unique_ptr<ByteBufferViewImpl> _impl;
+    uint8_t *_data = nullptr;
+    size_t   _size = 0;
 };
 
+static_assert(std::is_trivially_copyable_v<ByteBufferView>, "ByteBufferView must be trivially copyable");
+static_assert(sizeof(ByteBufferView) == sizeof(void *) + sizeof(size_t), "ByteBufferView must be a pointer and a length");
+
 } // namespace zeus
 #include "zeus/foundation/core/zeus_compatible.h"
@@ -1,21 +1,194 @@
 ﻿#pragma once
+#include <stddef.h>
 #include <stdint.h>
+#include <cstring>
+#include <type_traits>
 
 namespace zeus
 {
-uint16_t FlipBytes(const uint16_t& value);
-uint32_t FlipBytes(const uint32_t& value);
-uint64_t FlipBytes(const uint64_t& value);
-int16_t FlipBytes(const int16_t& value);
-int32_t FlipBytes(const int32_t& value);
-int64_t FlipBytes(const int64_t& value);
+enum class ByteOrder
+{
+    kLittleEndian,
+    kBigEndian,
+};
+
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+constexpr ByteOrder kNativeByteOrder = ByteOrder::kBigEndian;
+#else
+constexpr ByteOrder kNativeByteOrder = ByteOrder::kLittleEndian;
+#endif
+
+//移位形式可以在编译期求值，运行时编译器会识别为bswap/rev指令
+constexpr uint16_t FlipBytes(const uint16_t& value)
+{
+    return static_cast<uint16_t>(((value >> 8) & 0x00FF) | ((value << 8) & 0xFF00));
+}
+constexpr uint32_t FlipBytes(const uint32_t& value)
+{
+    return ((value >> 24) & 0x000000FF) | ((value >> 8) & 0x0000FF00) | ((value << 8) & 0x00FF0000) | ((value << 24) & 0xFF000000);
+}
+constexpr uint64_t FlipBytes(const uint64_t& value)
+{
+    return uint64_t(FlipBytes(uint32_t(value >> 32))) | (uint64_t(FlipBytes(uint32_t(value & 0xFFFFFFFF))) << 32);
+}
+constexpr int16_t FlipBytes(const int16_t& value)
+{
+    return static_cast<int16_t>(FlipBytes(uint16_t(value)));
+}
+constexpr int32_t FlipBytes(const int32_t& value)
+{
+    return static_cast<int32_t>(FlipBytes(uint32_t(value)));
+}
+constexpr int64_t FlipBytes(const int64_t& value)
+{
+    return static_cast<int64_t>(FlipBytes(uint64_t(value)));
+}
+
+constexpr uint16_t FlipBytes(const uint16_t* value)
+{
+    return FlipBytes(*value);
+}
+constexpr uint32_t FlipBytes(const uint32_t* value)
+{
+    return FlipBytes(*value);
+}
+constexpr uint64_t FlipBytes(const uint64_t* value)
+{
+    return FlipBytes(*value);
+}
+constexpr int16_t FlipBytes(const int16_t* value)
+{
+    return FlipBytes(*value);
+}
+constexpr int32_t FlipBytes(const int32_t* value)
+{
+    return FlipBytes(*value);
+}
+constexpr int64_t FlipBytes(const int64_t* value)
+{
+    return FlipBytes(*value);
+}
+
+//批量翻转count个宽度为width(2、4或8)字节的值，source和destination可以是同一块内存，不要求对齐
+//x64按CPU选择AVX2或SSSE3的pshufb，ARM64使用NEON的rev
+void FlipBytes(const void *source, void *destination, size_t count, size_t width) noexcept;
+//原地批量翻转
+inline void FlipBytes(uint16_t *values, size_t count) noexcept
+{
+    FlipBytes(values, values, count, sizeof(uint16_t));
+}
+inline void FlipBytes(uint32_t *values, size_t count) noexcept
+{
+    FlipBytes(values, values, count, sizeof(uint32_t));
+}
+inline void FlipBytes(uint64_t *values, size_t count) noexcept
+{
+    FlipBytes(values, values, count, sizeof(uint64_t));
+}
+inline void FlipBytes(const uint16_t *source, uint16_t *destination, size_t count) noexcept
+{
+    FlipBytes(source, destination, count, sizeof(uint16_t));
+}
+inline void FlipBytes(const uint32_t *source, uint32_t *destination, size_t count) noexcept
+{
+    FlipBytes(source, destination, count, sizeof(uint32_t));
+}
+inline void FlipBytes(const uint64_t *source, uint64_t *destination, size_t count) noexcept
+{
+    FlipBytes(source, destination, count, sizeof(uint64_t));
+}
+
+namespace byte_order_impl
+{
+template<size_t Size>
+struct UnsignedOf;
+template<>
+struct UnsignedOf<1>
+{
+    using Type = uint8_t;
+};
+template<>
+struct UnsignedOf<2>
+{
+    using Type = uint16_t;
+};
+template<>
+struct UnsignedOf<4>
+{
+    using Type = uint32_t;
+};
+template<>
+struct UnsignedOf<8>
+{
+    using Type = uint64_t;
+};
+
+template<typename T>
+constexpr T Flip(T value)
+{
+    if constexpr (1 == sizeof(T))
+    {
+        return value;
+    }
+    else
+    {
+        return FlipBytes(value);
+    }
+}
+} // namespace byte_order_impl
+
+//整数和枚举在本机字节序与order之间转换，转换是对称的，可以在编译期求值
+template<typename T>
+constexpr T ConvertByteOrder(T value, ByteOrder order)
+{
+    static_assert(std::is_integral_v<T> || std::is_enum_v<T>, "integral or enum required");
+    using Unsigned = typename byte_order_impl::UnsignedOf<sizeof(T)>::Type;
+    return kNativeByteOrder == order ? value : static_cast<T>(byte_order_impl::Flip(static_cast<Unsigned>(value)));
+}
+template<typename T>
+constexpr T HostToBigEndian(T value)
+{
+    return ConvertByteOrder(value, ByteOrder::kBigEndian);
+}
+template<typename T>
+constexpr T BigEndianToHost(T value)
+{
+    return ConvertByteOrder(value, ByteOrder::kBigEndian);
+}
+template<typename T>
+constexpr T HostToLittleEndian(T value)
+{
+    return ConvertByteOrder(value, ByteOrder::kLittleEndian);
+}
+template<typename T>
+constexpr T LittleEndianToHost(T value)
+{
+    return ConvertByteOrder(value, ByteOrder::kLittleEndian);
+}
 
-uint16_t FlipBytes(const uint16_t* value);
-uint32_t FlipBytes(const uint32_t* value);
-uint64_t FlipBytes(const uint64_t* value);
-int16_t FlipBytes(const int16_t* value);
-int32_t FlipBytes(const int32_t* value);
-int64_t FlipBytes(const int64_t* value);
+//从不要求对齐的内存按order读写整数、枚举或者浮点数
+template<typename T>
+T LoadOrdered(const void *data, ByteOrder order) noexcept
+{
+    static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>, "arithmetic or enum required");
+    using Unsigned = typename byte_order_impl::UnsignedOf<sizeof(T)>::Type;
+    Unsigned bits  = 0;
+    std::memcpy(&bits, data, sizeof(bits));
+    bits    = ConvertByteOrder(bits, order);
+    T value = {};
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+template<typename T>
+void StoreOrdered(void *data, T value, ByteOrder order) noexcept
+{
+    static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>, "arithmetic or enum required");
+    using Unsigned = typename byte_order_impl::UnsignedOf<sizeof(T)>::Type;
+    Unsigned bits  = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    bits = ConvertByteOrder(bits, order);
+    std::memcpy(data, &bits, sizeof(bits));
 }
+} // namespace zeus
 
 #include "zeus/foundation/core/zeus_compatible.h"
@@ -0,0 +1,71 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "zeus/foundation/byte/byte_buffer_view.h"
+
+namespace zeus
+{
+//预编译的单模式查找，先用SIMD同时比较模式的首字节和尾字节筛选候选位置，再比较中间部分
+//模式会被拷贝保存，可以在多次查找、多个线程之间复用
+class ByteSearcher
+{
+public:
+    static constexpr size_t npos = std::string::npos;
+public:
+    explicit ByteSearcher(ByteBufferView pattern);
+    explicit ByteSearcher(std::string_view pattern);
+    const std::vector<uint8_t> &Pattern() const noexcept { return _pattern; }
+    size_t                      Size() const noexcept { return _pattern.size(); }
+    //从offset开始查找，只接受与offset相差stride整数倍的位置，返回相对data起始的偏移，没有找到或者模式为空时返回npos
+    //指针版本的offset没有默认值，避免Find("text", 2)这样的调用被当成指针加长度
+    size_t Find(const void *data, size_t size, size_t offset, size_t stride = 1) const noexcept;
+    size_t Find(ByteBufferView src, size_t offset = 0, size_t stride = 1) const noexcept;
+    size_t Find(std::string_view src, size_t offset = 0) const noexcept;
+    //不拷贝模式的一次性查找
+    static size_t Search(const void *data, size_t size, const void *pattern, size_t patternSize, size_t offset = 0, size_t stride = 1) noexcept;
+private:
+    std::vector<uint8_t> _pattern;
+};
+
+//Aho-Corasick多模式查找，一次扫描同时匹配所有模式，时间与数据长度线性相关，与模式数量无关
+//状态转移表按模式中出现的字节分类压缩，匹配语义为最左最长：起始位置最靠前的匹配优先，起始位置相同时最长的优先
+class ByteMultiSearcher
+{
+public:
+    struct Match
+    {
+        size_t offset;  //相对数据起始的偏移
+        size_t length;  //匹配的模式长度
+        size_t pattern; //匹配的模式在构造参数中的下标
+    };
+public:
+    //空模式会被忽略，重复的模式只有第一个会被报告
+    explicit ByteMultiSearcher(const std::vector<ByteBufferView> &patterns);
+    explicit ByteMultiSearcher(const std::vector<std::string_view> &patterns);
+    size_t PatternCount() const noexcept { return _patternCount; }
+    //从offset开始查找第一个匹配
+    std::optional<Match> Find(const void *data, size_t size, size_t offset) const noexcept;
+    std::optional<Match> Find(std::string_view src, size_t offset = 0) const noexcept;
+    //所有互不重叠的匹配
+    std::vector<Match> FindAll(const void *data, size_t size) const;
+    std::vector<Match> FindAll(std::string_view src) const;
+private:
+    void Build(const std::vector<std::pair<const uint8_t *, size_t>> &patterns);
+private:
+    std::vector<uint32_t> _next;      //状态数*字节分类数的完整转移表，构造完成后不再需要失败指针
+    std::vector<uint32_t> _depth;     //状态对应前缀的长度
+    std::vector<uint32_t> _output;    //以该状态结尾的最长模式所在的状态，0表示没有
+    std::vector<size_t>   _pattern;   //状态本身对应的模式下标
+    uint16_t              _classes[256] = {}; //字节到分类的映射，256种字节都出现时分类数为257
+    size_t                _classCount   = 1;
+    size_t                _patternCount = 0;
+};
+} // namespace zeus
+
+#include "zeus/foundation/core/zeus_compatible.h"
@@ -0,0 +1,195 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <type_traits>
+#include <vector>
+#include "zeus/foundation/byte/byte_buffer_view.h"
+#include "zeus/foundation/byte/byte_order.h"
+
+namespace zeus
+{
+//按指定字节序向可增长的缓冲区写入整数、枚举、浮点数和字节块，用于二进制格式编码
+class ByteWriter
+{
+public:
+    explicit ByteWriter(ByteOrder order = ByteOrder::kLittleEndian) noexcept;
+    explicit ByteWriter(size_t capacity, ByteOrder order = ByteOrder::kLittleEndian);
+
+    template<typename T>
+    void Put(T value)
+    {
+        Put(value, _order);
+    }
+    template<typename T>
+    void Put(T value, ByteOrder order)
+    {
+        StoreOrdered(Grow(sizeof(T)), value, order);
+    }
+    //整块拷贝后批量翻转字节序
+    template<typename T>
+    void PutArray(const T *values, size_t count)
+    {
+        PutArray(values, count, _order);
+    }
+    template<typename T>
+    void PutArray(const T *values, size_t count, ByteOrder order)
+    {
+        static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>, "arithmetic or enum required");
+        if (!count)
+        {
+            return;
+        }
+        auto *data = Grow(sizeof(T) * count);
+        std::memcpy(data, values, sizeof(T) * count);
+        if (sizeof(T) > 1 && kNativeByteOrder != order)
+        {
+            FlipBytes(data, data, count, sizeof(T));
+        }
+    }
+    void PutBytes(const void *data, size_t size);
+    void PutBytes(ByteBufferView data) { PutBytes(data.Data(), data.Size()); }
+
+    //跳过size字节(填0)，返回跳过部分的偏移，之后可以用PutAt回填，比如长度字段
+    size_t Skip(size_t size);
+    //覆盖已经写入的位置，越界时返回false并且不修改
+    template<typename T>
+    bool PutAt(size_t offset, T value)
+    {
+        return PutAt(offset, value, _order);
+    }
+    template<typename T>
+    bool PutAt(size_t offset, T value, ByteOrder order)
+    {
+        if (offset > _buffer.size() || _buffer.size() - offset < sizeof(T))
+        {
+            return false;
+        }
+        StoreOrdered(_buffer.data() + offset, value, order);
+        return true;
+    }
+
+    ByteOrder                   Order() const noexcept { return _order; }
+    size_t                      Size() const noexcept { return _buffer.size(); }
+    void                        Reserve(size_t capacity) { _buffer.reserve(capacity); }
+    void                        Clear() noexcept { _buffer.clear(); }
+    ByteBufferView              View() const noexcept { return _buffer; }
+    const std::vector<uint8_t> &Buffer() const noexcept { return _buffer; }
+    //取走缓冲区，之后写入器为空
+    std::vector<uint8_t>        Release() noexcept;
+private:
+    uint8_t *Grow(size_t size);
+private:
+    std::vector<uint8_t> _buffer;
+    ByteOrder            _order;
+};
+
+//按指定字节序从ByteBufferView读取，不拷贝数据，数据需要在读取期间保持有效
+//所有读取都检查边界，剩余数据不足时返回空或者false，并且不移动读取位置
+class ByteReader
+{
+public:
+    explicit ByteReader(ByteBufferView data, ByteOrder order = ByteOrder::kLittleEndian) noexcept : _data(data), _order(order) {}
+
+    template<typename T>
+    std::optional<T> Get() noexcept
+    {
+        return Get<T>(_order);
+    }
+    template<typename T>
+    std::optional<T> Get(ByteOrder order) noexcept
+    {
+        auto value = Peek<T>(order);
+        if (value)
+        {
+            _offset += sizeof(T);
+        }
+        return value;
+    }
+    template<typename T>
+    std::optional<T> Peek() const noexcept
+    {
+        return Peek<T>(_order);
+    }
+    template<typename T>
+    std::optional<T> Peek(ByteOrder order) const noexcept
+    {
+        if (Remaining() < sizeof(T))
+        {
+            return std::nullopt;
+        }
+        return LoadOrdered<T>(_data.Data() + _offset, order);
+    }
+    template<typename T>
+    bool GetArray(T *values, size_t count) noexcept
+    {
+        return GetArray(values, count, _order);
+    }
+    template<typename T>
+    bool GetArray(T *values, size_t count, ByteOrder order) noexcept
+    {
+        static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>, "arithmetic or enum required");
+        if (count > Remaining() / sizeof(T))
+        {
+            return false;
+        }
+        if (count)
+        {
+            if (sizeof(T) > 1 && kNativeByteOrder != order)
+            {
+                FlipBytes(_data.Data() + _offset, values, count, sizeof(T));
+            }
+            else
+            {
+                std::memcpy(values, _data.Data() + _offset, sizeof(T) * count);
+            }
+        }
+        _offset += sizeof(T) * count;
+        return true;
+    }
+    //返回引用原数据的视图
+    std::optional<ByteBufferView> GetBytes(size_t size) noexcept
+    {
+        if (Remaining() < size)
+        {
+            return std::nullopt;
+        }
+        const auto view = _data.SubView(_offset, size);
+        _offset += size;
+        return view;
+    }
+    bool Skip(size_t size) noexcept
+    {
+        if (Remaining() < size)
+        {
+            return false;
+        }
+        _offset += size;
+        return true;
+    }
+    bool Seek(size_t offset) noexcept
+    {
+        if (offset > _data.Size())
+        {
+            return false;
+        }
+        _offset = offset;
+        return true;
+    }
+
+    ByteOrder      Order() const noexcept { return _order; }
+    size_t         Offset() const noexcept { return _offset; }
+    size_t         Size() const noexcept { return _data.Size(); }
+    size_t         Remaining() const noexcept { return _data.Size() - _offset; }
+    bool           AtEnd() const noexcept { return _offset == _data.Size(); }
+    ByteBufferView RemainingView() const noexcept { return _data.SubView(_offset); }
+private:
+    ByteBufferView _data;
+    size_t         _offset = 0;
+    ByteOrder      _order;
+};
+} // namespace zeus
+
+#include "zeus/foundation/core/zeus_compatible.h"
@@ -7,46 +7,33 @@
 #include <cstdint>
 #include <string>
 #include <optional>
+#include "zeus/foundation/byte/bit_utils.h"
 #include "zeus/foundation/byte/byte_buffer_view.h"
+#include "zeus/foundation/byte/byte_searcher.h"
 
 namespace zeus
 {
 
-std::vector<ByteBufferView> ByteSplit(const ByteBufferView &src, const ByteBufferView &delim, size_t stride = 1);
+std::vector<ByteBufferView> ByteSplit(ByteBufferView src, ByteBufferView delim, size_t stride = 1);
 
-std::vector<uint8_t>   ByteJoin(std::vector<ByteBufferView> &src, const ByteBufferView &delim);
-std::string::size_type ByteFind(const ByteBufferView &src, const ByteBufferView &sub, size_t offset = 0, size_t stride = 1);
-std::string::size_type ByteReverseFind(const ByteBufferView &src, const ByteBufferView &sub, size_t offset = 0, size_t stride = 1);
-std::vector<uint8_t>   ByteReplace(const ByteBufferView &src, const ByteBufferView &sub, const ByteBufferView &replacement, size_t stride = 1);
+std::vector<uint8_t>   ByteJoin(std::vector<ByteBufferView> &src, ByteBufferView delim);
+std::string::size_type ByteFind(ByteBufferView src, ByteBufferView sub, size_t offset = 0, size_t stride = 1);
+std::string::size_type ByteReverseFind(ByteBufferView src, ByteBufferView sub, size_t offset = 0, size_t stride = 1);
+std::vector<uint8_t>   ByteReplace(ByteBufferView src, ByteBufferView sub, ByteBufferView replacement, size_t stride = 1);
 
-bool                                ByteEndWith(const ByteBufferView &src, const ByteBufferView &end);
-bool                                ByteStartWith(const ByteBufferView &src, const ByteBufferView &start);
+//使用预编译的查找器，同一个分隔符或者模式需要反复使用时避免重复准备
+std::vector<ByteBufferView> ByteSplit(ByteBufferView src, const ByteSearcher &delim, size_t stride = 1);
+std::vector<uint8_t>        ByteReplace(ByteBufferView src, const ByteSearcher &sub, ByteBufferView replacement, size_t stride = 1);
+//一次扫描替换多个模式，replacements[i]替换patterns中下标为i的模式，匹配语义与ByteMultiSearcher一致
+std::vector<uint8_t> ByteReplace(ByteBufferView src, const ByteMultiSearcher &patterns, const std::vector<ByteBufferView> &replacements);
+
+bool                                ByteEndWith(ByteBufferView src, ByteBufferView end);
+bool                                ByteStartWith(ByteBufferView src, ByteBufferView start);
 std::optional<std::vector<uint8_t>> HexStringToBytes(const std::string &hex);
 
-size_t CountLeftZero(uint32_t x);
-size_t CountLeftOne(uint32_t x);
-size_t CountRightZero(uint32_t x);
-size_t CountRightOne(uint32_t x);
-
-size_t CountLeftZero(uint16_t x);
-size_t CountLeftOne(uint16_t x);
-size_t CountRightZero(uint16_t x);
-size_t CountRightOne(uint16_t x);
-
-size_t CountLeftZero(uint8_t x);
-size_t CountLeftOne(uint8_t x);
-size_t CountRightZero(uint8_t x);
-size_t CountRightOne(uint8_t x);
-
-size_t CountZero(uint8_t x);
-size_t CountOne(uint8_t x);
-size_t CountZero(uint16_t x);
-size_t CountOne(uint16_t x);
-size_t CountZero(uint32_t x);
-size_t CountOne(uint32_t x);
-
-size_t CountZero(const ByteBufferView &src);
-size_t CountOne(const ByteBufferView &src);
+//按字节统计整个缓冲区中0和1的位数，根据CPU选择AVX-512 VPOPCNTDQ、AVX2或者popcnt指令
+size_t CountZero(ByteBufferView src);
+size_t CountOne(ByteBufferView src);
 } // namespace zeus
 
 #include "zeus/foundation/core/zeus_compatible.h"
@@ -0,0 +1,38 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "zeus/expected.hpp"
+
+namespace zeus
+{
+//无状态的十六进制编解码，直接读写调用者提供的缓冲区，没有堆分配，CPU支持时使用SIMD加速
+class Hex
+{
+public:
+    struct DecodeError
+    {
+        size_t offset; //第一个非法字符在输入中的位置
+    };
+public:
+    static constexpr size_t EncodedLength(size_t length) noexcept
+    {
+        return length * 2;
+    }
+    static constexpr size_t DecodedLength(size_t length) noexcept
+    {
+        return length / 2;
+    }
+    //output至少需要EncodedLength(length)字节，返回写入的字符数
+    static size_t      Encode(const void *input, size_t length, char *output, bool upCase = false) noexcept;
+    static std::string Encode(const void *input, size_t length, bool upCase = false);
+    //大小写字母都可以解码，output至少需要DecodedLength(length)字节，返回写入的字节数
+    static zeus::expected<size_t, DecodeError>               Decode(const char *input, size_t length, void *output) noexcept;
+    static zeus::expected<std::vector<uint8_t>, DecodeError> Decode(std::string_view input);
+};
+} // namespace zeus
+
+#include "zeus/foundation/core/zeus_compatible.h"
@@ -25,6 +25,7 @@ public:
     zeus::expected<void, ConfigError>        SetConfigValue(const std::string& key, const ConfigValue& value) override;
     zeus::expected<void, ConfigError>        RemoveConfigValue(const std::string& key) override;
     std::vector<std::string>                 GetConfigKeys(const std::string& key) const override;
+    using Config::GetConfigKeys;
     //通知会作用在主配置上
     size_t AddChangeNotify(const std::function<void(const ConfigPoint& key, const ConfigValue& value)>& notify) const override;
     size_t AddChangeNotify(const std::string& key, const std::function<void(const ConfigValue&)>& notify) const override;
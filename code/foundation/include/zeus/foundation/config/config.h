@@ -3,10 +3,13 @@
 #include <memory>
 #include <string>
 #include <functional>
+#include <string_view>
 
 #include <zeus/expected.hpp>
 
 #include "zeus/foundation/config/config_commom.h"
+#include "zeus/foundation/container/small_vector.hpp"
+#include "zeus/foundation/string/string_pool.h"
 
 namespace zeus
 {
@@ -26,6 +29,16 @@ public:
     virtual zeus::expected<void, ConfigError>        RemoveConfigValue(const std::string& key);
     virtual std::vector<std::string>                 GetConfigKeys(const std::string& key = "") const;
 
+    //按顺序访问key下的子项名，visitor中不能修改配置，默认实现基于GetConfigKeys
+    virtual void ForEachConfigKey(const std::string& key, const std::function<void(std::string_view name)>& visitor) const;
+    //子项名保存在pool中，数量不超过N时keys不分配内存
+    template<size_t N>
+    void GetConfigKeys(const std::string& key, StringPool& pool, SmallVector<std::string_view, N>& keys) const
+    {
+        keys.clear();
+        ForEachConfigKey(key, [&pool, &keys](std::string_view name) { keys.emplace_back(pool.Intern(name)); });
+    }
+
     virtual size_t AddChangeNotify(const std::function<void(const ConfigPoint& key, const ConfigValue& value)>& notify) const;
     virtual size_t AddChangeNotify(const std::string& key, const std::function<void(const ConfigValue& value)>& notify) const;
     virtual size_t AddChangeNotify(const std::string& key, const std::function<void()>& notify);
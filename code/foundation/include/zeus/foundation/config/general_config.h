@@ -30,6 +30,9 @@ public:
     zeus::expected<void, ConfigError>        SetConfigValue(const std::string& key, const ConfigValue& value) override;
     zeus::expected<void, ConfigError>        RemoveConfigValue(const std::string& key) override;
     std::vector<std::string>                 GetConfigKeys(const std::string& key) const override;
+    using Config::GetConfigKeys;
+
+    void ForEachConfigKey(const std::string& key, const std::function<void(std::string_view name)>& visitor) const override;
 
     size_t AddChangeNotify(const std::function<void(const ConfigPoint& key, const ConfigValue& value)>& notify) const override;
     size_t AddChangeNotify(const std::string& key, const std::function<void(const ConfigValue& value)>& notify) const override;
@@ -35,6 +35,7 @@ public:
     zeus::expected<void, ConfigError>        SetConfigValue(const std::string& key, const ConfigValue& value) override;
     zeus::expected<void, ConfigError>        RemoveConfigValue(const std::string& key) override;
     std::vector<std::string>                 GetConfigKeys(const std::string& key) const override;
+    using Config::GetConfigKeys;
     //注意这里被管理的配置如果自身支持修改通知，那么哪怕不通过LayeredConfig修改此配置，LayeredConfig上的修改通知也会被触发。
     //如果被管理的配置自身不支持修改通知，那么只有通过LayeredConfig修改此配置，LayeredConfig上的通知才会被触发。
     size_t AddChangeNotify(const std::function<void(const ConfigPoint& key, const ConfigValue& value)>& notify) const override;
@@ -21,10 +21,13 @@ public:
     void          AddConfig(const ConfigPtr& config, const std::string& label);
     void          RemoveConfig(const std::string& label);
     ConfigPtr     FindConfig(const std::string& label, bool partial = true) const;
+    using Config::GetConfigKeys;
 protected:
     bool                                     HasConfigValue(const std::string& key) const override;
     zeus::expected<ConfigValue, ConfigError> GetConfigValue(const std::string& key) const override;
     std::vector<std::string>                 GetConfigKeys(const std::string& key) const override;
+
+    void ForEachConfigKey(const std::string& key, const std::function<void(std::string_view name)>& visitor) const override;
 private:
     std::unique_ptr<SwitchConfigImpl> _impl;
 };
@@ -1,40 +1,75 @@
 ﻿#pragma once
 #include <string>
+#include <string_view>
 #include <map>
 #include <unordered_map>
-#ifdef _WIN32
-#include <string.h>
-#else
-#include <strings.h>
-#endif
+#include "zeus/foundation/crypt/fast_hash.h"
+#include "zeus/foundation/string/string_utils.h"
 namespace zeus
 {
+//大小写不敏感的比较和散列，语义与Icompare/IEqual一致：char版本只忽略ASCII字母的大小写，wchar_t版本非ASCII字符按towlower处理
+//比较函数是透明的，std::map可以直接用std::string_view查找
 class StringICaseKeyCompare
 {
 public:
-    bool operator()(std::string const &first, std::string const &second) const
-    {
-#ifdef _WIN32
-        return _stricmp(first.c_str(), second.c_str()) < 0;
-#else
-        return strcasecmp(first.c_str(), second.c_str()) < 0;
-#endif
-    }
+    using is_transparent = void;
+    bool operator()(std::string_view first, std::string_view second) const { return Icompare(first, second) < 0; }
 };
 
 class WStringICaseKeyCompare
 {
 public:
-    bool operator()(std::wstring const &first, std::wstring const &second) const
+    using is_transparent = void;
+    bool operator()(std::wstring_view first, std::wstring_view second) const { return Icompare(first, second) < 0; }
+};
+
+//分块转成小写后散列，短字符串只在栈上转换一次，使用进程随机种子防止哈希洪水攻击
+template<typename CharType>
+class BasicStringICaseHash
+{
+public:
+    size_t operator()(std::basic_string_view<CharType> value) const noexcept
     {
-#ifdef _WIN32
-        return _wcsicmp(first.c_str(), second.c_str()) < 0;
-#else
-        return wcscasecmp(first.c_str(), second.c_str()) < 0;
-#endif
+        CharType buffer[kChunkSize];
+        if (value.size() <= kChunkSize)
+        {
+            ToLower(value.data(), value.size(), buffer);
+            return static_cast<size_t>(FastHash::Hash64(buffer, value.size() * sizeof(CharType), FastHash::RandomSeed()));
+        }
+        FastHash hash(FastHash::RandomSeed());
+        for (size_t offset = 0; offset < value.size(); offset += kChunkSize)
+        {
+            const auto chunk = value.substr(offset, kChunkSize);
+            ToLower(chunk.data(), chunk.size(), buffer);
+            hash.Update(buffer, chunk.size() * sizeof(CharType));
+        }
+        return static_cast<size_t>(hash.Digest64());
     }
+private:
+    static constexpr size_t kChunkSize = 256 / sizeof(CharType);
 };
 
+template<typename CharType>
+class BasicStringICaseEqual
+{
+public:
+    bool operator()(std::basic_string_view<CharType> first, std::basic_string_view<CharType> second) const { return IEqual(first, second); }
+};
+
+using StringICaseHash   = BasicStringICaseHash<char>;
+using WStringICaseHash  = BasicStringICaseHash<wchar_t>;
+using StringICaseEqual  = BasicStringICaseEqual<char>;
+using WStringICaseEqual = BasicStringICaseEqual<wchar_t>;
+
+template<typename ValueType>
+using CaseMap = std::map<std::string, ValueType, StringICaseKeyCompare>;
+template<typename ValueType>
+using WCaseMap = std::map<std::wstring, ValueType, WStringICaseKeyCompare>;
+template<typename ValueType>
+using CaseUnorderedMap = std::unordered_map<std::string, ValueType, StringICaseHash, StringICaseEqual>;
+template<typename ValueType>
+using WCaseUnorderedMap = std::unordered_map<std::wstring, ValueType, WStringICaseHash, WStringICaseEqual>;
+
 } // namespace zeus
 
 #include "zeus/foundation/core/zeus_compatible.h"
@@ -2,16 +2,27 @@
 
 #include <list>
 #include <memory>
+#include <memory_resource>
 #include <type_traits>
 #include "zeus/foundation/sync/mutex_object.hpp"
 
 namespace zeus
 {
-template<typename ValueType>
+template<typename ValueType, template<typename> class Allocator = std::allocator>
 class ConcurrentListBase
 {
-    using DataType = std::list<ValueType>;
 public:
+    using AllocatorType = Allocator<ValueType>;
+    using DataType      = std::list<ValueType, AllocatorType>;
+
+    ConcurrentListBase() = default;
+    explicit ConcurrentListBase(const AllocatorType& allocator) : _data(allocator) {}
+
+    AllocatorType GetAllocator()
+    {
+        MUTEX_OBJECT_LOCK(this->_data);
+        return this->_data->get_allocator();
+    }
 
     void Clear()
     {
@@ -76,15 +87,17 @@ protected:
     zeus::MutexObject<DataType> _data;
 };
 
-template<typename ValueType, bool shared = false>
-class ConcurrentList : public ConcurrentListBase<ValueType>
+template<typename ValueType, bool shared = false, template<typename> class Allocator = std::allocator>
+class ConcurrentList : public ConcurrentListBase<ValueType, Allocator>
 {
 };
 
-template<typename ValueType>
-class ConcurrentList<ValueType, false> : public ConcurrentListBase<ValueType>
+template<typename ValueType, template<typename> class Allocator>
+class ConcurrentList<ValueType, false, Allocator> : public ConcurrentListBase<ValueType, Allocator>
 {
 public:
+    using ConcurrentListBase<ValueType, Allocator>::ConcurrentListBase;
+
     void PushBack(const ValueType& value)
     {
         MUTEX_OBJECT_LOCK(this->_data);
@@ -124,19 +137,21 @@ public:
     }
 };
 
-template<typename ValueType>
-class ConcurrentList<ValueType, true> : public ConcurrentListBase<std::shared_ptr<ValueType>>
+template<typename ValueType, template<typename> class Allocator>
+class ConcurrentList<ValueType, true, Allocator> : public ConcurrentListBase<std::shared_ptr<ValueType>, Allocator>
 {
 public:
+    using ConcurrentListBase<std::shared_ptr<ValueType>, Allocator>::ConcurrentListBase;
+
     void PushBack(const ValueType& value)
     {
-        auto data = std::make_shared<ValueType>(value);
+        auto data = MakeValue(value);
         PushBack(data);
     }
 
     void PushBack(ValueType&& value)
     {
-        auto data = std::make_shared<ValueType>(std::forward<ValueType>(value));
+        auto data = MakeValue(std::forward<ValueType>(value));
         PushBack(data);
     }
 
@@ -149,19 +164,19 @@ public:
     template<typename... Args>
     void EmplaceBack(Args&&... args)
     {
-        auto data = std::make_shared<ValueType>(std::forward<Args>(args)...);
+        auto data = MakeValue(std::forward<Args>(args)...);
         PushBack(data);
     }
 
     void PushFront(const ValueType& value)
     {
-        auto data = std::make_shared<ValueType>(value);
+        auto data = MakeValue(value);
         PushFront(data);
     }
 
     void PushFront(ValueType&& value)
     {
-        auto data = std::make_shared<ValueType>(std::forward<ValueType>(value));
+        auto data = MakeValue(std::forward<ValueType>(value));
         PushFront(data);
     }
 
@@ -174,10 +189,21 @@ public:
     template<typename... Args>
     void EmplaceFront(Args&&... args)
     {
-        auto data = std::make_shared<ValueType>(std::forward<Args>(args)...);
+        auto data = MakeValue(std::forward<Args>(args)...);
         PushFront(data);
     }
+private:
+    //元素和shared_ptr的控制块一起用容器的分配器分配
+    template<typename... Args>
+    std::shared_ptr<ValueType> MakeValue(Args&&... args)
+    {
+        return std::allocate_shared<ValueType>(Allocator<ValueType>(this->GetAllocator()), std::forward<Args>(args)...);
+    }
 };
+
+//使用std::pmr::memory_resource分配内存的版本，比如MonotonicArena和PoolResource
+template<typename ValueType, bool shared = false>
+using PmrConcurrentList = ConcurrentList<ValueType, shared, std::pmr::polymorphic_allocator>;
 } // namespace zeus
 
 #include "zeus/foundation/core/zeus_compatible.h"
@@ -1,17 +1,26 @@
 ﻿#pragma once
 
 #include <queue>
+#include <deque>
 #include <memory>
+#include <memory_resource>
 #include <type_traits>
 #include "zeus/foundation/sync/mutex_object.hpp"
 
 namespace zeus
 {
-template<typename ValueType>
+template<typename ValueType, template<typename> class Allocator = std::allocator>
 class ConcurrentQueueBase
 {
-    using DataType = std::queue<ValueType>;
 public:
+    using AllocatorType = Allocator<ValueType>;
+    using DataType      = std::queue<ValueType, std::deque<ValueType, AllocatorType>>;
+
+    ConcurrentQueueBase() = default;
+    explicit ConcurrentQueueBase(const AllocatorType& allocator) : _data(allocator), _allocator(allocator) {}
+
+    //std::queue没有get_allocator，单独保存一份
+    AllocatorType GetAllocator() { return _allocator; }
 
     void Clear()
     {
@@ -76,17 +85,20 @@ public:
 
 protected:
     zeus::MutexObject<DataType> _data;
+    AllocatorType               _allocator;
 };
 
-template<typename ValueType, bool shared = false>
-class ConcurrentQueue : public ConcurrentQueueBase<ValueType>
+template<typename ValueType, bool shared = false, template<typename> class Allocator = std::allocator>
+class ConcurrentQueue : public ConcurrentQueueBase<ValueType, Allocator>
 {
 };
 
-template<typename ValueType>
-class ConcurrentQueue<ValueType, false> : public ConcurrentQueueBase<ValueType>
+template<typename ValueType, template<typename> class Allocator>
+class ConcurrentQueue<ValueType, false, Allocator> : public ConcurrentQueueBase<ValueType, Allocator>
 {
 public:
+    using ConcurrentQueueBase<ValueType, Allocator>::ConcurrentQueueBase;
+
     void Push(const ValueType& value)
     {
         MUTEX_OBJECT_LOCK(this->_data);
@@ -107,19 +119,21 @@ public:
     }
 };
 
-template<typename ValueType>
-class ConcurrentQueue<ValueType, true> : public ConcurrentQueueBase<std::shared_ptr<ValueType>>
+template<typename ValueType, template<typename> class Allocator>
+class ConcurrentQueue<ValueType, true, Allocator> : public ConcurrentQueueBase<std::shared_ptr<ValueType>, Allocator>
 {
 public:
+    using ConcurrentQueueBase<std::shared_ptr<ValueType>, Allocator>::ConcurrentQueueBase;
+
     void Push(const ValueType& value)
     {
-        auto data = std::make_shared<ValueType>(value);
+        auto data = MakeValue(value);
         Push(data);
     }
 
     void Push(ValueType&& value)
     {
-        auto data = std::make_shared<ValueType>(std::forward<ValueType>(value));
+        auto data = MakeValue(std::forward<ValueType>(value));
         Push(data);
     }
 
@@ -132,10 +146,21 @@ public:
     template<typename... Args>
     void Emplace(Args&&... args)
     {
-        auto data = std::make_shared<ValueType>(std::forward<Args>(args)...);
+        auto data = MakeValue(std::forward<Args>(args)...);
         Push(data);
     }
+private:
+    //元素和shared_ptr的控制块一起用容器的分配器分配
+    template<typename... Args>
+    std::shared_ptr<ValueType> MakeValue(Args&&... args)
+    {
+        return std::allocate_shared<ValueType>(Allocator<ValueType>(this->GetAllocator()), std::forward<Args>(args)...);
+    }
 };
+
+//使用std::pmr::memory_resource分配内存的版本，比如MonotonicArena和PoolResource
+template<typename ValueType, bool shared = false>
+using PmrConcurrentQueue = ConcurrentQueue<ValueType, shared, std::pmr::polymorphic_allocator>;
 } // namespace zeus
 
 #include "zeus/foundation/core/zeus_compatible.h"
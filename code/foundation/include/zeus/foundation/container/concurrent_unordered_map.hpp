@@ -4,14 +4,15 @@
 #include <vector>
 #include <memory>
 #include <type_traits>
+#include <functional>
 #include "zeus/foundation/sync/mutex_object.hpp"
 
 namespace zeus
 {
-template<typename KeyType, typename ValueType, bool shared = false>
+template<typename KeyType, typename ValueType, bool shared = false, typename HashType = std::hash<KeyType>>
 class ConcurrentUnorderedMapBase
 {
-    using DataType = std::unordered_map<KeyType, ValueType>;
+    using DataType = std::unordered_map<KeyType, ValueType, HashType>;
 public:
     ValueType Get(const KeyType& key)
     {
@@ -124,13 +125,14 @@ protected:
     zeus::MutexObject<DataType> _data;
 };
 
-template<typename KeyType, typename ValueType, bool shared = false>
-class ConcurrentUnorderedMap : public ConcurrentUnorderedMapBase<KeyType, ValueType>
+//HashType可以使用zeus::Hash，对外部输入的键使用带随机种子的散列
+template<typename KeyType, typename ValueType, bool shared = false, typename HashType = std::hash<KeyType>>
+class ConcurrentUnorderedMap : public ConcurrentUnorderedMapBase<KeyType, ValueType, false, HashType>
 {
 };
 
-template<typename KeyType, typename ValueType>
-class ConcurrentUnorderedMap<KeyType, ValueType, false> : public ConcurrentUnorderedMapBase<KeyType, ValueType>
+template<typename KeyType, typename ValueType, typename HashType>
+class ConcurrentUnorderedMap<KeyType, ValueType, false, HashType> : public ConcurrentUnorderedMapBase<KeyType, ValueType, false, HashType>
 
 {
 public:
@@ -181,8 +183,9 @@ public:
     }
 };
 
-template<typename KeyType, typename ValueType>
-class ConcurrentUnorderedMap<KeyType, ValueType, true> : public ConcurrentUnorderedMapBase<KeyType, std::shared_ptr<ValueType>>
+template<typename KeyType, typename ValueType, typename HashType>
+class ConcurrentUnorderedMap<KeyType, ValueType, true, HashType>
+    : public ConcurrentUnorderedMapBase<KeyType, std::shared_ptr<ValueType>, false, HashType>
 {
 public:
     bool Set(const KeyType& key, const ValueType& value, bool cover = true)
@@ -6,14 +6,15 @@
 #include <vector>
 #include <memory>
 #include <type_traits>
+#include <functional>
 #include "zeus/foundation/sync/mutex_object.hpp"
 
 namespace zeus
 {
-template<typename KeyType, typename ValueType>
+template<typename KeyType, typename ValueType, typename HashType = std::hash<KeyType>>
 class ConcurrentUnorderedMultiMapBase
 {
-    using DataType = std::unordered_multimap<KeyType, ValueType>;
+    using DataType = std::unordered_multimap<KeyType, ValueType, HashType>;
 public:
     std::vector<typename DataType::mapped_type> Get(const KeyType& key)
     {
@@ -102,13 +103,13 @@ protected:
     zeus::MutexObject<DataType> _data;
 };
 
-template<typename KeyType, typename ValueType, bool shared = false>
-class ConcurrentUnorderedMultiMap : public ConcurrentUnorderedMultiMapBase<KeyType, ValueType>
+template<typename KeyType, typename ValueType, bool shared = false, typename HashType = std::hash<KeyType>>
+class ConcurrentUnorderedMultiMap : public ConcurrentUnorderedMultiMapBase<KeyType, ValueType, HashType>
 {
 };
 
-template<typename KeyType, typename ValueType>
-class ConcurrentUnorderedMultiMap<KeyType, ValueType, false> : public ConcurrentUnorderedMultiMapBase<KeyType, ValueType>
+template<typename KeyType, typename ValueType, typename HashType>
+class ConcurrentUnorderedMultiMap<KeyType, ValueType, false, HashType> : public ConcurrentUnorderedMultiMapBase<KeyType, ValueType, HashType>
 {
 public:
     void Set(const KeyType& key, const ValueType& value)
@@ -124,8 +125,9 @@ public:
     }
 };
 
-template<typename KeyType, typename ValueType>
-class ConcurrentUnorderedMultiMap<KeyType, ValueType, true> : public ConcurrentUnorderedMultiMapBase<KeyType, std::shared_ptr<ValueType>>
+template<typename KeyType, typename ValueType, typename HashType>
+class ConcurrentUnorderedMultiMap<KeyType, ValueType, true, HashType>
+    : public ConcurrentUnorderedMultiMapBase<KeyType, std::shared_ptr<ValueType>, HashType>
 {
 public:
     void Set(const KeyType& key, const ValueType& value)
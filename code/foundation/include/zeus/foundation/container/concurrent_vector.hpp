@@ -2,16 +2,28 @@
 
 #include <vector>
 #include <memory>
+#include <memory_resource>
 #include <type_traits>
 #include "zeus/foundation/sync/mutex_object.hpp"
 
 namespace zeus
 {
-template<typename ValueType>
+template<typename ValueType, template<typename> class Allocator = std::allocator>
 class ConcurrentVectorBase
 {
 public:
-    using DataType = std::vector<ValueType>;
+    using AllocatorType = Allocator<ValueType>;
+    using DataType      = std::vector<ValueType, AllocatorType>;
+
+    ConcurrentVectorBase() = default;
+    explicit ConcurrentVectorBase(const AllocatorType& allocator) : _data(allocator) {}
+
+    AllocatorType GetAllocator()
+    {
+        MUTEX_OBJECT_LOCK(this->_data);
+        return this->_data->get_allocator();
+    }
+
     void Clear()
     {
         MUTEX_OBJECT_LOCK(this->_data);
@@ -81,15 +93,17 @@ protected:
     zeus::MutexObject<DataType> _data;
 };
 
-template<typename ValueType, bool shared = false>
-class ConcurrentVector : public ConcurrentVectorBase<ValueType>
+template<typename ValueType, bool shared = false, template<typename> class Allocator = std::allocator>
+class ConcurrentVector : public ConcurrentVectorBase<ValueType, Allocator>
 {
 };
 
-template<typename ValueType>
-class ConcurrentVector<ValueType, false> : public ConcurrentVectorBase<ValueType>
+template<typename ValueType, template<typename> class Allocator>
+class ConcurrentVector<ValueType, false, Allocator> : public ConcurrentVectorBase<ValueType, Allocator>
 {
 public:
+    using ConcurrentVectorBase<ValueType, Allocator>::ConcurrentVectorBase;
+
     void PushBack(const ValueType& value)
     {
         MUTEX_OBJECT_LOCK(this->_data);
@@ -110,19 +124,21 @@ public:
     }
 };
 
-template<typename ValueType>
-class ConcurrentVector<ValueType, true> : public ConcurrentVectorBase<std::shared_ptr<ValueType>>
+template<typename ValueType, template<typename> class Allocator>
+class ConcurrentVector<ValueType, true, Allocator> : public ConcurrentVectorBase<std::shared_ptr<ValueType>, Allocator>
 {
 public:
+    using ConcurrentVectorBase<std::shared_ptr<ValueType>, Allocator>::ConcurrentVectorBase;
+
     void PushBack(const ValueType& value)
     {
-        auto data = std::make_shared<ValueType>(value);
+        auto data = MakeValue(value);
         PushBack(data);
     }
 
     void PushBack(ValueType&& value)
     {
-        auto data = std::make_shared<ValueType>(std::forward<ValueType>(value));
+        auto data = MakeValue(std::forward<ValueType>(value));
         PushBack(data);
     }
 
@@ -135,11 +151,21 @@ public:
     template<typename... Args>
     void EmplaceBack(Args&&... args)
     {
-        auto data = std::make_shared<ValueType>(std::forward<Args>(args)...);
+        auto data = MakeValue(std::forward<Args>(args)...);
         PushBack(data);
     }
+private:
+    //元素和shared_ptr的控制块一起用容器的分配器分配
+    template<typename... Args>
+    std::shared_ptr<ValueType> MakeValue(Args&&... args)
+    {
+        return std::allocate_shared<ValueType>(Allocator<ValueType>(this->GetAllocator()), std::forward<Args>(args)...);
+    }
 };
 
+//使用std::pmr::memory_resource分配内存的版本，比如MonotonicArena和PoolResource
+template<typename ValueType, bool shared = false>
+using PmrConcurrentVector = ConcurrentVector<ValueType, shared, std::pmr::polymorphic_allocator>;
 } // namespace zeus
 
 #include "zeus/foundation/core/zeus_compatible.h"
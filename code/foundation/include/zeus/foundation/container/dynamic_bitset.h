@@ -0,0 +1,93 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "zeus/foundation/byte/bit_utils.h"
+
+namespace zeus
+{
+//运行时确定长度的位集合，按64位字存放，集合运算使用SIMD按字处理
+//Rank/Select在调用BuildRankIndex后使用每512位一个的累计计数索引，修改位之后索引失效，回退到扫描计数
+class DynamicBitset
+{
+public:
+    static constexpr size_t npos = std::string::npos;
+public:
+    DynamicBitset() = default;
+    explicit DynamicBitset(size_t size, bool value = false);
+
+    size_t Size() const noexcept { return _size; }
+    bool   Empty() const noexcept { return !_size; }
+    void   Resize(size_t size, bool value = false);
+    void   Clear() noexcept;
+
+    bool Test(size_t index) const noexcept { return index < _size && (_words[index / 64] >> (index % 64)) & 1; }
+    bool operator[](size_t index) const noexcept { return Test(index); }
+    //index超出Size时忽略
+    void Set(size_t index, bool value = true) noexcept;
+    void Reset(size_t index) noexcept { Set(index, false); }
+    void Flip(size_t index) noexcept;
+    void SetAll() noexcept;
+    void ResetAll() noexcept;
+    void FlipAll() noexcept;
+
+    //1的个数
+    size_t Count() const noexcept;
+    bool   Any() const noexcept;
+    bool   None() const noexcept { return !Any(); }
+    bool   All() const noexcept { return Count() == _size; }
+
+    //[0, index)中1的个数
+    size_t Rank(size_t index) const noexcept;
+    //第rank个(从0开始)为1的位的位置，不存在时返回npos
+    size_t Select(size_t rank) const noexcept;
+    //预先计算每512位的累计计数，之后Rank是O(1)，Select是O(log n)，修改任何位之后需要重新调用
+    void   BuildRankIndex();
+    bool   HasRankIndex() const noexcept { return _rankValid; }
+
+    //第一个为1的位，不存在时返回npos
+    size_t FindFirst() const noexcept { return FindFrom(0); }
+    //index之后下一个为1的位，不存在时返回npos
+    size_t FindNext(size_t index) const noexcept { return npos == index ? npos : FindFrom(index + 1); }
+    //按从小到大的顺序对每个为1的位调用function(size_t)
+    template<typename Function>
+    void ForEach(Function &&function) const
+    {
+        ForEachSetBit(_words.data(), _words.size(), std::forward<Function>(function));
+    }
+
+    //两个集合长度不同时，按本集合的长度计算，对方缺少的位视为0，超出本集合长度的位被忽略
+    DynamicBitset &operator&=(const DynamicBitset &other) noexcept;
+    DynamicBitset &operator|=(const DynamicBitset &other) noexcept;
+    DynamicBitset &operator^=(const DynamicBitset &other) noexcept;
+    //this &= ~other
+    DynamicBitset &AndNot(const DynamicBitset &other) noexcept;
+    DynamicBitset  operator~() const;
+
+    friend DynamicBitset operator&(DynamicBitset lhs, const DynamicBitset &rhs) { return lhs &= rhs; }
+    friend DynamicBitset operator|(DynamicBitset lhs, const DynamicBitset &rhs) { return lhs |= rhs; }
+    friend DynamicBitset operator^(DynamicBitset lhs, const DynamicBitset &rhs) { return lhs ^= rhs; }
+    friend bool          operator==(const DynamicBitset &lhs, const DynamicBitset &rhs) noexcept
+    {
+        return lhs._size == rhs._size && lhs._words == rhs._words;
+    }
+    friend bool operator!=(const DynamicBitset &lhs, const DynamicBitset &rhs) noexcept { return !(lhs == rhs); }
+
+    //底层存储，最后一个字中超出Size的位总是0
+    const uint64_t *Words() const noexcept { return _words.data(); }
+    size_t          WordCount() const noexcept { return _words.size(); }
+private:
+    size_t FindFrom(size_t index) const noexcept;
+    void   ClearTail() noexcept;
+private:
+    std::vector<uint64_t> _words;
+    std::vector<uint64_t> _blockRanks; //每8个字之前的1的个数
+    size_t                _size      = 0;
+    bool                  _rankValid = false;
+};
+} // namespace zeus
+
+#include "zeus/foundation/core/zeus_compatible.h"
@@ -0,0 +1,39 @@
+﻿#pragma once
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "zeus/foundation/crypt/fast_hash.h"
+
+namespace zeus
+{
+//用于散列容器的散列函数，字符串、整数、枚举、指针使用带进程随机种子的FastHash，防止哈希洪水攻击，其它类型回退到std::hash
+//种子每次进程启动都不同，散列值不能持久化或者跨进程使用
+template<typename T, typename Enable = void>
+struct Hash : std::hash<T>
+{
+};
+
+template<typename CharType, typename Traits, typename Allocator>
+struct Hash<std::basic_string<CharType, Traits, Allocator>>
+{
+    size_t operator()(std::basic_string_view<CharType, Traits> value) const noexcept
+    {
+        return static_cast<size_t>(FastHash::Hash64(value.data(), value.size() * sizeof(CharType), FastHash::RandomSeed()));
+    }
+};
+
+template<typename CharType, typename Traits>
+struct Hash<std::basic_string_view<CharType, Traits>> : Hash<std::basic_string<CharType, Traits>>
+{
+};
+
+template<typename T>
+struct Hash<T, std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>>>
+{
+    size_t operator()(T value) const noexcept { return static_cast<size_t>(FastHash::Hash64(&value, sizeof(value), FastHash::RandomSeed())); }
+};
+} // namespace zeus
+
+#include "zeus/foundation/core/zeus_compatible.h"
@@ -0,0 +1,130 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <utility>
+#include <vector>
+#include <zeus/expected.hpp>
+#include "zeus/foundation/byte/bit_utils.h"
+#include "zeus/foundation/serialization/serializer.h"
+
+namespace zeus
+{
+//压缩位图，32位整数集合按高16位分块，每块根据内容选择一种容器
+//数组容器:不超过4096个值时保存有序的低16位，位图容器:1024个64位字，行程容器:(起点,长度-1)对，只由AddRange和RunOptimize产生
+//适合稀疏或者成段的大id集合，集合运算按块进行，位图之间的运算使用SIMD
+class RoaringBitmap
+{
+public:
+    enum class ContainerType : uint8_t
+    {
+        kArray = 1,
+        kBitmap,
+        kRun,
+    };
+    static constexpr size_t kArrayMaxSize  = 4096;
+    static constexpr size_t kBitmapWords   = 1024;
+    static constexpr size_t kContainerBits = 65536;
+    struct Container
+    {
+        uint16_t              key         = 0;
+        ContainerType         type        = ContainerType::kArray;
+        uint32_t              cardinality = 0;
+        std::vector<uint16_t> values; //数组容器的有序值，或者行程容器的(起点,长度-1)对
+        std::vector<uint64_t> words;  //位图容器
+    };
+public:
+    RoaringBitmap() = default;
+    RoaringBitmap(std::initializer_list<uint32_t> values);
+    //values不需要有序
+    RoaringBitmap(const uint32_t *values, size_t size);
+
+    void Add(uint32_t value);
+    void AddMany(const uint32_t *values, size_t size);
+    //添加[begin, end)，整块覆盖的部分使用行程容器
+    void AddRange(uint64_t begin, uint64_t end);
+    //值不存在时返回false
+    bool Remove(uint32_t value);
+    bool Contains(uint32_t value) const noexcept;
+    void Clear() noexcept { _containers.clear(); }
+
+    uint64_t Cardinality() const noexcept;
+    bool     Empty() const noexcept { return _containers.empty(); }
+    //小于value的值的个数
+    uint64_t                Rank(uint32_t value) const noexcept;
+    //第rank个(从0开始)的值
+    std::optional<uint32_t> Select(uint64_t rank) const noexcept;
+    std::optional<uint32_t> Minimum() const noexcept;
+    std::optional<uint32_t> Maximum() const noexcept;
+    //按从小到大的顺序对每个值调用function(uint32_t)
+    template<typename Function>
+    void ForEach(Function &&function) const
+    {
+        for (const auto &container : _containers)
+        {
+            const uint32_t high = static_cast<uint32_t>(container.key) << 16;
+            switch (container.type)
+            {
+            case ContainerType::kArray:
+                for (const auto value : container.values)
+                {
+                    function(high | value);
+                }
+                break;
+            case ContainerType::kBitmap:
+                ForEachSetBit(container.words.data(), container.words.size(), [&](size_t bit) { function(high | static_cast<uint32_t>(bit)); });
+                break;
+            case ContainerType::kRun:
+                for (size_t index = 0; index + 1 < container.values.size(); index += 2)
+                {
+                    const uint32_t start  = high | container.values[index];
+                    const uint32_t length = container.values[index + 1];
+                    for (uint32_t offset = 0; offset <= length; ++offset)
+                    {
+                        function(start + offset);
+                    }
+                }
+                break;
+            }
+        }
+    }
+    std::vector<uint32_t> ToVector() const;
+
+    //把能节省空间的块转换为行程容器，返回是否有块被转换
+    bool   RunOptimize();
+    //容器和数据占用的堆内存字节数
+    size_t MemoryUsage() const noexcept;
+    //块的数量和各块的容器，用于统计和调试
+    const std::vector<Container> &Containers() const noexcept { return _containers; }
+
+    RoaringBitmap &operator&=(const RoaringBitmap &other);
+    RoaringBitmap &operator|=(const RoaringBitmap &other);
+    RoaringBitmap &operator^=(const RoaringBitmap &other);
+    //this &= ~other
+    RoaringBitmap &AndNot(const RoaringBitmap &other);
+
+    friend RoaringBitmap operator&(RoaringBitmap lhs, const RoaringBitmap &rhs) { return lhs &= rhs; }
+    friend RoaringBitmap operator|(RoaringBitmap lhs, const RoaringBitmap &rhs) { return lhs |= rhs; }
+    friend RoaringBitmap operator^(RoaringBitmap lhs, const RoaringBitmap &rhs) { return lhs ^= rhs; }
+    //按值比较，与容器类型无关
+    friend bool operator==(const RoaringBitmap &lhs, const RoaringBitmap &rhs) { return Equal(lhs, rhs); }
+    friend bool operator!=(const RoaringBitmap &lhs, const RoaringBitmap &rhs) { return !Equal(lhs, rhs); }
+
+    //小端格式: magic, 块数量, 每块(key, 类型, 数量, 数据)
+    std::vector<uint8_t>                                  Serialize() const;
+    static zeus::expected<RoaringBitmap, SerializerError> Deserialize(const void *data, size_t size);
+    zeus::expected<void, SerializerError>                 Save(Serializer &serializer) const;
+    static zeus::expected<RoaringBitmap, SerializerError> Load(Serializer &serializer);
+private:
+    static bool      Equal(const RoaringBitmap &lhs, const RoaringBitmap &rhs);
+    Container       *Find(uint16_t key) noexcept;
+    const Container *Find(uint16_t key) const noexcept;
+    Container       &FindOrInsert(uint16_t key);
+private:
+    std::vector<Container> _containers; //按key升序，不包含空块
+};
+} // namespace zeus
+
+#include "zeus/foundation/core/zeus_compatible.h"
@@ -0,0 +1,308 @@
+﻿#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace zeus
+{
+//前N个元素保存在对象内部的vector，元素数量不超过N时不分配堆内存，超过后和std::vector一样按倍数增长
+//接口和std::vector保持一致，移动时如果数据在堆上直接转移指针，在对象内部时逐个移动元素
+template<typename T, size_t N>
+class SmallVector
+{
+    static_assert(N > 0, "inline capacity must not be zero");
+public:
+    using value_type             = T;
+    using size_type              = size_t;
+    using difference_type        = std::ptrdiff_t;
+    using reference              = T &;
+    using const_reference        = const T &;
+    using pointer                = T *;
+    using const_pointer          = const T *;
+    using iterator               = T *;
+    using const_iterator         = const T *;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    static constexpr size_t kInlineCapacity = N;
+public:
+    SmallVector() noexcept = default;
+    explicit SmallVector(size_t count) { resize(count); }
+    SmallVector(size_t count, const T &value) { assign(count, value); }
+    template<typename InputIterator, typename = std::enable_if_t<!std::is_integral_v<InputIterator>>>
+    SmallVector(InputIterator first, InputIterator last)
+    {
+        assign(first, last);
+    }
+    SmallVector(std::initializer_list<T> list) { assign(list.begin(), list.end()); }
+    SmallVector(const SmallVector &other) { assign(other.begin(), other.end()); }
+    SmallVector(SmallVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>) { MoveFrom(std::move(other)); }
+    ~SmallVector()
+    {
+        clear();
+        Deallocate();
+    }
+    SmallVector &operator=(const SmallVector &other)
+    {
+        if (this != &other)
+        {
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+    SmallVector &operator=(SmallVector &&other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (this != &other)
+        {
+            clear();
+            Deallocate();
+            MoveFrom(std::move(other));
+        }
+        return *this;
+    }
+    SmallVector &operator=(std::initializer_list<T> list)
+    {
+        assign(list.begin(), list.end());
+        return *this;
+    }
+
+    void assign(size_t count, const T &value)
+    {
+        clear();
+        reserve(count);
+        for (size_t index = 0; index < count; ++index)
+        {
+            emplace_back(value);
+        }
+    }
+    template<typename InputIterator, typename = std::enable_if_t<!std::is_integral_v<InputIterator>>>
+    void assign(InputIterator first, InputIterator last)
+    {
+        clear();
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<InputIterator>::iterator_category>)
+        {
+            reserve(static_cast<size_t>(std::distance(first, last)));
+        }
+        for (; first != last; ++first)
+        {
+            emplace_back(*first);
+        }
+    }
+    void assign(std::initializer_list<T> list) { assign(list.begin(), list.end()); }
+
+    reference       operator[](size_t index) noexcept
+    {
+        assert(index < _size);
+        return _data[index];
+    }
+    const_reference operator[](size_t index) const noexcept
+    {
+        assert(index < _size);
+        return _data[index];
+    }
+    reference       front() noexcept { return (*this)[0]; }
+    const_reference front() const noexcept { return (*this)[0]; }
+    reference       back() noexcept { return (*this)[_size - 1]; }
+    const_reference back() const noexcept { return (*this)[_size - 1]; }
+    T              *data() noexcept { return _data; }
+    const T        *data() const noexcept { return _data; }
+
+    iterator               begin() noexcept { return _data; }
+    const_iterator         begin() const noexcept { return _data; }
+    const_iterator         cbegin() const noexcept { return _data; }
+    iterator               end() noexcept { return _data + _size; }
+    const_iterator         end() const noexcept { return _data + _size; }
+    const_iterator         cend() const noexcept { return _data + _size; }
+    reverse_iterator       rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator       rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    bool   empty() const noexcept { return !_size; }
+    size_t size() const noexcept { return _size; }
+    size_t capacity() const noexcept { return _capacity; }
+    //数据是否还在对象内部
+    bool   IsInline() const noexcept { return _data == InlineData(); }
+    void   reserve(size_t capacity)
+    {
+        if (capacity > _capacity)
+        {
+            Reallocate(capacity);
+        }
+    }
+    //元素不超过N个时搬回对象内部
+    void shrink_to_fit()
+    {
+        if (!IsInline() && _size < _capacity)
+        {
+            Reallocate(_size);
+        }
+    }
+
+    void clear() noexcept
+    {
+        std::destroy(begin(), end());
+        _size = 0;
+    }
+    void push_back(const T &value) { emplace_back(value); }
+    void push_back(T &&value) { emplace_back(std::move(value)); }
+    template<typename... Args>
+    reference emplace_back(Args &&...args)
+    {
+        if (_size < _capacity)
+        {
+            ::new (static_cast<void *>(_data + _size)) T(std::forward<Args>(args)...);
+        }
+        else
+        {
+            //先在新内存中构造新元素，参数可能引用现有元素
+            const size_t capacity = std::max(_capacity * 2, _size + 1);
+            T           *data     = Allocate(capacity);
+            ::new (static_cast<void *>(data + _size)) T(std::forward<Args>(args)...);
+            std::uninitialized_move(begin(), end(), data);
+            Replace(data, capacity);
+        }
+        return _data[_size++];
+    }
+    void pop_back() noexcept
+    {
+        assert(_size);
+        std::destroy_at(_data + --_size);
+    }
+    template<typename... Args>
+    iterator emplace(const_iterator position, Args &&...args)
+    {
+        const auto offset = position - begin();
+        emplace_back(std::forward<Args>(args)...);
+        std::rotate(begin() + offset, end() - 1, end());
+        return begin() + offset;
+    }
+    iterator insert(const_iterator position, const T &value) { return emplace(position, value); }
+    iterator insert(const_iterator position, T &&value) { return emplace(position, std::move(value)); }
+    template<typename InputIterator, typename = std::enable_if_t<!std::is_integral_v<InputIterator>>>
+    iterator insert(const_iterator position, InputIterator first, InputIterator last)
+    {
+        const auto   offset = position - begin();
+        const size_t size   = _size;
+        for (; first != last; ++first)
+        {
+            emplace_back(*first);
+        }
+        std::rotate(begin() + offset, begin() + size, end());
+        return begin() + offset;
+    }
+    iterator erase(const_iterator position) { return erase(position, position + 1); }
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        auto *target = begin() + (first - begin());
+        if (first != last)
+        {
+            auto *newEnd = std::move(begin() + (last - begin()), end(), target);
+            std::destroy(newEnd, end());
+            _size = static_cast<size_t>(newEnd - begin());
+        }
+        return target;
+    }
+    void resize(size_t size)
+    {
+        if (size < _size)
+        {
+            erase(begin() + size, end());
+            return;
+        }
+        reserve(size);
+        while (_size < size)
+        {
+            emplace_back();
+        }
+    }
+    void resize(size_t size, const T &value)
+    {
+        if (size < _size)
+        {
+            erase(begin() + size, end());
+            return;
+        }
+        reserve(size);
+        while (_size < size)
+        {
+            emplace_back(value);
+        }
+    }
+    void swap(SmallVector &other)
+    {
+        SmallVector temp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(temp);
+    }
+
+    friend bool operator==(const SmallVector &lhs, const SmallVector &rhs) { return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()); }
+    friend bool operator!=(const SmallVector &lhs, const SmallVector &rhs) { return !(lhs == rhs); }
+    friend bool operator<(const SmallVector &lhs, const SmallVector &rhs)
+    {
+        return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+private:
+    T       *InlineData() noexcept { return reinterpret_cast<T *>(_inline); }
+    const T *InlineData() const noexcept { return reinterpret_cast<const T *>(_inline); }
+    //不超过N时使用对象内部的存储
+    T       *Allocate(size_t capacity) { return capacity <= N ? InlineData() : std::allocator<T>().allocate(capacity); }
+    void     Deallocate() noexcept
+    {
+        if (!IsInline())
+        {
+            std::allocator<T>().deallocate(_data, _capacity);
+        }
+        _data     = InlineData();
+        _capacity = N;
+    }
+    //data中已经构造好新的元素，销毁并释放旧的
+    void Replace(T *data, size_t capacity) noexcept
+    {
+        std::destroy(begin(), end());
+        Deallocate();
+        _data     = data;
+        _capacity = capacity <= N ? N : capacity;
+    }
+    void Reallocate(size_t capacity)
+    {
+        T *data = Allocate(capacity);
+        if (data == _data)
+        {
+            return;
+        }
+        std::uninitialized_move(begin(), end(), data);
+        Replace(data, capacity);
+    }
+    void MoveFrom(SmallVector &&other)
+    {
+        if (other.IsInline())
+        {
+            std::uninitialized_move(other.begin(), other.end(), InlineData());
+            _size = other._size;
+            other.clear();
+        }
+        else
+        {
+            _data           = other._data;
+            _size           = other._size;
+            _capacity       = other._capacity;
+            other._data     = other.InlineData();
+            other._size     = 0;
+            other._capacity = N;
+        }
+    }
+private:
+    T     *_data     = reinterpret_cast<T *>(_inline);
+    size_t _size     = 0;
+    size_t _capacity = N;
+    alignas(T) unsigned char _inline[sizeof(T) * N];
+};
+} // namespace zeus
+
+#include "zeus/foundation/core/zeus_compatible.h"
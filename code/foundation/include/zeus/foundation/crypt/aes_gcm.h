@@ -0,0 +1,45 @@
+﻿#pragma once
+
+#include <memory>
+#include <string>
+#include <cstddef>
+
+namespace zeus
+{
+class AesGcmImpl;
+//AES-GCM认证加密，一次处理同时完成加密和认证，不需要再额外计算HMAC
+//加解密结果直接写入调用者提供的缓冲区，input和output可以是同一块内存(原地加解密)
+//同一个key的对象可以反复使用，但是每次加密必须使用不同的iv
+class AesGcm
+{
+public:
+    static constexpr size_t kTagSize = 16;
+    static constexpr size_t kIvSize  = 12;
+public:
+    //key长度必须是16、24或32字节
+    AesGcm(const void *key, size_t keyLength);
+    AesGcm(const std::string &key);
+    ~AesGcm();
+    AesGcm(const AesGcm &)            = delete;
+    AesGcm &operator=(const AesGcm &) = delete;
+    AesGcm(AesGcm &&other) noexcept;
+    AesGcm     &operator=(AesGcm &&other) noexcept;
+    std::string Name();
+    //output至少需要length字节，tag至少需要tagLength字节(4-16字节)
+    void Encrypt(
+        const void *iv, size_t ivLength, const void *aad, size_t aadLength, const void *input, size_t length, void *output, void *tag,
+        size_t tagLength = kTagSize
+    );
+    void Encrypt(const void *iv, size_t ivLength, const void *input, size_t length, void *output, void *tag, size_t tagLength = kTagSize);
+    //认证失败时返回false，并把output的length字节清零，原地解密时密文也会被清除
+    bool Decrypt(
+        const void *iv, size_t ivLength, const void *aad, size_t aadLength, const void *input, size_t length, void *output, const void *tag,
+        size_t tagLength = kTagSize
+    );
+    bool Decrypt(const void *iv, size_t ivLength, const void *input, size_t length, void *output, const void *tag, size_t tagLength = kTagSize);
+private:
+    std::unique_ptr<AesGcmImpl> _impl;
+};
+} // namespace zeus
+
+#include "zeus/foundation/core/zeus_compatible.h"
@@ -0,0 +1,47 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "zeus/expected.hpp"
+
+namespace zeus
+{
+//无状态的Base64编解码，直接读写调用者提供的缓冲区，没有堆分配，CPU支持时使用SIMD加速
+//与Base64Encrypt/Base64Decrypt不同，不支持换行，解码时遇到任何非法字符都会失败
+class Base64
+{
+public:
+    enum class Alphabet
+    {
+        kStandard, //+/
+        kUrlSafe,  //-_
+    };
+    struct DecodeError
+    {
+        size_t offset; //第一个非法字符在输入中的位置
+    };
+public:
+    //编码length字节后的字符数
+    static constexpr size_t EncodedLength(size_t length, bool padding = true) noexcept
+    {
+        return padding ? (length + 2) / 3 * 4 : length / 3 * 4 + (length % 3 ? length % 3 + 1 : 0);
+    }
+    //解码length个字符最多输出的字节数，用于分配输出缓冲区
+    static constexpr size_t DecodedMaxLength(size_t length) noexcept
+    {
+        return length / 4 * 3 + (length % 4 ? length % 4 - 1 : 0);
+    }
+    //output至少需要EncodedLength(length, padding)字节，返回写入的字符数
+    static size_t      Encode(const void *input, size_t length, char *output, Alphabet alphabet = Alphabet::kStandard, bool padding = true) noexcept;
+    static std::string Encode(const void *input, size_t length, Alphabet alphabet = Alphabet::kStandard, bool padding = true);
+    //output至少需要DecodedMaxLength(length)字节，返回写入的字节数，末尾的填充字符可以省略
+    static zeus::expected<size_t, DecodeError>
+        Decode(const char *input, size_t length, void *output, Alphabet alphabet = Alphabet::kStandard) noexcept;
+    static zeus::expected<std::vector<uint8_t>, DecodeError> Decode(std::string_view input, Alphabet alphabet = Alphabet::kStandard);
+};
+} // namespace zeus
+
+#include "zeus/foundation/core/zeus_compatible.h"
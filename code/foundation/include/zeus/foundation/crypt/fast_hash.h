@@ -0,0 +1,52 @@
+﻿#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace zeus
+{
+struct Hash128Value
+{
+    uint64_t low  = 0;
+    uint64_t high = 0;
+    bool     operator==(const Hash128Value &other) const noexcept { return low == other.low && high == other.high; }
+    bool     operator!=(const Hash128Value &other) const noexcept { return !(*this == other); }
+};
+
+//非密码学的快速散列，算法和结果与XXH3(xxHash 0.8)一致，长数据使用SIMD加速
+//适合散列表、分片、去重等场景，不能用于签名、校验等安全场景
+//上下文可以直接放在栈上，没有堆分配，可以拷贝保存中间状态
+class FastHash
+{
+public:
+    static constexpr size_t kSecretSize = 192;
+public:
+    explicit FastHash(uint64_t seed = 0) noexcept;
+    void         Reset() noexcept;
+    void         Reset(uint64_t seed) noexcept;
+    void         Update(const void *input, size_t length) noexcept;
+    void         Update(std::string_view data) noexcept;
+    //获取目前已经散列的数据计算出的散列值，不影响继续Update
+    uint64_t     Digest64() const noexcept;
+    Hash128Value Digest128() const noexcept;
+public:
+    static uint64_t     Hash64(const void *input, size_t length, uint64_t seed = 0) noexcept;
+    static uint64_t     Hash64(std::string_view data, uint64_t seed = 0) noexcept;
+    static Hash128Value Hash128(const void *input, size_t length, uint64_t seed = 0) noexcept;
+    static Hash128Value Hash128(std::string_view data, uint64_t seed = 0) noexcept;
+    //进程启动后随机生成的种子，用于散列表等对外部输入做散列的场景，防止构造大量冲突的哈希洪水攻击
+    static uint64_t     RandomSeed() noexcept;
+private:
+    std::array<uint64_t, 8>          _accumulators;
+    std::array<uint8_t, 256>         _buffer;
+    std::array<uint8_t, kSecretSize> _secret;
+    uint64_t                         _seed;
+    uint64_t                         _totalLength;
+    size_t                           _bufferSize;
+    size_t                           _stripes;
+};
+} // namespace zeus
+
+#include "zeus/foundation/core/zeus_compatible.h"
@@ -26,6 +26,11 @@ public:
     const std::byte *Digest() override;
     void             Reset() override;
     size_t           GetSize() override;
+public:
+    //一次性计算HMAC并写入digest，digest长度需要不小于type对应的散列长度，不需要创建实例
+    static void Hash(
+        const void *input, size_t length, const void *saltByte, size_t saltLength, void *digest, HMACDigestType type = HMACDigestType::SHA256
+    );
 protected:
     void UpdateImpl(const void *input, size_t length) override;
 
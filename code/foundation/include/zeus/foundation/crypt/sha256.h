@@ -0,0 +1,62 @@
+﻿#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace zeus
+{
+//可以直接放在栈上的SHA256上下文，没有堆分配，可以拷贝(用于保存中间状态)和反复Reset使用
+//适合大量短数据的散列计算，CPU支持SHA扩展指令时会自动使用硬件加速
+class Sha256
+{
+public:
+    static constexpr size_t kDigestSize = 32;
+    static constexpr size_t kBlockSize  = 64;
+    using DigestBytes                   = std::array<std::byte, kDigestSize>;
+public:
+    Sha256() noexcept;
+    void Reset() noexcept;
+    void Update(const void *input, size_t length) noexcept;
+    void Update(std::string_view data) noexcept;
+    //输出散列值到digest(kDigestSize字节)，之后上下文自动重置，可以直接开始下一次计算
+    void        Final(void *digest) noexcept;
+    DigestBytes Final() noexcept;
+public:
+    static DigestBytes Hash(const void *input, size_t length) noexcept;
+    static DigestBytes Hash(std::string_view data) noexcept;
+    static void        Hash(const void *input, size_t length, void *digest) noexcept;
+    //一次计算多条消息的散列值，消息会按SIMD通道数分组并行计算，适合大量长度相近的短消息
+    static void        HashMany(const void *const *inputs, const size_t *lengths, size_t count, DigestBytes *digests) noexcept;
+private:
+    std::array<uint32_t, 8>         _state;
+    std::array<uint8_t, kBlockSize> _buffer;
+    uint64_t                        _length;
+    size_t                          _bufferSize;
+};
+
+//基于Sha256的HMAC上下文，同样可以放在栈上反复使用，Reset后保留密钥
+class HmacSha256
+{
+public:
+    static constexpr size_t kDigestSize = Sha256::kDigestSize;
+    using DigestBytes                   = Sha256::DigestBytes;
+public:
+    HmacSha256(const void *key, size_t keyLength) noexcept;
+    void        Reset() noexcept;
+    void        Update(const void *input, size_t length) noexcept;
+    void        Update(std::string_view data) noexcept;
+    void        Final(void *digest) noexcept;
+    DigestBytes Final() noexcept;
+public:
+    static DigestBytes Hash(const void *key, size_t keyLength, const void *input, size_t length) noexcept;
+    static void        Hash(const void *key, size_t keyLength, const void *input, size_t length, void *digest) noexcept;
+private:
+    Sha256 _inner;
+    Sha256 _innerInit;
+    Sha256 _outerInit;
+};
+} // namespace zeus
+
+#include "zeus/foundation/core/zeus_compatible.h"
@@ -24,6 +24,10 @@ public:
     const std::byte *Digest() override;
     void             Reset() override;
     size_t           GetSize() override;
+public:
+    static constexpr size_t kDigestSize = 48;
+    //一次性计算散列值并写入digest(kDigestSize字节)，不需要创建实例，也没有堆分配
+    static void Hash(const void *input, size_t length, void *digest);
 protected:
     void UpdateImpl(const void *input, size_t length) override;
 private:
@@ -2,6 +2,7 @@
 #include <memory>
 #include <string>
 #include <optional>
+#include "zeus/foundation/crypt/uuid_value.h"
 #ifdef _WIN32
 #include <Guiddef.h>
 #endif
@@ -28,6 +29,9 @@ public:
     GUID               toGuid() const;
 #endif
     static std::optional<Uuid> FromWindowsString(const std::string& guid);
+    //与UuidValue互相转换，高频场景请直接使用UuidValue
+    UuidValue                  ToValue() const noexcept;
+    static Uuid                FromValue(const UuidValue& value);
 
     friend bool operator==(Uuid const& lhs, Uuid const& rhs) noexcept;
     friend bool operator<(Uuid const& lhs, Uuid const& rhs) noexcept;
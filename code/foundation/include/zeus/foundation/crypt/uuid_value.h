@@ -0,0 +1,112 @@
+﻿#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace zeus
+{
+//16字节的UUID值类型，可以直接拷贝、比较、放在栈上或者数组中，没有堆分配
+//字节按RFC 9562的网络字节序存放，比较按字节序进行，UUIDv7的比较结果与生成时间顺序一致
+class UuidValue
+{
+public:
+    static constexpr size_t kSize          = 16;
+    static constexpr size_t kStringLength  = 36; //xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx
+    static constexpr size_t kCompactLength = 32; //不带分隔符
+public:
+    constexpr UuidValue() noexcept = default;
+    constexpr explicit UuidValue(const std::array<uint8_t, kSize> &bytes) noexcept
+    {
+        for (size_t index = 0; index < kSize; ++index)
+        {
+            _data[index] = bytes[index];
+        }
+    }
+    constexpr const uint8_t *Data() const noexcept { return _data; }
+    constexpr uint8_t       *Data() noexcept { return _data; }
+    constexpr bool           IsNil() const noexcept
+    {
+        for (const auto item : _data)
+        {
+            if (item)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    //版本号，随机生成的为4，时间有序的为7
+    constexpr uint8_t Version() const noexcept { return _data[6] >> 4; }
+    constexpr size_t  Hash() const noexcept
+    {
+        uint64_t high = 0;
+        uint64_t low  = 0;
+        for (size_t index = 0; index < kSize / 2; ++index)
+        {
+            high = (high << 8) | _data[index];
+            low  = (low << 8) | _data[index + kSize / 2];
+        }
+        uint64_t hash = (high ^ (low >> 32 | low << 32)) * 0x9E3779B97F4A7C15ULL;
+        hash ^= hash >> 32;
+        return static_cast<size_t>(hash);
+    }
+    //output至少需要kStringLength字节(hyphen为false时kCompactLength字节)，不写入结尾的\0，返回写入的字符数
+    size_t      Format(char *output, bool upCase = false, bool hyphen = true) const noexcept;
+    std::string ToString(bool upCase = false, bool hyphen = true) const;
+    //支持xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx、不带分隔符以及{}包含的格式，大小写均可
+    static std::optional<UuidValue> Parse(std::string_view text) noexcept;
+    //版本4随机UUID，使用线程内缓冲的系统密码学安全随机数，系统随机数不可用时抛出std::exception派生的CryptoPP::OS_RNG_Err
+    //fork之后子进程丢弃继承的缓冲区重新获取随机数，不会和父进程生成相同的值
+    static UuidValue GenerateRandom();
+    static void      GenerateRandom(UuidValue *values, size_t count);
+    //版本7时间有序UUID，前48位是Unix毫秒时间戳，同一毫秒内进程内单调递增，适合作为数据库索引的键，异常同GenerateRandom
+    static UuidValue GenerateTimeOrdered();
+    //版本7 UUID中的Unix毫秒时间戳
+    constexpr uint64_t Timestamp() const noexcept
+    {
+        uint64_t timestamp = 0;
+        for (size_t index = 0; index < 6; ++index)
+        {
+            timestamp = (timestamp << 8) | _data[index];
+        }
+        return timestamp;
+    }
+
+    friend constexpr bool operator==(const UuidValue &lhs, const UuidValue &rhs) noexcept { return 0 == Compare(lhs, rhs); }
+    friend constexpr bool operator!=(const UuidValue &lhs, const UuidValue &rhs) noexcept { return 0 != Compare(lhs, rhs); }
+    friend constexpr bool operator<(const UuidValue &lhs, const UuidValue &rhs) noexcept { return Compare(lhs, rhs) < 0; }
+    friend constexpr bool operator<=(const UuidValue &lhs, const UuidValue &rhs) noexcept { return Compare(lhs, rhs) <= 0; }
+    friend constexpr bool operator>(const UuidValue &lhs, const UuidValue &rhs) noexcept { return Compare(lhs, rhs) > 0; }
+    friend constexpr bool operator>=(const UuidValue &lhs, const UuidValue &rhs) noexcept { return Compare(lhs, rhs) >= 0; }
+private:
+    static constexpr int Compare(const UuidValue &lhs, const UuidValue &rhs) noexcept
+    {
+        for (size_t index = 0; index < kSize; ++index)
+        {
+            if (lhs._data[index] != rhs._data[index])
+            {
+                return lhs._data[index] < rhs._data[index] ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+private:
+    uint8_t _data[kSize] = {};
+};
+} // namespace zeus
+
+namespace std
+{
+template<>
+struct hash<zeus::UuidValue>
+{
+    constexpr size_t operator()(const zeus::UuidValue &value) const noexcept { return value.Hash(); }
+};
+} // namespace std
+
+#include "zeus/foundation/core/zeus_compatible.h"
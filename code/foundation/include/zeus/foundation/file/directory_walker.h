@@ -0,0 +1,60 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <limits>
+#include <system_error>
+#include <vector>
+#include "zeus/expected.hpp"
+
+namespace zeus
+{
+//遍历目录树中的普通文件，用目录的工作队列把子目录分给多个线程同时列出
+//Linux上使用getdents64返回的d_type判断类型，只有符号链接、文件系统不提供类型或者需要文件大小时才stat
+//文件按发现的顺序回调，不排序也不去重
+class DirectoryWalker
+{
+public:
+    struct Entry
+    {
+        std::filesystem::path path;
+        //根目录下直接的文件深度为1
+        size_t                depth      = 0;
+        bool                  symbolLink = false;
+        //Options::querySize为true时有效，符号链接是目标文件的大小
+        uint64_t              size       = 0;
+    };
+    //callback返回false时停止遍历
+    using Callback        = std::function<bool(const Entry& entry)>;
+    //在查询大小和回调之前调用，返回false时跳过这个文件
+    using FileFilter      = std::function<bool(const std::filesystem::path& path)>;
+    //返回false时不进入这个目录，depth是目录中文件的深度减1
+    using DirectoryFilter = std::function<bool(const std::filesystem::path& path, size_t depth)>;
+    struct Options
+    {
+        //文件的最大深度，1表示只列出根目录下的文件
+        size_t          maxDepth                  = std::numeric_limits<size_t>::max();
+        //进入指向目录的符号链接，会跳过指回祖先目录的链接
+        bool            followSymbolLinkDirectory = false;
+        //列出指向普通文件的符号链接
+        bool            includeSymbolLinkFile     = false;
+        bool            querySize                 = false;
+        //同时列出目录的线程数，大于1时callback和过滤器会被并发调用
+        size_t          parallelism               = 1;
+        FileFilter      fileFilter;
+        DirectoryFilter directoryFilter;
+    };
+public:
+    //根目录无法打开时返回错误，子目录没有权限或者在遍历过程中被删除时跳过
+    static zeus::expected<void, std::error_code> Walk(const std::filesystem::path& directory, const Options& options, const Callback& callback);
+    //收集所有文件的路径，没有顺序
+    static zeus::expected<std::vector<std::filesystem::path>, std::error_code> Collect(
+        const std::filesystem::path& directory, const Options& options
+    );
+    //所有文件的总大小
+    static zeus::expected<uint64_t, std::error_code> TotalSize(const std::filesystem::path& directory, const Options& options);
+};
+} // namespace zeus
+
+#include "zeus/foundation/core/zeus_compatible.h"
@@ -52,6 +52,17 @@ zeus::expected<void, std::error_code> CreateWriteableDirectory(const std::filesy
 
 zeus::expected<bool, std::error_code> FileEqual(std::ifstream& file1, std::ifstream& file2);
 zeus::expected<bool, std::error_code> FileEqual(const std::filesystem::path& path1, const std::filesystem::path& path2);
+//parallelism大于1时大文件分段由多个线程同时比较，适合SSD等支持并发读取的设备
+zeus::expected<bool, std::error_code> FileEqual(const std::filesystem::path& path1, const std::filesystem::path& path2, size_t parallelism);
+
+//复制进度回调，copied是已经复制的字节数，返回false取消复制
+using FileCopyProgress = std::function<bool(uint64_t copied, uint64_t total)>;
+//复制文件内容和权限，数据尽量不经过用户态
+//Linux上依次尝试FICLONE(共享数据块，btrfs/xfs等)、copy_file_range、sendfile，都不支持时映射源文件后写入；Windows上使用CopyFileEx
+//overwrite为false时目标存在返回file_exists；失败或者取消时删除未完成的目标文件，取消返回operation_canceled
+zeus::expected<void, std::error_code> FileCopy(
+    const std::filesystem::path& from, const std::filesystem::path& to, bool overwrite = false, const FileCopyProgress& progress = nullptr
+);
 
 } // namespace zeus
 
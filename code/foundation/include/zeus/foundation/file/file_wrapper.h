@@ -4,8 +4,10 @@
 #include <string_view>
 #include <filesystem>
 #include <chrono>
+#include <initializer_list>
 #include "zeus/expected.hpp"
 #include "zeus/foundation/core/platform_def.h"
+#include "zeus/foundation/core/enum_bit_operator.h"
 
 namespace zeus
 {
@@ -26,6 +28,41 @@ public:
         kWrite,
         kReadWrite
     };
+    //打开时的附加选项，可以组合
+    enum class OpenFlag : uint32_t
+    {
+        kNone       = 0,
+        //绕过页缓存直接读写设备(Linux O_DIRECT，Windows FILE_FLAG_NO_BUFFERING)，大量顺序读写不会挤出其他数据的缓存
+        //缓冲区地址、文件偏移和长度都需要按DirectIoAlignment对齐，缓冲区可以从AlignedBufferPool获取
+        kDirect     = 1 << 0,
+        //按顺序访问，加大预读
+        kSequential = 1 << 1,
+        //随机访问，关闭预读
+        kRandom     = 1 << 2,
+    };
+    //访问方式提示，Linux上对应posix_fadvise
+    enum class Advice
+    {
+        kNormal,
+        kSequential,
+        kRandom,
+        //预读指定范围到页缓存
+        kWillNeed,
+        //丢弃指定范围的页缓存，脏页不会被丢弃，需要先Flush
+        kDontNeed,
+    };
+    //分散读取的目标缓冲区
+    struct ReadBuffer
+    {
+        void*  data;
+        size_t size;
+    };
+    //聚集写入的源缓冲区
+    struct WriteBuffer
+    {
+        const void* data;
+        size_t      size;
+    };
     FileWrapper();
     FileWrapper(PlatformFileHandle file);
     FileWrapper(const FileWrapper&)            = delete;
@@ -75,6 +112,7 @@ public:
     zeus::expected<void, std::error_code>                SetCloseOnExec(bool closeOnExec);
 #endif
     zeus::expected<uint64_t, std::error_code>                              FileSize();
+    //带offset和type的重载先Seek再读写，会移动文件偏移，多个线程共用时请使用ReadAt/WriteAt
     zeus::expected<size_t, std::error_code>                                Write(const void* data, size_t size);
     zeus::expected<size_t, std::error_code>                                Write(const void* data, size_t size, int64_t offset, OffsetType type);
     zeus::expected<size_t, std::error_code>                                Write(const std::string& data);
@@ -90,20 +128,62 @@ public:
     zeus::expected<uint64_t, std::error_code>                              Seek(int64_t offset, OffsetType type);
     zeus::expected<uint64_t, std::error_code>                              Tell();
     zeus::expected<void, std::error_code>                                  Flush();
+    //只刷新文件数据和读取数据需要的元数据(比如文件长度)，不刷新修改时间等，Linux上对应fdatasync，Windows上等同于Flush
+    zeus::expected<void, std::error_code>                                  FlushData();
     zeus::expected<std::chrono::system_clock::time_point, std::error_code> CreateTime();
     zeus::expected<std::chrono::system_clock::time_point, std::error_code> LastAccessTime();
     zeus::expected<std::chrono::system_clock::time_point, std::error_code> LastWriteTime();
     zeus::expected<std::chrono::system_clock::time_point, std::error_code> LastChangeTime();
+    //修改文件长度，直接读写按块写入后用它截去结尾的填充
+    zeus::expected<void, std::error_code>                                  Resize(uint64_t size);
+    //为[offset, offset + length)预先分配磁盘空间，顺序写入时减少碎片和元数据更新，keepSize为true时不改变文件长度
+    zeus::expected<void, std::error_code>                                  Preallocate(uint64_t offset, uint64_t length, bool keepSize = false);
+    //length为0表示到文件结尾，Windows上没有对应的接口，直接返回成功，访问方式需要在打开时通过OpenFlag指定
+    zeus::expected<void, std::error_code>                                  Advise(Advice advice, uint64_t offset = 0, uint64_t length = 0);
+    //直接读写要求的缓冲区、偏移和长度的对齐，不小于设备的逻辑块大小
+    zeus::expected<size_t, std::error_code>                                DirectIoAlignment() const;
+
+    //在指定位置读写，不使用也不移动文件偏移(Windows上同步句柄的文件指针会被移动)，多个线程共用一个FileWrapper时也不会互相影响
+    //内部重复调用直到完成全部长度，读到文件结尾时返回实际读取的长度
+    zeus::expected<size_t, std::error_code> ReadAt(void* buffer, size_t size, uint64_t offset);
+    zeus::expected<size_t, std::error_code> WriteAt(const void* data, size_t size, uint64_t offset);
+    //分散读取和聚集写入，一次系统调用处理多个缓冲区，比如记录头和记录内容，不需要先拼接
+    //内部重复调用直到完成全部长度，读到文件结尾时返回实际读取的长度
+    zeus::expected<size_t, std::error_code> ReadV(const ReadBuffer* buffers, size_t count);
+    zeus::expected<size_t, std::error_code> ReadV(const ReadBuffer* buffers, size_t count, uint64_t offset);
+    zeus::expected<size_t, std::error_code> ReadV(std::initializer_list<ReadBuffer> buffers) { return ReadV(buffers.begin(), buffers.size()); }
+    zeus::expected<size_t, std::error_code> ReadV(std::initializer_list<ReadBuffer> buffers, uint64_t offset)
+    {
+        return ReadV(buffers.begin(), buffers.size(), offset);
+    }
+    zeus::expected<size_t, std::error_code> WriteV(const WriteBuffer* buffers, size_t count);
+    zeus::expected<size_t, std::error_code> WriteV(const WriteBuffer* buffers, size_t count, uint64_t offset);
+    zeus::expected<size_t, std::error_code> WriteV(std::initializer_list<WriteBuffer> buffers) { return WriteV(buffers.begin(), buffers.size()); }
+    zeus::expected<size_t, std::error_code> WriteV(std::initializer_list<WriteBuffer> buffers, uint64_t offset)
+    {
+        return WriteV(buffers.begin(), buffers.size(), offset);
+    }
 
 public:
     static zeus::expected<FileWrapper, std::error_code> Open(const std::filesystem::path& path, OpenMode mode);
     static zeus::expected<FileWrapper, std::error_code> Create(const std::filesystem::path& path, OpenMode mode, bool autoFlush = false);
     static zeus::expected<FileWrapper, std::error_code> OpenOrCreate(const std::filesystem::path& path, OpenMode mode, bool autoFlush = false);
     static zeus::expected<FileWrapper, std::error_code> Truncate(const std::filesystem::path& path, OpenMode mode, bool autoFlush = false);
+    static zeus::expected<FileWrapper, std::error_code> Open(const std::filesystem::path& path, OpenMode mode, OpenFlag flags);
+    static zeus::expected<FileWrapper, std::error_code> Create(
+        const std::filesystem::path& path, OpenMode mode, OpenFlag flags, bool autoFlush = false
+    );
+    static zeus::expected<FileWrapper, std::error_code> OpenOrCreate(
+        const std::filesystem::path& path, OpenMode mode, OpenFlag flags, bool autoFlush = false
+    );
+    static zeus::expected<FileWrapper, std::error_code> Truncate(
+        const std::filesystem::path& path, OpenMode mode, OpenFlag flags, bool autoFlush = false
+    );
     static zeus::expected<FileWrapper, std::error_code> OpenSymbolLink(const std::filesystem::path& path, OpenMode mode, bool autoFlush = false);
 private:
     std::unique_ptr<FileWrapperImpl> _impl;
 };
+ZEUS_ENUM_BIT_OPERATOR(FileWrapper::OpenFlag)
 
 } // namespace zeus
 
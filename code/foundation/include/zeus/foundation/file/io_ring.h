@@ -0,0 +1,111 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <system_error>
+#include <vector>
+#include "zeus/expected.hpp"
+#include "zeus/foundation/file/file_wrapper.h"
+
+namespace zeus
+{
+class ThreadPool;
+class AdvancedThread;
+
+struct IoRingImpl;
+//异步文件IO引擎，Linux上使用io_uring，内核不支持、被禁用或者其他平台时使用线程池执行阻塞的定位读写
+//请求先放入队列，Submit时一次批量提交；完成回调默认在内部的完成线程中执行，可以投递到ThreadPool或者AdvancedThread
+//请求完成之前文件和缓冲区需要保持有效；析构时等待所有已提交的请求完成，未提交的请求以operation_canceled完成
+class IoRing
+{
+public:
+    using Result   = zeus::expected<size_t, std::error_code>;
+    using Callback = std::function<void(const Result& result)>;
+    using Executor = std::function<void(std::function<void()>&& task)>;
+    enum class Backend
+    {
+        kIoUring,
+        kThreadPool,
+    };
+    struct Options
+    {
+        //提交队列的长度，链接在一起的请求数量不能超过这个值
+        uint32_t queueDepth      = 256;
+        //线程池后端的线程数
+        size_t   fallbackThreads = 4;
+        //不使用io_uring，用于测试和对比
+        bool     forceFallback   = false;
+    };
+public:
+    IoRing();
+    explicit IoRing(const Options& options);
+    ~IoRing();
+    IoRing(const IoRing&)            = delete;
+    IoRing& operator=(const IoRing&) = delete;
+
+    Backend GetBackend() const noexcept;
+
+    //完成回调执行的位置，需要在提交请求之前设置
+    void SetCallbackExecutor(Executor executor);
+    void SetCallbackExecutor(ThreadPool& pool);
+    void SetCallbackExecutor(AdvancedThread& thread);
+
+    //注册文件后，对这些文件的请求使用注册的序号，内核不需要每次查找和引用文件，重复注册会替换之前的文件
+    zeus::expected<void, std::error_code> RegisterFiles(const std::vector<FileWrapper*>& files);
+    //注册缓冲区后用ReadFixed/WriteFixed按序号读写，内核不需要每次映射内存，重复注册会替换之前的缓冲区
+    zeus::expected<void, std::error_code> RegisterBuffers(const std::vector<FileWrapper::ReadBuffer>& buffers);
+
+    //以下函数把请求放入队列，调用Submit后开始执行
+    //linkNext为true时下一个请求在这个请求成功后才开始执行，比如写入后Fsync，前面的请求失败时后续请求以operation_canceled完成
+    //链接由同一个线程连续放入的请求组成，到linkNext为false的请求结束后整体进入队列，其他线程的请求和Submit不会插入或者拆开链接
+    //链接中有超出注册缓冲区的请求时整个链接都不执行，这个请求以invalid_argument完成，其他请求取消
+    //和pread/pwrite一样，读取到文件结尾时完成的长度可能小于size，单个请求最多读写0x7ffff000字节，两种后端一致
+    //完成的长度小于请求的长度也会中断链接，后续请求取消
+    void Read(FileWrapper& file, void* buffer, size_t size, uint64_t offset, Callback callback, bool linkNext = false);
+    void Write(FileWrapper& file, const void* data, size_t size, uint64_t offset, Callback callback, bool linkNext = false);
+    //bufferOffset是在注册的缓冲区内的偏移
+    void ReadFixed(
+        FileWrapper& file, size_t bufferIndex, size_t bufferOffset, size_t size, uint64_t offset, Callback callback, bool linkNext = false
+    );
+    void WriteFixed(
+        FileWrapper& file, size_t bufferIndex, size_t bufferOffset, size_t size, uint64_t offset, Callback callback, bool linkNext = false
+    );
+    //dataOnly为true时只刷新数据(fdatasync)
+    void Fsync(FileWrapper& file, Callback callback, bool dataOnly = false, bool linkNext = false);
+
+    //批量提交队列中的请求，返回提交的数量，当前线程还没有结束的链接在最后一个请求处结束并一起提交
+    size_t Submit();
+    //等待所有已经提交的请求完成，回调已经执行或者已经投递给执行器
+    void   Drain();
+    //已经提交还没有完成的请求数量
+    size_t InFlight() const;
+private:
+    friend class AsyncFile;
+    std::unique_ptr<IoRingImpl> _impl;
+};
+
+//绑定IoRing的文件，每个请求立即提交，通过future获取结果，请求不会和其他线程或者调用者未结束的链接连在一起
+class AsyncFile
+{
+public:
+    AsyncFile(IoRing& ring, FileWrapper&& file);
+    AsyncFile(const AsyncFile&)            = delete;
+    AsyncFile& operator=(const AsyncFile&) = delete;
+
+    std::future<IoRing::Result> Read(void* buffer, size_t size, uint64_t offset);
+    std::future<IoRing::Result> Write(const void* data, size_t size, uint64_t offset);
+    std::future<IoRing::Result> Sync(bool dataOnly = false);
+    //写入和刷新链接在一起提交，写入成功后才刷新，结果是写入的长度或者其中一步的错误
+    std::future<IoRing::Result> WriteAndSync(const void* data, size_t size, uint64_t offset, bool dataOnly = false);
+
+    FileWrapper& File() noexcept { return _file; }
+    IoRing&      Ring() noexcept { return _ring; }
+private:
+    IoRing&     _ring;
+    FileWrapper _file;
+};
+} // namespace zeus
+
+#include "zeus/foundation/core/zeus_compatible.h"
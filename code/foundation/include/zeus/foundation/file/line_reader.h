@@ -0,0 +1,73 @@
+﻿#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+#include "zeus/expected.hpp"
+#include "zeus/foundation/file/file_wrapper.h"
+
+namespace zeus
+{
+struct LineReaderImpl;
+//按大块读取文件并切分行，返回的string_view直接指向内部缓冲区，不为每一行申请内存
+//行的内容不包含分隔符，最后一行没有分隔符时同样返回，和std::getline的结果一致
+//跨越块边界的行会被移动到缓冲区开头拼接完整，超过缓冲区长度的行会扩大缓冲区
+class LineReader
+{
+public:
+    static constexpr size_t kDefaultBlockSize = 256 * 1024;
+    struct Options
+    {
+        char   delimiter           = '\n';
+        //去掉行尾的'\r'，用于读取CRLF换行的文本
+        bool   stripCarriageReturn = false;
+        size_t blockSize           = kDefaultBlockSize;
+    };
+    //文件中按行边界切分出的一段，[offset, offset + length)
+    struct Range
+    {
+        uint64_t offset;
+        uint64_t length;
+    };
+    using Callback        = std::function<bool(std::string_view line)>;
+    //segment是段的序号，同一段内的行按顺序回调
+    using SegmentCallback = std::function<bool(size_t segment, std::string_view line)>;
+public:
+    explicit LineReader(FileWrapper&& file);
+    LineReader(FileWrapper&& file, const Options& options);
+    //只读取文件的一段，range通常来自SplitRanges
+    LineReader(FileWrapper&& file, const Range& range, const Options& options);
+    LineReader(LineReader&& other) noexcept;
+    LineReader& operator=(LineReader&& other) noexcept;
+    LineReader(const LineReader&)            = delete;
+    LineReader& operator=(const LineReader&) = delete;
+    ~LineReader();
+
+    //读取下一行，到达结尾时返回false；line在下一次调用Next之前有效
+    zeus::expected<bool, std::error_code> Next(std::string_view& line);
+    //callback返回false时停止
+    zeus::expected<void, std::error_code> ForEach(const Callback& callback);
+    //已经返回的行数
+    uint64_t                              LineCount() const noexcept;
+
+public:
+    static zeus::expected<LineReader, std::error_code> Open(const std::filesystem::path& path);
+    static zeus::expected<LineReader, std::error_code> Open(const std::filesystem::path& path, const Options& options);
+    //把文件按行边界切分为最多count段，每段的长度大致相同，空文件返回空列表
+    static zeus::expected<std::vector<Range>, std::error_code> SplitRanges(FileWrapper& file, size_t count, char delimiter = '\n');
+    //把文件切分为parallelism段，由多个线程同时逐行处理，callback会被并发调用；任意回调返回false时所有线程尽快停止
+    static zeus::expected<void, std::error_code> ParallelForEach(const std::filesystem::path& path, size_t parallelism, const SegmentCallback& callback);
+    static zeus::expected<void, std::error_code> ParallelForEach(
+        const std::filesystem::path& path, size_t parallelism, const SegmentCallback& callback, const Options& options
+    );
+private:
+    std::unique_ptr<LineReaderImpl> _impl;
+};
+} // namespace zeus
+
+#include "zeus/foundation/core/zeus_compatible.h"
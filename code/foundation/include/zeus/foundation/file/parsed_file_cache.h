@@ -0,0 +1,56 @@
+﻿#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+#include "zeus/expected.hpp"
+
+namespace zeus
+{
+struct ParsedFileCacheImpl;
+//按路径缓存解析后的KV/INI文件，每次查询只stat一次，(设备, inode, 修改时间, 大小)都没有变化时直接使用缓存的结果
+//procfs、sysfs这类伪文件系统的修改时间和大小不反映内容，总是重新读取，但同一次查询多个键时只解析一次
+//解析规则和kv_file_utils.h、ini_file_utils.h中的函数一致，线程安全
+class ParsedFileCache
+{
+public:
+    //文件中的键值，保留文件中的顺序和重复的键
+    using KVTable  = std::vector<std::pair<std::string, std::string>>;
+    //section和其中的键值，重复的section合并到第一次出现的位置
+    using IniTable = std::vector<std::pair<std::string, KVTable>>;
+    using Values   = std::vector<std::optional<std::string>>;
+public:
+    //KV和INI分别最多缓存capacity个文件，超过时淘汰最久没有使用的
+    explicit ParsedFileCache(size_t capacity = 64);
+    ParsedFileCache(const ParsedFileCache&)            = delete;
+    ParsedFileCache& operator=(const ParsedFileCache&) = delete;
+    ~ParsedFileCache();
+
+    //返回的结果是共享的，文件变化后重新解析不会修改已经返回的结果
+    zeus::expected<std::shared_ptr<const KVTable>, std::error_code>  GetKVTable(const std::filesystem::path& path, std::string_view delim = "=");
+    zeus::expected<std::shared_ptr<const IniTable>, std::error_code> GetIniTable(const std::filesystem::path& path);
+
+    //一次解析查询多个键，结果和keys一一对应，值为键第一次出现时的值，不存在的键为空
+    zeus::expected<Values, std::error_code> GetKVValues(
+        const std::filesystem::path& path, const std::vector<std::string_view>& keys, std::string_view delim = "="
+    );
+    zeus::expected<Values, std::error_code> GetIniValues(
+        const std::filesystem::path& path, std::string_view section, const std::vector<std::string_view>& keys
+    );
+
+    void Invalidate(const std::filesystem::path& path);
+    void Clear();
+
+    //进程内共享的缓存
+    static ParsedFileCache& Instance();
+private:
+    std::unique_ptr<ParsedFileCacheImpl> _impl;
+};
+} // namespace zeus
+
+#include "zeus/foundation/core/zeus_compatible.h"
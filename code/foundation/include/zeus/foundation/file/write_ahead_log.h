@@ -0,0 +1,85 @@
+﻿#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <system_error>
+#include "zeus/expected.hpp"
+
+namespace zeus
+{
+struct WriteAheadLogImpl;
+//只追加的预写日志，用于把状态的增量持久化，而不是每次重写整个文件
+//日志由目录下按第一条记录序号命名的多个段文件组成，每条记录带有序号和CRC32校验
+//打开时按顺序校验并回放所有记录，最后一个段结尾写了一半的记录会被截掉，其他位置的损坏返回错误
+//多个线程可以同时Append，等待落盘的写入合并为一次写入和一次fdatasync(组提交)，记录只需要数据和文件长度落盘
+//记录中的整数使用本机字节序，日志不能在字节序不同的机器之间复制
+class WriteAheadLog
+{
+public:
+    enum class SyncMode
+    {
+        //不主动fsync，由操作系统决定写回时机，需要时调用Sync
+        kNone,
+        //Append在记录落盘后返回
+        kAlways,
+        //距离上次fsync超过syncInterval时，下一次写入后fsync
+        kInterval,
+    };
+    //回放记录，sequence从1开始连续递增
+    using RecordCallback = std::function<bool(uint64_t sequence, std::string_view data)>;
+    //段的数量超过compactionSegments时调用，lastSequence是已经写入的最后一条记录
+    //调用者把状态另外保存后返回其中包含的最后一条记录，日志据此删除不再需要的段，返回空时不做处理
+    using CompactionHook = std::function<std::optional<uint64_t>(uint64_t lastSequence)>;
+    struct Options
+    {
+        //段的长度超过segmentSize后，下一次写入创建新的段
+        uint64_t                  segmentSize        = 64 * 1024 * 1024;
+        //创建段时预先分配segmentSize的磁盘空间，不改变文件长度
+        bool                      preallocate        = true;
+        SyncMode                  syncMode           = SyncMode::kAlways;
+        std::chrono::milliseconds syncInterval       = std::chrono::milliseconds(1000);
+        size_t                    compactionSegments = 8;
+        CompactionHook            compactionHook;
+    };
+public:
+    WriteAheadLog(const WriteAheadLog&)            = delete;
+    WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+    WriteAheadLog(WriteAheadLog&& other) noexcept;
+    WriteAheadLog& operator=(WriteAheadLog&& other) noexcept;
+    //关闭前把所有记录落盘
+    ~WriteAheadLog();
+
+    //返回记录的序号，写入或者fsync失败后日志进入错误状态，之后所有的写入都返回同一个错误
+    zeus::expected<uint64_t, std::error_code> Append(std::string_view data);
+    zeus::expected<uint64_t, std::error_code> Append(const void* data, size_t size);
+    //把已经Append的所有记录写入并fsync
+    zeus::expected<void, std::error_code>     Sync();
+    //sequence及之前的记录已经包含在另外保存的状态中，删除只包含这些记录的段，之后打开时不再回放它们
+    zeus::expected<void, std::error_code>     Checkpoint(uint64_t sequence);
+    //最后一条记录的序号，没有记录时为0
+    uint64_t                                  LastSequence() const;
+    //已经fsync的最后一条记录的序号
+    uint64_t                                  DurableSequence() const;
+    uint64_t                                  CheckpointSequence() const;
+    size_t                                    SegmentCount() const;
+
+public:
+    //目录不存在时创建，replay依次收到检查点之后的每一条记录，返回false时停止回放但仍然打开日志
+    static zeus::expected<WriteAheadLog, std::error_code> Open(
+        const std::filesystem::path& directory, const Options& options, const RecordCallback& replay
+    );
+    //只读地遍历sequence之后的记录，不修复损坏的结尾，可以在日志被其他对象打开时使用
+    static zeus::expected<void, std::error_code> Read(const std::filesystem::path& directory, uint64_t sequence, const RecordCallback& callback);
+private:
+    WriteAheadLog();
+private:
+    std::unique_ptr<WriteAheadLogImpl> _impl;
+};
+} // namespace zeus
+
+#include "zeus/foundation/core/zeus_compatible.h"
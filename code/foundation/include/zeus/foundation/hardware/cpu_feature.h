@@ -0,0 +1,59 @@
+﻿#pragma once
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define ZEUS_ARCH_X64 1
+#endif
+#if defined(_M_ARM64) || defined(__aarch64__)
+#define ZEUS_ARCH_ARM64 1
+#endif
+
+//GCC/Clang需要给使用高级指令集的函数单独打上target属性，MSVC则不需要
+#if defined(ZEUS_ARCH_X64) && (defined(__GNUC__) || defined(__clang__))
+#define ZEUS_TARGET_SSSE3           __attribute__((target("ssse3")))
+#define ZEUS_TARGET_SSE42           __attribute__((target("sse4.2")))
+#define ZEUS_TARGET_POPCNT          __attribute__((target("popcnt")))
+#define ZEUS_TARGET_AVX2            __attribute__((target("avx2")))
+#define ZEUS_TARGET_AVX512BW        __attribute__((target("avx512f,avx512bw")))
+#define ZEUS_TARGET_AVX512VPOPCNTDQ __attribute__((target("avx512f,avx512vpopcntdq")))
+#define ZEUS_TARGET_SHA             __attribute__((target("sha,sse4.1")))
+#else
+#define ZEUS_TARGET_SSSE3
+#define ZEUS_TARGET_SSE42
+#define ZEUS_TARGET_POPCNT
+#define ZEUS_TARGET_AVX2
+#define ZEUS_TARGET_AVX512BW
+#define ZEUS_TARGET_AVX512VPOPCNTDQ
+#define ZEUS_TARGET_SHA
+#endif
+
+namespace zeus
+{
+namespace Hardware
+{
+//当前CPU支持的指令集，进程内只检测一次，用于SIMD实现的运行时分发
+struct CpuFeature
+{
+    bool sse2            = false;
+    bool ssse3           = false;
+    bool sse41           = false;
+    bool sse42           = false;
+    bool popcnt          = false;
+    bool lzcnt           = false;
+    bool bmi1            = false;
+    bool bmi2            = false;
+    bool aes             = false;
+    bool pclmulqdq       = false;
+    bool sha             = false;
+    bool avx             = false;
+    bool avx2            = false;
+    bool avx512f         = false;
+    bool avx512bw        = false;
+    bool avx512vpopcntdq = false;
+    bool neon            = false;
+};
+
+const CpuFeature& GetCpuFeature() noexcept;
+} // namespace Hardware
+} // namespace zeus
+
+#include "zeus/foundation/core/zeus_compatible.h"
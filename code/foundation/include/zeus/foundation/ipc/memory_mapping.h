@@ -10,6 +10,28 @@ namespace zeus
 struct MemoryMappingImpl;
 class MemoryMapping
 {
+public:
+    //访问方式的提示，Windows上只支持kWillNeed，其他的忽略
+    enum class Advice
+    {
+        kNormal,
+        kSequential,
+        kRandom,
+        kWillNeed,
+        kDontNeed,
+        //使用透明大页，减少TLB缺失
+        kHugePage,
+    };
+    struct Options
+    {
+        //建立映射时读入所有页，避免第一次访问时逐页缺页(MAP_POPULATE，Windows上使用PrefetchVirtualMemory)
+        bool   populate = false;
+        //映射到大页上，只能用于hugetlbfs上的文件或者以大页创建的共享内存(MAP_HUGETLB/FILE_MAP_LARGE_PAGES)，否则返回错误
+        bool   hugeTlb  = false;
+        //锁定在物理内存中，受RLIMIT_MEMLOCK或者进程工作集大小限制
+        bool   lock     = false;
+        Advice advice   = Advice::kNormal;
+    };
 public:
     MemoryMapping(const MemoryMapping &)            = delete;
     MemoryMapping &operator=(const MemoryMapping &) = delete;
@@ -26,11 +48,18 @@ public:
     uint64_t                              Size() const;
     zeus::expected<void, std::error_code> UnMap();
     zeus::expected<void, std::error_code> Flush();
+    //offset是相对Data()的偏移，length为0表示到映射结尾
+    zeus::expected<void, std::error_code> Advise(Advice advice, uint64_t offset = 0, uint64_t length = 0);
+    zeus::expected<void, std::error_code> Lock();
+    zeus::expected<void, std::error_code> Unlock();
 public:
     static size_t                                         SystemMemoryAlign();
     static zeus::expected<MemoryMapping, std::error_code> Map(
         PlatformMemoryMappingHandle handle, uint64_t size, uint64_t offset = 0, bool readOnly = false
     );
+    static zeus::expected<MemoryMapping, std::error_code> Map(
+        PlatformMemoryMappingHandle handle, uint64_t size, uint64_t offset, bool readOnly, const Options &options
+    );
 protected:
     MemoryMapping();
 private:
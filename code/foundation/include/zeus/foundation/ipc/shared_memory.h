@@ -17,7 +17,14 @@ struct SharedMemoryImpl;
 class SharedMemory
 {
 public:
-
+    struct Options
+    {
+        //以大页创建，映射时可以使用MemoryMapping::Options::hugeTlb，大小向上取整到大页的长度
+        //Linux上在挂载的hugetlbfs中创建，需要预留大页(/proc/sys/vm/nr_hugepages)，映射的偏移需要按大页对齐
+        //Windows上使用SEC_LARGE_PAGES，需要启用SeLockMemoryPrivilege
+        bool hugeTlb = false;
+    };
+public:
     SharedMemory(const SharedMemory&) = delete;
     SharedMemory(SharedMemory&& other) noexcept;
     SharedMemory& operator=(const SharedMemory&) = delete;
@@ -26,6 +33,8 @@ public:
     std::string                                    Name() const;
     uint64_t                                       Size() const;
     zeus::expected<MemoryMapping, std::error_code> Map(uint64_t size, uint64_t offset = 0, bool readOnly = false);
+    //options.hugeTlb只能用于以Options::hugeTlb创建的共享内存，否则返回invalid_argument
+    zeus::expected<MemoryMapping, std::error_code> Map(uint64_t size, uint64_t offset, bool readOnly, const MemoryMapping::Options& options);
 #ifdef _WIN32
     HANDLE Handle() const;
 #endif
@@ -38,8 +47,12 @@ public:
     //linux需遵循文件名规范，不要使用特殊字符
     static zeus::expected<SharedMemory, std::error_code> OpenOrCreate(const std::string& name, uint64_t size, bool readOnly = false);
     static zeus::expected<SharedMemory, std::error_code> Open(const std::string& name, bool readOnly = false);
+    //打开时的options需要和创建时一致，Linux上大页共享内存和普通共享内存在不同的位置
+    static zeus::expected<SharedMemory, std::error_code> OpenOrCreate(const std::string& name, uint64_t size, bool readOnly, const Options& options);
+    static zeus::expected<SharedMemory, std::error_code> Open(const std::string& name, bool readOnly, const Options& options);
 #ifdef __linux__
     static zeus::expected<void, std::error_code> Clear(const std::string& name);
+    static zeus::expected<void, std::error_code> Clear(const std::string& name, const Options& options);
 #endif
 protected:
     SharedMemory();
@@ -0,0 +1,71 @@
+﻿#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace zeus
+{
+//按对齐要求分配的定长缓冲区池，用于直接读写(O_DIRECT/FILE_FLAG_NO_BUFFERING)这类要求缓冲区地址和长度按设备块大小对齐的场景
+//归还的缓冲区缓存起来给下次Acquire复用，避免反复申请和释放大块的对齐内存，线程安全
+//池需要比从它获取的缓冲区活得更久
+class AlignedBufferPool
+{
+public:
+    //独占一块缓冲区，析构时归还给池
+    class Buffer
+    {
+    public:
+        Buffer() noexcept = default;
+        Buffer(Buffer &&other) noexcept;
+        Buffer &operator=(Buffer &&other) noexcept;
+        Buffer(const Buffer &)            = delete;
+        Buffer &operator=(const Buffer &) = delete;
+        ~Buffer();
+
+        void    *Data() const noexcept { return _data; }
+        uint8_t *Bytes() const noexcept { return static_cast<uint8_t *>(_data); }
+        size_t   Size() const noexcept;
+        explicit operator bool() const noexcept { return _data; }
+        //提前归还给池
+        void     Release() noexcept;
+    private:
+        friend class AlignedBufferPool;
+        Buffer(AlignedBufferPool *pool, void *data) noexcept : _pool(pool), _data(data) {}
+    private:
+        AlignedBufferPool *_pool = nullptr;
+        void              *_data = nullptr;
+    };
+public:
+    //bufferSize会向上取整到alignment的整数倍，alignment必须是2的幂，通常使用FileWrapper::DirectIoAlignment的结果
+    //最多缓存maxCached个空闲的缓冲区，超过的直接释放
+    AlignedBufferPool(size_t bufferSize, size_t alignment, size_t maxCached = 16);
+    AlignedBufferPool(const AlignedBufferPool &)            = delete;
+    AlignedBufferPool &operator=(const AlignedBufferPool &) = delete;
+    ~AlignedBufferPool();
+
+    //分配失败时抛出std::bad_alloc
+    Buffer Acquire();
+    //释放所有缓存的空闲缓冲区
+    void   Trim() noexcept;
+
+    size_t BufferSize() const noexcept { return _bufferSize; }
+    size_t Alignment() const noexcept { return _alignment; }
+    size_t CachedCount() const;
+
+    static constexpr size_t AlignUp(size_t value, size_t alignment) noexcept { return (value + alignment - 1) & ~(alignment - 1); }
+    static constexpr size_t AlignDown(size_t value, size_t alignment) noexcept { return value & ~(alignment - 1); }
+private:
+    void Recycle(void *data) noexcept;
+private:
+    const size_t        _alignment;
+    const size_t        _bufferSize;
+    const size_t        _maxCached;
+    mutable std::mutex  _mutex;
+    std::vector<void *> _free;
+};
+} // namespace zeus
+
+#include "zeus/foundation/core/zeus_compatible.h"
@@ -0,0 +1,86 @@
+﻿#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <new>
+
+namespace zeus
+{
+//单调增长的内存区，从块中顺序分配，单次释放不回收(只有最后一次分配可以退回)，Reset时一次性回收
+//块用完后向上游申请新块，块大小按倍数增长，适合单个请求/单次解析内的大量小对象，用完后整体丢弃
+//可以直接作为std::pmr::memory_resource给pmr容器使用，非线程安全
+class MonotonicArena : public std::pmr::memory_resource
+{
+public:
+    static constexpr size_t kDefaultChunkSize = 4096;
+    static constexpr size_t kMaxChunkSize     = 16 * 1024 * 1024;
+public:
+    explicit MonotonicArena(size_t chunkSize = kDefaultChunkSize, std::pmr::memory_resource *upstream = std::pmr::get_default_resource()) noexcept;
+    //先使用外部提供的缓冲区(比如栈上的数组)，用完后再向上游申请，缓冲区需要在Arena生命周期内保持有效
+    MonotonicArena(void *buffer, size_t size, std::pmr::memory_resource *upstream = std::pmr::get_default_resource()) noexcept;
+    MonotonicArena(const MonotonicArena &)            = delete;
+    MonotonicArena &operator=(const MonotonicArena &) = delete;
+    ~MonotonicArena() override;
+
+    //alignment必须是2的幂，size过大时抛出std::bad_alloc
+    void *Allocate(size_t size, size_t alignment = alignof(std::max_align_t))
+    {
+        assert(alignment && !(alignment & (alignment - 1)));
+        const auto current = reinterpret_cast<uintptr_t>(_current);
+        const auto aligned = (current + alignment - 1) & ~(alignment - 1);
+        if (_current && aligned <= reinterpret_cast<uintptr_t>(_end) && size <= reinterpret_cast<uintptr_t>(_end) - aligned)
+        {
+            _current = reinterpret_cast<uint8_t *>(aligned + size);
+            _allocated += aligned + size - current;
+            return reinterpret_cast<void *>(aligned);
+        }
+        return AllocateSlow(size, alignment);
+    }
+    template<typename T>
+    T *Allocate(size_t count = 1)
+    {
+        if (count > std::numeric_limits<size_t>::max() / sizeof(T))
+        {
+            throw std::bad_alloc();
+        }
+        return static_cast<T *>(Allocate(sizeof(T) * count, alignof(T)));
+    }
+    //回收所有分配，保留最大的一个块留给下一轮使用，避免重新向上游申请
+    void Reset() noexcept;
+    //回收所有分配并把所有块还给上游
+    void Release() noexcept;
+
+    //已经分配给调用者的字节数(包含对齐填充)
+    size_t                     BytesAllocated() const noexcept { return _allocated; }
+    //从上游申请的字节数
+    size_t                     BytesReserved() const noexcept { return _reserved; }
+    size_t                     ChunkCount() const noexcept;
+    std::pmr::memory_resource *Upstream() const noexcept { return _upstream; }
+protected:
+    void *do_allocate(size_t bytes, size_t alignment) override;
+    void  do_deallocate(void *pointer, size_t bytes, size_t alignment) override;
+    bool  do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+private:
+    struct Chunk;
+    void *AllocateSlow(size_t size, size_t alignment);
+    void  UseChunk(Chunk *chunk) noexcept;
+    void  FreeChunk(Chunk *chunk) noexcept;
+private:
+    std::pmr::memory_resource *_upstream;
+    Chunk                     *_chunks        = nullptr;
+    Chunk                     *_spare         = nullptr;
+    uint8_t                   *_initialBuffer = nullptr;
+    size_t                     _initialSize   = 0;
+    size_t                     _firstSize     = kDefaultChunkSize;
+    size_t                     _nextSize      = kDefaultChunkSize;
+    uint8_t                   *_current       = nullptr;
+    uint8_t                   *_end           = nullptr;
+    size_t                     _allocated     = 0;
+    size_t                     _reserved      = 0;
+};
+} // namespace zeus
+
+#include "zeus/foundation/core/zeus_compatible.h"
@@ -0,0 +1,73 @@
+﻿#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace zeus
+{
+//按大小分级的内存池，16到4096字节按2的幂分级，每级是一个空闲链表
+//分配和释放只操作当前线程自己的缓存，不需要加锁；某个线程缓存的空闲块过多时整批归还到无锁的共享链表，其他线程缓存为空时整批取走
+//所以生产者分配、消费者释放的跨线程场景也能复用内存
+//释放不加锁也不分配内存，当前线程还没有这个池的缓存时直接把块归还到共享链表
+//线程退出时缓存中的空闲块全部归还到共享链表，缓存留给之后的线程使用
+//超过kMaxBlockSize或者对齐要求更高的分配直接转给上游，池中的块在PoolResource析构时一次性还给上游
+class PoolResource : public std::pmr::memory_resource
+{
+public:
+    static constexpr size_t kMinBlockSize = 16;
+    static constexpr size_t kMaxBlockSize = 4096;
+    static constexpr size_t kClassCount   = 9;
+    static constexpr size_t kSlabSize     = 64 * 1024;
+public:
+    explicit PoolResource(std::pmr::memory_resource *upstream = std::pmr::get_default_resource());
+    PoolResource(const PoolResource &)            = delete;
+    PoolResource &operator=(const PoolResource &) = delete;
+    ~PoolResource() override;
+
+    void *Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+    void  Deallocate(void *pointer, size_t size, size_t alignment = alignof(std::max_align_t)) noexcept;
+    //size和alignment对应的块大小，不由池管理时返回0
+    static size_t BlockSize(size_t size, size_t alignment = alignof(std::max_align_t)) noexcept;
+
+    //池从上游申请的字节数，不包含直接转给上游的大块
+    size_t                     BytesReserved() const noexcept { return _reserved.load(std::memory_order_relaxed); }
+    std::pmr::memory_resource *Upstream() const noexcept { return _upstream; }
+protected:
+    void *do_allocate(size_t bytes, size_t alignment) override;
+    void  do_deallocate(void *pointer, size_t bytes, size_t alignment) override;
+    bool  do_is_equal(const std::pmr::memory_resource &other) const noexcept override;
+private:
+    struct Node;
+    struct ThreadCache;
+    struct ThreadCaches;
+    struct Slab
+    {
+        void  *data;
+        size_t alignment;
+    };
+    static ThreadCaches &LocalCaches() noexcept;
+    ThreadCache         *FindCache() noexcept;
+    ThreadCache         &LocalCache();
+    void         Refill(ThreadCache &cache, size_t index);
+    void         Spill(ThreadCache &cache, size_t index) noexcept;
+    void         PushShared(size_t index, Node *first, Node *last) noexcept;
+    void         ReleaseCache(std::thread::id owner) noexcept;
+private:
+    std::pmr::memory_resource                   *_upstream;
+    const uint64_t                               _id;
+    std::array<std::atomic<Node *>, kClassCount> _shared;
+    std::atomic<size_t>                          _reserved = 0;
+    std::mutex                                   _mutex;
+    std::vector<std::unique_ptr<ThreadCache>>    _caches;
+    std::vector<Slab>                            _slabs;
+};
+} // namespace zeus
+
+#include "zeus/foundation/core/zeus_compatible.h"
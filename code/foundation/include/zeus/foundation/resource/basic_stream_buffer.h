@@ -20,9 +20,12 @@ public:
     BasicStreamBuffer& operator=(const BasicStreamBuffer&) = delete;
     BasicStreamBuffer& operator=(BasicStreamBuffer&&)      = delete;
 protected:
-    int_type overflow(int_type c) override;
-    int_type underflow() override;
-    int      sync() override;
+    int_type        overflow(int_type c) override;
+    int_type        underflow() override;
+    int             sync() override;
+    //批量读写，超过缓冲区的部分直接读写设备，不经过缓冲区复制
+    std::streamsize xsgetn(char_type* s, std::streamsize count) override;
+    std::streamsize xsputn(const char_type* s, std::streamsize count) override;
 
     virtual int WriteDevice(const char_type* buffer, std::size_t length);
     virtual int ReadDevice(char_type* buffer, std::size_t length);
@@ -3,14 +3,21 @@
 #include <filesystem>
 #include <string>
 #include <cstdint>
+#include <functional>
 #include <zeus/expected.hpp>
 #include "zeus/foundation/core/platform_def.h"
+#include "zeus/foundation/ipc/memory_mapping.h"
 
 namespace zeus
 {
 struct FileMappingImpl;
 class FileMapping
 {
+public:
+    //64位进程默认每个窗口映射1GB，32位进程地址空间有限，使用64MB
+    static constexpr uint64_t kDefaultWindowSize = sizeof(void*) >= 8 ? 1024ULL * 1024 * 1024 : 64ULL * 1024 * 1024;
+    //offset是窗口在文件中的偏移，返回false时停止
+    using WindowCallback                         = std::function<bool(uint64_t offset, void* data, uint64_t size)>;
 public:
     FileMapping(const FileMapping&)            = delete;
     FileMapping& operator=(const FileMapping&) = delete;
@@ -19,6 +26,18 @@ public:
     ~FileMapping();
     zeus::expected<void, std::error_code> Map(uint64_t offset, uint64_t length);
     zeus::expected<void, std::error_code> MapAll(uint64_t offset = 0);
+    zeus::expected<void, std::error_code> Map(uint64_t offset, uint64_t length, const MemoryMapping::Options& options);
+    zeus::expected<void, std::error_code> MapAll(uint64_t offset, const MemoryMapping::Options& options);
+    //offset是相对Data()的偏移，length为0表示到映射结尾
+    zeus::expected<void, std::error_code> Advise(MemoryMapping::Advice advice, uint64_t offset = 0, uint64_t length = 0);
+    //按窗口依次映射整个文件，同一时间只占用windowSize的地址空间，用于处理超过地址空间预算的大文件
+    //相邻窗口重叠overlap字节，跨越窗口边界且不超过overlap的记录可以在一个窗口中完整访问，overlap必须小于windowSize
+    //每个窗口使用options映射，windowSize为0时使用kDefaultWindowSize，结束后解除映射
+    zeus::expected<void, std::error_code> ForEachWindow(
+        uint64_t windowSize, uint64_t overlap, const MemoryMapping::Options& options, const WindowCallback& callback
+    );
+    //当前映射在文件中的偏移
+    uint64_t                              Offset() const;
     bool                                  Empty() const;
     void*                                 Data() const;
     uint64_t                              Size() const;
@@ -1,5 +1,8 @@
 ﻿#pragma once
+#include <cstdint>
 #include <streambuf>
+#include <system_error>
+#include "zeus/expected.hpp"
 #include "zeus/foundation/resource/basic_stream_buffer.h"
 #include "zeus/foundation/core/platform_def.h"
 
@@ -8,14 +11,36 @@ namespace zeus
 struct PipeStreamBufferImpl;
 class PipeStreamBuffer : public BasicStreamBuffer
 {
+public:
+    //缓冲区的长度和管道的容量一致，一次读写可以处理管道中的全部数据
+    static constexpr size_t kAutoBufferSize    = 0;
+    //无法查询管道容量时使用的长度
+    static constexpr size_t kDefaultBufferSize = 64 * 1024;
 public:
     //PipeStreamBuffer 并不管理pipe的生命周期，调用者应保证pipe的生命周期大于PipeStreamBuffer
-    PipeStreamBuffer(PlatformFileHandle pipe, BasicStreamBuffer::BufferMode mode, size_t bufferSize = 4096);
+    PipeStreamBuffer(PlatformFileHandle pipe, BasicStreamBuffer::BufferMode mode, size_t bufferSize = kAutoBufferSize);
     ~PipeStreamBuffer();
     PipeStreamBuffer(const PipeStreamBuffer&)            = delete;
     PipeStreamBuffer(PipeStreamBuffer&& other)           = delete;
     PipeStreamBuffer& operator=(const PipeStreamBuffer&) = delete;
     PipeStreamBuffer& operator=(PipeStreamBuffer&&)      = delete;
+
+    PlatformFileHandle                        Handle() const noexcept;
+    //把管道中剩余的数据全部转移到out直到管道关闭，返回转移的长度，包括已经读入缓冲区的数据
+    //Linux上使用splice在内核中直接转移到文件或者socket，不复制到用户态，out不支持splice时(比如以O_APPEND打开的文件)改为读写
+    zeus::expected<uint64_t, std::error_code> TransferTo(PlatformFileHandle out);
+public:
+    //管道的容量，Windows上为创建时指定的缓冲区长度
+    static zeus::expected<size_t, std::error_code> PipeCapacity(PlatformFileHandle pipe);
+#ifdef __linux__
+    //调整管道的容量(F_SETPIPE_SZ)，非特权进程不能超过/proc/sys/fs/pipe-max-size，返回调整后的容量
+    //子进程输出大量数据时加大容量可以减少子进程阻塞和唤醒的次数
+    static zeus::expected<size_t, std::error_code> SetPipeCapacity(int pipe, size_t size);
+    //在内核中从in移动最多length字节到out，in和out至少有一个是管道，返回0表示in已经没有数据
+    static zeus::expected<size_t, std::error_code> Splice(int in, int out, size_t length);
+    //复制管道in中最多length字节到管道out，不消耗in中的数据，用于同时把输出交给多个目标
+    static zeus::expected<size_t, std::error_code> Tee(int in, int out, size_t length);
+#endif
 protected:
     int WriteDevice(const char_type* buffer, std::size_t length) override;
     int ReadDevice(char_type* buffer, std::size_t length) override;
@@ -23,6 +23,8 @@ enum class SerializerError
     kCryptFileSizeUnsatisfied,
     kCryptEncryptError,
     kCryptDecryptError,
+
+    kDataFormatError,
 };
 
 class Serializer
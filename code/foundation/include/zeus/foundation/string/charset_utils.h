@@ -2,14 +2,38 @@
 #include <string>
 #include <optional>
 #include <string_view>
+#include "zeus/expected.hpp"
 namespace zeus
 {
 class CharsetUtils
 {
 public:
+    struct TranscodeError
+    {
+        size_t offset; //第一个非法编码单元在输入中的位置
+    };
+public:
+    //不统计\0，非法的UTF-8返回空
     static std::optional<size_t> UTF8CharPrintCount(std::string_view data);
+    //非法输入抛出std::range_error
     static std::string           UnicodeToUTF8(std::wstring_view source);
     static std::wstring          UTF8ToUnicode(std::string_view source);
+
+    //以下接口直接读写调用者提供的缓冲区，没有堆分配，CPU支持时使用SIMD加速
+    //过长编码、代理区码点、超过U+10FFFF的码点以及截断的序列都视为非法
+    static bool                                   IsValidUTF8(std::string_view data) noexcept;
+    //校验并统计码点数
+    static zeus::expected<size_t, TranscodeError> UTF8CodePointCount(std::string_view data) noexcept;
+    //转码后的精确长度(编码单元数)，输入需要是合法的，输入非法时结果不小于转码出错前实际写入的长度
+    static size_t                                 UTF16LengthFromUTF8(std::string_view data) noexcept;
+    static size_t                                 UTF32LengthFromUTF8(std::string_view data) noexcept;
+    static size_t                                 UTF8LengthFromUTF16(std::u16string_view data) noexcept;
+    static size_t                                 UTF8LengthFromUTF32(std::u32string_view data) noexcept;
+    //output至少需要上面对应的Length函数计算出的长度，返回写入的编码单元数
+    static zeus::expected<size_t, TranscodeError> UTF8ToUTF16(std::string_view source, char16_t *output) noexcept;
+    static zeus::expected<size_t, TranscodeError> UTF8ToUTF32(std::string_view source, char32_t *output) noexcept;
+    static zeus::expected<size_t, TranscodeError> UTF16ToUTF8(std::u16string_view source, char *output) noexcept;
+    static zeus::expected<size_t, TranscodeError> UTF32ToUTF8(std::u32string_view source, char *output) noexcept;
 #ifdef _WIN32
     static std::string  UnicodeToANSI(std::wstring_view source);
     static std::wstring ANSIToUnicode(std::string_view source);
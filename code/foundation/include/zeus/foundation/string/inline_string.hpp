@@ -0,0 +1,149 @@
+﻿#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace zeus
+{
+//固定容量的字符串，字符保存在对象内部，不分配内存，N是最多能保存的字符数(不含结尾的0)
+//构造时超出容量的部分被截断，Assign/Append超出容量时返回false并且不修改内容
+template<size_t N, typename CharType = char>
+class BasicInlineString
+{
+public:
+    using value_type     = CharType;
+    using size_type      = size_t;
+    using view_type      = std::basic_string_view<CharType>;
+    using iterator       = CharType *;
+    using const_iterator = const CharType *;
+    static constexpr size_t npos      = view_type::npos;
+    static constexpr size_t kCapacity = N;
+public:
+    constexpr BasicInlineString() noexcept = default;
+    constexpr explicit BasicInlineString(view_type value) noexcept { Copy(value.data(), value.size() < N ? value.size() : N); }
+    constexpr explicit BasicInlineString(const CharType *value) noexcept : BasicInlineString(view_type(value)) {}
+    explicit BasicInlineString(const std::basic_string<CharType> &value) noexcept : BasicInlineString(view_type(value)) {}
+
+    constexpr bool Assign(view_type value) noexcept
+    {
+        if (value.size() > N)
+        {
+            return false;
+        }
+        Copy(value.data(), value.size());
+        return true;
+    }
+    constexpr bool Append(view_type value) noexcept
+    {
+        if (value.size() > N - _size)
+        {
+            return false;
+        }
+        for (size_t index = 0; index < value.size(); ++index)
+        {
+            _data[_size + index] = value[index];
+        }
+        _size        = static_cast<SizeType>(_size + value.size());
+        _data[_size] = CharType();
+        return true;
+    }
+    constexpr bool Append(CharType value) noexcept { return Append(view_type(&value, 1)); }
+    constexpr bool push_back(CharType value) noexcept { return Append(value); }
+    constexpr void pop_back() noexcept
+    {
+        assert(_size);
+        _data[--_size] = CharType();
+    }
+    //超出容量时返回false
+    constexpr bool resize(size_t size, CharType value = CharType()) noexcept
+    {
+        if (size > N)
+        {
+            return false;
+        }
+        for (size_t index = _size; index < size; ++index)
+        {
+            _data[index] = value;
+        }
+        _size        = static_cast<SizeType>(size);
+        _data[_size] = CharType();
+        return true;
+    }
+    constexpr void clear() noexcept
+    {
+        _size    = 0;
+        _data[0] = CharType();
+    }
+
+    constexpr size_t          size() const noexcept { return _size; }
+    constexpr size_t          length() const noexcept { return _size; }
+    static constexpr size_t   capacity() noexcept { return N; }
+    constexpr bool            empty() const noexcept { return !_size; }
+    constexpr bool            full() const noexcept { return N == _size; }
+    constexpr const CharType *data() const noexcept { return _data; }
+    constexpr CharType       *data() noexcept { return _data; }
+    constexpr const CharType *c_str() const noexcept { return _data; }
+    constexpr const CharType &operator[](size_t index) const noexcept
+    {
+        assert(index < _size);
+        return _data[index];
+    }
+    constexpr CharType &operator[](size_t index) noexcept
+    {
+        assert(index < _size);
+        return _data[index];
+    }
+    constexpr const_iterator begin() const noexcept { return _data; }
+    constexpr const_iterator end() const noexcept { return _data + _size; }
+    constexpr iterator       begin() noexcept { return _data; }
+    constexpr iterator       end() noexcept { return _data + _size; }
+
+    constexpr view_type         View() const noexcept { return {_data, _size}; }
+    constexpr                   operator view_type() const noexcept { return View(); }
+    std::basic_string<CharType> ToString() const { return std::basic_string<CharType>(_data, _size); }
+
+    friend constexpr bool operator==(const BasicInlineString &lhs, const BasicInlineString &rhs) noexcept { return lhs.View() == rhs.View(); }
+    friend constexpr bool operator==(const BasicInlineString &lhs, view_type rhs) noexcept { return lhs.View() == rhs; }
+    friend constexpr bool operator==(view_type lhs, const BasicInlineString &rhs) noexcept { return lhs == rhs.View(); }
+    friend constexpr bool operator!=(const BasicInlineString &lhs, const BasicInlineString &rhs) noexcept { return lhs.View() != rhs.View(); }
+    friend constexpr bool operator!=(const BasicInlineString &lhs, view_type rhs) noexcept { return lhs.View() != rhs; }
+    friend constexpr bool operator!=(view_type lhs, const BasicInlineString &rhs) noexcept { return lhs != rhs.View(); }
+    friend constexpr bool operator<(const BasicInlineString &lhs, const BasicInlineString &rhs) noexcept { return lhs.View() < rhs.View(); }
+private:
+    //长度字段按容量选择最小的类型
+    using SizeType = std::conditional_t<N <= UINT8_MAX, uint8_t, std::conditional_t<N <= UINT16_MAX, uint16_t, size_t>>;
+    constexpr void Copy(const CharType *value, size_t size) noexcept
+    {
+        for (size_t index = 0; index < size; ++index)
+        {
+            _data[index] = value[index];
+        }
+        _size        = static_cast<SizeType>(size);
+        _data[_size] = CharType();
+    }
+private:
+    CharType _data[N + 1] = {};
+    SizeType _size        = 0;
+};
+
+template<size_t N>
+using InlineString = BasicInlineString<N, char>;
+template<size_t N>
+using InlineWString = BasicInlineString<N, wchar_t>;
+} // namespace zeus
+
+namespace std
+{
+template<size_t N, typename CharType>
+struct hash<zeus::BasicInlineString<N, CharType>>
+{
+    size_t operator()(const zeus::BasicInlineString<N, CharType> &value) const noexcept { return hash<basic_string_view<CharType>>()(value.View()); }
+};
+} // namespace std
+
+#include "zeus/foundation/core/zeus_compatible.h"
@@ -0,0 +1,229 @@
+﻿#pragma once
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+
+namespace zeus
+{
+struct SplitOptions
+{
+    bool   keepEmpty = false;                              //是否保留空字段，不保留时连续的分隔符视为一个
+    size_t maxSplit  = std::numeric_limits<size_t>::max(); //最多分割次数，达到后剩余部分整体作为最后一个字段
+};
+
+//惰性分割的前向迭代器，字段直接引用原字符串，没有堆分配
+//Range需要提供Find(view, delimLength)查找下一个分隔符和SkipDelimiters(view)跳过开头的分隔符
+//迭代器引用Range对象，Range对象需要比迭代器活得久
+template<typename Range, typename CharType>
+class BasicSplitIterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = std::basic_string_view<CharType>;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = const value_type *;
+    using reference         = const value_type &;
+public:
+    BasicSplitIterator() = default;
+    BasicSplitIterator(const Range *range, value_type data) : _range(range), _rest(data), _end(false) { Advance(); }
+    reference           operator*() const { return _current; }
+    pointer             operator->() const { return &_current; }
+    BasicSplitIterator &operator++()
+    {
+        Advance();
+        return *this;
+    }
+    BasicSplitIterator operator++(int)
+    {
+        auto temp = *this;
+        Advance();
+        return temp;
+    }
+    bool operator==(const BasicSplitIterator &other) const
+    {
+        if (_end || other._end)
+        {
+            return _end == other._end;
+        }
+        return _current.data() == other._current.data() && _current.size() == other._current.size() && _last == other._last;
+    }
+    bool operator!=(const BasicSplitIterator &other) const { return !(*this == other); }
+    //还没有分割的剩余部分
+    value_type Rest() const { return _last ? value_type() : _rest; }
+private:
+    void Advance()
+    {
+        const auto &options = _range->Options();
+        for (;;)
+        {
+            if (_last)
+            {
+                _end = true;
+                return;
+            }
+            if (!options.keepEmpty)
+            {
+                _range->SkipDelimiters(_rest);
+            }
+            size_t     delimLength = 0;
+            const auto position    = _splits < options.maxSplit ? _range->Find(_rest, delimLength) : value_type::npos;
+            if (value_type::npos == position)
+            {
+                _current = _rest;
+                _last    = true;
+            }
+            else
+            {
+                _current = _rest.substr(0, position);
+                _rest.remove_prefix(position + delimLength);
+                ++_splits;
+            }
+            if (options.keepEmpty || !_current.empty())
+            {
+                return;
+            }
+        }
+    }
+private:
+    const Range *_range = nullptr;
+    value_type   _rest;
+    value_type   _current;
+    size_t       _splits = 0;
+    bool         _last   = false;
+    bool         _end    = true;
+};
+
+//按分隔字符串分割，单字符分隔符使用memchr/wmemchr查找，多字符分隔符先查找首字符再比较剩余部分
+template<typename CharType>
+class BasicSplitter
+{
+public:
+    using Traits   = std::char_traits<CharType>;
+    using View     = std::basic_string_view<CharType>;
+    using Iterator = BasicSplitIterator<BasicSplitter, CharType>;
+public:
+    //data和delim只保存引用，需要在使用期间保持有效；delim为空时不分割
+    BasicSplitter(View data, View delim, const SplitOptions &options = {}) : _data(data), _delim(delim), _options(options) {}
+    Iterator            begin() const { return Iterator(this, _data); }
+    Iterator            end() const { return Iterator(); }
+    const SplitOptions &Options() const { return _options; }
+
+    size_t Find(View data, size_t &delimLength) const
+    {
+        delimLength = _delim.size();
+        if (_delim.empty() || data.size() < _delim.size())
+        {
+            return View::npos;
+        }
+        const CharType *begin = data.data();
+        const CharType *last  = begin + (data.size() - _delim.size());
+        for (const CharType *current = begin; current <= last; ++current)
+        {
+            current = Traits::find(current, static_cast<size_t>(last - current) + 1, _delim.front());
+            if (!current)
+            {
+                break;
+            }
+            if (0 == Traits::compare(current + 1, _delim.data() + 1, _delim.size() - 1))
+            {
+                return static_cast<size_t>(current - begin);
+            }
+        }
+        return View::npos;
+    }
+    void SkipDelimiters(View &data) const
+    {
+        if (_delim.empty())
+        {
+            return;
+        }
+        while (data.size() >= _delim.size() && 0 == Traits::compare(data.data(), _delim.data(), _delim.size()))
+        {
+            data.remove_prefix(_delim.size());
+        }
+    }
+private:
+    View         _data;
+    View         _delim;
+    SplitOptions _options;
+};
+
+//按分隔字符集合中的任意一个字符分割，例如按空白字符切分/proc下的文件，ASCII范围内的分隔字符使用查表判断
+template<typename CharType>
+class BasicTokenizer
+{
+public:
+    using Traits   = std::char_traits<CharType>;
+    using View     = std::basic_string_view<CharType>;
+    using Iterator = BasicSplitIterator<BasicTokenizer, CharType>;
+public:
+    BasicTokenizer(View data, View delimiters, const SplitOptions &options = {}) : _data(data), _delimiters(delimiters), _options(options)
+    {
+        for (const auto item : delimiters)
+        {
+            const auto value = static_cast<std::make_unsigned_t<CharType>>(item);
+            if (value < _table.size())
+            {
+                _table[value] = true;
+            }
+            else
+            {
+                _wide = true;
+            }
+        }
+    }
+    Iterator            begin() const { return Iterator(this, _data); }
+    Iterator            end() const { return Iterator(); }
+    const SplitOptions &Options() const { return _options; }
+
+    bool IsDelimiter(CharType character) const
+    {
+        const auto value = static_cast<std::make_unsigned_t<CharType>>(character);
+        if (value < _table.size())
+        {
+            return _table[value];
+        }
+        return _wide && View::npos != _delimiters.find(character);
+    }
+    size_t Find(View data, size_t &delimLength) const
+    {
+        delimLength = 1;
+        for (size_t index = 0; index < data.size(); ++index)
+        {
+            if (IsDelimiter(data[index]))
+            {
+                return index;
+            }
+        }
+        return View::npos;
+    }
+    void SkipDelimiters(View &data) const
+    {
+        size_t index = 0;
+        while (index < data.size() && IsDelimiter(data[index]))
+        {
+            ++index;
+        }
+        data.remove_prefix(index);
+    }
+private:
+    View                  _data;
+    View                  _delimiters;
+    SplitOptions          _options;
+    std::array<bool, 256> _table = {};
+    bool                  _wide  = false;
+};
+
+using Splitter       = BasicSplitter<char>;
+using WSplitter      = BasicSplitter<wchar_t>;
+using SplitIterator  = Splitter::Iterator;
+using WSplitIterator = WSplitter::Iterator;
+using Tokenizer      = BasicTokenizer<char>;
+using WTokenizer     = BasicTokenizer<wchar_t>;
+} // namespace zeus
+
+#include "zeus/foundation/core/zeus_compatible.h"
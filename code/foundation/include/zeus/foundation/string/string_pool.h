@@ -0,0 +1,55 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace zeus
+{
+//字符串池，字符串拷贝到按块分配的内存中，返回的string_view以0结尾，在Clear或者池销毁之前一直有效
+//Store总是拷贝一份，Intern对相同内容只保存一份，用于把大量短字符串的分配合并成少数几次块分配
+//不是线程安全的
+class StringPool
+{
+public:
+    explicit StringPool(size_t blockSize = 4096);
+    ~StringPool();
+    StringPool(const StringPool&)            = delete;
+    StringPool& operator=(const StringPool&) = delete;
+    StringPool(StringPool&& other) noexcept;
+    StringPool& operator=(StringPool&& other) noexcept;
+
+    std::string_view                Store(std::string_view value);
+    std::string_view                Intern(std::string_view value);
+    //已经Intern的字符串，不存在时返回空
+    std::optional<std::string_view> Find(std::string_view value) const;
+
+    size_t InternedCount() const noexcept { return _interned.size(); }
+    //已经保存的字节数，包括结尾的0
+    size_t BytesUsed() const noexcept { return _used; }
+    //已经分配的块的总字节数
+    size_t BytesReserved() const noexcept { return _reserved; }
+    //释放除第一个块以外的所有块，第一个块留作复用，之前返回的string_view全部失效
+    void   Clear() noexcept;
+private:
+    char* Allocate(size_t size);
+private:
+    struct Block
+    {
+        std::unique_ptr<char[]> data;
+        size_t                  size = 0;
+    };
+    std::vector<Block>                   _blocks;
+    std::unordered_set<std::string_view> _interned;
+    char*                                _cursor    = nullptr;
+    size_t                               _remaining = 0;
+    size_t                               _blockSize;
+    size_t                               _used     = 0;
+    size_t                               _reserved = 0;
+};
+} // namespace zeus
+
+#include "zeus/foundation/core/zeus_compatible.h"
@@ -7,9 +7,12 @@
 #include <string>
 #include <vector>
 #include <string_view>
+#include "zeus/foundation/container/small_vector.hpp"
 
 namespace zeus
 {
+class ByteSearcher;
+class ByteMultiSearcher;
 
 bool              IsNumber(std::string_view str);
 bool              IsNumber(std::wstring_view str);
@@ -27,6 +30,7 @@ std::wstring TrimBegin(std::wstring_view str);
 std::wstring TrimEnd(std::wstring_view str);
 std::wstring Trim(std::wstring_view str);
 
+//char版本只比较ASCII字母的大小写，其余字节按无符号值比较(与strcasecmp一致)；wchar_t版本非ASCII字符按当前locale的towlower比较
 int  Icompare(std::string_view str1, std::string_view str2);
 int  Icompare(std::wstring_view str1, std::wstring_view str2);
 bool IEqual(std::string_view str1, std::string_view str2);
@@ -49,6 +53,9 @@ std::wstring JoinView(const std::vector<std::wstring_view>& strs, std::wstring_v
 
 std::string  Replace(std::string_view src, std::string_view substr, std::string_view replacement);
 std::wstring Replace(std::wstring_view src, std::wstring_view substr, std::wstring_view replacement);
+//使用预编译的查找器，replacements[i]替换patterns中下标为i的模式，所有模式在一次扫描中完成替换
+std::string Replace(std::string_view src, const ByteSearcher& substr, std::string_view replacement);
+std::string Replace(std::string_view src, const ByteMultiSearcher& patterns, const std::vector<std::string_view>& replacements);
 
 bool EndWith(std::string_view str, std::string_view end);
 bool EndWith(std::wstring_view str, std::wstring_view end);
@@ -66,6 +73,13 @@ void ToLower(std::wstring& str);
 void ToUpper(std::string& str);
 void ToUpper(std::wstring& str);
 
+//把size个字符转换后写入output，input和output可以是同一块内存
+//char版本只转换ASCII字母，UTF-8多字节字符原样保留；wchar_t版本非ASCII字符使用当前locale的towlower/towupper
+void ToLower(const char* input, size_t size, char* output);
+void ToLower(const wchar_t* input, size_t size, wchar_t* output);
+void ToUpper(const char* input, size_t size, char* output);
+void ToUpper(const wchar_t* input, size_t size, wchar_t* output);
+
 std::string BytesToHexString(const void* input, size_t length, bool upCase);
 
 std::string IntToHexString(uint32_t integer, bool upCase = true);
@@ -80,6 +94,27 @@ std::string ExpandVariableString(
 
 std::vector<std::string>  SplitMultiString(const void* data, size_t length);
 std::vector<std::wstring> SplitMultiWString(const void* data, size_t length);
+//结果引用data，不拷贝字符串，字段不超过N个时不分配内存
+template<typename CharType, size_t N>
+void SplitMultiString(const void* data, size_t length, SmallVector<std::basic_string_view<CharType>, N>& result)
+{
+    result.clear();
+    std::basic_string_view<CharType> rest(static_cast<const CharType*>(data), length / sizeof(CharType));
+    while (!rest.empty())
+    {
+        const auto end  = rest.find(CharType());
+        const auto item = rest.substr(0, end);
+        if (!item.empty())
+        {
+            result.emplace_back(item);
+        }
+        if (std::basic_string_view<CharType>::npos == end)
+        {
+            break;
+        }
+        rest.remove_prefix(end + 1);
+    }
+}
 
 std::string Unquote(std::string_view str);
 
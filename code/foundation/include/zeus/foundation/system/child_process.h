@@ -19,6 +19,7 @@
 namespace zeus
 {
 
+class PipeStreamBuffer;
 struct ChildProcessImpl;
 class ChildProcess
 {
@@ -51,6 +52,9 @@ public:
     std::istream& GetStdout();
     std::istream& GetStderr();
     std::ostream& GetStdin();
+    //输出流使用的缓冲区，可以通过PipeStreamBuffer::TransferTo把大量输出直接转移到文件或socket
+    PipeStreamBuffer& GetStdoutBuffer();
+    PipeStreamBuffer& GetStderrBuffer();
 #ifdef _WIN32
 #endif
 private:
@@ -6,6 +6,7 @@
 #include <chrono>
 #include <optional>
 #include <filesystem>
+#include <functional>
 #include <vector>
 #include <string_view>
 #include <system_error>
@@ -13,6 +14,8 @@
 #include <sys/types.h>
 #endif
 #include <zeus/expected.hpp>
+#include "zeus/foundation/container/small_vector.hpp"
+#include "zeus/foundation/string/string_pool.h"
 #ifdef _WIN32
 #include "zeus/foundation/system/win/session.h"
 #endif
@@ -66,6 +69,17 @@ public:
     static zeus::expected<std::filesystem::path, std::error_code>    GetProcessExePath(const PID& pid);
     static zeus::expected<std::string, std::error_code>              GetProcessExePathString(const PID& pid);
     static zeus::expected<std::vector<std::string>, std::error_code> GetProcessCmdlineArguments(const PID& pid);
+    //参数保存在pool中，返回的string_view在pool有效期间可用
+    static zeus::expected<void, std::error_code> ForEachProcessCmdlineArgument(
+        const PID& pid, StringPool& pool, const std::function<void(std::string_view argument)>& visitor
+    );
+    //参数不超过N个时arguments不分配内存
+    template<size_t N>
+    static zeus::expected<void, std::error_code> GetProcessCmdlineArguments(const PID& pid, StringPool& pool, SmallVector<std::string_view, N>& arguments)
+    {
+        arguments.clear();
+        return ForEachProcessCmdlineArgument(pid, pool, [&arguments](std::string_view argument) { arguments.emplace_back(argument); });
+    }
 #ifdef __linux__
     static zeus::expected<bool, std::error_code>                                  IsProcessZombie(const PID& pid);
     static zeus::expected<std::map<std::string, std::string>, std::error_code>    GetProcessEnvironmentVariable(const PID& pid);
@@ -1,63 +1,159 @@
 ﻿#include "zeus/foundation/byte/byte_order.h"
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic) 没有c++20，没有std::span可用
+#include <array>
+#include "zeus/foundation/hardware/cpu_feature.h"
+#ifdef ZEUS_ARCH_X64
+#include <immintrin.h>
+#endif
+#ifdef ZEUS_ARCH_ARM64
+#include <arm_neon.h>
+#endif
 
-uint16_t zeus::FlipBytes(const uint16_t& value)
+namespace zeus
 {
-    return ((value >> 8) & 0x00FF) | ((value << 8) & 0xFF00);
-}
-
-uint32_t zeus::FlipBytes(const uint32_t& value)
-{
-    return ((value >> 24) & 0x000000FF) | ((value >> 8) & 0x0000FF00) | ((value << 8) & 0x00FF0000) | ((value << 24) & 0xFF000000);
-}
-
-uint64_t zeus::FlipBytes(const uint64_t& value)
+namespace
 {
-    uint32_t hi = uint32_t(value >> 32);
-    uint32_t lo = uint32_t(value & 0xFFFFFFFF);
-    return uint64_t(FlipBytes(hi)) | (uint64_t(FlipBytes(lo)) << 32);
-}
-
-int16_t zeus::FlipBytes(const int16_t& value)
-{
-    return FlipBytes(uint16_t(value));
-}
+using FlipFunction = void (*)(const uint8_t* source, uint8_t* destination, size_t count);
 
-int32_t zeus::FlipBytes(const int32_t& value)
+template<typename T>
+void FlipScalar(const uint8_t* source, uint8_t* destination, size_t count)
 {
-    return FlipBytes(uint32_t(value));
+    for (size_t index = 0; index < count; ++index)
+    {
+        T value;
+        std::memcpy(&value, source + index * sizeof(T), sizeof(T));
+        value = FlipBytes(value);
+        std::memcpy(destination + index * sizeof(T), &value, sizeof(T));
+    }
 }
 
-int64_t zeus::FlipBytes(const int64_t& value)
+#ifdef ZEUS_ARCH_X64
+//16字节内每个宽度为Width的值的字节逆序
+template<size_t Width>
+constexpr std::array<int8_t, 16> ShuffleMask()
 {
-    return FlipBytes(uint64_t(value));
+    std::array<int8_t, 16> mask {};
+    for (size_t index = 0; index < 16; ++index)
+    {
+        mask[index] = static_cast<int8_t>(index / Width * Width + (Width - 1 - index % Width));
+    }
+    return mask;
 }
 
-uint16_t zeus::FlipBytes(const uint16_t* value)
+template<typename T>
+ZEUS_TARGET_SSSE3 void FlipSsse3(const uint8_t* source, uint8_t* destination, size_t count)
 {
-    return FlipBytes(*value);
+    static constexpr auto kMask  = ShuffleMask<sizeof(T)>();
+    const __m128i         mask   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kMask.data()));
+    constexpr size_t      kBlock = 16 / sizeof(T);
+    size_t                index  = 0;
+    for (; index + kBlock <= count; index += kBlock)
+    {
+        const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + index * sizeof(T)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + index * sizeof(T)), _mm_shuffle_epi8(value, mask));
+    }
+    FlipScalar<T>(source + index * sizeof(T), destination + index * sizeof(T), count - index);
 }
 
-uint32_t zeus::FlipBytes(const uint32_t* value)
+template<typename T>
+ZEUS_TARGET_AVX2 void FlipAvx2(const uint8_t* source, uint8_t* destination, size_t count)
 {
-    return FlipBytes(*value);
+    static constexpr auto kMask  = ShuffleMask<sizeof(T)>();
+    const __m256i         mask   = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(kMask.data())));
+    constexpr size_t      kBlock = 32 / sizeof(T);
+    size_t                index  = 0;
+    //每次两个寄存器，隐藏shuffle的延迟
+    for (; index + kBlock * 2 <= count; index += kBlock * 2)
+    {
+        const auto*   from   = reinterpret_cast<const __m256i*>(source + index * sizeof(T));
+        auto*         to     = reinterpret_cast<__m256i*>(destination + index * sizeof(T));
+        const __m256i first  = _mm256_shuffle_epi8(_mm256_loadu_si256(from), mask);
+        const __m256i second = _mm256_shuffle_epi8(_mm256_loadu_si256(from + 1), mask);
+        _mm256_storeu_si256(to, first);
+        _mm256_storeu_si256(to + 1, second);
+    }
+    FlipSsse3<T>(source + index * sizeof(T), destination + index * sizeof(T), count - index);
 }
+#endif
 
-uint64_t zeus::FlipBytes(const uint64_t* value)
+#ifdef ZEUS_ARCH_ARM64
+template<typename T>
+uint8x16_t Reverse(uint8x16_t value)
 {
-    return FlipBytes(*value);
+    if constexpr (2 == sizeof(T))
+    {
+        return vrev16q_u8(value);
+    }
+    else if constexpr (4 == sizeof(T))
+    {
+        return vrev32q_u8(value);
+    }
+    else
+    {
+        return vrev64q_u8(value);
+    }
 }
 
-int16_t zeus::FlipBytes(const int16_t* value)
+template<typename T>
+void FlipNeon(const uint8_t* source, uint8_t* destination, size_t count)
 {
-    return FlipBytes(*value);
+    constexpr size_t kBlock = 16 / sizeof(T);
+    size_t           index  = 0;
+    for (; index + kBlock <= count; index += kBlock)
+    {
+        vst1q_u8(destination + index * sizeof(T), Reverse<T>(vld1q_u8(source + index * sizeof(T))));
+    }
+    FlipScalar<T>(source + index * sizeof(T), destination + index * sizeof(T), count - index);
 }
+#endif
 
-int32_t zeus::FlipBytes(const int32_t* value)
+template<typename T>
+FlipFunction SelectFlip()
 {
-    return FlipBytes(*value);
+#ifdef ZEUS_ARCH_X64
+    const auto& feature = Hardware::GetCpuFeature();
+    if (feature.avx2)
+    {
+        return FlipAvx2<T>;
+    }
+    if (feature.ssse3)
+    {
+        return FlipSsse3<T>;
+    }
+    return FlipScalar<T>;
+#elif defined(ZEUS_ARCH_ARM64)
+    return FlipNeon<T>;
+#else
+    return FlipScalar<T>;
+#endif
 }
+} // namespace
 
-int64_t zeus::FlipBytes(const int64_t* value)
+void FlipBytes(const void* source, void* destination, size_t count, size_t width) noexcept
 {
-    return FlipBytes(*value);
+    static const FlipFunction flip16 = SelectFlip<uint16_t>();
+    static const FlipFunction flip32 = SelectFlip<uint32_t>();
+    static const FlipFunction flip64 = SelectFlip<uint64_t>();
+    const auto*               from   = static_cast<const uint8_t*>(source);
+    auto*                     to     = static_cast<uint8_t*>(destination);
+    switch (width)
+    {
+    case sizeof(uint16_t):
+        flip16(from, to, count);
+        break;
+    case sizeof(uint32_t):
+        flip32(from, to, count);
+        break;
+    case sizeof(uint64_t):
+        flip64(from, to, count);
+        break;
+    default:
+        if (from != to)
+        {
+            std::memmove(to, from, count * width);
+        }
+        break;
+    }
 }
+} // namespace zeus
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic) 没有c++20，没有std::span可用
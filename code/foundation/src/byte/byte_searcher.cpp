@@ -0,0 +1,344 @@
+﻿#include "zeus/foundation/byte/byte_searcher.h"
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic) 没有c++20，没有std::span可用
+#include <cstring>
+#include <deque>
+#include "zeus/foundation/byte/bit_utils.h"
+#include "zeus/foundation/hardware/cpu_feature.h"
+#ifdef ZEUS_ARCH_X64
+#include <immintrin.h>
+#endif
+
+namespace zeus
+{
+namespace
+{
+constexpr auto kNoPattern = static_cast<size_t>(-1);
+
+//模式长度至少为2，返回相对data的偏移，没有找到返回npos
+using FindFunction = size_t (*)(const uint8_t* data, size_t size, const uint8_t* pattern, size_t patternSize);
+
+size_t FindScalar(const uint8_t* data, size_t size, const uint8_t* pattern, size_t patternSize)
+{
+    if (size < patternSize)
+    {
+        return ByteSearcher::npos;
+    }
+    const uint8_t* last = data + (size - patternSize);
+    for (const uint8_t* current = data; current <= last; ++current)
+    {
+        current = static_cast<const uint8_t*>(std::memchr(current, pattern[0], static_cast<size_t>(last - current) + 1));
+        if (!current)
+        {
+            break;
+        }
+        if (0 == std::memcmp(current + 1, pattern + 1, patternSize - 1))
+        {
+            return static_cast<size_t>(current - data);
+        }
+    }
+    return ByteSearcher::npos;
+}
+
+#ifdef ZEUS_ARCH_X64
+//同时比较每个位置的首字节和对应的尾字节，两者都相同的候选位置才比较中间部分，随机数据上几乎不会出现误判
+size_t FindSse2(const uint8_t* data, size_t size, const uint8_t* pattern, size_t patternSize)
+{
+    const __m128i first = _mm_set1_epi8(static_cast<char>(pattern[0]));
+    const __m128i last  = _mm_set1_epi8(static_cast<char>(pattern[patternSize - 1]));
+    size_t        index = 0;
+    for (; index + patternSize - 1 + 16 <= size; index += 16)
+    {
+        const __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index));
+        const __m128i blockLast  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index + patternSize - 1));
+        auto          mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, blockFirst), _mm_cmpeq_epi8(last, blockLast))));
+        while (mask)
+        {
+            const size_t candidate = index + CountRightZero(mask);
+            if (0 == std::memcmp(data + candidate + 1, pattern + 1, patternSize - 2))
+            {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+    const size_t result = FindScalar(data + index, size - index, pattern, patternSize);
+    return ByteSearcher::npos == result ? result : index + result;
+}
+
+ZEUS_TARGET_AVX2 size_t FindAvx2(const uint8_t* data, size_t size, const uint8_t* pattern, size_t patternSize)
+{
+    const __m256i first = _mm256_set1_epi8(static_cast<char>(pattern[0]));
+    const __m256i last  = _mm256_set1_epi8(static_cast<char>(pattern[patternSize - 1]));
+    size_t        index = 0;
+    for (; index + patternSize - 1 + 32 <= size; index += 32)
+    {
+        const __m256i blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index));
+        const __m256i blockLast  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index + patternSize - 1));
+        auto          mask =
+            static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(first, blockFirst), _mm256_cmpeq_epi8(last, blockLast))));
+        while (mask)
+        {
+            const size_t candidate = index + CountRightZero(mask);
+            if (0 == std::memcmp(data + candidate + 1, pattern + 1, patternSize - 2))
+            {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+    const size_t result = FindSse2(data + index, size - index, pattern, patternSize);
+    return ByteSearcher::npos == result ? result : index + result;
+}
+#endif
+
+FindFunction SelectFind()
+{
+#ifdef ZEUS_ARCH_X64
+    if (Hardware::GetCpuFeature().avx2)
+    {
+        return FindAvx2;
+    }
+    return FindSse2;
+#else
+    return FindScalar;
+#endif
+}
+
+size_t FindOnce(const uint8_t* data, size_t size, const uint8_t* pattern, size_t patternSize)
+{
+    static const FindFunction find = SelectFind();
+    if (size < patternSize)
+    {
+        return ByteSearcher::npos;
+    }
+    if (1 == patternSize)
+    {
+        const void* found = std::memchr(data, pattern[0], size);
+        return found ? static_cast<size_t>(static_cast<const uint8_t*>(found) - data) : ByteSearcher::npos;
+    }
+    return find(data, size, pattern, patternSize);
+}
+} // namespace
+
+ByteSearcher::ByteSearcher(ByteBufferView pattern)
+{
+    if (pattern)
+    {
+        _pattern.assign(pattern.Data(), pattern.Data() + pattern.Size());
+    }
+}
+
+ByteSearcher::ByteSearcher(std::string_view pattern) : _pattern(pattern.begin(), pattern.end())
+{
+}
+
+size_t ByteSearcher::Find(const void* data, size_t size, size_t offset, size_t stride) const noexcept
+{
+    return Search(data, size, _pattern.data(), _pattern.size(), offset, stride);
+}
+
+size_t ByteSearcher::Find(ByteBufferView src, size_t offset, size_t stride) const noexcept
+{
+    if (!src)
+    {
+        return npos;
+    }
+    return Find(src.Data(), src.Size(), offset, stride);
+}
+
+size_t ByteSearcher::Find(std::string_view src, size_t offset) const noexcept
+{
+    return Find(src.data(), src.size(), offset, 1);
+}
+
+size_t ByteSearcher::Search(const void* data, size_t size, const void* pattern, size_t patternSize, size_t offset, size_t stride) noexcept
+{
+    if (!data || !patternSize || offset >= size || !stride)
+    {
+        return npos;
+    }
+    const auto* bytes    = static_cast<const uint8_t*>(data);
+    const auto* needle   = static_cast<const uint8_t*>(pattern);
+    size_t      position = offset;
+    while (position < size)
+    {
+        const size_t found = FindOnce(bytes + position, size - position, needle, patternSize);
+        if (npos == found)
+        {
+            return npos;
+        }
+        const size_t candidate = position + found;
+        const size_t remainder = (candidate - offset) % stride;
+        if (0 == remainder)
+        {
+            return candidate;
+        }
+        //跳到下一个对齐的位置继续
+        position = candidate + (stride - remainder);
+    }
+    return npos;
+}
+
+ByteMultiSearcher::ByteMultiSearcher(const std::vector<ByteBufferView>& patterns)
+{
+    std::vector<std::pair<const uint8_t*, size_t>> items;
+    items.reserve(patterns.size());
+    for (const auto& pattern : patterns)
+    {
+        items.emplace_back(pattern.Data(), pattern ? pattern.Size() : 0);
+    }
+    Build(items);
+}
+
+ByteMultiSearcher::ByteMultiSearcher(const std::vector<std::string_view>& patterns)
+{
+    std::vector<std::pair<const uint8_t*, size_t>> items;
+    items.reserve(patterns.size());
+    for (const auto& pattern : patterns)
+    {
+        items.emplace_back(reinterpret_cast<const uint8_t*>(pattern.data()), pattern.size());
+    }
+    Build(items);
+}
+
+void ByteMultiSearcher::Build(const std::vector<std::pair<const uint8_t*, size_t>>& patterns)
+{
+    _patternCount = patterns.size();
+    //只为模式中出现过的字节分配分类，其余字节共用分类0，转移表的列数等于分类数
+    for (const auto& [pattern, size] : patterns)
+    {
+        for (size_t index = 0; index < size; ++index)
+        {
+            if (!_classes[pattern[index]])
+            {
+                _classes[pattern[index]] = static_cast<uint16_t>(_classCount++);
+            }
+        }
+    }
+    _next.assign(_classCount, 0);
+    _depth.assign(1, 0);
+    _pattern.assign(1, kNoPattern);
+    for (size_t patternIndex = 0; patternIndex < patterns.size(); ++patternIndex)
+    {
+        const auto& [pattern, size] = patterns[patternIndex];
+        if (!size)
+        {
+            continue;
+        }
+        uint32_t state = 0;
+        for (size_t index = 0; index < size; ++index)
+        {
+            auto& next = _next[state * _classCount + _classes[pattern[index]]];
+            if (!next)
+            {
+                const uint32_t depth = _depth[state] + 1;
+                next                 = static_cast<uint32_t>(_depth.size());
+                _depth.emplace_back(depth);
+                _pattern.emplace_back(kNoPattern);
+                _next.resize(_next.size() + _classCount, 0);
+                //resize后next引用失效，重新读取
+                state = _next[state * _classCount + _classes[pattern[index]]];
+            }
+            else
+            {
+                state = next;
+            }
+        }
+        if (kNoPattern == _pattern[state])
+        {
+            _pattern[state] = patternIndex;
+        }
+    }
+
+    //按广度优先计算失败指针，把缺失的转移补全成完整的DFA，匹配时不需要回溯
+    const size_t          stateCount = _depth.size();
+    std::vector<uint32_t> fail(stateCount, 0);
+    std::deque<uint32_t>  queue;
+    _output.assign(stateCount, 0);
+    for (size_t category = 0; category < _classCount; ++category)
+    {
+        if (const auto child = _next[category])
+        {
+            queue.emplace_back(child);
+        }
+    }
+    while (!queue.empty())
+    {
+        const auto state = queue.front();
+        queue.pop_front();
+        _output[state] = kNoPattern != _pattern[state] ? state : _output[fail[state]];
+        for (size_t category = 0; category < _classCount; ++category)
+        {
+            auto&      next     = _next[state * _classCount + category];
+            const auto fallback = _next[fail[state] * _classCount + category];
+            if (next)
+            {
+                fail[next] = fallback;
+                queue.emplace_back(next);
+            }
+            else
+            {
+                next = fallback;
+            }
+        }
+    }
+}
+
+std::optional<ByteMultiSearcher::Match> ByteMultiSearcher::Find(const void* data, size_t size, size_t offset) const noexcept
+{
+    if (!data || _depth.size() <= 1)
+    {
+        return std::nullopt;
+    }
+    const auto*          bytes = static_cast<const uint8_t*>(data);
+    std::optional<Match> best;
+    uint32_t             state = 0;
+    for (size_t index = offset; index < size; ++index)
+    {
+        state = _next[state * _classCount + _classes[bytes[index]]];
+        //当前可能继续延伸的前缀已经从best之后开始，后面不会再有起始位置更靠前或者更长的匹配
+        if (best && index + 1 - _depth[state] > best->offset)
+        {
+            return best;
+        }
+        if (const auto output = _output[state])
+        {
+            const size_t length = _depth[output];
+            const size_t start  = index + 1 - length;
+            if (!best || start < best->offset || (start == best->offset && length > best->length))
+            {
+                best = Match {start, length, _pattern[output]};
+            }
+        }
+    }
+    return best;
+}
+
+std::optional<ByteMultiSearcher::Match> ByteMultiSearcher::Find(std::string_view src, size_t offset) const noexcept
+{
+    return Find(src.data(), src.size(), offset);
+}
+
+std::vector<ByteMultiSearcher::Match> ByteMultiSearcher::FindAll(const void* data, size_t size) const
+{
+    std::vector<Match> result;
+    size_t             offset = 0;
+    while (offset < size)
+    {
+        const auto match = Find(data, size, offset);
+        if (!match)
+        {
+            break;
+        }
+        result.emplace_back(*match);
+        offset = match->offset + match->length;
+    }
+    return result;
+}
+
+std::vector<ByteMultiSearcher::Match> ByteMultiSearcher::FindAll(std::string_view src) const
+{
+    return FindAll(src.data(), src.size());
+}
+} // namespace zeus
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic) 没有c++20，没有std::span可用
@@ -0,0 +1,42 @@
+﻿#include "zeus/foundation/byte/byte_stream.h"
+
+namespace zeus
+{
+ByteWriter::ByteWriter(ByteOrder order) noexcept : _order(order)
+{
+}
+
+ByteWriter::ByteWriter(size_t capacity, ByteOrder order) : _order(order)
+{
+    _buffer.reserve(capacity);
+}
+
+void ByteWriter::PutBytes(const void* data, size_t size)
+{
+    if (size)
+    {
+        std::memcpy(Grow(size), data, size);
+    }
+}
+
+size_t ByteWriter::Skip(size_t size)
+{
+    const size_t offset = _buffer.size();
+    _buffer.resize(offset + size);
+    return offset;
+}
+
+std::vector<uint8_t> ByteWriter::Release() noexcept
+{
+    auto buffer = std::move(_buffer);
+    _buffer.clear();
+    return buffer;
+}
+
+uint8_t* ByteWriter::Grow(size_t size)
+{
+    const size_t offset = _buffer.size();
+    _buffer.resize(offset + size);
+    return _buffer.data() + offset;
+}
+} // namespace zeus
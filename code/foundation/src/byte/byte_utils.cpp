@@ -7,15 +7,138 @@
 #include <cstdint>
 #include <cstring>
 #include <limits>
+#include "zeus/foundation/byte/hex.h"
+#include "zeus/foundation/hardware/cpu_feature.h"
+#ifdef ZEUS_ARCH_X64
+#include <immintrin.h>
+#endif
 
 namespace zeus
 {
-std::vector<ByteBufferView> ByteSplit(const ByteBufferView& src, const ByteBufferView& delim, size_t stride)
+namespace
+{
+using CountOneFunction = size_t (*)(const uint8_t* data, size_t size);
+
+size_t CountOneScalar(const uint8_t* data, size_t size)
+{
+    size_t count = 0;
+    size_t index = 0;
+    for (; index + 8 <= size; index += 8)
+    {
+        uint64_t word = 0;
+        std::memcpy(&word, data + index, sizeof(word));
+        count += CountOne(word);
+    }
+    for (; index < size; ++index)
+    {
+        count += CountOne(data[index]);
+    }
+    return count;
+}
+
+#ifdef ZEUS_ARCH_X64
+ZEUS_TARGET_POPCNT size_t CountOnePopcnt(const uint8_t* data, size_t size)
+{
+    //4个独立的累加器，避免popcnt之间的依赖链
+    uint64_t counts[4] = {};
+    size_t   index     = 0;
+    for (; index + 32 <= size; index += 32)
+    {
+        uint64_t words[4];
+        std::memcpy(words, data + index, sizeof(words));
+        counts[0] += static_cast<uint64_t>(_mm_popcnt_u64(words[0]));
+        counts[1] += static_cast<uint64_t>(_mm_popcnt_u64(words[1]));
+        counts[2] += static_cast<uint64_t>(_mm_popcnt_u64(words[2]));
+        counts[3] += static_cast<uint64_t>(_mm_popcnt_u64(words[3]));
+    }
+    for (; index + 8 <= size; index += 8)
+    {
+        uint64_t word = 0;
+        std::memcpy(&word, data + index, sizeof(word));
+        counts[0] += static_cast<uint64_t>(_mm_popcnt_u64(word));
+    }
+    for (; index < size; ++index)
+    {
+        counts[0] += static_cast<uint64_t>(_mm_popcnt_u32(data[index]));
+    }
+    return static_cast<size_t>(counts[0] + counts[1] + counts[2] + counts[3]);
+}
+
+//按半字节查表统计每个字节的位数，字节计数最多累加31轮(31*8<256)后用SAD横向求和到64位
+ZEUS_TARGET_AVX2 size_t CountOneAvx2(const uint8_t* data, size_t size)
+{
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i mask   = _mm256_set1_epi8(0x0F);
+    __m256i       total  = _mm256_setzero_si256();
+    size_t        index  = 0;
+    while (index + 32 <= size)
+    {
+        __m256i bytes  = _mm256_setzero_si256();
+        size_t  rounds = 0;
+        for (; rounds < 31 && index + 32 <= size; ++rounds, index += 32)
+        {
+            const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index));
+            const __m256i low   = _mm256_shuffle_epi8(lookup, _mm256_and_si256(block, mask));
+            const __m256i high  = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(block, 4), mask));
+            bytes               = _mm256_add_epi8(bytes, _mm256_add_epi8(low, high));
+        }
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+    }
+    const __m128i sum   = _mm_add_epi64(_mm256_castsi256_si128(total), _mm256_extracti128_si256(total, 1));
+    const auto    count = static_cast<uint64_t>(_mm_cvtsi128_si64(sum)) + static_cast<uint64_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(sum, sum)));
+    return static_cast<size_t>(count) + CountOnePopcnt(data + index, size - index);
+}
+
+ZEUS_TARGET_AVX512VPOPCNTDQ size_t CountOneAvx512(const uint8_t* data, size_t size)
+{
+    __m512i total = _mm512_setzero_si512();
+    size_t  index = 0;
+    for (; index + 64 <= size; index += 64)
+    {
+        total = _mm512_add_epi64(total, _mm512_popcnt_epi64(_mm512_loadu_si512(data + index)));
+    }
+    uint64_t lanes[8];
+    _mm512_storeu_si512(lanes, total);
+    uint64_t count = 0;
+    for (const auto lane : lanes)
+    {
+        count += lane;
+    }
+    return static_cast<size_t>(count) + CountOnePopcnt(data + index, size - index);
+}
+#endif
+
+CountOneFunction SelectCountOne()
+{
+#ifdef ZEUS_ARCH_X64
+    const auto& feature = Hardware::GetCpuFeature();
+    if (feature.avx512vpopcntdq)
+    {
+        return CountOneAvx512;
+    }
+    if (feature.avx2 && feature.popcnt)
+    {
+        return CountOneAvx2;
+    }
+    if (feature.popcnt)
+    {
+        return CountOnePopcnt;
+    }
+#endif
+    return CountOneScalar;
+}
+} // namespace
+
+std::vector<ByteBufferView> ByteSplit(ByteBufferView src, ByteBufferView delim, size_t stride)
+{
+    return ByteSplit(src, ByteSearcher(delim), stride);
+}
+std::vector<ByteBufferView> ByteSplit(ByteBufferView src, const ByteSearcher& delim, size_t stride)
 {
     std::vector<ByteBufferView> result;
     size_t                      offset     = 0;
     size_t                      findOffset = 0;
-    while ((findOffset = ByteFind(src, delim, offset, stride)) != std::string::npos)
+    while ((findOffset = delim.Find(src, offset, stride)) != std::string::npos)
     {
         if (findOffset != offset)
         {
@@ -29,7 +152,7 @@ std::vector<ByteBufferView> ByteSplit(const ByteBufferView& src, const ByteBuffe
     }
     return result;
 }
-std::vector<uint8_t> ByteJoin(std::vector<ByteBufferView>& src, const ByteBufferView& delim)
+std::vector<uint8_t> ByteJoin(std::vector<ByteBufferView>& src, ByteBufferView delim)
 {
     std::vector<uint8_t> result;
     if (src.empty())
@@ -63,33 +186,15 @@ std::vector<uint8_t> ByteJoin(std::vector<ByteBufferView>& src, const ByteBuffer
     return result;
 }
 
-std::string::size_type ByteFind(const ByteBufferView& src, const ByteBufferView& sub, size_t offset, size_t stride)
+std::string::size_type ByteFind(ByteBufferView src, ByteBufferView sub, size_t offset, size_t stride)
 {
-    if (offset >= src.Size())
-    {
-        return std::string::npos;
-    }
-    auto element = src.SubView(offset, src.Size() - offset);
-    if (!element || !sub || element.Size() < sub.Size())
+    if (!src || !sub)
     {
         return std::string::npos;
     }
-    const uint8_t* start = element.Data();
-    const uint8_t* end   = start + element.Size() - sub.Size();
-    while (start <= end)
-    {
-        if (0 == std::memcmp(start, sub.Data(), sub.Size()))
-        {
-            return start - src.Data();
-        }
-        else
-        {
-            start += stride;
-        }
-    }
-    return std::string::npos;
+    return ByteSearcher::Search(src.Data(), src.Size(), sub.Data(), sub.Size(), offset, stride);
 }
-std::string::size_type ByteReverseFind(const ByteBufferView& src, const ByteBufferView& sub, size_t offset, size_t stride)
+std::string::size_type ByteReverseFind(ByteBufferView src, ByteBufferView sub, size_t offset, size_t stride)
 {
     if (offset >= src.Size())
     {
@@ -115,10 +220,14 @@ std::string::size_type ByteReverseFind(const ByteBufferView& src, const ByteBuff
     }
     return std::string::npos;
 }
-std::vector<uint8_t> ByteReplace(const ByteBufferView& src, const ByteBufferView& sub, const ByteBufferView& replacement, size_t stride)
+std::vector<uint8_t> ByteReplace(ByteBufferView src, ByteBufferView sub, ByteBufferView replacement, size_t stride)
+{
+    return ByteReplace(src, ByteSearcher(sub), replacement, stride);
+}
+std::vector<uint8_t> ByteReplace(ByteBufferView src, const ByteSearcher& sub, ByteBufferView replacement, size_t stride)
 {
     std::vector<uint8_t> result;
-    if (!src || !sub || src.Size() < sub.Size())
+    if (!src || !sub.Size() || src.Size() < sub.Size())
     {
         result.resize(src.Size());
         std::memcpy(result.data(), src.Data(), src.Size());
@@ -127,7 +236,7 @@ std::vector<uint8_t> ByteReplace(const ByteBufferView& src, const ByteBufferView
     std::vector<size_t> subpos;
     size_t              findOffset = 0;
     size_t              offset     = 0;
-    while (findOffset = ByteFind(src, sub, offset, stride), findOffset != std::string::npos)
+    while (findOffset = sub.Find(src, offset, stride), findOffset != std::string::npos)
     {
         offset = findOffset + sub.Size();
         subpos.emplace_back(findOffset);
@@ -156,7 +265,39 @@ std::vector<uint8_t> ByteReplace(const ByteBufferView& src, const ByteBufferView
     }
     return result;
 }
-bool ByteEndWith(const ByteBufferView& src, const ByteBufferView& end)
+std::vector<uint8_t> ByteReplace(ByteBufferView src, const ByteMultiSearcher& patterns, const std::vector<ByteBufferView>& replacements)
+{
+    assert(replacements.size() == patterns.PatternCount());
+    std::vector<uint8_t> result;
+    if (!src)
+    {
+        return result;
+    }
+    const auto matches = patterns.FindAll(src.Data(), src.Size());
+    size_t     size    = src.Size();
+    for (const auto& match : matches)
+    {
+        size = size - match.length + replacements[match.pattern].Size();
+    }
+    result.resize(size);
+    uint8_t* newData   = result.data();
+    size_t   oldOffset = 0;
+    for (const auto& match : matches)
+    {
+        const auto& replacement = replacements[match.pattern];
+        std::memcpy(newData, src.Data() + oldOffset, match.offset - oldOffset);
+        newData += match.offset - oldOffset;
+        if (replacement)
+        {
+            std::memcpy(newData, replacement.Data(), replacement.Size());
+            newData += replacement.Size();
+        }
+        oldOffset = match.offset + match.length;
+    }
+    std::memcpy(newData, src.Data() + oldOffset, src.Size() - oldOffset);
+    return result;
+}
+bool ByteEndWith(ByteBufferView src, ByteBufferView end)
 {
     if (!src)
     {
@@ -172,7 +313,7 @@ bool ByteEndWith(const ByteBufferView& src, const ByteBufferView& end)
     }
     return 0 == std::memcmp(src.Data() + src.Size() - end.Size(), end.Data(), end.Size());
 }
-bool ByteStartWith(const ByteBufferView& src, const ByteBufferView& start)
+bool ByteStartWith(ByteBufferView src, ByteBufferView start)
 {
     if (!src)
     {
@@ -189,266 +330,27 @@ bool ByteStartWith(const ByteBufferView& src, const ByteBufferView& start)
     return 0 == std::memcmp(src.Data(), start.Data(), start.Size());
 }
 
-namespace
-{
-uint8_t CharToByte(const char& hex)
-{
-    if ('0' <= hex && hex <= '9')
-    {
-        return (hex - '0');
-    }
-    else if ('a' <= hex && hex <= 'f')
-    {
-        return (hex - 'a' + 10);
-    }
-    else if ('A' <= hex && hex <= 'F')
-    {
-        return (hex - 'A' + 10);
-    }
-    else
-    {
-        return std::numeric_limits<uint8_t>::max();
-    }
-}
-} // namespace
-
 std::optional<std::vector<uint8_t>> HexStringToBytes(const std::string& hex)
 {
-    if (0 != hex.size() % 2)
+    auto result = Hex::Decode(hex);
+    if (!result.has_value())
     {
         return std::nullopt;
     }
-    std::vector<uint8_t> result(hex.size() / 2);
-    uint8_t*             data = result.data();
-    for (auto i = 0U; i < result.size(); i++)
-    {
-        auto bigByte   = CharToByte(hex.at(2 * i));
-        auto smallByte = CharToByte(hex.at(2 * i + 1));
-        if (std::numeric_limits<uint8_t>::max() == bigByte || std::numeric_limits<uint8_t>::max() == smallByte)
-        {
-            return std::nullopt;
-        }
-        *data = (bigByte << 4) + smallByte;
-        ++data;
-    }
-    return std::move(result);
+    return std::move(*result);
 }
-size_t CountLeftZero(uint32_t x)
+size_t CountZero(ByteBufferView src)
 {
-    if (0 == x)
-    {
-        return 32;
-    }
-    int count = 0;
-    while (!(x & 0x80000000))
-    { ///0x80000000 = 1<<31
-        count++;
-        x <<= 1;
-    }
-    return count;
+    return src.Size() * 8 - CountOne(src);
 }
-size_t CountLeftOne(uint32_t x)
+size_t CountOne(ByteBufferView src)
 {
-    int count = 0;
-    while ((x & 0x80000000))
-    { ///0x80000000 = 1<<31
-        count++;
-        x <<= 1;
-    }
-    return count;
-}
-size_t CountRightZero(uint32_t x)
-{
-    if (0 == x)
-    {
-        return 32;
-    }
-    int count = 0;
-    while (!(x & 0x00000001))
-    {
-        count++;
-        x >>= 1;
-    }
-    return count;
-}
-size_t CountRightOne(uint32_t x)
-{
-    int count = 0;
-    while ((x & 0x00000001))
-    {
-        count++;
-        x >>= 1;
-    }
-    return count;
-}
-
-size_t CountLeftZero(uint16_t x)
-{
-    if (0 == x)
-    {
-        return 16;
-    }
-    int count = 0;
-    while (!(x & 0x8000))
-    {
-        count++;
-        x <<= 1;
-    }
-    return count;
-}
-size_t CountLeftOne(uint16_t x)
-{
-    int count = 0;
-    while ((x & 0x8000))
-    {
-        count++;
-        x <<= 1;
-    }
-    return count;
-}
-size_t CountRightZero(uint16_t x)
-{
-    if (0 == x)
-    {
-        return 16;
-    }
-    int count = 0;
-    while (!(x & 0x0001))
-    {
-        count++;
-        x >>= 1;
-    }
-    return count;
-}
-size_t CountRightOne(uint16_t x)
-{
-    int count = 0;
-    while ((x & 0x0001))
-    {
-        count++;
-        x >>= 1;
-    }
-    return count;
-}
-
-size_t CountLeftZero(uint8_t x)
-{
-    if (0 == x)
-    {
-        return 8;
-    }
-    int count = 0;
-    while (!(x & 0x80))
-    {
-        count++;
-        x <<= 1;
-    }
-    return count;
-}
-size_t CountLeftOne(uint8_t x)
-{
-    int count = 0;
-    while ((x & 0x80))
-    {
-        count++;
-        x <<= 1;
-    }
-    return count;
-}
-size_t CountRightZero(uint8_t x)
-{
-    if (0 == x)
-    {
-        return 8;
-    }
-    int count = 0;
-    while (!(x & 0x01))
-    {
-        count++;
-        x >>= 1;
-    }
-    return count;
-}
-size_t CountRightOne(uint8_t x)
-{
-    int count = 0;
-    while ((x & 0x01))
-    {
-        count++;
-        x >>= 1;
-    }
-    return count;
-}
-size_t CountZero(uint8_t x)
-{
-    return 8 - CountOne(x);
-}
-size_t CountOne(uint8_t x)
-{
-    int count = 0;
-    while (x)
-    {
-        if (x & 0x01)
-        {
-            count++;
-        }
-        x >>= 1;
-    }
-    return count;
-}
-
-size_t CountZero(uint16_t x)
-{
-    return 16 - CountOne(x);
-}
-size_t CountOne(uint16_t x)
-{
-    int count = 0;
-    while (x)
-    {
-        if (x & 0x0001)
-        {
-            count++;
-        }
-        x >>= 1;
-    }
-    return count;
-}
-size_t CountZero(uint32_t x)
-{
-    return 32 - CountOne(x);
-}
-size_t CountOne(uint32_t x)
-{
-    int count = 0;
-    while (x)
-    {
-        if (x & 0x00000001)
-        {
-            count++;
-        }
-        x >>= 1;
-    }
-    return count;
-}
-
-size_t CountZero(const ByteBufferView& src)
-{
-    size_t count = 0;
-    for (size_t index = 0; index < src.Size(); index++)
-    {
-        count += CountZero(src[index]);
-    }
-    return count;
-}
-size_t CountOne(const ByteBufferView& src)
-{
-    size_t count = 0;
-    for (size_t index = 0; index < src.Size(); index++)
+    static const CountOneFunction countOne = SelectCountOne();
+    if (!src)
     {
-        count += CountOne(src[index]);
+        return 0;
     }
-    return count;
+    return countOne(src.Data(), src.Size());
 }
 } // namespace zeus
 
@@ -0,0 +1,250 @@
+﻿#include "zeus/foundation/byte/hex.h"
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic) 没有c++20，没有std::span可用
+#include <array>
+#include "zeus/foundation/hardware/cpu_feature.h"
+#ifdef ZEUS_ARCH_X64
+#include <immintrin.h>
+#endif
+
+namespace zeus
+{
+namespace
+{
+constexpr char kLowerTable[] = "0123456789abcdef";
+constexpr char kUpperTable[] = "0123456789ABCDEF";
+constexpr auto kInvalid      = static_cast<uint8_t>(0xFF);
+
+constexpr std::array<uint8_t, 256> MakeDecodeTable()
+{
+    std::array<uint8_t, 256> decode {};
+    for (auto& item : decode)
+    {
+        item = kInvalid;
+    }
+    for (uint8_t index = 0; index < 16; ++index)
+    {
+        decode[static_cast<uint8_t>(kLowerTable[index])] = index;
+        decode[static_cast<uint8_t>(kUpperTable[index])] = index;
+    }
+    return decode;
+}
+
+constexpr std::array<uint8_t, 256> kDecodeTable = MakeDecodeTable();
+
+//SIMD内核只处理能完整装入寄存器的部分，返回消耗的输入长度，剩余部分由标量代码处理
+using EncodeBlocksFunction = size_t (*)(const uint8_t* input, size_t length, char* output, const char* table);
+using DecodeBlocksFunction = size_t (*)(const char* input, size_t length, uint8_t* output);
+
+size_t EncodeBlocksScalar(const uint8_t* input, size_t length, char* output, const char* table)
+{
+    for (size_t index = 0; index < length; ++index)
+    {
+        *output++ = table[input[index] >> 4];
+        *output++ = table[input[index] & 0x0F];
+    }
+    return length;
+}
+
+size_t DecodeBlocksScalar(const char* input, size_t length, uint8_t* output)
+{
+    const size_t bytes = length / 2;
+    for (size_t index = 0; index < bytes; ++index)
+    {
+        const uint8_t high = kDecodeTable[static_cast<uint8_t>(input[index * 2])];
+        const uint8_t low  = kDecodeTable[static_cast<uint8_t>(input[index * 2 + 1])];
+        if ((high | low) & 0x80)
+        {
+            return index * 2;
+        }
+        output[index] = static_cast<uint8_t>((high << 4) | low);
+    }
+    return bytes * 2;
+}
+
+#ifdef ZEUS_ARCH_X64
+ZEUS_TARGET_SSSE3 size_t EncodeBlocksSsse3(const uint8_t* input, size_t length, char* output, const char* table)
+{
+    const __m128i lookup   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table));
+    const __m128i mask     = _mm_set1_epi8(0x0F);
+    size_t        consumed = 0;
+    for (; consumed + 16 <= length; consumed += 16, output += 32)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + consumed));
+        const __m128i high  = _mm_shuffle_epi8(lookup, _mm_and_si128(_mm_srli_epi16(block, 4), mask));
+        const __m128i low   = _mm_shuffle_epi8(lookup, _mm_and_si128(block, mask));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + 16), _mm_unpackhi_epi8(high, low));
+    }
+    return consumed + EncodeBlocksScalar(input + consumed, length - consumed, output, table);
+}
+
+ZEUS_TARGET_AVX2 size_t EncodeBlocksAvx2(const uint8_t* input, size_t length, char* output, const char* table)
+{
+    const __m256i lookup   = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(table)));
+    const __m256i mask     = _mm256_set1_epi8(0x0F);
+    size_t        consumed = 0;
+    for (; consumed + 32 <= length; consumed += 32, output += 64)
+    {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + consumed));
+        const __m256i high  = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(block, 4), mask));
+        const __m256i low   = _mm256_shuffle_epi8(lookup, _mm256_and_si256(block, mask));
+        //unpack按128位通道交错，需要重新排列通道
+        const __m256i first  = _mm256_unpacklo_epi8(high, low);
+        const __m256i second = _mm256_unpackhi_epi8(high, low);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), _mm256_permute2x128_si256(first, second, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + 32), _mm256_permute2x128_si256(first, second, 0x31));
+    }
+    return consumed + EncodeBlocksSsse3(input + consumed, length - consumed, output, table);
+}
+
+//把16个十六进制字符转换成4bit的值，同时校验字符是否合法
+ZEUS_TARGET_SSSE3 inline bool CharsToValuesSsse3(__m128i input, __m128i& values)
+{
+    const __m128i digit  = _mm_and_si128(_mm_cmpgt_epi8(input, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(input, _mm_set1_epi8('9' + 1)));
+    const __m128i upper  = _mm_and_si128(_mm_cmpgt_epi8(input, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(input, _mm_set1_epi8('F' + 1)));
+    const __m128i lower  = _mm_and_si128(_mm_cmpgt_epi8(input, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(input, _mm_set1_epi8('f' + 1)));
+    const __m128i valid  = _mm_or_si128(_mm_or_si128(digit, upper), lower);
+    __m128i       offset = _mm_and_si128(digit, _mm_set1_epi8(-'0'));
+    offset               = _mm_or_si128(offset, _mm_and_si128(upper, _mm_set1_epi8(10 - 'A')));
+    offset               = _mm_or_si128(offset, _mm_and_si128(lower, _mm_set1_epi8(10 - 'a')));
+    values               = _mm_add_epi8(input, offset);
+    return 0xFFFF == _mm_movemask_epi8(valid);
+}
+
+ZEUS_TARGET_SSSE3 size_t DecodeBlocksSsse3(const char* input, size_t length, uint8_t* output)
+{
+    //每对字符的高4bit乘16加上低4bit
+    const __m128i merge    = _mm_set1_epi16(0x0110);
+    size_t        consumed = 0;
+    for (; consumed + 32 <= length; consumed += 32, output += 16)
+    {
+        __m128i first;
+        __m128i second;
+        if (!CharsToValuesSsse3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + consumed)), first) ||
+            !CharsToValuesSsse3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + consumed + 16)), second))
+        {
+            break;
+        }
+        const __m128i bytes = _mm_packus_epi16(_mm_maddubs_epi16(first, merge), _mm_maddubs_epi16(second, merge));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), bytes);
+    }
+    return consumed + DecodeBlocksScalar(input + consumed, length - consumed, output);
+}
+
+ZEUS_TARGET_AVX2 inline bool CharsToValuesAvx2(__m256i input, __m256i& values)
+{
+    const __m256i digit =
+        _mm256_and_si256(_mm256_cmpgt_epi8(input, _mm256_set1_epi8('0' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), input));
+    const __m256i upper =
+        _mm256_and_si256(_mm256_cmpgt_epi8(input, _mm256_set1_epi8('A' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('F' + 1), input));
+    const __m256i lower =
+        _mm256_and_si256(_mm256_cmpgt_epi8(input, _mm256_set1_epi8('a' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('f' + 1), input));
+    const __m256i valid  = _mm256_or_si256(_mm256_or_si256(digit, upper), lower);
+    __m256i       offset = _mm256_and_si256(digit, _mm256_set1_epi8(-'0'));
+    offset               = _mm256_or_si256(offset, _mm256_and_si256(upper, _mm256_set1_epi8(10 - 'A')));
+    offset               = _mm256_or_si256(offset, _mm256_and_si256(lower, _mm256_set1_epi8(10 - 'a')));
+    values               = _mm256_add_epi8(input, offset);
+    return -1 == _mm256_movemask_epi8(valid);
+}
+
+ZEUS_TARGET_AVX2 size_t DecodeBlocksAvx2(const char* input, size_t length, uint8_t* output)
+{
+    const __m256i merge    = _mm256_set1_epi16(0x0110);
+    size_t        consumed = 0;
+    for (; consumed + 64 <= length; consumed += 64, output += 32)
+    {
+        __m256i first;
+        __m256i second;
+        if (!CharsToValuesAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + consumed)), first) ||
+            !CharsToValuesAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + consumed + 32)), second))
+        {
+            break;
+        }
+        //pack按128位通道交错，需要重新排列64位分组
+        const __m256i bytes = _mm256_packus_epi16(_mm256_maddubs_epi16(first, merge), _mm256_maddubs_epi16(second, merge));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), _mm256_permute4x64_epi64(bytes, 0xD8));
+    }
+    return consumed + DecodeBlocksSsse3(input + consumed, length - consumed, output);
+}
+#endif
+
+EncodeBlocksFunction SelectEncodeBlocks()
+{
+#ifdef ZEUS_ARCH_X64
+    const auto& feature = Hardware::GetCpuFeature();
+    if (feature.avx2)
+    {
+        return EncodeBlocksAvx2;
+    }
+    if (feature.ssse3)
+    {
+        return EncodeBlocksSsse3;
+    }
+#endif
+    return EncodeBlocksScalar;
+}
+
+DecodeBlocksFunction SelectDecodeBlocks()
+{
+#ifdef ZEUS_ARCH_X64
+    const auto& feature = Hardware::GetCpuFeature();
+    if (feature.avx2)
+    {
+        return DecodeBlocksAvx2;
+    }
+    if (feature.ssse3)
+    {
+        return DecodeBlocksSsse3;
+    }
+#endif
+    return DecodeBlocksScalar;
+}
+} // namespace
+
+size_t Hex::Encode(const void* input, size_t length, char* output, bool upCase) noexcept
+{
+    static const EncodeBlocksFunction encodeBlocks = SelectEncodeBlocks();
+    encodeBlocks(static_cast<const uint8_t*>(input), length, output, upCase ? kUpperTable : kLowerTable);
+    return EncodedLength(length);
+}
+
+std::string Hex::Encode(const void* input, size_t length, bool upCase)
+{
+    std::string result(EncodedLength(length), '\0');
+    Encode(input, length, result.data(), upCase);
+    return result;
+}
+
+zeus::expected<size_t, Hex::DecodeError> Hex::Decode(const char* input, size_t length, void* output) noexcept
+{
+    static const DecodeBlocksFunction decodeBlocks = SelectDecodeBlocks();
+
+    const size_t consumed = decodeBlocks(input, length, static_cast<uint8_t*>(output));
+    //内核只会在遇到非法字符或者末尾不足一对时停下
+    for (size_t index = consumed; index < length; ++index)
+    {
+        if (kInvalid == kDecodeTable[static_cast<uint8_t>(input[index])])
+        {
+            return zeus::unexpected(DecodeError {index});
+        }
+    }
+    if (consumed != length)
+    {
+        //奇数长度，最后一个字符无法组成字节
+        return zeus::unexpected(DecodeError {length - 1});
+    }
+    return DecodedLength(length);
+}
+
+zeus::expected<std::vector<uint8_t>, Hex::DecodeError> Hex::Decode(std::string_view input)
+{
+    std::vector<uint8_t> result(DecodedLength(input.size()));
+    auto                 size = Decode(input.data(), input.size(), result.data());
+    if (!size.has_value())
+    {
+        return zeus::unexpected(size.error());
+    }
+    return result;
+}
+} // namespace zeus
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic) 没有c++20，没有std::span可用
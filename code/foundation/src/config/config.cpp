@@ -31,6 +31,14 @@ std::vector<std::string> Config::GetConfigKeys(const std::string& /*key*/) const
     return std::vector<std::string>();
 }
 
+void Config::ForEachConfigKey(const std::string& key, const std::function<void(std::string_view name)>& visitor) const
+{
+    for (const auto& name : GetConfigKeys(key))
+    {
+        visitor(name);
+    }
+}
+
 size_t Config::AddChangeNotify(const std::function<void(const ConfigPoint& key, const ConfigValue& value)>& /*notify*/) const
 {
     return 0;
@@ -228,24 +228,27 @@ zeus::expected<void, ConfigError> GeneralConfig::RemoveConfigValue(const std::st
 std::vector<std::string> GeneralConfig::GetConfigKeys(const std::string& key) const
 {
     std::vector<std::string> keys;
-    auto const               point = CasConfigPointer(key);
-    std::shared_lock         lock(_impl->mutex);
+    ForEachConfigKey(key, [&keys](std::string_view name) { keys.emplace_back(name); });
+    return keys;
+}
+void GeneralConfig::ForEachConfigKey(const std::string& key, const std::function<void(std::string_view name)>& visitor) const
+{
+    auto const       point = CasConfigPointer(key);
+    std::shared_lock lock(_impl->mutex);
     if (_impl->data.contains(point))
     {
         auto& place = _impl->data.at(point);
         if (place.is_object())
         {
-            keys.reserve(place.size());
             for (const auto& item : place.items())
             {
                 if (!item.value().is_null())
                 {
-                    keys.emplace_back(item.key());
+                    visitor(item.key());
                 }
             }
         }
     }
-    return keys;
 }
 size_t GeneralConfig::AddChangeNotify(const std::function<void(const ConfigPoint& key, const ConfigValue& value)>& notify) const
 {
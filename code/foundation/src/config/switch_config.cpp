@@ -101,4 +101,13 @@ std::vector<std::string> SwitchConfig::GetConfigKeys(const std::string& key) con
     }
     return std::vector<std::string>();
 }
+
+void SwitchConfig::ForEachConfigKey(const std::string& key, const std::function<void(std::string_view name)>& visitor) const
+{
+    auto config = FindConfig(_impl->label, _impl->partial);
+    if (config)
+    {
+        config->ForEachConfigKey(key, visitor);
+    }
+}
 } // namespace zeus
@@ -0,0 +1,245 @@
+﻿#include "zeus/foundation/container/dynamic_bitset.h"
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic) 没有c++20，没有std::span可用
+#include <algorithm>
+#include "zeus/foundation/byte/byte_utils.h"
+#include "impl/bit_operation.h"
+
+namespace zeus
+{
+namespace
+{
+constexpr size_t kWordsPerBlock = 8;
+constexpr size_t kBitsPerBlock  = kWordsPerBlock * 64;
+
+size_t WordsFor(size_t size)
+{
+    return (size + 63) / 64;
+}
+
+size_t CountWords(const uint64_t* words, size_t count)
+{
+    return CountOne(ByteBufferView(reinterpret_cast<const uint8_t*>(words), count * sizeof(uint64_t)));
+}
+
+//字内第rank个为1的位，调用者保证rank小于字中1的个数
+size_t SelectInWord(uint64_t word, size_t rank)
+{
+    for (; rank; --rank)
+    {
+        word &= word - 1;
+    }
+    return CountRightZero(word);
+}
+} // namespace
+
+DynamicBitset::DynamicBitset(size_t size, bool value) : _words(WordsFor(size), value ? ~0ULL : 0), _size(size)
+{
+    ClearTail();
+}
+
+void DynamicBitset::Resize(size_t size, bool value)
+{
+    const size_t oldSize = _size;
+    _words.resize(WordsFor(size), value ? ~0ULL : 0);
+    _size = size;
+    if (value && oldSize < size && oldSize % 64)
+    {
+        //原来最后一个字中超出长度的部分
+        _words[oldSize / 64] |= ~0ULL << (oldSize % 64);
+    }
+    ClearTail();
+    _rankValid = false;
+}
+
+void DynamicBitset::Clear() noexcept
+{
+    _words.clear();
+    _blockRanks.clear();
+    _size      = 0;
+    _rankValid = false;
+}
+
+void DynamicBitset::Set(size_t index, bool value) noexcept
+{
+    if (index >= _size)
+    {
+        return;
+    }
+    const uint64_t mask = 1ULL << (index % 64);
+    if (value)
+    {
+        _words[index / 64] |= mask;
+    }
+    else
+    {
+        _words[index / 64] &= ~mask;
+    }
+    _rankValid = false;
+}
+
+void DynamicBitset::Flip(size_t index) noexcept
+{
+    if (index >= _size)
+    {
+        return;
+    }
+    _words[index / 64] ^= 1ULL << (index % 64);
+    _rankValid = false;
+}
+
+void DynamicBitset::SetAll() noexcept
+{
+    std::fill(_words.begin(), _words.end(), ~0ULL);
+    ClearTail();
+    _rankValid = false;
+}
+
+void DynamicBitset::ResetAll() noexcept
+{
+    std::fill(_words.begin(), _words.end(), 0);
+    _rankValid = false;
+}
+
+void DynamicBitset::FlipAll() noexcept
+{
+    for (auto& word : _words)
+    {
+        word = ~word;
+    }
+    ClearTail();
+    _rankValid = false;
+}
+
+size_t DynamicBitset::Count() const noexcept
+{
+    return CountWords(_words.data(), _words.size());
+}
+
+bool DynamicBitset::Any() const noexcept
+{
+    return std::any_of(_words.begin(), _words.end(), [](uint64_t word) { return 0 != word; });
+}
+
+size_t DynamicBitset::Rank(size_t index) const noexcept
+{
+    index            = std::min(index, _size);
+    const size_t end = index / 64;
+    size_t       count;
+    if (_rankValid)
+    {
+        const size_t block = index / kBitsPerBlock;
+        count              = _blockRanks[block] + CountWords(_words.data() + block * kWordsPerBlock, end - block * kWordsPerBlock);
+    }
+    else
+    {
+        count = CountWords(_words.data(), end);
+    }
+    if (index % 64)
+    {
+        count += CountOne(static_cast<uint64_t>(_words[end] & ((1ULL << (index % 64)) - 1)));
+    }
+    return count;
+}
+
+size_t DynamicBitset::Select(size_t rank) const noexcept
+{
+    size_t word = 0;
+    if (_rankValid)
+    {
+        //最后一个累计计数不超过rank的块
+        const auto block = static_cast<size_t>(std::upper_bound(_blockRanks.begin(), _blockRanks.end(), rank) - _blockRanks.begin()) - 1;
+        rank -= _blockRanks[block];
+        word = block * kWordsPerBlock;
+    }
+    for (; word < _words.size(); ++word)
+    {
+        const size_t count = CountOne(_words[word]);
+        if (rank < count)
+        {
+            return word * 64 + SelectInWord(_words[word], rank);
+        }
+        rank -= count;
+    }
+    return npos;
+}
+
+void DynamicBitset::BuildRankIndex()
+{
+    const size_t blocks = (_words.size() + kWordsPerBlock - 1) / kWordsPerBlock;
+    _blockRanks.assign(blocks + 1, 0);
+    for (size_t block = 0; block < blocks; ++block)
+    {
+        const size_t begin      = block * kWordsPerBlock;
+        const size_t count      = std::min(kWordsPerBlock, _words.size() - begin);
+        _blockRanks[block + 1] = _blockRanks[block] + CountWords(_words.data() + begin, count);
+    }
+    _rankValid = true;
+}
+
+DynamicBitset& DynamicBitset::operator&=(const DynamicBitset& other) noexcept
+{
+    const size_t common = std::min(_words.size(), other._words.size());
+    ApplyBitOperation(BitOperation::kAnd, _words.data(), other._words.data(), common);
+    std::fill(_words.begin() + static_cast<std::ptrdiff_t>(common), _words.end(), 0);
+    _rankValid = false;
+    return *this;
+}
+
+DynamicBitset& DynamicBitset::operator|=(const DynamicBitset& other) noexcept
+{
+    ApplyBitOperation(BitOperation::kOr, _words.data(), other._words.data(), std::min(_words.size(), other._words.size()));
+    ClearTail();
+    _rankValid = false;
+    return *this;
+}
+
+DynamicBitset& DynamicBitset::operator^=(const DynamicBitset& other) noexcept
+{
+    ApplyBitOperation(BitOperation::kXor, _words.data(), other._words.data(), std::min(_words.size(), other._words.size()));
+    ClearTail();
+    _rankValid = false;
+    return *this;
+}
+
+DynamicBitset& DynamicBitset::AndNot(const DynamicBitset& other) noexcept
+{
+    ApplyBitOperation(BitOperation::kAndNot, _words.data(), other._words.data(), std::min(_words.size(), other._words.size()));
+    _rankValid = false;
+    return *this;
+}
+
+DynamicBitset DynamicBitset::operator~() const
+{
+    DynamicBitset result(*this);
+    result.FlipAll();
+    return result;
+}
+
+size_t DynamicBitset::FindFrom(size_t index) const noexcept
+{
+    if (index >= _size)
+    {
+        return npos;
+    }
+    size_t   word    = index / 64;
+    uint64_t current = _words[word] & (~0ULL << (index % 64));
+    while (!current)
+    {
+        if (++word == _words.size())
+        {
+            return npos;
+        }
+        current = _words[word];
+    }
+    return word * 64 + CountRightZero(current);
+}
+
+void DynamicBitset::ClearTail() noexcept
+{
+    if (_size % 64)
+    {
+        _words.back() &= (1ULL << (_size % 64)) - 1;
+    }
+}
+} // namespace zeus
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic) 没有c++20，没有std::span可用
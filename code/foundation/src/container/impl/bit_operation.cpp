@@ -0,0 +1,134 @@
+﻿#include "bit_operation.h"
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic) 没有c++20，没有std::span可用
+#include "zeus/foundation/hardware/cpu_feature.h"
+#ifdef ZEUS_ARCH_X64
+#include <immintrin.h>
+#endif
+
+namespace zeus
+{
+namespace
+{
+using ApplyFunction = void (*)(uint64_t* destination, const uint64_t* source, size_t words);
+
+template<BitOperation Operation>
+uint64_t Combine(uint64_t destination, uint64_t source)
+{
+    switch (Operation)
+    {
+    case BitOperation::kAnd:
+        return destination & source;
+    case BitOperation::kOr:
+        return destination | source;
+    case BitOperation::kXor:
+        return destination ^ source;
+    case BitOperation::kAndNot:
+        return destination & ~source;
+    }
+    return destination;
+}
+
+template<BitOperation Operation>
+void ApplyScalar(uint64_t* destination, const uint64_t* source, size_t words)
+{
+    for (size_t index = 0; index < words; ++index)
+    {
+        destination[index] = Combine<Operation>(destination[index], source[index]);
+    }
+}
+
+#ifdef ZEUS_ARCH_X64
+template<BitOperation Operation>
+__m128i Combine128(__m128i destination, __m128i source)
+{
+    switch (Operation)
+    {
+    case BitOperation::kAnd:
+        return _mm_and_si128(destination, source);
+    case BitOperation::kOr:
+        return _mm_or_si128(destination, source);
+    case BitOperation::kXor:
+        return _mm_xor_si128(destination, source);
+    case BitOperation::kAndNot:
+        return _mm_andnot_si128(source, destination);
+    }
+    return destination;
+}
+
+template<BitOperation Operation>
+void ApplySse2(uint64_t* destination, const uint64_t* source, size_t words)
+{
+    size_t index = 0;
+    for (; index + 4 <= words; index += 4)
+    {
+        auto*         target = reinterpret_cast<__m128i*>(destination + index);
+        const auto*   from   = reinterpret_cast<const __m128i*>(source + index);
+        const __m128i first  = Combine128<Operation>(_mm_loadu_si128(target), _mm_loadu_si128(from));
+        const __m128i second = Combine128<Operation>(_mm_loadu_si128(target + 1), _mm_loadu_si128(from + 1));
+        _mm_storeu_si128(target, first);
+        _mm_storeu_si128(target + 1, second);
+    }
+    ApplyScalar<Operation>(destination + index, source + index, words - index);
+}
+
+template<BitOperation Operation>
+ZEUS_TARGET_AVX2 __m256i Combine256(__m256i destination, __m256i source)
+{
+    switch (Operation)
+    {
+    case BitOperation::kAnd:
+        return _mm256_and_si256(destination, source);
+    case BitOperation::kOr:
+        return _mm256_or_si256(destination, source);
+    case BitOperation::kXor:
+        return _mm256_xor_si256(destination, source);
+    case BitOperation::kAndNot:
+        return _mm256_andnot_si256(source, destination);
+    }
+    return destination;
+}
+
+template<BitOperation Operation>
+ZEUS_TARGET_AVX2 void ApplyAvx2(uint64_t* destination, const uint64_t* source, size_t words)
+{
+    size_t index = 0;
+    for (; index + 8 <= words; index += 8)
+    {
+        auto*         target = reinterpret_cast<__m256i*>(destination + index);
+        const auto*   from   = reinterpret_cast<const __m256i*>(source + index);
+        const __m256i first  = Combine256<Operation>(_mm256_loadu_si256(target), _mm256_loadu_si256(from));
+        const __m256i second = Combine256<Operation>(_mm256_loadu_si256(target + 1), _mm256_loadu_si256(from + 1));
+        _mm256_storeu_si256(target, first);
+        _mm256_storeu_si256(target + 1, second);
+    }
+    ApplySse2<Operation>(destination + index, source + index, words - index);
+}
+#endif
+
+template<BitOperation Operation>
+ApplyFunction SelectApply()
+{
+#ifdef ZEUS_ARCH_X64
+    if (Hardware::GetCpuFeature().avx2)
+    {
+        return ApplyAvx2<Operation>;
+    }
+    return ApplySse2<Operation>;
+#else
+    return ApplyScalar<Operation>;
+#endif
+}
+} // namespace
+
+void ApplyBitOperation(BitOperation operation, uint64_t* destination, const uint64_t* source, size_t words) noexcept
+{
+    static const ApplyFunction functions[] = {
+        SelectApply<BitOperation::kAnd>(),
+        SelectApply<BitOperation::kOr>(),
+        SelectApply<BitOperation::kXor>(),
+        SelectApply<BitOperation::kAndNot>(),
+    };
+    functions[static_cast<size_t>(operation)](destination, source, words);
+}
+} // namespace zeus
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic) 没有c++20，没有std::span可用
@@ -0,0 +1,18 @@
+﻿#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace zeus
+{
+enum class BitOperation
+{
+    kAnd,
+    kOr,
+    kXor,
+    kAndNot,
+};
+
+//destination = destination operation source，按CPU选择AVX2或者SSE2实现
+void ApplyBitOperation(BitOperation operation, uint64_t* destination, const uint64_t* source, size_t words) noexcept;
+} // namespace zeus
@@ -0,0 +1,924 @@
+﻿#include "zeus/foundation/container/roaring_bitmap.h"
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic) 没有c++20，没有std::span可用
+#include <algorithm>
+#include <iterator>
+#include "zeus/foundation/byte/byte_utils.h"
+#include "impl/bit_operation.h"
+
+namespace zeus
+{
+namespace
+{
+using Container     = RoaringBitmap::Container;
+using ContainerType = RoaringBitmap::ContainerType;
+
+constexpr uint32_t kMagic             = 0x3142525A; //"ZRB1"
+constexpr size_t   kHeaderSize        = 8;
+constexpr size_t   kContainerHeadSize = 8;
+constexpr size_t   kBitmapBytes       = RoaringBitmap::kBitmapWords * sizeof(uint64_t);
+
+uint16_t High(uint32_t value)
+{
+    return static_cast<uint16_t>(value >> 16);
+}
+
+uint16_t Low(uint32_t value)
+{
+    return static_cast<uint16_t>(value & 0xFFFF);
+}
+
+uint32_t CountWords(const uint64_t* words, size_t count)
+{
+    return static_cast<uint32_t>(CountOne(ByteBufferView(reinterpret_cast<const uint8_t*>(words), count * sizeof(uint64_t))));
+}
+
+//设置[begin, last]
+void SetRange(uint64_t* words, uint32_t begin, uint32_t last)
+{
+    const uint32_t first = begin / 64;
+    const uint32_t end   = last / 64;
+    const uint64_t head  = ~0ULL << (begin % 64);
+    const uint64_t tail  = ~0ULL >> (63 - last % 64);
+    if (first == end)
+    {
+        words[first] |= head & tail;
+        return;
+    }
+    words[first] |= head;
+    std::fill(words + first + 1, words + end, ~0ULL);
+    words[end] |= tail;
+}
+
+//按值检查，行程对是(起点,长度-1)
+bool RunContains(const std::vector<uint16_t>& runs, uint16_t low)
+{
+    size_t left  = 0;
+    size_t right = runs.size() / 2;
+    //找最后一个起点不大于low的行程
+    while (left < right)
+    {
+        const size_t middle = (left + right) / 2;
+        if (runs[middle * 2] <= low)
+        {
+            left = middle + 1;
+        }
+        else
+        {
+            right = middle;
+        }
+    }
+    return left && low - runs[(left - 1) * 2] <= runs[(left - 1) * 2 + 1];
+}
+
+bool ContainerContains(const Container& container, uint16_t low)
+{
+    switch (container.type)
+    {
+    case ContainerType::kArray:
+        return std::binary_search(container.values.begin(), container.values.end(), low);
+    case ContainerType::kBitmap:
+        return (container.words[low / 64] >> (low % 64)) & 1;
+    case ContainerType::kRun:
+        return RunContains(container.values, low);
+    }
+    return false;
+}
+
+//位图形式的副本，用于位图之间的运算
+std::vector<uint64_t> BitmapWords(const Container& container)
+{
+    if (ContainerType::kBitmap == container.type)
+    {
+        return container.words;
+    }
+    std::vector<uint64_t> words(RoaringBitmap::kBitmapWords, 0);
+    if (ContainerType::kArray == container.type)
+    {
+        for (const auto value : container.values)
+        {
+            words[value / 64] |= 1ULL << (value % 64);
+        }
+    }
+    else
+    {
+        for (size_t index = 0; index + 1 < container.values.size(); index += 2)
+        {
+            SetRange(words.data(), container.values[index], static_cast<uint32_t>(container.values[index]) + container.values[index + 1]);
+        }
+    }
+    return words;
+}
+
+std::vector<uint16_t> ArrayValues(const Container& container)
+{
+    if (ContainerType::kArray == container.type)
+    {
+        return container.values;
+    }
+    std::vector<uint16_t> values;
+    values.reserve(container.cardinality);
+    if (ContainerType::kBitmap == container.type)
+    {
+        ForEachSetBit(container.words.data(), container.words.size(), [&values](size_t bit) { values.emplace_back(static_cast<uint16_t>(bit)); });
+    }
+    else
+    {
+        for (size_t index = 0; index + 1 < container.values.size(); index += 2)
+        {
+            for (uint32_t offset = 0; offset <= container.values[index + 1]; ++offset)
+            {
+                values.emplace_back(static_cast<uint16_t>(container.values[index] + offset));
+            }
+        }
+    }
+    return values;
+}
+
+void ToBitmap(Container& container)
+{
+    if (ContainerType::kBitmap != container.type)
+    {
+        container.words = BitmapWords(container);
+        container.values.clear();
+        container.values.shrink_to_fit();
+        container.type = ContainerType::kBitmap;
+    }
+}
+
+void ToArray(Container& container)
+{
+    if (ContainerType::kArray != container.type)
+    {
+        container.values = ArrayValues(container);
+        container.words.clear();
+        container.words.shrink_to_fit();
+        container.type = ContainerType::kArray;
+    }
+}
+
+//cardinality已经正确时，按数量选择数组或者位图，行程容器保持不变
+void Normalize(Container& container)
+{
+    if (ContainerType::kBitmap == container.type && container.cardinality <= RoaringBitmap::kArrayMaxSize)
+    {
+        ToArray(container);
+    }
+    else if (ContainerType::kArray == container.type && container.cardinality > RoaringBitmap::kArrayMaxSize)
+    {
+        ToBitmap(container);
+    }
+}
+
+//修改之前把行程容器转换为数组或者位图
+void ToMutable(Container& container)
+{
+    if (ContainerType::kRun == container.type)
+    {
+        if (container.cardinality <= RoaringBitmap::kArrayMaxSize)
+        {
+            ToArray(container);
+        }
+        else
+        {
+            ToBitmap(container);
+        }
+    }
+}
+
+uint32_t RunCardinality(const std::vector<uint16_t>& runs)
+{
+    uint32_t cardinality = 0;
+    for (size_t index = 0; index + 1 < runs.size(); index += 2)
+    {
+        cardinality += runs[index + 1] + 1U;
+    }
+    return cardinality;
+}
+
+//小于low的值的个数
+uint32_t ContainerRank(const Container& container, uint16_t low)
+{
+    switch (container.type)
+    {
+    case ContainerType::kArray:
+        return static_cast<uint32_t>(std::lower_bound(container.values.begin(), container.values.end(), low) - container.values.begin());
+    case ContainerType::kBitmap:
+    {
+        uint32_t count = CountWords(container.words.data(), low / 64);
+        if (low % 64)
+        {
+            count += static_cast<uint32_t>(CountOne(static_cast<uint64_t>(container.words[low / 64] & ((1ULL << (low % 64)) - 1))));
+        }
+        return count;
+    }
+    case ContainerType::kRun:
+    {
+        uint32_t count = 0;
+        for (size_t index = 0; index + 1 < container.values.size() && container.values[index] < low; index += 2)
+        {
+            count += std::min<uint32_t>(container.values[index + 1] + 1U, static_cast<uint32_t>(low - container.values[index]));
+        }
+        return count;
+    }
+    }
+    return 0;
+}
+
+//调用者保证rank小于cardinality
+uint16_t ContainerSelect(const Container& container, uint32_t rank)
+{
+    switch (container.type)
+    {
+    case ContainerType::kArray:
+        return container.values[rank];
+    case ContainerType::kBitmap:
+        for (size_t index = 0; index < container.words.size(); ++index)
+        {
+            const auto count = static_cast<uint32_t>(CountOne(container.words[index]));
+            if (rank < count)
+            {
+                uint64_t word = container.words[index];
+                for (; rank; --rank)
+                {
+                    word &= word - 1;
+                }
+                return static_cast<uint16_t>(index * 64 + CountRightZero(word));
+            }
+            rank -= count;
+        }
+        break;
+    case ContainerType::kRun:
+        for (size_t index = 0; index + 1 < container.values.size(); index += 2)
+        {
+            if (rank <= container.values[index + 1])
+            {
+                return static_cast<uint16_t>(container.values[index] + rank);
+            }
+            rank -= container.values[index + 1] + 1U;
+        }
+        break;
+    }
+    return 0;
+}
+
+//行程的数量，位图中每个前一位为0的1是一个行程的起点
+size_t RunCount(const Container& container)
+{
+    size_t count = 0;
+    switch (container.type)
+    {
+    case ContainerType::kArray:
+        for (size_t index = 0; index < container.values.size(); ++index)
+        {
+            if (!index || container.values[index] != container.values[index - 1] + 1)
+            {
+                ++count;
+            }
+        }
+        break;
+    case ContainerType::kBitmap:
+    {
+        uint64_t carry = 0;
+        for (const auto word : container.words)
+        {
+            count += CountOne(word & ~((word << 1) | carry));
+            carry = word >> 63;
+        }
+        break;
+    }
+    case ContainerType::kRun:
+        count = container.values.size() / 2;
+        break;
+    }
+    return count;
+}
+
+size_t PayloadSize(const Container& container)
+{
+    switch (container.type)
+    {
+    case ContainerType::kArray:
+        return container.values.size() * sizeof(uint16_t);
+    case ContainerType::kBitmap:
+        return kBitmapBytes;
+    case ContainerType::kRun:
+        return container.values.size() * sizeof(uint16_t);
+    }
+    return 0;
+}
+
+void ToRun(Container& container)
+{
+    std::vector<uint16_t> runs;
+    runs.reserve(RunCount(container) * 2);
+    const auto values = ArrayValues(container);
+    for (size_t index = 0; index < values.size();)
+    {
+        size_t last = index;
+        while (last + 1 < values.size() && values[last + 1] == values[last] + 1)
+        {
+            ++last;
+        }
+        runs.emplace_back(values[index]);
+        runs.emplace_back(static_cast<uint16_t>(last - index));
+        index = last + 1;
+    }
+    container.values = std::move(runs);
+    container.words.clear();
+    container.words.shrink_to_fit();
+    container.type = ContainerType::kRun;
+}
+
+Container FromWords(uint16_t key, std::vector<uint64_t>&& words)
+{
+    Container result;
+    result.key         = key;
+    result.type        = ContainerType::kBitmap;
+    result.cardinality = CountWords(words.data(), words.size());
+    result.words       = std::move(words);
+    Normalize(result);
+    return result;
+}
+
+Container FromValues(uint16_t key, std::vector<uint16_t>&& values)
+{
+    Container result;
+    result.key         = key;
+    result.type        = ContainerType::kArray;
+    result.cardinality = static_cast<uint32_t>(values.size());
+    result.values      = std::move(values);
+    Normalize(result);
+    return result;
+}
+
+//数组和数组之间用有序合并，数组和其他容器之间按值过滤，其他情况转换为位图按字运算
+Container Combine(BitOperation operation, const Container& lhs, const Container& rhs)
+{
+    const bool lhsArray = ContainerType::kArray == lhs.type;
+    const bool rhsArray = ContainerType::kArray == rhs.type;
+    std::vector<uint16_t> values;
+    switch (operation)
+    {
+    case BitOperation::kAnd:
+        if (lhsArray && rhsArray)
+        {
+            std::set_intersection(lhs.values.begin(), lhs.values.end(), rhs.values.begin(), rhs.values.end(), std::back_inserter(values));
+            return FromValues(lhs.key, std::move(values));
+        }
+        if (lhsArray || rhsArray)
+        {
+            const auto& array = lhsArray ? lhs : rhs;
+            const auto& other = lhsArray ? rhs : lhs;
+            std::copy_if(array.values.begin(), array.values.end(), std::back_inserter(values), [&other](uint16_t value) { return ContainerContains(other, value); });
+            return FromValues(lhs.key, std::move(values));
+        }
+        break;
+    case BitOperation::kOr:
+        if (lhsArray && rhsArray && lhs.values.size() + rhs.values.size() <= RoaringBitmap::kArrayMaxSize)
+        {
+            std::set_union(lhs.values.begin(), lhs.values.end(), rhs.values.begin(), rhs.values.end(), std::back_inserter(values));
+            return FromValues(lhs.key, std::move(values));
+        }
+        //整块已满时结果就是满块
+        if (RoaringBitmap::kContainerBits == lhs.cardinality)
+        {
+            return lhs;
+        }
+        if (RoaringBitmap::kContainerBits == rhs.cardinality)
+        {
+            return rhs;
+        }
+        break;
+    case BitOperation::kXor:
+        if (lhsArray && rhsArray)
+        {
+            std::set_symmetric_difference(lhs.values.begin(), lhs.values.end(), rhs.values.begin(), rhs.values.end(), std::back_inserter(values));
+            return FromValues(lhs.key, std::move(values));
+        }
+        break;
+    case BitOperation::kAndNot:
+        if (lhsArray)
+        {
+            std::copy_if(lhs.values.begin(), lhs.values.end(), std::back_inserter(values), [&rhs](uint16_t value) { return !ContainerContains(rhs, value); });
+            return FromValues(lhs.key, std::move(values));
+        }
+        break;
+    }
+    auto       words = BitmapWords(lhs);
+    const auto other = BitmapWords(rhs);
+    ApplyBitOperation(operation, words.data(), other.data(), words.size());
+    return FromWords(lhs.key, std::move(words));
+}
+
+//按key合并两组块，只在一边出现的块根据运算决定是否保留
+std::vector<Container> Merge(BitOperation operation, std::vector<Container>&& lhs, const std::vector<Container>& rhs)
+{
+    const bool             keepLeft  = BitOperation::kAnd != operation;
+    const bool             keepRight = BitOperation::kOr == operation || BitOperation::kXor == operation;
+    std::vector<Container> result;
+    result.reserve(keepRight ? lhs.size() + rhs.size() : lhs.size());
+    auto left  = lhs.begin();
+    auto right = rhs.begin();
+    while (left != lhs.end() || right != rhs.end())
+    {
+        if (right == rhs.end() || (left != lhs.end() && left->key < right->key))
+        {
+            if (keepLeft)
+            {
+                result.emplace_back(std::move(*left));
+            }
+            ++left;
+        }
+        else if (left == lhs.end() || right->key < left->key)
+        {
+            if (keepRight)
+            {
+                result.emplace_back(*right);
+            }
+            ++right;
+        }
+        else
+        {
+            auto container = Combine(operation, *left, *right);
+            if (container.cardinality)
+            {
+                result.emplace_back(std::move(container));
+            }
+            ++left;
+            ++right;
+        }
+    }
+    return result;
+}
+
+template<typename T>
+void PutLittle(std::vector<uint8_t>& buffer, T value)
+{
+    for (size_t index = 0; index < sizeof(T); ++index)
+    {
+        buffer.emplace_back(static_cast<uint8_t>(value >> (index * 8)));
+    }
+}
+
+template<typename T>
+T GetLittle(const uint8_t* data)
+{
+    T value = 0;
+    for (size_t index = 0; index < sizeof(T); ++index)
+    {
+        value |= static_cast<T>(static_cast<T>(data[index]) << (index * 8));
+    }
+    return value;
+}
+} // namespace
+
+RoaringBitmap::RoaringBitmap(std::initializer_list<uint32_t> values) : RoaringBitmap(values.begin(), values.size())
+{
+}
+
+RoaringBitmap::RoaringBitmap(const uint32_t* values, size_t size)
+{
+    AddMany(values, size);
+}
+
+void RoaringBitmap::Add(uint32_t value)
+{
+    auto&          container = FindOrInsert(High(value));
+    const uint16_t low       = Low(value);
+    if (container.cardinality && ContainerContains(container, low))
+    {
+        return;
+    }
+    ToMutable(container);
+    if (ContainerType::kArray == container.type)
+    {
+        container.values.insert(std::upper_bound(container.values.begin(), container.values.end(), low), low);
+    }
+    else
+    {
+        container.words[low / 64] |= 1ULL << (low % 64);
+    }
+    ++container.cardinality;
+    Normalize(container);
+}
+
+void RoaringBitmap::AddMany(const uint32_t* values, size_t size)
+{
+    std::vector<uint32_t> sorted(values, values + size);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    for (size_t index = 0; index < sorted.size();)
+    {
+        const uint16_t key = High(sorted[index]);
+        size_t         end = index;
+        while (end < sorted.size() && High(sorted[end]) == key)
+        {
+            ++end;
+        }
+        auto& container = FindOrInsert(key);
+        ToMutable(container);
+        if (ContainerType::kArray == container.type && container.values.size() + (end - index) <= kArrayMaxSize)
+        {
+            std::vector<uint16_t> merged;
+            merged.reserve(container.values.size() + (end - index));
+            std::vector<uint16_t> lows;
+            lows.reserve(end - index);
+            std::transform(sorted.begin() + static_cast<std::ptrdiff_t>(index), sorted.begin() + static_cast<std::ptrdiff_t>(end), std::back_inserter(lows), Low);
+            std::set_union(container.values.begin(), container.values.end(), lows.begin(), lows.end(), std::back_inserter(merged));
+            container.values = std::move(merged);
+        }
+        else
+        {
+            ToBitmap(container);
+            for (size_t position = index; position < end; ++position)
+            {
+                const uint16_t low = Low(sorted[position]);
+                container.words[low / 64] |= 1ULL << (low % 64);
+            }
+        }
+        container.cardinality =
+            ContainerType::kArray == container.type ? static_cast<uint32_t>(container.values.size()) : CountWords(container.words.data(), container.words.size());
+        Normalize(container);
+        index = end;
+    }
+}
+
+void RoaringBitmap::AddRange(uint64_t begin, uint64_t end)
+{
+    end = std::min<uint64_t>(end, 0x100000000ULL);
+    if (begin >= end)
+    {
+        return;
+    }
+    const auto firstKey = static_cast<uint32_t>(begin >> 16);
+    const auto lastKey  = static_cast<uint32_t>((end - 1) >> 16);
+    for (uint32_t key = firstKey; key <= lastKey; ++key)
+    {
+        const uint32_t lowBegin  = key == firstKey ? Low(static_cast<uint32_t>(begin)) : 0;
+        const uint32_t lowLast   = key == lastKey ? Low(static_cast<uint32_t>(end - 1)) : 0xFFFF;
+        auto&          container = FindOrInsert(static_cast<uint16_t>(key));
+        if (0 == lowBegin && 0xFFFF == lowLast)
+        {
+            container.type        = ContainerType::kRun;
+            container.values      = {0, 0xFFFF};
+            container.cardinality = kContainerBits;
+            container.words.clear();
+            container.words.shrink_to_fit();
+            continue;
+        }
+        if (kContainerBits == container.cardinality)
+        {
+            continue;
+        }
+        ToBitmap(container);
+        SetRange(container.words.data(), lowBegin, lowLast);
+        container.cardinality = CountWords(container.words.data(), container.words.size());
+        Normalize(container);
+    }
+}
+
+bool RoaringBitmap::Remove(uint32_t value)
+{
+    auto*          container = Find(High(value));
+    const uint16_t low       = Low(value);
+    if (!container || !ContainerContains(*container, low))
+    {
+        return false;
+    }
+    if (1 == container->cardinality)
+    {
+        _containers.erase(_containers.begin() + (container - _containers.data()));
+        return true;
+    }
+    ToMutable(*container);
+    if (ContainerType::kArray == container->type)
+    {
+        container->values.erase(std::lower_bound(container->values.begin(), container->values.end(), low));
+    }
+    else
+    {
+        container->words[low / 64] &= ~(1ULL << (low % 64));
+    }
+    --container->cardinality;
+    Normalize(*container);
+    return true;
+}
+
+bool RoaringBitmap::Contains(uint32_t value) const noexcept
+{
+    const auto* container = Find(High(value));
+    return container && ContainerContains(*container, Low(value));
+}
+
+uint64_t RoaringBitmap::Cardinality() const noexcept
+{
+    uint64_t cardinality = 0;
+    for (const auto& container : _containers)
+    {
+        cardinality += container.cardinality;
+    }
+    return cardinality;
+}
+
+uint64_t RoaringBitmap::Rank(uint32_t value) const noexcept
+{
+    const uint16_t key  = High(value);
+    uint64_t       rank = 0;
+    for (const auto& container : _containers)
+    {
+        if (container.key > key)
+        {
+            break;
+        }
+        rank += container.key < key ? container.cardinality : ContainerRank(container, Low(value));
+    }
+    return rank;
+}
+
+std::optional<uint32_t> RoaringBitmap::Select(uint64_t rank) const noexcept
+{
+    for (const auto& container : _containers)
+    {
+        if (rank < container.cardinality)
+        {
+            return static_cast<uint32_t>(container.key) << 16 | ContainerSelect(container, static_cast<uint32_t>(rank));
+        }
+        rank -= container.cardinality;
+    }
+    return std::nullopt;
+}
+
+std::optional<uint32_t> RoaringBitmap::Minimum() const noexcept
+{
+    if (_containers.empty())
+    {
+        return std::nullopt;
+    }
+    return Select(0);
+}
+
+std::optional<uint32_t> RoaringBitmap::Maximum() const noexcept
+{
+    if (_containers.empty())
+    {
+        return std::nullopt;
+    }
+    const auto& container = _containers.back();
+    return static_cast<uint32_t>(container.key) << 16 | ContainerSelect(container, container.cardinality - 1);
+}
+
+std::vector<uint32_t> RoaringBitmap::ToVector() const
+{
+    std::vector<uint32_t> result;
+    result.reserve(static_cast<size_t>(Cardinality()));
+    ForEach([&result](uint32_t value) { result.emplace_back(value); });
+    return result;
+}
+
+bool RoaringBitmap::RunOptimize()
+{
+    bool changed = false;
+    for (auto& container : _containers)
+    {
+        if (ContainerType::kRun != container.type && RunCount(container) * 2 * sizeof(uint16_t) < PayloadSize(container))
+        {
+            ToRun(container);
+            changed = true;
+        }
+    }
+    return changed;
+}
+
+size_t RoaringBitmap::MemoryUsage() const noexcept
+{
+    size_t usage = _containers.capacity() * sizeof(Container);
+    for (const auto& container : _containers)
+    {
+        usage += container.values.capacity() * sizeof(uint16_t) + container.words.capacity() * sizeof(uint64_t);
+    }
+    return usage;
+}
+
+RoaringBitmap& RoaringBitmap::operator&=(const RoaringBitmap& other)
+{
+    _containers = Merge(BitOperation::kAnd, std::move(_containers), other._containers);
+    return *this;
+}
+
+RoaringBitmap& RoaringBitmap::operator|=(const RoaringBitmap& other)
+{
+    _containers = Merge(BitOperation::kOr, std::move(_containers), other._containers);
+    return *this;
+}
+
+RoaringBitmap& RoaringBitmap::operator^=(const RoaringBitmap& other)
+{
+    _containers = Merge(BitOperation::kXor, std::move(_containers), other._containers);
+    return *this;
+}
+
+RoaringBitmap& RoaringBitmap::AndNot(const RoaringBitmap& other)
+{
+    _containers = Merge(BitOperation::kAndNot, std::move(_containers), other._containers);
+    return *this;
+}
+
+std::vector<uint8_t> RoaringBitmap::Serialize() const
+{
+    size_t size = kHeaderSize;
+    for (const auto& container : _containers)
+    {
+        size += kContainerHeadSize + PayloadSize(container);
+    }
+    std::vector<uint8_t> buffer;
+    buffer.reserve(size);
+    PutLittle(buffer, kMagic);
+    PutLittle(buffer, static_cast<uint32_t>(_containers.size()));
+    for (const auto& container : _containers)
+    {
+        PutLittle(buffer, container.key);
+        PutLittle(buffer, static_cast<uint8_t>(container.type));
+        PutLittle(buffer, static_cast<uint8_t>(0));
+        //行程容器记录行程数量，其他记录值的数量
+        PutLittle(buffer, ContainerType::kRun == container.type ? static_cast<uint32_t>(container.values.size() / 2) : container.cardinality);
+        if (ContainerType::kBitmap == container.type)
+        {
+            for (const auto word : container.words)
+            {
+                PutLittle(buffer, word);
+            }
+        }
+        else
+        {
+            for (const auto value : container.values)
+            {
+                PutLittle(buffer, value);
+            }
+        }
+    }
+    return buffer;
+}
+
+zeus::expected<RoaringBitmap, SerializerError> RoaringBitmap::Deserialize(const void* data, size_t size)
+{
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    if (size < kHeaderSize || kMagic != GetLittle<uint32_t>(bytes))
+    {
+        return zeus::unexpected(SerializerError::kDataFormatError);
+    }
+    const auto    count  = GetLittle<uint32_t>(bytes + 4);
+    size_t        offset = kHeaderSize;
+    RoaringBitmap result;
+    //每块至少有头部，先检查数量避免按错误的数量预分配
+    if (count > (size - offset) / kContainerHeadSize)
+    {
+        return zeus::unexpected(SerializerError::kDataFormatError);
+    }
+    result._containers.reserve(count);
+    for (uint32_t index = 0; index < count; ++index)
+    {
+        if (size - offset < kContainerHeadSize)
+        {
+            return zeus::unexpected(SerializerError::kDataFormatError);
+        }
+        Container container;
+        container.key        = GetLittle<uint16_t>(bytes + offset);
+        container.type       = static_cast<ContainerType>(bytes[offset + 2]);
+        const auto itemCount = GetLittle<uint32_t>(bytes + offset + 4);
+        offset += kContainerHeadSize;
+        if (!result._containers.empty() && container.key <= result._containers.back().key)
+        {
+            return zeus::unexpected(SerializerError::kDataFormatError);
+        }
+        switch (container.type)
+        {
+        case ContainerType::kArray:
+            if (!itemCount || itemCount > kArrayMaxSize || (size - offset) / sizeof(uint16_t) < itemCount)
+            {
+                return zeus::unexpected(SerializerError::kDataFormatError);
+            }
+            container.values.resize(itemCount);
+            for (uint32_t item = 0; item < itemCount; ++item)
+            {
+                container.values[item] = GetLittle<uint16_t>(bytes + offset + item * sizeof(uint16_t));
+                if (item && container.values[item] <= container.values[item - 1])
+                {
+                    return zeus::unexpected(SerializerError::kDataFormatError);
+                }
+            }
+            container.cardinality = itemCount;
+            offset += itemCount * sizeof(uint16_t);
+            break;
+        case ContainerType::kBitmap:
+            if (size - offset < kBitmapBytes)
+            {
+                return zeus::unexpected(SerializerError::kDataFormatError);
+            }
+            container.words.resize(kBitmapWords);
+            for (size_t word = 0; word < kBitmapWords; ++word)
+            {
+                container.words[word] = GetLittle<uint64_t>(bytes + offset + word * sizeof(uint64_t));
+            }
+            container.cardinality = CountWords(container.words.data(), container.words.size());
+            if (container.cardinality != itemCount || container.cardinality <= kArrayMaxSize)
+            {
+                return zeus::unexpected(SerializerError::kDataFormatError);
+            }
+            offset += kBitmapBytes;
+            break;
+        case ContainerType::kRun:
+        {
+            if (!itemCount || itemCount > kContainerBits / 2 || (size - offset) / (2 * sizeof(uint16_t)) < itemCount)
+            {
+                return zeus::unexpected(SerializerError::kDataFormatError);
+            }
+            container.values.resize(static_cast<size_t>(itemCount) * 2);
+            uint32_t next = 0; //下一个行程允许的最小起点
+            for (size_t item = 0; item < container.values.size(); item += 2)
+            {
+                container.values[item]     = GetLittle<uint16_t>(bytes + offset + item * sizeof(uint16_t));
+                container.values[item + 1] = GetLittle<uint16_t>(bytes + offset + (item + 1) * sizeof(uint16_t));
+                const uint32_t last        = static_cast<uint32_t>(container.values[item]) + container.values[item + 1];
+                if (container.values[item] < next || last > 0xFFFF)
+                {
+                    return zeus::unexpected(SerializerError::kDataFormatError);
+                }
+                next = last + 2;
+            }
+            container.cardinality = RunCardinality(container.values);
+            offset += container.values.size() * sizeof(uint16_t);
+            break;
+        }
+        default:
+            return zeus::unexpected(SerializerError::kDataFormatError);
+        }
+        result._containers.emplace_back(std::move(container));
+    }
+    if (offset != size)
+    {
+        return zeus::unexpected(SerializerError::kDataFormatError);
+    }
+    return result;
+}
+
+zeus::expected<void, SerializerError> RoaringBitmap::Save(Serializer& serializer) const
+{
+    return serializer.Save(Serialize());
+}
+
+zeus::expected<RoaringBitmap, SerializerError> RoaringBitmap::Load(Serializer& serializer)
+{
+    auto data = serializer.Load();
+    if (!data.has_value())
+    {
+        return zeus::unexpected(data.error());
+    }
+    return Deserialize(data->data(), data->size());
+}
+
+bool RoaringBitmap::Equal(const RoaringBitmap& lhs, const RoaringBitmap& rhs)
+{
+    if (lhs._containers.size() != rhs._containers.size())
+    {
+        return false;
+    }
+    for (size_t index = 0; index < lhs._containers.size(); ++index)
+    {
+        const auto& left  = lhs._containers[index];
+        const auto& right = rhs._containers[index];
+        if (left.key != right.key || left.cardinality != right.cardinality)
+        {
+            return false;
+        }
+        if (left.type == right.type ? left.values != right.values || left.words != right.words : BitmapWords(left) != BitmapWords(right))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+RoaringBitmap::Container* RoaringBitmap::Find(uint16_t key) noexcept
+{
+    return const_cast<Container*>(static_cast<const RoaringBitmap*>(this)->Find(key));
+}
+
+const RoaringBitmap::Container* RoaringBitmap::Find(uint16_t key) const noexcept
+{
+    auto iter = std::lower_bound(_containers.begin(), _containers.end(), key, [](const Container& container, uint16_t value) { return container.key < value; });
+    return iter != _containers.end() && iter->key == key ? &*iter : nullptr;
+}
+
+RoaringBitmap::Container& RoaringBitmap::FindOrInsert(uint16_t key)
+{
+    auto iter = std::lower_bound(_containers.begin(), _containers.end(), key, [](const Container& container, uint16_t value) { return container.key < value; });
+    if (iter == _containers.end() || iter->key != key)
+    {
+        Container container;
+        container.key = key;
+        iter          = _containers.insert(iter, std::move(container));
+    }
+    return *iter;
+}
+} // namespace zeus
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic) 没有c++20，没有std::span可用
@@ -0,0 +1,60 @@
+﻿#include "zeus/foundation/crypt/aes_gcm.h"
+#include "impl/aes_gcm_impl.h"
+
+namespace zeus
+{
+AesGcm::AesGcm(const void *key, size_t keyLength) : _impl(std::make_unique<AesGcmImpl>(key, keyLength))
+{
+}
+
+AesGcm::AesGcm(const std::string &key) : AesGcm(key.data(), key.size())
+{
+}
+
+AesGcm::~AesGcm()
+{
+}
+
+AesGcm::AesGcm(AesGcm &&other) noexcept : _impl(std::move(other._impl))
+{
+}
+
+AesGcm &AesGcm::operator=(AesGcm &&other) noexcept
+{
+    if (this != &other)
+    {
+        _impl = std::move(other._impl);
+    }
+    return *this;
+}
+
+std::string AesGcm::Name()
+{
+    return _impl->Name();
+}
+
+void AesGcm::Encrypt(
+    const void *iv, size_t ivLength, const void *aad, size_t aadLength, const void *input, size_t length, void *output, void *tag, size_t tagLength
+)
+{
+    _impl->Encrypt(iv, ivLength, aad, aadLength, input, length, output, tag, tagLength);
+}
+
+void AesGcm::Encrypt(const void *iv, size_t ivLength, const void *input, size_t length, void *output, void *tag, size_t tagLength)
+{
+    _impl->Encrypt(iv, ivLength, nullptr, 0, input, length, output, tag, tagLength);
+}
+
+bool AesGcm::Decrypt(
+    const void *iv, size_t ivLength, const void *aad, size_t aadLength, const void *input, size_t length, void *output, const void *tag,
+    size_t tagLength
+)
+{
+    return _impl->Decrypt(iv, ivLength, aad, aadLength, input, length, output, tag, tagLength);
+}
+
+bool AesGcm::Decrypt(const void *iv, size_t ivLength, const void *input, size_t length, void *output, const void *tag, size_t tagLength)
+{
+    return _impl->Decrypt(iv, ivLength, nullptr, 0, input, length, output, tag, tagLength);
+}
+} // namespace zeus
@@ -0,0 +1,373 @@
+﻿#include "zeus/foundation/crypt/base64.h"
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic) 没有c++20，没有std::span可用
+#include <array>
+#include <cassert>
+#include "zeus/foundation/hardware/cpu_feature.h"
+#ifdef ZEUS_ARCH_X64
+#include <immintrin.h>
+#endif
+
+namespace zeus
+{
+namespace
+{
+constexpr char kStandardTable[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+constexpr char kUrlSafeTable[]  = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+constexpr char kPadding         = '=';
+constexpr auto kInvalid         = static_cast<uint8_t>(0xFF);
+
+constexpr std::array<uint8_t, 256> MakeDecodeTable(const char* table)
+{
+    std::array<uint8_t, 256> decode {};
+    for (auto& item : decode)
+    {
+        item = kInvalid;
+    }
+    for (size_t index = 0; index < 64; ++index)
+    {
+        decode[static_cast<uint8_t>(table[index])] = static_cast<uint8_t>(index);
+    }
+    return decode;
+}
+
+constexpr std::array<uint8_t, 256> kStandardDecodeTable = MakeDecodeTable(kStandardTable);
+constexpr std::array<uint8_t, 256> kUrlSafeDecodeTable  = MakeDecodeTable(kUrlSafeTable);
+
+const char* EncodeTable(Base64::Alphabet alphabet)
+{
+    return Base64::Alphabet::kUrlSafe == alphabet ? kUrlSafeTable : kStandardTable;
+}
+
+const uint8_t* DecodeTable(Base64::Alphabet alphabet)
+{
+    return Base64::Alphabet::kUrlSafe == alphabet ? kUrlSafeDecodeTable.data() : kStandardDecodeTable.data();
+}
+
+//SIMD内核只处理能完整装入寄存器的部分，返回消耗的输入长度，剩余部分由标量代码处理
+using EncodeBlocksFunction = size_t (*)(const uint8_t* input, size_t length, char* output, const char* table);
+using DecodeBlocksFunction = size_t (*)(const char* input, size_t length, uint8_t* output, const char* table);
+
+size_t EncodeBlocksScalar(const uint8_t* input, size_t length, char* output, const char* table)
+{
+    const size_t blocks = length / 3;
+    for (size_t index = 0; index < blocks; ++index, input += 3, output += 4)
+    {
+        const uint32_t value = (static_cast<uint32_t>(input[0]) << 16) | (static_cast<uint32_t>(input[1]) << 8) | input[2];
+        output[0]            = table[(value >> 18) & 0x3F];
+        output[1]            = table[(value >> 12) & 0x3F];
+        output[2]            = table[(value >> 6) & 0x3F];
+        output[3]            = table[value & 0x3F];
+    }
+    return blocks * 3;
+}
+
+size_t DecodeBlocksScalar(const char* input, size_t length, uint8_t* output, const char* table)
+{
+    const uint8_t* decode = table == kUrlSafeTable ? kUrlSafeDecodeTable.data() : kStandardDecodeTable.data();
+    const size_t   blocks = length / 4;
+    for (size_t index = 0; index < blocks; ++index, input += 4, output += 3)
+    {
+        const uint8_t a = decode[static_cast<uint8_t>(input[0])];
+        const uint8_t b = decode[static_cast<uint8_t>(input[1])];
+        const uint8_t c = decode[static_cast<uint8_t>(input[2])];
+        const uint8_t d = decode[static_cast<uint8_t>(input[3])];
+        if ((a | b | c | d) & 0x80)
+        {
+            return index * 4;
+        }
+        const uint32_t value = (static_cast<uint32_t>(a) << 18) | (static_cast<uint32_t>(b) << 12) | (static_cast<uint32_t>(c) << 6) | d;
+        output[0]            = static_cast<uint8_t>(value >> 16);
+        output[1]            = static_cast<uint8_t>(value >> 8);
+        output[2]            = static_cast<uint8_t>(value);
+    }
+    return blocks * 4;
+}
+
+#ifdef ZEUS_ARCH_X64
+//编码参考Wojciech Muła的算法：先把每3字节拆成4个6bit索引，再按索引区间加上偏移得到字符
+ZEUS_TARGET_SSSE3 inline __m128i SplitIndicesSsse3(__m128i input)
+{
+    input              = _mm_shuffle_epi8(input, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    const __m128i high = _mm_mulhi_epu16(_mm_and_si128(input, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+    const __m128i low  = _mm_mullo_epi16(_mm_and_si128(input, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(high, low);
+}
+
+ZEUS_TARGET_SSSE3 inline __m128i IndicesToCharsSsse3(__m128i indices, __m128i shift)
+{
+    __m128i       reduced = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    const __m128i less    = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+    reduced               = _mm_or_si128(reduced, _mm_and_si128(less, _mm_set1_epi8(13)));
+    return _mm_add_epi8(indices, _mm_shuffle_epi8(shift, reduced));
+}
+
+inline __m128i EncodeShift(const char* table)
+{
+    return _mm_setr_epi8(
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        static_cast<char>(table[62] - 62), static_cast<char>(table[63] - 63), 'A', 0, 0
+    );
+}
+
+ZEUS_TARGET_SSSE3 size_t EncodeBlocksSsse3(const uint8_t* input, size_t length, char* output, const char* table)
+{
+    const __m128i shift    = EncodeShift(table);
+    size_t        consumed = 0;
+    //每次读16字节只用12字节，保证不越界读
+    for (; consumed + 16 <= length; consumed += 12, output += 16)
+    {
+        const __m128i indices = SplitIndicesSsse3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + consumed)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), IndicesToCharsSsse3(indices, shift));
+    }
+    return consumed + EncodeBlocksScalar(input + consumed, length - consumed, output, table);
+}
+
+ZEUS_TARGET_AVX2 inline __m256i SplitIndicesAvx2(__m256i input)
+{
+    const __m256i order = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10, 1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    input               = _mm256_shuffle_epi8(input, order);
+    const __m256i high  = _mm256_mulhi_epu16(_mm256_and_si256(input, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+    const __m256i low   = _mm256_mullo_epi16(_mm256_and_si256(input, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+    return _mm256_or_si256(high, low);
+}
+
+ZEUS_TARGET_AVX2 inline __m256i IndicesToCharsAvx2(__m256i indices, __m256i shift)
+{
+    __m256i       reduced = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+    const __m256i less    = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+    reduced               = _mm256_or_si256(reduced, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+    return _mm256_add_epi8(indices, _mm256_shuffle_epi8(shift, reduced));
+}
+
+ZEUS_TARGET_AVX2 size_t EncodeBlocksAvx2(const uint8_t* input, size_t length, char* output, const char* table)
+{
+    const __m128i shift128 = EncodeShift(table);
+    const __m256i shift    = _mm256_broadcastsi128_si256(shift128);
+    size_t        consumed = 0;
+    //两个128位通道各处理12字节，第二次读取需要额外4字节
+    for (; consumed + 28 <= length; consumed += 24, output += 32)
+    {
+        const __m128i low   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + consumed));
+        const __m128i high  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + consumed + 12));
+        const __m256i block = _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), IndicesToCharsAvx2(SplitIndicesAvx2(block), shift));
+    }
+    return consumed + EncodeBlocksSsse3(input + consumed, length - consumed, output, table);
+}
+
+//解码时按字符区间计算偏移，同时校验字符是否合法，合并后的6bit值再用乘加指令拼成字节
+ZEUS_TARGET_SSSE3 inline bool CharsToValuesSsse3(__m128i input, __m128i& values, char char62, char char63)
+{
+    const __m128i upper  = _mm_and_si128(_mm_cmpgt_epi8(input, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(input, _mm_set1_epi8('Z' + 1)));
+    const __m128i lower  = _mm_and_si128(_mm_cmpgt_epi8(input, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(input, _mm_set1_epi8('z' + 1)));
+    const __m128i digit  = _mm_and_si128(_mm_cmpgt_epi8(input, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(input, _mm_set1_epi8('9' + 1)));
+    const __m128i is62   = _mm_cmpeq_epi8(input, _mm_set1_epi8(char62));
+    const __m128i is63   = _mm_cmpeq_epi8(input, _mm_set1_epi8(char63));
+    const __m128i valid  = _mm_or_si128(_mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, is62)), is63);
+    __m128i       offset = _mm_or_si128(_mm_and_si128(upper, _mm_set1_epi8(-'A')), _mm_and_si128(lower, _mm_set1_epi8(26 - 'a')));
+    offset               = _mm_or_si128(offset, _mm_and_si128(digit, _mm_set1_epi8(52 - '0')));
+    offset               = _mm_or_si128(offset, _mm_and_si128(is62, _mm_set1_epi8(static_cast<char>(62 - char62))));
+    offset               = _mm_or_si128(offset, _mm_and_si128(is63, _mm_set1_epi8(static_cast<char>(63 - char63))));
+    values               = _mm_add_epi8(input, offset);
+    return 0xFFFF == _mm_movemask_epi8(valid);
+}
+
+ZEUS_TARGET_SSSE3 inline __m128i PackValuesSsse3(__m128i values)
+{
+    const __m128i merged = _mm_madd_epi16(_mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140)), _mm_set1_epi32(0x00011000));
+    return _mm_shuffle_epi8(merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+ZEUS_TARGET_SSSE3 size_t DecodeBlocksSsse3(const char* input, size_t length, uint8_t* output, const char* table)
+{
+    size_t consumed = 0;
+    //每次写16字节只有12字节有效，后面至少还有8个字符(>=4字节输出)才不会写越界
+    for (; consumed + 24 <= length; consumed += 16, output += 12)
+    {
+        __m128i values;
+        if (!CharsToValuesSsse3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + consumed)), values, table[62], table[63]))
+        {
+            break;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), PackValuesSsse3(values));
+    }
+    return consumed + DecodeBlocksScalar(input + consumed, length - consumed, output, table);
+}
+
+ZEUS_TARGET_AVX2 inline bool CharsToValuesAvx2(__m256i input, __m256i& values, char char62, char char63)
+{
+    const __m256i upper =
+        _mm256_and_si256(_mm256_cmpgt_epi8(input, _mm256_set1_epi8('A' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), input));
+    const __m256i lower =
+        _mm256_and_si256(_mm256_cmpgt_epi8(input, _mm256_set1_epi8('a' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), input));
+    const __m256i digit =
+        _mm256_and_si256(_mm256_cmpgt_epi8(input, _mm256_set1_epi8('0' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), input));
+    const __m256i is62   = _mm256_cmpeq_epi8(input, _mm256_set1_epi8(char62));
+    const __m256i is63   = _mm256_cmpeq_epi8(input, _mm256_set1_epi8(char63));
+    const __m256i valid  = _mm256_or_si256(_mm256_or_si256(_mm256_or_si256(upper, lower), _mm256_or_si256(digit, is62)), is63);
+    __m256i       offset = _mm256_or_si256(_mm256_and_si256(upper, _mm256_set1_epi8(-'A')), _mm256_and_si256(lower, _mm256_set1_epi8(26 - 'a')));
+    offset               = _mm256_or_si256(offset, _mm256_and_si256(digit, _mm256_set1_epi8(52 - '0')));
+    offset               = _mm256_or_si256(offset, _mm256_and_si256(is62, _mm256_set1_epi8(static_cast<char>(62 - char62))));
+    offset               = _mm256_or_si256(offset, _mm256_and_si256(is63, _mm256_set1_epi8(static_cast<char>(63 - char63))));
+    values               = _mm256_add_epi8(input, offset);
+    return -1 == _mm256_movemask_epi8(valid);
+}
+
+ZEUS_TARGET_AVX2 size_t DecodeBlocksAvx2(const char* input, size_t length, uint8_t* output, const char* table)
+{
+    const __m256i order = _mm256_setr_epi8(
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1
+    );
+    size_t consumed = 0;
+    //每次写32字节只有24字节有效，后面至少还有16个字符(>=10字节输出)才不会写越界
+    for (; consumed + 48 <= length; consumed += 32, output += 24)
+    {
+        __m256i values;
+        if (!CharsToValuesAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + consumed)), values, table[62], table[63]))
+        {
+            break;
+        }
+        __m256i merged = _mm256_madd_epi16(_mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140)), _mm256_set1_epi32(0x00011000));
+        merged         = _mm256_shuffle_epi8(merged, order);
+        merged         = _mm256_permutevar8x32_epi32(merged, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output), merged);
+    }
+    return consumed + DecodeBlocksSsse3(input + consumed, length - consumed, output, table);
+}
+#endif
+
+EncodeBlocksFunction SelectEncodeBlocks()
+{
+#ifdef ZEUS_ARCH_X64
+    const auto& feature = Hardware::GetCpuFeature();
+    if (feature.avx2)
+    {
+        return EncodeBlocksAvx2;
+    }
+    if (feature.ssse3)
+    {
+        return EncodeBlocksSsse3;
+    }
+#endif
+    return EncodeBlocksScalar;
+}
+
+DecodeBlocksFunction SelectDecodeBlocks()
+{
+#ifdef ZEUS_ARCH_X64
+    const auto& feature = Hardware::GetCpuFeature();
+    if (feature.avx2)
+    {
+        return DecodeBlocksAvx2;
+    }
+    if (feature.ssse3)
+    {
+        return DecodeBlocksSsse3;
+    }
+#endif
+    return DecodeBlocksScalar;
+}
+} // namespace
+
+size_t Base64::Encode(const void* input, size_t length, char* output, Alphabet alphabet, bool padding) noexcept
+{
+    static const EncodeBlocksFunction encodeBlocks = SelectEncodeBlocks();
+
+    const char* table    = EncodeTable(alphabet);
+    const auto* data     = static_cast<const uint8_t*>(input);
+    const auto  consumed = encodeBlocks(data, length, output, table);
+    data += consumed;
+    char* current = output + consumed / 3 * 4;
+    switch (length - consumed)
+    {
+    case 1:
+        *current++ = table[data[0] >> 2];
+        *current++ = table[(data[0] & 0x03) << 4];
+        if (padding)
+        {
+            *current++ = kPadding;
+            *current++ = kPadding;
+        }
+        break;
+    case 2:
+        *current++ = table[data[0] >> 2];
+        *current++ = table[((data[0] & 0x03) << 4) | (data[1] >> 4)];
+        *current++ = table[(data[1] & 0x0F) << 2];
+        if (padding)
+        {
+            *current++ = kPadding;
+        }
+        break;
+    default:
+        break;
+    }
+    return static_cast<size_t>(current - output);
+}
+
+std::string Base64::Encode(const void* input, size_t length, Alphabet alphabet, bool padding)
+{
+    std::string result(EncodedLength(length, padding), '\0');
+    Encode(input, length, result.data(), alphabet, padding);
+    return result;
+}
+
+zeus::expected<size_t, Base64::DecodeError> Base64::Decode(const char* input, size_t length, void* output, Alphabet alphabet) noexcept
+{
+    static const DecodeBlocksFunction decodeBlocks = SelectDecodeBlocks();
+
+    const uint8_t* decode = DecodeTable(alphabet);
+    //填充字符只能出现在最后一组的末尾
+    size_t dataLength     = length;
+    if (length && 0 == length % 4 && kPadding == input[length - 1])
+    {
+        --dataLength;
+        if (kPadding == input[length - 2])
+        {
+            --dataLength;
+        }
+    }
+    auto*        data     = static_cast<uint8_t*>(output);
+    const size_t consumed = decodeBlocks(input, dataLength, data, EncodeTable(alphabet));
+    data += consumed / 4 * 3;
+
+    //内核只会在遇到非法字符或者不足一组时停下，剩余不超过4个字符
+    const size_t remain = dataLength - consumed;
+    uint8_t      values[4];
+    for (size_t index = 0; index < remain; ++index)
+    {
+        values[index] = decode[static_cast<uint8_t>(input[consumed + index])];
+        if (kInvalid == values[index])
+        {
+            return zeus::unexpected(DecodeError {consumed + index});
+        }
+    }
+    assert(remain < 4);
+    if (1 == remain)
+    {
+        //单个字符无法组成一个字节
+        return zeus::unexpected(DecodeError {consumed});
+    }
+    if (remain >= 2)
+    {
+        *data++ = static_cast<uint8_t>((values[0] << 2) | (values[1] >> 4));
+    }
+    if (remain >= 3)
+    {
+        *data++ = static_cast<uint8_t>((values[1] << 4) | (values[2] >> 2));
+    }
+    return static_cast<size_t>(data - static_cast<uint8_t*>(output));
+}
+
+zeus::expected<std::vector<uint8_t>, Base64::DecodeError> Base64::Decode(std::string_view input, Alphabet alphabet)
+{
+    std::vector<uint8_t> result(DecodedMaxLength(input.size()));
+    auto                 size = Decode(input.data(), input.size(), result.data(), alphabet);
+    if (!size.has_value())
+    {
+        return zeus::unexpected(size.error());
+    }
+    result.resize(*size);
+    return result;
+}
+} // namespace zeus
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic) 没有c++20，没有std::span可用
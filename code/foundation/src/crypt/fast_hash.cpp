@@ -0,0 +1,741 @@
+﻿#include "zeus/foundation/crypt/fast_hash.h"
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic) 没有c++20，没有std::span可用
+#include <chrono>
+#include <cstring>
+#include <random>
+#include "zeus/foundation/hardware/cpu_feature.h"
+#ifdef ZEUS_ARCH_X64
+#include <immintrin.h>
+#endif
+#if defined(_MSC_VER) && defined(ZEUS_ARCH_X64)
+#include <intrin.h>
+#endif
+
+namespace zeus
+{
+namespace
+{
+constexpr uint32_t kPrime32_1 = 0x9E3779B1U;
+constexpr uint32_t kPrime32_2 = 0x85EBCA77U;
+constexpr uint32_t kPrime32_3 = 0xC2B2AE3DU;
+constexpr uint64_t kPrime64_1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t kPrime64_2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t kPrime64_3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t kPrime64_4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t kPrime64_5 = 0x27D4EB2F165667C5ULL;
+constexpr uint64_t kPrimeMx1  = 0x165667919E3779F9ULL;
+constexpr uint64_t kPrimeMx2  = 0x9FB21C651E98DF25ULL;
+
+constexpr size_t kStripeLength      = 64;
+constexpr size_t kSecretConsumeRate = 8;
+constexpr size_t kBufferStripes     = 4;
+constexpr size_t kBufferSize        = kStripeLength * kBufferStripes;
+constexpr size_t kSecretLimit       = FastHash::kSecretSize - kStripeLength;
+constexpr size_t kStripesPerBlock   = kSecretLimit / kSecretConsumeRate;
+constexpr size_t kBlockLength       = kStripeLength * kStripesPerBlock;
+constexpr size_t kMidSizeMax        = 240;
+constexpr size_t kSecretSizeMin     = 136;
+constexpr size_t kMidSizeStart      = 3;
+constexpr size_t kMidSizeLast       = 17;
+constexpr size_t kLastStripeStart   = 7;
+constexpr size_t kMergeStart        = 11;
+
+alignas(64) constexpr uint8_t kDefaultSecret[FastHash::kSecretSize] = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c, 0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb,
+    0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f, 0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c, 0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb,
+    0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3, 0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d, 0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31,
+    0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64, 0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e, 0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc,
+    0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce, 0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+constexpr std::array<uint64_t, 8> kInitAccumulators = {
+    kPrime32_3, kPrime64_1, kPrime64_2, kPrime64_3, kPrime64_4, kPrime32_2, kPrime64_5, kPrime32_1,
+};
+
+//散列值需要跨平台一致，统一按小端读取
+inline uint64_t Read64(const uint8_t* data)
+{
+    uint64_t value = 0;
+    std::memcpy(&value, data, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap64(value);
+#endif
+    return value;
+}
+
+inline uint32_t Read32(const uint8_t* data)
+{
+    uint32_t value = 0;
+    std::memcpy(&value, data, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap32(value);
+#endif
+    return value;
+}
+
+inline void Write64(uint8_t* data, uint64_t value)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap64(value);
+#endif
+    std::memcpy(data, &value, sizeof(value));
+}
+
+inline uint64_t Swap64(uint64_t value)
+{
+    return ((value << 56) & 0xff00000000000000ULL) | ((value << 40) & 0x00ff000000000000ULL) | ((value << 24) & 0x0000ff0000000000ULL) |
+           ((value << 8) & 0x000000ff00000000ULL) | ((value >> 8) & 0x00000000ff000000ULL) | ((value >> 24) & 0x0000000000ff0000ULL) |
+           ((value >> 40) & 0x000000000000ff00ULL) | ((value >> 56) & 0x00000000000000ffULL);
+}
+
+inline uint32_t Swap32(uint32_t value)
+{
+    return ((value << 24) & 0xff000000U) | ((value << 8) & 0x00ff0000U) | ((value >> 8) & 0x0000ff00U) | ((value >> 24) & 0x000000ffU);
+}
+
+inline uint64_t RotateLeft64(uint64_t value, int count)
+{
+    return (value << count) | (value >> (64 - count));
+}
+
+inline uint32_t RotateLeft32(uint32_t value, int count)
+{
+    return (value << count) | (value >> (32 - count));
+}
+
+inline Hash128Value Multiply128(uint64_t left, uint64_t right)
+{
+#if defined(__SIZEOF_INT128__)
+    const auto product = static_cast<unsigned __int128>(left) * right;
+    return {static_cast<uint64_t>(product), static_cast<uint64_t>(product >> 64)};
+#elif defined(_MSC_VER) && defined(ZEUS_ARCH_X64)
+    uint64_t high = 0;
+    uint64_t low  = _umul128(left, right, &high);
+    return {low, high};
+#else
+    const uint64_t lowLow   = (left & 0xFFFFFFFF) * (right & 0xFFFFFFFF);
+    const uint64_t highLow  = (left >> 32) * (right & 0xFFFFFFFF);
+    const uint64_t lowHigh  = (left & 0xFFFFFFFF) * (right >> 32);
+    const uint64_t highHigh = (left >> 32) * (right >> 32);
+    const uint64_t cross    = (lowLow >> 32) + (highLow & 0xFFFFFFFF) + lowHigh;
+    const uint64_t upper    = (highLow >> 32) + (cross >> 32) + highHigh;
+    const uint64_t lower    = (cross << 32) | (lowLow & 0xFFFFFFFF);
+    return {lower, upper};
+#endif
+}
+
+inline uint64_t MultiplyFold64(uint64_t left, uint64_t right)
+{
+    const auto product = Multiply128(left, right);
+    return product.low ^ product.high;
+}
+
+inline uint64_t XorShift64(uint64_t value, int shift)
+{
+    return value ^ (value >> shift);
+}
+
+inline uint64_t Avalanche64(uint64_t hash)
+{
+    hash ^= hash >> 33;
+    hash *= kPrime64_2;
+    hash ^= hash >> 29;
+    hash *= kPrime64_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+inline uint64_t Avalanche(uint64_t hash)
+{
+    hash = XorShift64(hash, 37);
+    hash *= kPrimeMx1;
+    return XorShift64(hash, 32);
+}
+
+inline uint64_t RrmxMx(uint64_t hash, uint64_t length)
+{
+    hash ^= RotateLeft64(hash, 49) ^ RotateLeft64(hash, 24);
+    hash *= kPrimeMx2;
+    hash ^= (hash >> 35) + length;
+    hash *= kPrimeMx2;
+    return XorShift64(hash, 28);
+}
+
+inline uint64_t Mix16(const uint8_t* input, const uint8_t* secret, uint64_t seed)
+{
+    return MultiplyFold64(Read64(input) ^ (Read64(secret) + seed), Read64(input + 8) ^ (Read64(secret + 8) - seed));
+}
+
+inline void Mix32(Hash128Value& accumulator, const uint8_t* first, const uint8_t* second, const uint8_t* secret, uint64_t seed)
+{
+    accumulator.low += Mix16(first, secret, seed);
+    accumulator.low ^= Read64(second) + Read64(second + 8);
+    accumulator.high += Mix16(second, secret + 16, seed);
+    accumulator.high ^= Read64(first) + Read64(first + 8);
+}
+
+// 64位短数据(<=240字节)
+
+uint64_t Hash64Length0To16(const uint8_t* input, size_t length, const uint8_t* secret, uint64_t seed)
+{
+    if (length > 8)
+    {
+        const uint64_t flipLow  = (Read64(secret + 24) ^ Read64(secret + 32)) + seed;
+        const uint64_t flipHigh = (Read64(secret + 40) ^ Read64(secret + 48)) - seed;
+        const uint64_t low      = Read64(input) ^ flipLow;
+        const uint64_t high     = Read64(input + length - 8) ^ flipHigh;
+        return Avalanche(length + Swap64(low) + high + MultiplyFold64(low, high));
+    }
+    if (length >= 4)
+    {
+        seed ^= static_cast<uint64_t>(Swap32(static_cast<uint32_t>(seed))) << 32;
+        const uint64_t flip  = (Read64(secret + 8) ^ Read64(secret + 16)) - seed;
+        const uint64_t value = Read32(input + length - 4) + (static_cast<uint64_t>(Read32(input)) << 32);
+        return RrmxMx(value ^ flip, length);
+    }
+    if (length > 0)
+    {
+        const uint32_t combined = (static_cast<uint32_t>(input[0]) << 16) | (static_cast<uint32_t>(input[length >> 1]) << 24) |
+                                  static_cast<uint32_t>(input[length - 1]) | (static_cast<uint32_t>(length) << 8);
+        const uint64_t flip     = (Read32(secret) ^ Read32(secret + 4)) + seed;
+        return Avalanche64(combined ^ flip);
+    }
+    return Avalanche64(seed ^ Read64(secret + 56) ^ Read64(secret + 64));
+}
+
+uint64_t Hash64Length17To128(const uint8_t* input, size_t length, const uint8_t* secret, uint64_t seed)
+{
+    uint64_t accumulator = length * kPrime64_1;
+    if (length > 32)
+    {
+        if (length > 64)
+        {
+            if (length > 96)
+            {
+                accumulator += Mix16(input + 48, secret + 96, seed);
+                accumulator += Mix16(input + length - 64, secret + 112, seed);
+            }
+            accumulator += Mix16(input + 32, secret + 64, seed);
+            accumulator += Mix16(input + length - 48, secret + 80, seed);
+        }
+        accumulator += Mix16(input + 16, secret + 32, seed);
+        accumulator += Mix16(input + length - 32, secret + 48, seed);
+    }
+    accumulator += Mix16(input, secret, seed);
+    accumulator += Mix16(input + length - 16, secret + 16, seed);
+    return Avalanche(accumulator);
+}
+
+uint64_t Hash64Length129To240(const uint8_t* input, size_t length, const uint8_t* secret, uint64_t seed)
+{
+    const size_t rounds      = length / 16;
+    uint64_t     accumulator = length * kPrime64_1;
+    for (size_t index = 0; index < 8; ++index)
+    {
+        accumulator += Mix16(input + 16 * index, secret + 16 * index, seed);
+    }
+    accumulator = Avalanche(accumulator);
+    for (size_t index = 8; index < rounds; ++index)
+    {
+        accumulator += Mix16(input + 16 * index, secret + 16 * (index - 8) + kMidSizeStart, seed);
+    }
+    accumulator += Mix16(input + length - 16, secret + kSecretSizeMin - kMidSizeLast, seed);
+    return Avalanche(accumulator);
+}
+
+uint64_t Hash64Short(const uint8_t* input, size_t length, const uint8_t* secret, uint64_t seed)
+{
+    if (length <= 16)
+    {
+        return Hash64Length0To16(input, length, secret, seed);
+    }
+    if (length <= 128)
+    {
+        return Hash64Length17To128(input, length, secret, seed);
+    }
+    return Hash64Length129To240(input, length, secret, seed);
+}
+
+// 128位短数据(<=240字节)
+
+Hash128Value Hash128Length0To16(const uint8_t* input, size_t length, const uint8_t* secret, uint64_t seed)
+{
+    if (length > 8)
+    {
+        const uint64_t flipLow  = (Read64(secret + 32) ^ Read64(secret + 40)) - seed;
+        const uint64_t flipHigh = (Read64(secret + 48) ^ Read64(secret + 56)) + seed;
+        const uint64_t low      = Read64(input);
+        uint64_t       high     = Read64(input + length - 8);
+        Hash128Value   product  = Multiply128(low ^ high ^ flipLow, kPrime64_1);
+        product.low += static_cast<uint64_t>(length - 1) << 54;
+        high ^= flipHigh;
+        product.high += high + static_cast<uint64_t>(static_cast<uint32_t>(high)) * (kPrime32_2 - 1);
+        product.low ^= Swap64(product.high);
+        Hash128Value result = Multiply128(product.low, kPrime64_2);
+        result.high += product.high * kPrime64_2;
+        return {Avalanche(result.low), Avalanche(result.high)};
+    }
+    if (length >= 4)
+    {
+        seed ^= static_cast<uint64_t>(Swap32(static_cast<uint32_t>(seed))) << 32;
+        const uint64_t value   = Read32(input) + (static_cast<uint64_t>(Read32(input + length - 4)) << 32);
+        const uint64_t flip    = (Read64(secret + 16) ^ Read64(secret + 24)) + seed;
+        Hash128Value   product = Multiply128(value ^ flip, kPrime64_1 + (length << 2));
+        product.high += product.low << 1;
+        product.low ^= product.high >> 3;
+        product.low = XorShift64(product.low, 35);
+        product.low *= kPrimeMx2;
+        product.low = XorShift64(product.low, 28);
+        return {product.low, Avalanche(product.high)};
+    }
+    if (length > 0)
+    {
+        const uint32_t low      = (static_cast<uint32_t>(input[0]) << 16) | (static_cast<uint32_t>(input[length >> 1]) << 24) |
+                                  static_cast<uint32_t>(input[length - 1]) | (static_cast<uint32_t>(length) << 8);
+        const uint32_t high     = RotateLeft32(Swap32(low), 13);
+        const uint64_t flipLow  = (Read32(secret) ^ Read32(secret + 4)) + seed;
+        const uint64_t flipHigh = (Read32(secret + 8) ^ Read32(secret + 12)) - seed;
+        return {Avalanche64(low ^ flipLow), Avalanche64(high ^ flipHigh)};
+    }
+    return {Avalanche64(seed ^ Read64(secret + 64) ^ Read64(secret + 72)), Avalanche64(seed ^ Read64(secret + 80) ^ Read64(secret + 88))};
+}
+
+Hash128Value Hash128Finish(const Hash128Value& accumulator, size_t length, uint64_t seed)
+{
+    const uint64_t low  = accumulator.low + accumulator.high;
+    const uint64_t high = accumulator.low * kPrime64_1 + accumulator.high * kPrime64_4 + (length - seed) * kPrime64_2;
+    return {Avalanche(low), 0 - Avalanche(high)};
+}
+
+Hash128Value Hash128Length17To128(const uint8_t* input, size_t length, const uint8_t* secret, uint64_t seed)
+{
+    Hash128Value accumulator {length * kPrime64_1, 0};
+    if (length > 32)
+    {
+        if (length > 64)
+        {
+            if (length > 96)
+            {
+                Mix32(accumulator, input + 48, input + length - 64, secret + 96, seed);
+            }
+            Mix32(accumulator, input + 32, input + length - 48, secret + 64, seed);
+        }
+        Mix32(accumulator, input + 16, input + length - 32, secret + 32, seed);
+    }
+    Mix32(accumulator, input, input + length - 16, secret, seed);
+    return Hash128Finish(accumulator, length, seed);
+}
+
+Hash128Value Hash128Length129To240(const uint8_t* input, size_t length, const uint8_t* secret, uint64_t seed)
+{
+    const size_t rounds = length / 32;
+    Hash128Value accumulator {length * kPrime64_1, 0};
+    for (size_t index = 0; index < 4; ++index)
+    {
+        Mix32(accumulator, input + 32 * index, input + 32 * index + 16, secret + 32 * index, seed);
+    }
+    accumulator.low  = Avalanche(accumulator.low);
+    accumulator.high = Avalanche(accumulator.high);
+    for (size_t index = 4; index < rounds; ++index)
+    {
+        Mix32(accumulator, input + 32 * index, input + 32 * index + 16, secret + kMidSizeStart + 32 * (index - 4), seed);
+    }
+    Mix32(accumulator, input + length - 16, input + length - 32, secret + kSecretSizeMin - kMidSizeLast - 16, 0 - seed);
+    return Hash128Finish(accumulator, length, seed);
+}
+
+Hash128Value Hash128Short(const uint8_t* input, size_t length, const uint8_t* secret, uint64_t seed)
+{
+    if (length <= 16)
+    {
+        return Hash128Length0To16(input, length, secret, seed);
+    }
+    if (length <= 128)
+    {
+        return Hash128Length17To128(input, length, secret, seed);
+    }
+    return Hash128Length129To240(input, length, secret, seed);
+}
+
+// 长数据：8个64位累加器按64字节一条带(stripe)累加，每处理完一个块(block)打乱一次
+
+//x64总是支持SSE2，标量版本只在其它架构上使用
+[[maybe_unused]] void AccumulateScalar(uint64_t* accumulators, const uint8_t* input, const uint8_t* secret, size_t stripes)
+{
+    for (size_t stripe = 0; stripe < stripes; ++stripe)
+    {
+        const uint8_t* data = input + stripe * kStripeLength;
+        const uint8_t* key  = secret + stripe * kSecretConsumeRate;
+        for (size_t index = 0; index < 8; ++index)
+        {
+            const uint64_t value    = Read64(data + 8 * index);
+            const uint64_t keyed    = value ^ Read64(key + 8 * index);
+            accumulators[index ^ 1] += value;
+            accumulators[index] += (keyed & 0xFFFFFFFF) * (keyed >> 32);
+        }
+    }
+}
+
+[[maybe_unused]] void ScrambleScalar(uint64_t* accumulators, const uint8_t* secret)
+{
+    for (size_t index = 0; index < 8; ++index)
+    {
+        uint64_t value = accumulators[index];
+        value          = XorShift64(value, 47);
+        value ^= Read64(secret + 8 * index);
+        accumulators[index] = value * kPrime32_1;
+    }
+}
+
+#ifdef ZEUS_ARCH_X64
+void AccumulateSse2(uint64_t* accumulators, const uint8_t* input, const uint8_t* secret, size_t stripes)
+{
+    __m128i state[4];
+    for (size_t index = 0; index < 4; ++index)
+    {
+        state[index] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(accumulators) + index);
+    }
+    for (size_t stripe = 0; stripe < stripes; ++stripe)
+    {
+        const auto* data = reinterpret_cast<const __m128i*>(input + stripe * kStripeLength);
+        const auto* key  = reinterpret_cast<const __m128i*>(secret + stripe * kSecretConsumeRate);
+        for (size_t index = 0; index < 4; ++index)
+        {
+            const __m128i value   = _mm_loadu_si128(data + index);
+            const __m128i keyed   = _mm_xor_si128(value, _mm_loadu_si128(key + index));
+            const __m128i product = _mm_mul_epu32(keyed, _mm_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1)));
+            const __m128i swapped = _mm_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));
+            state[index]          = _mm_add_epi64(_mm_add_epi64(state[index], swapped), product);
+        }
+    }
+    for (size_t index = 0; index < 4; ++index)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(accumulators) + index, state[index]);
+    }
+}
+
+void ScrambleSse2(uint64_t* accumulators, const uint8_t* secret)
+{
+    const __m128i prime = _mm_set1_epi32(static_cast<int>(kPrime32_1));
+    for (size_t index = 0; index < 4; ++index)
+    {
+        __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(accumulators) + index);
+        value         = _mm_xor_si128(value, _mm_srli_epi64(value, 47));
+        value         = _mm_xor_si128(value, _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret) + index));
+        const __m128i low  = _mm_mul_epu32(value, prime);
+        const __m128i high = _mm_mul_epu32(_mm_shuffle_epi32(value, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(accumulators) + index, _mm_add_epi64(low, _mm_slli_epi64(high, 32)));
+    }
+}
+
+ZEUS_TARGET_AVX2 void AccumulateAvx2(uint64_t* accumulators, const uint8_t* input, const uint8_t* secret, size_t stripes)
+{
+    __m256i state[2];
+    for (size_t index = 0; index < 2; ++index)
+    {
+        state[index] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(accumulators) + index);
+    }
+    for (size_t stripe = 0; stripe < stripes; ++stripe)
+    {
+        const auto* data = reinterpret_cast<const __m256i*>(input + stripe * kStripeLength);
+        const auto* key  = reinterpret_cast<const __m256i*>(secret + stripe * kSecretConsumeRate);
+        for (size_t index = 0; index < 2; ++index)
+        {
+            const __m256i value   = _mm256_loadu_si256(data + index);
+            const __m256i keyed   = _mm256_xor_si256(value, _mm256_loadu_si256(key + index));
+            const __m256i product = _mm256_mul_epu32(keyed, _mm256_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1)));
+            const __m256i swapped = _mm256_shuffle_epi32(value, _MM_SHUFFLE(1, 0, 3, 2));
+            state[index]          = _mm256_add_epi64(_mm256_add_epi64(state[index], swapped), product);
+        }
+    }
+    for (size_t index = 0; index < 2; ++index)
+    {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(accumulators) + index, state[index]);
+    }
+}
+
+ZEUS_TARGET_AVX2 void ScrambleAvx2(uint64_t* accumulators, const uint8_t* secret)
+{
+    const __m256i prime = _mm256_set1_epi32(static_cast<int>(kPrime32_1));
+    for (size_t index = 0; index < 2; ++index)
+    {
+        __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(accumulators) + index);
+        value         = _mm256_xor_si256(value, _mm256_srli_epi64(value, 47));
+        value         = _mm256_xor_si256(value, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret) + index));
+        const __m256i low  = _mm256_mul_epu32(value, prime);
+        const __m256i high = _mm256_mul_epu32(_mm256_shuffle_epi32(value, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(accumulators) + index, _mm256_add_epi64(low, _mm256_slli_epi64(high, 32)));
+    }
+}
+#endif
+
+struct LongKernel
+{
+    void (*accumulate)(uint64_t* accumulators, const uint8_t* input, const uint8_t* secret, size_t stripes);
+    void (*scramble)(uint64_t* accumulators, const uint8_t* secret);
+};
+
+LongKernel SelectLongKernel()
+{
+#ifdef ZEUS_ARCH_X64
+    if (Hardware::GetCpuFeature().avx2)
+    {
+        return {AccumulateAvx2, ScrambleAvx2};
+    }
+    return {AccumulateSse2, ScrambleSse2};
+#else
+    return {AccumulateScalar, ScrambleScalar};
+#endif
+}
+
+const LongKernel& GetLongKernel()
+{
+    static const LongKernel kernel = SelectLongKernel();
+    return kernel;
+}
+
+void InitSecret(uint8_t* secret, uint64_t seed)
+{
+    for (size_t index = 0; index < FastHash::kSecretSize / 16; ++index)
+    {
+        Write64(secret + 16 * index, Read64(kDefaultSecret + 16 * index) + seed);
+        Write64(secret + 16 * index + 8, Read64(kDefaultSecret + 16 * index + 8) - seed);
+    }
+}
+
+void HashLongInternal(uint64_t* accumulators, const uint8_t* input, size_t length, const uint8_t* secret)
+{
+    const auto&  kernel = GetLongKernel();
+    const size_t blocks = (length - 1) / kBlockLength;
+    for (size_t block = 0; block < blocks; ++block)
+    {
+        kernel.accumulate(accumulators, input + block * kBlockLength, secret, kStripesPerBlock);
+        kernel.scramble(accumulators, secret + kSecretLimit);
+    }
+    const size_t stripes = ((length - 1) - blocks * kBlockLength) / kStripeLength;
+    kernel.accumulate(accumulators, input + blocks * kBlockLength, secret, stripes);
+    kernel.accumulate(accumulators, input + length - kStripeLength, secret + kSecretLimit - kLastStripeStart, 1);
+}
+
+uint64_t MergeAccumulators(const uint64_t* accumulators, const uint8_t* secret, uint64_t start)
+{
+    uint64_t result = start;
+    for (size_t index = 0; index < 4; ++index)
+    {
+        result += MultiplyFold64(accumulators[2 * index] ^ Read64(secret + 16 * index), accumulators[2 * index + 1] ^ Read64(secret + 16 * index + 8));
+    }
+    return Avalanche(result);
+}
+
+uint64_t Digest64Long(const uint64_t* accumulators, const uint8_t* secret, uint64_t length)
+{
+    return MergeAccumulators(accumulators, secret + kMergeStart, length * kPrime64_1);
+}
+
+Hash128Value Digest128Long(const uint64_t* accumulators, const uint8_t* secret, uint64_t length)
+{
+    return {
+        MergeAccumulators(accumulators, secret + kMergeStart, length * kPrime64_1),
+        MergeAccumulators(accumulators, secret + FastHash::kSecretSize - sizeof(kInitAccumulators) - kMergeStart, ~(length * kPrime64_2)),
+    };
+}
+
+const uint8_t* LongSecret(uint64_t seed, uint8_t* buffer)
+{
+    if (0 == seed)
+    {
+        return kDefaultSecret;
+    }
+    InitSecret(buffer, seed);
+    return buffer;
+}
+
+//流式计算时在条带缓冲区中累加，跨越块边界时打乱
+void ConsumeStripes(uint64_t* accumulators, size_t& stripesSoFar, const uint8_t* input, size_t stripes, const uint8_t* secret)
+{
+    const auto& kernel = GetLongKernel();
+    if (kStripesPerBlock - stripesSoFar <= stripes)
+    {
+        const size_t toEnd = kStripesPerBlock - stripesSoFar;
+        const size_t after = stripes - toEnd;
+        kernel.accumulate(accumulators, input, secret + stripesSoFar * kSecretConsumeRate, toEnd);
+        kernel.scramble(accumulators, secret + kSecretLimit);
+        kernel.accumulate(accumulators, input + toEnd * kStripeLength, secret, after);
+        stripesSoFar = after;
+    }
+    else
+    {
+        kernel.accumulate(accumulators, input, secret + stripesSoFar * kSecretConsumeRate, stripes);
+        stripesSoFar += stripes;
+    }
+}
+
+//Digest时在累加器副本上处理缓冲区剩余的数据，不足一个条带时用上一次缓冲区末尾的数据补齐
+void FinishStripes(uint64_t* accumulators, size_t stripes, const uint8_t* buffer, size_t bufferSize, const uint8_t* secret)
+{
+    if (bufferSize >= kStripeLength)
+    {
+        ConsumeStripes(accumulators, stripes, buffer, (bufferSize - 1) / kStripeLength, secret);
+        GetLongKernel().accumulate(accumulators, buffer + bufferSize - kStripeLength, secret + kSecretLimit - kLastStripeStart, 1);
+    }
+    else
+    {
+        uint8_t      lastStripe[kStripeLength];
+        const size_t catchup = kStripeLength - bufferSize;
+        std::memcpy(lastStripe, buffer + kBufferSize - catchup, catchup);
+        std::memcpy(lastStripe + catchup, buffer, bufferSize);
+        GetLongKernel().accumulate(accumulators, lastStripe, secret + kSecretLimit - kLastStripeStart, 1);
+    }
+}
+} // namespace
+
+FastHash::FastHash(uint64_t seed) noexcept
+{
+    Reset(seed);
+}
+
+void FastHash::Reset() noexcept
+{
+    _accumulators = kInitAccumulators;
+    _totalLength  = 0;
+    _bufferSize   = 0;
+    _stripes      = 0;
+}
+
+void FastHash::Reset(uint64_t seed) noexcept
+{
+    _seed = seed;
+    InitSecret(_secret.data(), seed);
+    Reset();
+}
+
+void FastHash::Update(const void* input, size_t length) noexcept
+{
+    const auto* data = static_cast<const uint8_t*>(input);
+    const auto* end  = data + length;
+    _totalLength += length;
+    if (_bufferSize + length <= kBufferSize)
+    {
+        if (length)
+        {
+            std::memcpy(_buffer.data() + _bufferSize, data, length);
+        }
+        _bufferSize += length;
+        return;
+    }
+    if (_bufferSize)
+    {
+        const size_t fill = kBufferSize - _bufferSize;
+        std::memcpy(_buffer.data() + _bufferSize, data, fill);
+        data += fill;
+        ConsumeStripes(_accumulators.data(), _stripes, _buffer.data(), kBufferStripes, _secret.data());
+        _bufferSize = 0;
+    }
+    //至少保留最后一部分数据在缓冲区中，Digest时需要用它计算最后一个条带
+    if (static_cast<size_t>(end - data) > kBufferSize)
+    {
+        do
+        {
+            ConsumeStripes(_accumulators.data(), _stripes, data, kBufferStripes, _secret.data());
+            data += kBufferSize;
+        } while (static_cast<size_t>(end - data) > kBufferSize);
+        std::memcpy(_buffer.data() + kBufferSize - kStripeLength, data - kStripeLength, kStripeLength);
+    }
+    _bufferSize = static_cast<size_t>(end - data);
+    std::memcpy(_buffer.data(), data, _bufferSize);
+}
+
+void FastHash::Update(std::string_view data) noexcept
+{
+    Update(data.data(), data.size());
+}
+
+uint64_t FastHash::Digest64() const noexcept
+{
+    if (_totalLength <= kMidSizeMax)
+    {
+        return Hash64Short(_buffer.data(), static_cast<size_t>(_totalLength), kDefaultSecret, _seed);
+    }
+    std::array<uint64_t, 8> accumulators = _accumulators;
+    FinishStripes(accumulators.data(), _stripes, _buffer.data(), _bufferSize, _secret.data());
+    return Digest64Long(accumulators.data(), _secret.data(), _totalLength);
+}
+
+Hash128Value FastHash::Digest128() const noexcept
+{
+    if (_totalLength <= kMidSizeMax)
+    {
+        return Hash128Short(_buffer.data(), static_cast<size_t>(_totalLength), kDefaultSecret, _seed);
+    }
+    std::array<uint64_t, 8> accumulators = _accumulators;
+    FinishStripes(accumulators.data(), _stripes, _buffer.data(), _bufferSize, _secret.data());
+    return Digest128Long(accumulators.data(), _secret.data(), _totalLength);
+}
+
+uint64_t FastHash::Hash64(const void* input, size_t length, uint64_t seed) noexcept
+{
+    const auto* data = static_cast<const uint8_t*>(input);
+    if (length <= kMidSizeMax)
+    {
+        return Hash64Short(data, length, kDefaultSecret, seed);
+    }
+    uint8_t                 buffer[kSecretSize];
+    const uint8_t*          secret       = LongSecret(seed, buffer);
+    std::array<uint64_t, 8> accumulators = kInitAccumulators;
+    HashLongInternal(accumulators.data(), data, length, secret);
+    return Digest64Long(accumulators.data(), secret, length);
+}
+
+uint64_t FastHash::Hash64(std::string_view data, uint64_t seed) noexcept
+{
+    return Hash64(data.data(), data.size(), seed);
+}
+
+Hash128Value FastHash::Hash128(const void* input, size_t length, uint64_t seed) noexcept
+{
+    const auto* data = static_cast<const uint8_t*>(input);
+    if (length <= kMidSizeMax)
+    {
+        return Hash128Short(data, length, kDefaultSecret, seed);
+    }
+    uint8_t                 buffer[kSecretSize];
+    const uint8_t*          secret       = LongSecret(seed, buffer);
+    std::array<uint64_t, 8> accumulators = kInitAccumulators;
+    HashLongInternal(accumulators.data(), data, length, secret);
+    return Digest128Long(accumulators.data(), secret, length);
+}
+
+Hash128Value FastHash::Hash128(std::string_view data, uint64_t seed) noexcept
+{
+    return Hash128(data.data(), data.size(), seed);
+}
+
+uint64_t FastHash::RandomSeed() noexcept
+{
+    static const uint64_t seed = []() noexcept
+    {
+        try
+        {
+            std::random_device device;
+            return (static_cast<uint64_t>(device()) << 32) | device();
+        }
+        catch (...)
+        {
+            //random_device没有可用的熵源时会抛出异常，退化为时钟和受地址随机化影响的地址混合
+            static const int anchor = 0;
+            const uint64_t   values[] = {
+                static_cast<uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count()),
+                static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()),
+                static_cast<uint64_t>(reinterpret_cast<uintptr_t>(&anchor)),
+                static_cast<uint64_t>(reinterpret_cast<uintptr_t>(&values)),
+            };
+            return Hash64(values, sizeof(values));
+        }
+    }();
+    return seed;
+}
+} // namespace zeus
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic) 没有c++20，没有std::span可用
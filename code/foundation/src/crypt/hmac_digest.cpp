@@ -39,6 +39,10 @@ HMACDigest& HMACDigest::operator=(HMACDigest&& other) noexcept
     }
     return *this;
 }
+void HMACDigest::Hash(const void* input, size_t length, const void* saltByte, size_t saltLength, void* digest, HMACDigestType type)
+{
+    HMACDigestImpl::Hash(type, saltByte, saltLength, input, length, digest);
+}
 std::string HMACDigest::Name()
 {
     return _impl->Name();
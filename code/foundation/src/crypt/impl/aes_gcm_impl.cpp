@@ -0,0 +1,46 @@
+﻿#include "aes_gcm_impl.h"
+#include <cryptopp/misc.h>
+
+namespace zeus
+{
+
+AesGcmImpl::AesGcmImpl(const void* key, size_t keyLength)
+{
+    _encryption.SetKey(reinterpret_cast<const CryptoPP::byte*>(key), keyLength);
+    _decryption.SetKey(reinterpret_cast<const CryptoPP::byte*>(key), keyLength);
+}
+
+void AesGcmImpl::Encrypt(
+    const void* iv, size_t ivLength, const void* aad, size_t aadLength, const void* input, size_t length, void* output, void* tag, size_t tagLength
+)
+{
+    _encryption.EncryptAndAuthenticate(
+        reinterpret_cast<CryptoPP::byte*>(output), reinterpret_cast<CryptoPP::byte*>(tag), tagLength, reinterpret_cast<const CryptoPP::byte*>(iv),
+        static_cast<int>(ivLength), reinterpret_cast<const CryptoPP::byte*>(aad), aadLength, reinterpret_cast<const CryptoPP::byte*>(input), length
+    );
+}
+
+bool AesGcmImpl::Decrypt(
+    const void* iv, size_t ivLength, const void* aad, size_t aadLength, const void* input, size_t length, void* output, const void* tag,
+    size_t tagLength
+)
+{
+    const bool verified = _decryption.DecryptAndVerify(
+        reinterpret_cast<CryptoPP::byte*>(output), reinterpret_cast<const CryptoPP::byte*>(tag), tagLength,
+        reinterpret_cast<const CryptoPP::byte*>(iv), static_cast<int>(ivLength), reinterpret_cast<const CryptoPP::byte*>(aad), aadLength,
+        reinterpret_cast<const CryptoPP::byte*>(input), length
+    );
+    if (!verified)
+    {
+        //认证失败时已经解密出的明文不能留给调用者
+        CryptoPP::SecureWipeArray(reinterpret_cast<CryptoPP::byte*>(output), length);
+    }
+    return verified;
+}
+
+std::string AesGcmImpl::Name()
+{
+    return "AES(GCM)";
+}
+
+} // namespace zeus
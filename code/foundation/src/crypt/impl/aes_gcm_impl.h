@@ -0,0 +1,30 @@
+﻿#pragma once
+
+#include <string>
+#include <cstddef>
+#include <cryptopp/aes.h>
+#include <cryptopp/gcm.h>
+
+namespace zeus
+{
+
+class AesGcmImpl
+{
+public:
+    AesGcmImpl(const void *key, size_t keyLength);
+
+    void Encrypt(
+        const void *iv, size_t ivLength, const void *aad, size_t aadLength, const void *input, size_t length, void *output, void *tag,
+        size_t tagLength
+    );
+    bool Decrypt(
+        const void *iv, size_t ivLength, const void *aad, size_t aadLength, const void *input, size_t length, void *output, const void *tag,
+        size_t tagLength
+    );
+    std::string Name();
+private:
+    //Crypto++内部会根据CPU能力选择AES-NI/PCLMULQDQ或ARMv8 AES/PMULL实现
+    CryptoPP::GCM<CryptoPP::AES>::Encryption _encryption;
+    CryptoPP::GCM<CryptoPP::AES>::Decryption _decryption;
+};
+} // namespace zeus
@@ -4,6 +4,7 @@
 #include <cryptopp/hmac.h>
 #include <cryptopp/md5.h>
 #include <cryptopp/sha.h>
+#include "zeus/foundation/crypt/sha256.h"
 
 namespace zeus
 {
@@ -38,6 +39,41 @@ HMACDigestImpl::HMACDigestImpl(HMACDigestType type, const void *key, size_t leng
     : BaseDigestImpl(CreateTransform(type, reinterpret_cast<const uint8_t *>(key), length)), _type(type)
 {
 }
+template<typename HashType>
+static void CalculateHmac(const void *key, size_t keyLength, const void *input, size_t length, void *digest)
+{
+    CryptoPP::HMAC<HashType>(reinterpret_cast<const CryptoPP::byte *>(key), keyLength)
+        .CalculateDigest(reinterpret_cast<CryptoPP::byte *>(digest), reinterpret_cast<const CryptoPP::byte *>(input), length);
+}
+
+void HMACDigestImpl::Hash(HMACDigestType type, const void *key, size_t keyLength, const void *input, size_t length, void *digest)
+{
+    switch (type)
+    {
+    case HMACDigestType::MD5:
+        CalculateHmac<CryptoPP::Weak::MD5>(key, keyLength, input, length, digest);
+        break;
+    case HMACDigestType::SHA1:
+        CalculateHmac<CryptoPP::SHA1>(key, keyLength, input, length, digest);
+        break;
+    case HMACDigestType::SHA224:
+        CalculateHmac<CryptoPP::SHA224>(key, keyLength, input, length, digest);
+        break;
+    case HMACDigestType::SHA256:
+        HmacSha256::Hash(key, keyLength, input, length, digest);
+        break;
+    case HMACDigestType::SHA384:
+        CalculateHmac<CryptoPP::SHA384>(key, keyLength, input, length, digest);
+        break;
+    case HMACDigestType::SHA512:
+        CalculateHmac<CryptoPP::SHA512>(key, keyLength, input, length, digest);
+        break;
+    default:
+        assert(false);
+        break;
+    }
+}
+
 std::string HMACDigestImpl::Name()
 {
     switch (_type)
@@ -11,6 +11,7 @@ public:
     /* Default construct. */
     HMACDigestImpl(HMACDigestType type, const void* key, size_t length);
     std::string Name();
+    static void Hash(HMACDigestType type, const void* key, size_t keyLength, const void* input, size_t length, void* digest);
 private:
     HMACDigestType _type;
 };
@@ -8,4 +8,8 @@ Md5DigestImpl::Md5DigestImpl()
     :BaseDigestImpl(std::make_shared<CryptoPP::Weak::MD5>())
 {
 }
+void Md5DigestImpl::Hash(const void* input, size_t length, void* digest)
+{
+    CryptoPP::Weak::MD5().CalculateDigest(reinterpret_cast<CryptoPP::byte*>(digest), reinterpret_cast<const CryptoPP::byte*>(input), length);
+}
 }
@@ -9,5 +9,6 @@ class Md5DigestImpl :public BaseDigestImpl
 public:
     /* Default construct. */
     Md5DigestImpl();
+    static void Hash(const void* input, size_t length, void* digest);
 };
 }
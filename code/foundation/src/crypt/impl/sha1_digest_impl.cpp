@@ -7,4 +7,8 @@ SHA1DigestImpl::SHA1DigestImpl()
     :BaseDigestImpl(std::make_shared<CryptoPP::SHA1>())
 {
 }
+void SHA1DigestImpl::Hash(const void* input, size_t length, void* digest)
+{
+    CryptoPP::SHA1().CalculateDigest(reinterpret_cast<CryptoPP::byte*>(digest), reinterpret_cast<const CryptoPP::byte*>(input), length);
+}
 }
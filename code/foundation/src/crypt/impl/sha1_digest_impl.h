@@ -9,5 +9,6 @@ class SHA1DigestImpl :public BaseDigestImpl
 public:
     /* Default construct. */
     SHA1DigestImpl();
+    static void Hash(const void* input, size_t length, void* digest);
 };
 }
@@ -6,4 +6,8 @@ namespace zeus
 SHA224DigestImpl::SHA224DigestImpl() : BaseDigestImpl(std::make_shared<CryptoPP::SHA224>())
 {
 }
+void SHA224DigestImpl::Hash(const void* input, size_t length, void* digest)
+{
+    CryptoPP::SHA224().CalculateDigest(reinterpret_cast<CryptoPP::byte*>(digest), reinterpret_cast<const CryptoPP::byte*>(input), length);
+}
 }
@@ -9,5 +9,6 @@ class SHA224DigestImpl : public BaseDigestImpl
 public:
     /* Default construct. */
     SHA224DigestImpl();
+    static void Hash(const void* input, size_t length, void* digest);
 };
 }
@@ -6,4 +6,8 @@ namespace zeus
 SHA384DigestImpl::SHA384DigestImpl() : BaseDigestImpl(std::make_shared<CryptoPP::SHA384>())
 {
 }
+void SHA384DigestImpl::Hash(const void* input, size_t length, void* digest)
+{
+    CryptoPP::SHA384().CalculateDigest(reinterpret_cast<CryptoPP::byte*>(digest), reinterpret_cast<const CryptoPP::byte*>(input), length);
+}
 }
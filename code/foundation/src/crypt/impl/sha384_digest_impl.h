@@ -9,5 +9,6 @@ class SHA384DigestImpl : public BaseDigestImpl
 public:
     /* Default construct. */
     SHA384DigestImpl();
+    static void Hash(const void* input, size_t length, void* digest);
 };
 }
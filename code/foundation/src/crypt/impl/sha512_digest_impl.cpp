@@ -6,4 +6,8 @@ namespace zeus
 SHA512DigestImpl::SHA512DigestImpl() : BaseDigestImpl(std::make_shared<CryptoPP::SHA512>())
 {
 }
+void SHA512DigestImpl::Hash(const void* input, size_t length, void* digest)
+{
+    CryptoPP::SHA512().CalculateDigest(reinterpret_cast<CryptoPP::byte*>(digest), reinterpret_cast<const CryptoPP::byte*>(input), length);
+}
 }
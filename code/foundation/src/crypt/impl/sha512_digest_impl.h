@@ -9,5 +9,6 @@ class SHA512DigestImpl : public BaseDigestImpl
 public:
     /* Default construct. */
     SHA512DigestImpl();
+    static void Hash(const void* input, size_t length, void* digest);
 };
 }
@@ -62,4 +62,9 @@ void Md5Digest::UpdateImpl(const void* input, size_t length)
 {
     _impl->UpdateImpl(input, length);
 }
+
+void Md5Digest::Hash(const void *input, size_t length, void *digest)
+{
+    Md5DigestImpl::Hash(input, length, digest);
+}
 } // namespace zeus
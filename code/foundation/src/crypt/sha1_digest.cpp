@@ -58,4 +58,9 @@ void SHA1Digest::UpdateImpl(const void* input, std::size_t length)
 {
     _impl->UpdateImpl(input, length);
 }
+
+void SHA1Digest::Hash(const void *input, size_t length, void *digest)
+{
+    SHA1DigestImpl::Hash(input, length, digest);
+}
 } // namespace zeus
@@ -67,4 +67,9 @@ void SHA224Digest::Reset()
 {
     _impl->Reset();
 }
+
+void SHA224Digest::Hash(const void *input, size_t length, void *digest)
+{
+    SHA224DigestImpl::Hash(input, length, digest);
+}
 } // namespace zeus
@@ -0,0 +1,653 @@
+﻿#include "zeus/foundation/crypt/sha256.h"
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic) 没有c++20，没有std::span可用
+#include <algorithm>
+#include <cstring>
+#include "zeus/foundation/hardware/cpu_feature.h"
+#ifdef ZEUS_ARCH_X64
+#include <immintrin.h>
+#endif
+
+namespace zeus
+{
+namespace
+{
+constexpr std::array<uint32_t, 8> kSha256Init = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+};
+
+alignas(16) constexpr uint32_t kSha256K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be,
+    0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa,
+    0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967, 0x27b70a85,
+    0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+    0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f,
+    0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+inline uint32_t LoadBigEndian32(const uint8_t* data)
+{
+    return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) | (static_cast<uint32_t>(data[2]) << 8) |
+           static_cast<uint32_t>(data[3]);
+}
+
+inline void StoreBigEndian32(uint8_t* data, uint32_t value)
+{
+    data[0] = static_cast<uint8_t>(value >> 24);
+    data[1] = static_cast<uint8_t>(value >> 16);
+    data[2] = static_cast<uint8_t>(value >> 8);
+    data[3] = static_cast<uint8_t>(value);
+}
+
+inline uint32_t RotateRight(uint32_t value, uint32_t count)
+{
+    return (value >> count) | (value << (32 - count));
+}
+
+void CompressScalar(uint32_t* state, const uint8_t* data, size_t blocks)
+{
+    uint32_t w[64];
+    for (size_t block = 0; block < blocks; ++block, data += Sha256::kBlockSize)
+    {
+        for (size_t t = 0; t < 16; ++t)
+        {
+            w[t] = LoadBigEndian32(data + t * 4);
+        }
+        for (size_t t = 16; t < 64; ++t)
+        {
+            const uint32_t s0 = RotateRight(w[t - 15], 7) ^ RotateRight(w[t - 15], 18) ^ (w[t - 15] >> 3);
+            const uint32_t s1 = RotateRight(w[t - 2], 17) ^ RotateRight(w[t - 2], 19) ^ (w[t - 2] >> 10);
+            w[t]              = w[t - 16] + s0 + w[t - 7] + s1;
+        }
+        uint32_t a = state[0];
+        uint32_t b = state[1];
+        uint32_t c = state[2];
+        uint32_t d = state[3];
+        uint32_t e = state[4];
+        uint32_t f = state[5];
+        uint32_t g = state[6];
+        uint32_t h = state[7];
+        for (size_t t = 0; t < 64; ++t)
+        {
+            const uint32_t s1    = RotateRight(e, 6) ^ RotateRight(e, 11) ^ RotateRight(e, 25);
+            const uint32_t ch    = (e & f) ^ (~e & g);
+            const uint32_t temp1 = h + s1 + ch + kSha256K[t] + w[t];
+            const uint32_t s0    = RotateRight(a, 2) ^ RotateRight(a, 13) ^ RotateRight(a, 22);
+            const uint32_t maj   = (a & b) ^ (a & c) ^ (b & c);
+            const uint32_t temp2 = s0 + maj;
+            h                    = g;
+            g                    = f;
+            f                    = e;
+            e                    = d + temp1;
+            d                    = c;
+            c                    = b;
+            b                    = a;
+            a                    = temp1 + temp2;
+        }
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+}
+
+#ifdef ZEUS_ARCH_X64
+//Intel SHA扩展指令实现，状态寄存器使用ABEF/CDGH排列
+ZEUS_TARGET_SHA void CompressShaNi(uint32_t* state, const uint8_t* data, size_t blocks)
+{
+    const __m128i kByteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    __m128i temp   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state));
+    __m128i state1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4));
+    temp           = _mm_shuffle_epi32(temp, 0xB1);
+    state1         = _mm_shuffle_epi32(state1, 0x1B);
+    __m128i state0 = _mm_alignr_epi8(temp, state1, 8);
+    state1         = _mm_blend_epi16(state1, temp, 0xF0);
+
+    for (size_t block = 0; block < blocks; ++block, data += Sha256::kBlockSize)
+    {
+        const __m128i abefSave = state0;
+        const __m128i cdghSave = state1;
+        __m128i       message[4];
+        for (size_t group = 0; group < 16; ++group)
+        {
+            __m128i& current = message[group % 4];
+            if (group < 4)
+            {
+                current = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + group * 16)), kByteSwap);
+            }
+            __m128i roundMessage = _mm_add_epi32(current, _mm_load_si128(reinterpret_cast<const __m128i*>(kSha256K + group * 4)));
+            state1               = _mm_sha256rnds2_epu32(state1, state0, roundMessage);
+            if (group >= 3 && group <= 14)
+            {
+                __m128i& next = message[(group + 1) % 4];
+                next          = _mm_add_epi32(next, _mm_alignr_epi8(current, message[(group + 3) % 4], 4));
+                next          = _mm_sha256msg2_epu32(next, current);
+            }
+            roundMessage = _mm_shuffle_epi32(roundMessage, 0x0E);
+            state0       = _mm_sha256rnds2_epu32(state0, state1, roundMessage);
+            if (group >= 1 && group <= 12)
+            {
+                __m128i& previous = message[(group + 3) % 4];
+                previous          = _mm_sha256msg1_epu32(previous, current);
+            }
+        }
+        state0 = _mm_add_epi32(state0, abefSave);
+        state1 = _mm_add_epi32(state1, cdghSave);
+    }
+
+    temp   = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    state0 = _mm_blend_epi16(temp, state1, 0xF0);
+    state1 = _mm_alignr_epi8(state1, temp, 8);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), state0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), state1);
+}
+#endif
+
+using CompressFunction = void (*)(uint32_t*, const uint8_t*, size_t);
+
+CompressFunction SelectCompress()
+{
+#ifdef ZEUS_ARCH_X64
+    const auto& feature = Hardware::GetCpuFeature();
+    if (feature.sha && feature.sse41 && feature.ssse3)
+    {
+        return CompressShaNi;
+    }
+#endif
+    return CompressScalar;
+}
+
+void Compress(uint32_t* state, const uint8_t* data, size_t blocks)
+{
+    static const CompressFunction compress = SelectCompress();
+    compress(state, data, blocks);
+}
+
+//多消息并行计算时每个通道的数据，完整的块直接引用原始数据，末尾的块和填充拷贝到tail中
+struct LaneMessage
+{
+    const uint8_t* data       = nullptr;
+    size_t         fullBlocks = 0;
+    size_t         blocks     = 0;
+    uint8_t*       digest     = nullptr;
+    uint8_t        tail[Sha256::kBlockSize * 2];
+};
+
+void PrepareLane(LaneMessage& lane, const void* input, size_t length, void* digest)
+{
+    lane.data                  = static_cast<const uint8_t*>(input);
+    lane.fullBlocks            = length / Sha256::kBlockSize;
+    lane.digest                = static_cast<uint8_t*>(digest);
+    const size_t remain        = length % Sha256::kBlockSize;
+    const size_t tailBlocks    = remain + 9 > Sha256::kBlockSize ? 2 : 1;
+    lane.blocks                = lane.fullBlocks + tailBlocks;
+    std::memset(lane.tail, 0, sizeof(lane.tail));
+    if (remain)
+    {
+        std::memcpy(lane.tail, lane.data + lane.fullBlocks * Sha256::kBlockSize, remain);
+    }
+    lane.tail[remain]          = 0x80;
+    const uint64_t bitLength   = static_cast<uint64_t>(length) * 8;
+    uint8_t*       lengthField = lane.tail + tailBlocks * Sha256::kBlockSize - 8;
+    StoreBigEndian32(lengthField, static_cast<uint32_t>(bitLength >> 32));
+    StoreBigEndian32(lengthField + 4, static_cast<uint32_t>(bitLength));
+}
+
+const uint8_t* LaneBlock(const LaneMessage& lane, size_t index)
+{
+    if (index < lane.fullBlocks)
+    {
+        return lane.data + index * Sha256::kBlockSize;
+    }
+    if (index < lane.blocks)
+    {
+        return lane.tail + (index - lane.fullBlocks) * Sha256::kBlockSize;
+    }
+    //已经结束的通道继续参与计算，但是结果会被丢弃
+    return lane.tail;
+}
+
+void StoreLaneDigest(const LaneMessage& lane, const uint32_t* state)
+{
+    if (lane.digest)
+    {
+        for (size_t index = 0; index < 8; ++index)
+        {
+            StoreBigEndian32(lane.digest + index * 4, state[index]);
+        }
+    }
+}
+
+#ifdef ZEUS_ARCH_X64
+//SSE2每个寄存器4个通道，每个通道计算一条消息
+inline __m128i RotateRightX4(__m128i value, int count)
+{
+    return _mm_or_si128(_mm_srli_epi32(value, count), _mm_slli_epi32(value, 32 - count));
+}
+
+void HashLanesSse2(LaneMessage* lanes)
+{
+    constexpr size_t kLanes = 4;
+    size_t           blocks = 0;
+    __m128i          state[8];
+    for (size_t index = 0; index < 8; ++index)
+    {
+        state[index] = _mm_set1_epi32(static_cast<int>(kSha256Init[index]));
+    }
+    for (size_t lane = 0; lane < kLanes; ++lane)
+    {
+        blocks = std::max(blocks, lanes[lane].blocks);
+    }
+    for (size_t block = 0; block < blocks; ++block)
+    {
+        const uint8_t* data[kLanes];
+        for (size_t lane = 0; lane < kLanes; ++lane)
+        {
+            data[lane] = LaneBlock(lanes[lane], block);
+        }
+        __m128i w[64];
+        for (size_t t = 0; t < 16; ++t)
+        {
+            w[t] = _mm_set_epi32(
+                static_cast<int>(LoadBigEndian32(data[3] + t * 4)), static_cast<int>(LoadBigEndian32(data[2] + t * 4)),
+                static_cast<int>(LoadBigEndian32(data[1] + t * 4)), static_cast<int>(LoadBigEndian32(data[0] + t * 4))
+            );
+        }
+        for (size_t t = 16; t < 64; ++t)
+        {
+            const __m128i s0 = _mm_xor_si128(
+                _mm_xor_si128(RotateRightX4(w[t - 15], 7), RotateRightX4(w[t - 15], 18)), _mm_srli_epi32(w[t - 15], 3)
+            );
+            const __m128i s1 = _mm_xor_si128(
+                _mm_xor_si128(RotateRightX4(w[t - 2], 17), RotateRightX4(w[t - 2], 19)), _mm_srli_epi32(w[t - 2], 10)
+            );
+            w[t]             = _mm_add_epi32(_mm_add_epi32(w[t - 16], s0), _mm_add_epi32(w[t - 7], s1));
+        }
+        __m128i a = state[0];
+        __m128i b = state[1];
+        __m128i c = state[2];
+        __m128i d = state[3];
+        __m128i e = state[4];
+        __m128i f = state[5];
+        __m128i g = state[6];
+        __m128i h = state[7];
+        for (size_t t = 0; t < 64; ++t)
+        {
+            const __m128i s1 = _mm_xor_si128(_mm_xor_si128(RotateRightX4(e, 6), RotateRightX4(e, 11)), RotateRightX4(e, 25));
+            const __m128i ch = _mm_xor_si128(_mm_and_si128(e, f), _mm_andnot_si128(e, g));
+            const __m128i temp1 =
+                _mm_add_epi32(_mm_add_epi32(_mm_add_epi32(h, s1), _mm_add_epi32(ch, _mm_set1_epi32(static_cast<int>(kSha256K[t])))), w[t]);
+            const __m128i s0    = _mm_xor_si128(_mm_xor_si128(RotateRightX4(a, 2), RotateRightX4(a, 13)), RotateRightX4(a, 22));
+            const __m128i maj   = _mm_or_si128(_mm_and_si128(a, b), _mm_and_si128(c, _mm_or_si128(a, b)));
+            h                   = g;
+            g                   = f;
+            f                   = e;
+            e                   = _mm_add_epi32(d, temp1);
+            d                   = c;
+            c                   = b;
+            b                   = a;
+            a                   = _mm_add_epi32(temp1, _mm_add_epi32(s0, maj));
+        }
+        state[0] = _mm_add_epi32(state[0], a);
+        state[1] = _mm_add_epi32(state[1], b);
+        state[2] = _mm_add_epi32(state[2], c);
+        state[3] = _mm_add_epi32(state[3], d);
+        state[4] = _mm_add_epi32(state[4], e);
+        state[5] = _mm_add_epi32(state[5], f);
+        state[6] = _mm_add_epi32(state[6], g);
+        state[7] = _mm_add_epi32(state[7], h);
+
+        alignas(16) uint32_t laneState[8][kLanes];
+        bool                 extracted = false;
+        for (size_t lane = 0; lane < kLanes; ++lane)
+        {
+            if (lanes[lane].blocks != block + 1)
+            {
+                continue;
+            }
+            if (!extracted)
+            {
+                for (size_t index = 0; index < 8; ++index)
+                {
+                    _mm_store_si128(reinterpret_cast<__m128i*>(laneState[index]), state[index]);
+                }
+                extracted = true;
+            }
+            uint32_t digestState[8];
+            for (size_t index = 0; index < 8; ++index)
+            {
+                digestState[index] = laneState[index][lane];
+            }
+            StoreLaneDigest(lanes[lane], digestState);
+        }
+    }
+}
+
+//AVX2每个寄存器8个通道
+ZEUS_TARGET_AVX2 inline __m256i RotateRightX8(__m256i value, int count)
+{
+    return _mm256_or_si256(_mm256_srli_epi32(value, count), _mm256_slli_epi32(value, 32 - count));
+}
+
+ZEUS_TARGET_AVX2 void HashLanesAvx2(LaneMessage* lanes)
+{
+    constexpr size_t kLanes = 8;
+    size_t           blocks = 0;
+    __m256i          state[8];
+    for (size_t index = 0; index < 8; ++index)
+    {
+        state[index] = _mm256_set1_epi32(static_cast<int>(kSha256Init[index]));
+    }
+    for (size_t lane = 0; lane < kLanes; ++lane)
+    {
+        blocks = std::max(blocks, lanes[lane].blocks);
+    }
+    for (size_t block = 0; block < blocks; ++block)
+    {
+        const uint8_t* data[kLanes];
+        for (size_t lane = 0; lane < kLanes; ++lane)
+        {
+            data[lane] = LaneBlock(lanes[lane], block);
+        }
+        __m256i w[64];
+        for (size_t t = 0; t < 16; ++t)
+        {
+            w[t] = _mm256_set_epi32(
+                static_cast<int>(LoadBigEndian32(data[7] + t * 4)), static_cast<int>(LoadBigEndian32(data[6] + t * 4)),
+                static_cast<int>(LoadBigEndian32(data[5] + t * 4)), static_cast<int>(LoadBigEndian32(data[4] + t * 4)),
+                static_cast<int>(LoadBigEndian32(data[3] + t * 4)), static_cast<int>(LoadBigEndian32(data[2] + t * 4)),
+                static_cast<int>(LoadBigEndian32(data[1] + t * 4)), static_cast<int>(LoadBigEndian32(data[0] + t * 4))
+            );
+        }
+        for (size_t t = 16; t < 64; ++t)
+        {
+            const __m256i s0 = _mm256_xor_si256(
+                _mm256_xor_si256(RotateRightX8(w[t - 15], 7), RotateRightX8(w[t - 15], 18)), _mm256_srli_epi32(w[t - 15], 3)
+            );
+            const __m256i s1 = _mm256_xor_si256(
+                _mm256_xor_si256(RotateRightX8(w[t - 2], 17), RotateRightX8(w[t - 2], 19)), _mm256_srli_epi32(w[t - 2], 10)
+            );
+            w[t]             = _mm256_add_epi32(_mm256_add_epi32(w[t - 16], s0), _mm256_add_epi32(w[t - 7], s1));
+        }
+        __m256i a = state[0];
+        __m256i b = state[1];
+        __m256i c = state[2];
+        __m256i d = state[3];
+        __m256i e = state[4];
+        __m256i f = state[5];
+        __m256i g = state[6];
+        __m256i h = state[7];
+        for (size_t t = 0; t < 64; ++t)
+        {
+            const __m256i s1    = _mm256_xor_si256(_mm256_xor_si256(RotateRightX8(e, 6), RotateRightX8(e, 11)), RotateRightX8(e, 25));
+            const __m256i ch    = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+            const __m256i temp1 = _mm256_add_epi32(
+                _mm256_add_epi32(_mm256_add_epi32(h, s1), _mm256_add_epi32(ch, _mm256_set1_epi32(static_cast<int>(kSha256K[t])))), w[t]
+            );
+            const __m256i s0  = _mm256_xor_si256(_mm256_xor_si256(RotateRightX8(a, 2), RotateRightX8(a, 13)), RotateRightX8(a, 22));
+            const __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+            h                 = g;
+            g                 = f;
+            f                 = e;
+            e                 = _mm256_add_epi32(d, temp1);
+            d                 = c;
+            c                 = b;
+            b                 = a;
+            a                 = _mm256_add_epi32(temp1, _mm256_add_epi32(s0, maj));
+        }
+        state[0] = _mm256_add_epi32(state[0], a);
+        state[1] = _mm256_add_epi32(state[1], b);
+        state[2] = _mm256_add_epi32(state[2], c);
+        state[3] = _mm256_add_epi32(state[3], d);
+        state[4] = _mm256_add_epi32(state[4], e);
+        state[5] = _mm256_add_epi32(state[5], f);
+        state[6] = _mm256_add_epi32(state[6], g);
+        state[7] = _mm256_add_epi32(state[7], h);
+
+        alignas(32) uint32_t laneState[8][kLanes];
+        bool                 extracted = false;
+        for (size_t lane = 0; lane < kLanes; ++lane)
+        {
+            if (lanes[lane].blocks != block + 1)
+            {
+                continue;
+            }
+            if (!extracted)
+            {
+                for (size_t index = 0; index < 8; ++index)
+                {
+                    _mm256_store_si256(reinterpret_cast<__m256i*>(laneState[index]), state[index]);
+                }
+                extracted = true;
+            }
+            uint32_t digestState[8];
+            for (size_t index = 0; index < 8; ++index)
+            {
+                digestState[index] = laneState[index][lane];
+            }
+            StoreLaneDigest(lanes[lane], digestState);
+        }
+    }
+}
+
+template<size_t kLanes>
+void HashManyLanes(const void* const* inputs, const size_t* lengths, size_t count, Sha256::DigestBytes* digests, void (*hashLanes)(LaneMessage*))
+{
+    LaneMessage lanes[kLanes];
+    for (size_t offset = 0; offset < count; offset += kLanes)
+    {
+        for (size_t lane = 0; lane < kLanes; ++lane)
+        {
+            const size_t index = offset + lane;
+            if (index < count)
+            {
+                PrepareLane(lanes[lane], inputs[index], lengths[index], digests[index].data());
+            }
+            else
+            {
+                //不足一组时用空消息补齐，结果不输出
+                PrepareLane(lanes[lane], nullptr, 0, nullptr);
+            }
+        }
+        hashLanes(lanes);
+    }
+}
+#endif
+} // namespace
+
+Sha256::Sha256() noexcept
+{
+    Reset();
+}
+
+void Sha256::Reset() noexcept
+{
+    _state      = kSha256Init;
+    _length     = 0;
+    _bufferSize = 0;
+}
+
+void Sha256::Update(const void* input, size_t length) noexcept
+{
+    const auto* data = static_cast<const uint8_t*>(input);
+    _length += length;
+    if (_bufferSize)
+    {
+        const size_t fill = std::min(length, kBlockSize - _bufferSize);
+        std::memcpy(_buffer.data() + _bufferSize, data, fill);
+        _bufferSize += fill;
+        data += fill;
+        length -= fill;
+        if (_bufferSize < kBlockSize)
+        {
+            return;
+        }
+        Compress(_state.data(), _buffer.data(), 1);
+        _bufferSize = 0;
+    }
+    if (const size_t blocks = length / kBlockSize; blocks)
+    {
+        Compress(_state.data(), data, blocks);
+        data += blocks * kBlockSize;
+        length -= blocks * kBlockSize;
+    }
+    if (length)
+    {
+        std::memcpy(_buffer.data(), data, length);
+        _bufferSize = length;
+    }
+}
+
+void Sha256::Update(std::string_view data) noexcept
+{
+    Update(data.data(), data.size());
+}
+
+void Sha256::Final(void* digest) noexcept
+{
+    const uint64_t bitLength = _length * 8;
+    _buffer[_bufferSize++]   = 0x80;
+    if (_bufferSize > kBlockSize - 8)
+    {
+        std::memset(_buffer.data() + _bufferSize, 0, kBlockSize - _bufferSize);
+        Compress(_state.data(), _buffer.data(), 1);
+        _bufferSize = 0;
+    }
+    std::memset(_buffer.data() + _bufferSize, 0, kBlockSize - 8 - _bufferSize);
+    StoreBigEndian32(_buffer.data() + kBlockSize - 8, static_cast<uint32_t>(bitLength >> 32));
+    StoreBigEndian32(_buffer.data() + kBlockSize - 4, static_cast<uint32_t>(bitLength));
+    Compress(_state.data(), _buffer.data(), 1);
+    auto* output = static_cast<uint8_t*>(digest);
+    for (size_t index = 0; index < _state.size(); ++index)
+    {
+        StoreBigEndian32(output + index * 4, _state[index]);
+    }
+    Reset();
+}
+
+Sha256::DigestBytes Sha256::Final() noexcept
+{
+    DigestBytes digest;
+    Final(digest.data());
+    return digest;
+}
+
+Sha256::DigestBytes Sha256::Hash(const void* input, size_t length) noexcept
+{
+    DigestBytes digest;
+    Hash(input, length, digest.data());
+    return digest;
+}
+
+Sha256::DigestBytes Sha256::Hash(std::string_view data) noexcept
+{
+    return Hash(data.data(), data.size());
+}
+
+void Sha256::Hash(const void* input, size_t length, void* digest) noexcept
+{
+    Sha256 context;
+    context.Update(input, length);
+    context.Final(digest);
+}
+
+void Sha256::HashMany(const void* const* inputs, const size_t* lengths, size_t count, DigestBytes* digests) noexcept
+{
+#ifdef ZEUS_ARCH_X64
+    const auto& feature = Hardware::GetCpuFeature();
+    //SHA扩展指令单条消息的速度已经超过多通道SIMD
+    if (!feature.sha || !feature.sse41)
+    {
+        if (feature.avx2)
+        {
+            HashManyLanes<8>(inputs, lengths, count, digests, HashLanesAvx2);
+        }
+        else
+        {
+            HashManyLanes<4>(inputs, lengths, count, digests, HashLanesSse2);
+        }
+        return;
+    }
+#endif
+    for (size_t index = 0; index < count; ++index)
+    {
+        Hash(inputs[index], lengths[index], digests[index].data());
+    }
+}
+
+HmacSha256::HmacSha256(const void* key, size_t keyLength) noexcept
+{
+    std::array<uint8_t, Sha256::kBlockSize> block {};
+    if (keyLength > Sha256::kBlockSize)
+    {
+        Sha256::Hash(key, keyLength, block.data());
+    }
+    else if (keyLength)
+    {
+        std::memcpy(block.data(), key, keyLength);
+    }
+    for (auto& item : block)
+    {
+        item ^= 0x36;
+    }
+    _innerInit.Update(block.data(), block.size());
+    for (auto& item : block)
+    {
+        item ^= 0x36 ^ 0x5c;
+    }
+    _outerInit.Update(block.data(), block.size());
+    _inner = _innerInit;
+}
+
+void HmacSha256::Reset() noexcept
+{
+    _inner = _innerInit;
+}
+
+void HmacSha256::Update(const void* input, size_t length) noexcept
+{
+    _inner.Update(input, length);
+}
+
+void HmacSha256::Update(std::string_view data) noexcept
+{
+    _inner.Update(data.data(), data.size());
+}
+
+void HmacSha256::Final(void* digest) noexcept
+{
+    uint8_t innerDigest[kDigestSize];
+    _inner.Final(innerDigest);
+    Sha256 outer = _outerInit;
+    outer.Update(innerDigest, sizeof(innerDigest));
+    outer.Final(digest);
+    Reset();
+}
+
+HmacSha256::DigestBytes HmacSha256::Final() noexcept
+{
+    DigestBytes digest;
+    Final(digest.data());
+    return digest;
+}
+
+HmacSha256::DigestBytes HmacSha256::Hash(const void* key, size_t keyLength, const void* input, size_t length) noexcept
+{
+    DigestBytes digest;
+    Hash(key, keyLength, input, length, digest.data());
+    return digest;
+}
+
+void HmacSha256::Hash(const void* key, size_t keyLength, const void* input, size_t length, void* digest) noexcept
+{
+    HmacSha256 context(key, keyLength);
+    context.Update(input, length);
+    context.Final(digest);
+}
+} // namespace zeus
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic) 没有c++20，没有std::span可用
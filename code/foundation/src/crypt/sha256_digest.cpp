@@ -1,4 +1,5 @@
 ﻿#include "zeus/foundation/crypt/sha256_digest.h"
+#include "zeus/foundation/crypt/sha256.h"
 #include "impl/sha256_digest_impl.h"
 
 namespace zeus
@@ -67,4 +68,9 @@ void SHA256Digest::Reset()
 {
     _impl->Reset();
 }
+
+void SHA256Digest::Hash(const void *input, size_t length, void *digest)
+{
+    Sha256::Hash(input, length, digest);
+}
 } // namespace zeus
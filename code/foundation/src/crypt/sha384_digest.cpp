@@ -67,4 +67,9 @@ void SHA384Digest::Reset()
 {
     _impl->Reset();
 }
+
+void SHA384Digest::Hash(const void *input, size_t length, void *digest)
+{
+    SHA384DigestImpl::Hash(input, length, digest);
+}
 } // namespace zeus
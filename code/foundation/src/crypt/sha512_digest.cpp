@@ -67,4 +67,9 @@ void SHA512Digest::Reset()
 {
     _impl->Reset();
 }
+
+void SHA512Digest::Hash(const void *input, size_t length, void *digest)
+{
+    SHA512DigestImpl::Hash(input, length, digest);
+}
 } // namespace zeus
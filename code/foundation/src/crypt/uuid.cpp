@@ -1,7 +1,4 @@
 ﻿#include "zeus/foundation/crypt/uuid.h"
-#include <sstream>
-#include <iomanip>
-#include <ios>
 #include <array>
 #include <cstring>
 
@@ -13,7 +10,7 @@
 #endif
 #include "zeus/foundation/string/charset_utils.h"
 #include "zeus/foundation/byte/byte_order.h"
-#include "zeus/foundation/byte/byte_utils.h"
+#include "zeus/foundation/byte/hex.h"
 namespace zeus
 {
 
@@ -81,23 +78,16 @@ Uuid Uuid::GenerateRandom()
 
 std::string Uuid::toString(const std::string& split, bool up) const
 {
-    std::stringstream str;
-    str.imbue(std::locale::classic());
-    if (up)
-    {
-        str.setf(std::ios_base::uppercase);
-    }
-    else
-    {
-        str.unsetf(std::ios_base::uppercase);
-    }
-    str << std::hex << std::setfill('0') << std::setw(2) << (int) _impl->data[0] << std::setw(2) << (int) _impl->data[1] << std::setw(2)
-        << (int) _impl->data[2] << std::setw(2) << (int) _impl->data[3] << split << std::setw(2) << (int) _impl->data[4] << std::setw(2)
-        << (int) _impl->data[5] << split << std::setw(2) << (int) _impl->data[6] << std::setw(2) << (int) _impl->data[7] << split << std::setw(2)
-        << (int) _impl->data[8] << std::setw(2) << (int) _impl->data[9] << split << std::setw(2) << (int) _impl->data[10] << std::setw(2)
-        << (int) _impl->data[11] << std::setw(2) << (int) _impl->data[12] << std::setw(2) << (int) _impl->data[13] << std::setw(2)
-        << (int) _impl->data[14] << std::setw(2) << (int) _impl->data[15];
-    return str.str();
+    char compact[UuidValue::kCompactLength];
+    Hex::Encode(_impl->data.data(), _impl->data.size(), compact, up);
+    std::string result;
+    result.reserve(UuidValue::kCompactLength + split.size() * 4);
+    result.append(compact, 8).append(split);
+    result.append(compact + 8, 4).append(split);
+    result.append(compact + 12, 4).append(split);
+    result.append(compact + 16, 4).append(split);
+    result.append(compact + 20, 12);
+    return result;
 }
 #ifdef _WIN32
 std::string Uuid::toWindowsString() const
@@ -141,47 +131,23 @@ std::optional<Uuid> Uuid::FromWindowsString(const std::string& guid)
     {
         return std::nullopt;
     }
-    Uuid result;
-    //第一段
-    auto temp  = guid.substr(1, 8);
-    auto bytes = HexStringToBytes(temp);
-    if (!bytes || bytes->size() != 4)
+    auto value = UuidValue::Parse(guid);
+    if (!value)
     {
         return std::nullopt;
     }
-    std::memcpy(&result._impl->data[0], bytes->data(), bytes->size());
-    //第二段
-    temp  = guid.substr(2 + 8, 4);
-    bytes = HexStringToBytes(temp);
-    if (!bytes->data() || bytes->size() != 2)
-    {
-        return std::nullopt;
-    }
-    std::memcpy(&result._impl->data[4], bytes->data(), bytes->size());
-    //第三段
-    temp  = guid.substr(3 + 12, 4);
-    bytes = HexStringToBytes(temp);
-    if (!bytes->data() || bytes->size() != 2)
-    {
-        return std::nullopt;
-    }
-    std::memcpy(&result._impl->data[6], bytes->data(), bytes->size());
-    //第四段
-    temp  = guid.substr(4 + 16, 4);
-    bytes = HexStringToBytes(temp);
-    if (!bytes->data() || bytes->size() != 2)
-    {
-        return std::nullopt;
-    }
-    std::memcpy(&result._impl->data[8], bytes->data(), bytes->size());
-    //第五段
-    temp  = guid.substr(5 + 20, 12);
-    bytes = HexStringToBytes(temp);
-    if (!bytes->data() || bytes->size() != 6)
-    {
-        return std::nullopt;
-    }
-    std::memcpy(&result._impl->data[10], bytes->data(), bytes->size());
+    return FromValue(*value);
+}
+
+UuidValue Uuid::ToValue() const noexcept
+{
+    return UuidValue(_impl->data);
+}
+
+Uuid Uuid::FromValue(const UuidValue& value)
+{
+    Uuid result;
+    std::memcpy(result._impl->data.data(), value.Data(), UuidValue::kSize);
     return result;
 }
 
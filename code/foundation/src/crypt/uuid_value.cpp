@@ -0,0 +1,198 @@
+﻿#include "zeus/foundation/crypt/uuid_value.h"
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic) 没有c++20，没有std::span可用
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <cryptopp/osrng.h>
+#ifdef __linux__
+#include <pthread.h>
+#endif
+#include "zeus/foundation/byte/hex.h"
+
+namespace zeus
+{
+namespace
+{
+constexpr size_t kRandomBufferSize = 4096;
+constexpr size_t kHyphenOffsets[]  = {8, 13, 18, 23};
+
+#ifdef __linux__
+//fork出的子进程继承了父进程缓冲区中还没有用过的随机数，子进程中递增代数，缓冲区发现代数变化时丢弃剩余的随机数
+std::atomic<uint64_t> gForkGeneration {0};
+
+void RegisterForkHandler()
+{
+    static const int registered = pthread_atfork(nullptr, nullptr, []() { gForkGeneration.fetch_add(1, std::memory_order_relaxed); });
+    (void) registered;
+}
+#endif
+
+//每次向系统申请随机数需要一次系统调用，线程内缓冲一批，批量生成时直接从缓冲区拷贝
+class RandomBuffer
+{
+public:
+    void Fill(uint8_t* output, size_t size)
+    {
+#ifdef __linux__
+        if (const auto generation = gForkGeneration.load(std::memory_order_relaxed); generation != _generation)
+        {
+            std::memset(_data.data(), 0, _data.size());
+            _offset     = _data.size();
+            _generation = generation;
+        }
+#endif
+        while (size)
+        {
+            if (_offset == _data.size())
+            {
+                //失败时抛出OS_RNG_Err，_offset不变，下次调用重新获取
+                CryptoPP::OS_GenerateRandomBlock(false, _data.data(), _data.size());
+                _offset = 0;
+            }
+            const size_t count = std::min(size, _data.size() - _offset);
+            std::memcpy(output, _data.data() + _offset, count);
+            //用过的随机数不再留在内存中
+            std::memset(_data.data() + _offset, 0, count);
+            _offset += count;
+            output += count;
+            size -= count;
+        }
+    }
+private:
+    std::array<uint8_t, kRandomBufferSize> _data {};
+    size_t                                 _offset = kRandomBufferSize;
+#ifdef __linux__
+    uint64_t                               _generation = 0;
+#endif
+};
+
+RandomBuffer& GetRandomBuffer()
+{
+#ifdef __linux__
+    RegisterForkHandler();
+#endif
+    thread_local RandomBuffer buffer;
+    return buffer;
+}
+
+void SetVersion(uint8_t* data, uint8_t version)
+{
+    data[6] = static_cast<uint8_t>((data[6] & 0x0F) | (version << 4));
+    //RFC 9562 variant 10xx
+    data[8] = static_cast<uint8_t>((data[8] & 0x3F) | 0x80);
+}
+} // namespace
+
+size_t UuidValue::Format(char* output, bool upCase, bool hyphen) const noexcept
+{
+    if (!hyphen)
+    {
+        return Hex::Encode(_data, kSize, output, upCase);
+    }
+    //整体编码后再插入分隔符，16字节刚好一次SIMD处理
+    char compact[kCompactLength];
+    Hex::Encode(_data, kSize, compact, upCase);
+    std::memcpy(output, compact, 8);
+    output[8] = '-';
+    std::memcpy(output + 9, compact + 8, 4);
+    output[13] = '-';
+    std::memcpy(output + 14, compact + 12, 4);
+    output[18] = '-';
+    std::memcpy(output + 19, compact + 16, 4);
+    output[23] = '-';
+    std::memcpy(output + 24, compact + 20, 12);
+    return kStringLength;
+}
+
+std::string UuidValue::ToString(bool upCase, bool hyphen) const
+{
+    std::string result(hyphen ? kStringLength : kCompactLength, '\0');
+    Format(result.data(), upCase, hyphen);
+    return result;
+}
+
+std::optional<UuidValue> UuidValue::Parse(std::string_view text) noexcept
+{
+    if (kStringLength + 2 == text.size() && '{' == text.front() && '}' == text.back())
+    {
+        text = text.substr(1, kStringLength);
+    }
+    char        compact[kCompactLength];
+    const char* hex = text.data();
+    if (kStringLength == text.size())
+    {
+        size_t begin  = 0;
+        size_t copied = 0;
+        for (const auto offset : kHyphenOffsets)
+        {
+            if ('-' != text[offset])
+            {
+                return std::nullopt;
+            }
+            std::memcpy(compact + copied, text.data() + begin, offset - begin);
+            copied += offset - begin;
+            begin = offset + 1;
+        }
+        std::memcpy(compact + copied, text.data() + begin, kStringLength - begin);
+        hex = compact;
+    }
+    else if (kCompactLength != text.size())
+    {
+        return std::nullopt;
+    }
+    UuidValue result;
+    if (!Hex::Decode(hex, kCompactLength, result._data).has_value())
+    {
+        return std::nullopt;
+    }
+    return result;
+}
+
+UuidValue UuidValue::GenerateRandom()
+{
+    UuidValue result;
+    GetRandomBuffer().Fill(result._data, kSize);
+    SetVersion(result._data, 4);
+    return result;
+}
+
+void UuidValue::GenerateRandom(UuidValue* values, size_t count)
+{
+    static_assert(sizeof(UuidValue) == kSize, "UuidValue must be 16 bytes");
+    GetRandomBuffer().Fill(reinterpret_cast<uint8_t*>(values), count * kSize);
+    for (size_t index = 0; index < count; ++index)
+    {
+        SetVersion(values[index]._data, 4);
+    }
+}
+
+UuidValue UuidValue::GenerateTimeOrdered()
+{
+    //48位毫秒时间戳加12位计数器(rand_a)，同一毫秒内计数器递增，计数器溢出时借用下一毫秒，保证进程内严格单调
+    static std::atomic<uint64_t> last {0};
+
+    const auto now =
+        static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+    const uint64_t candidate = now << 12;
+    uint64_t       previous  = last.load(std::memory_order_relaxed);
+    uint64_t       next      = 0;
+    do
+    {
+        next = std::max(candidate, previous + 1);
+    } while (!last.compare_exchange_weak(previous, next, std::memory_order_relaxed));
+
+    UuidValue result;
+    GetRandomBuffer().Fill(result._data + 8, kSize - 8);
+    const uint64_t timestamp = next >> 12;
+    for (size_t index = 0; index < 6; ++index)
+    {
+        result._data[index] = static_cast<uint8_t>(timestamp >> (40 - 8 * index));
+    }
+    result._data[6] = static_cast<uint8_t>((next >> 8) & 0x0F);
+    result._data[7] = static_cast<uint8_t>(next);
+    SetVersion(result._data, 7);
+    return result;
+}
+} // namespace zeus
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic) 没有c++20，没有std::span可用
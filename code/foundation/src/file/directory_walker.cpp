@@ -0,0 +1,126 @@
+﻿#include "zeus/foundation/file/directory_walker.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include "impl/directory_walker_impl.h"
+
+namespace zeus
+{
+zeus::expected<void, std::error_code> DirectoryWalker::Walk(const std::filesystem::path& directory, const Options& options, const Callback& callback)
+{
+    //按后进先出处理目录，队列的长度和树的深度相关而不是和目录总数相关
+    std::mutex                 mutex;
+    std::condition_variable    condition;
+    std::vector<DirectoryTask> tasks;
+    size_t                     active = 0;
+    std::atomic<bool>          stop   = false;
+    std::error_code            error;
+    tasks.push_back({directory, 0, nullptr});
+
+    auto worker = [&]()
+    {
+        std::vector<DirectoryTask> children;
+        for (;;)
+        {
+            DirectoryTask task;
+            {
+                std::unique_lock lock(mutex);
+                condition.wait(lock, [&]() { return stop || !tasks.empty() || !active; });
+                if (stop || tasks.empty())
+                {
+                    return;
+                }
+                task = std::move(tasks.back());
+                tasks.pop_back();
+                ++active;
+            }
+            children.clear();
+            auto result = ListDirectory(task, options, callback, stop, children);
+            {
+                std::lock_guard lock(mutex);
+                --active;
+                if (!result.has_value())
+                {
+                    if (!task.depth || !IsSkippableDirectoryError(result.error()))
+                    {
+                        if (!error)
+                        {
+                            error = result.error();
+                        }
+                        stop = true;
+                    }
+                }
+                else if (!result.value())
+                {
+                    stop = true;
+                }
+                std::move(children.begin(), children.end(), std::back_inserter(tasks));
+            }
+            condition.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    const size_t             parallelism = std::max<size_t>(options.parallelism, 1);
+    threads.reserve(parallelism - 1);
+    for (size_t index = 1; index < parallelism; ++index)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    if (error)
+    {
+        return zeus::unexpected(error);
+    }
+    return {};
+}
+
+zeus::expected<std::vector<std::filesystem::path>, std::error_code> DirectoryWalker::Collect(
+    const std::filesystem::path& directory, const Options& options
+)
+{
+    std::mutex                         mutex;
+    std::vector<std::filesystem::path> files;
+    auto                               ret = Walk(
+        directory, options,
+        [&](const Entry& entry)
+        {
+            std::lock_guard lock(mutex);
+            files.emplace_back(entry.path);
+            return true;
+        }
+    );
+    if (!ret.has_value())
+    {
+        return zeus::unexpected(ret.error());
+    }
+    return files;
+}
+
+zeus::expected<uint64_t, std::error_code> DirectoryWalker::TotalSize(const std::filesystem::path& directory, const Options& options)
+{
+    std::atomic<uint64_t> totalSize = 0;
+    auto                  sizeOptions = options;
+    sizeOptions.querySize             = true;
+    auto ret                          = Walk(
+        directory, sizeOptions,
+        [&totalSize](const Entry& entry)
+        {
+            totalSize.fetch_add(entry.size, std::memory_order_relaxed);
+            return true;
+        }
+    );
+    if (!ret.has_value())
+    {
+        return zeus::unexpected(ret.error());
+    }
+    return totalSize.load();
+}
+} // namespace zeus
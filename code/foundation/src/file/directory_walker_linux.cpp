@@ -0,0 +1,193 @@
+﻿#ifdef __linux__
+#include "zeus/foundation/file/directory_walker.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include "zeus/foundation/core/system_error.h"
+#include "zeus/foundation/resource/linux/file_descriptor.h"
+#include "impl/directory_walker_impl.h"
+
+namespace zeus
+{
+namespace
+{
+//getdents64返回的记录，glibc较老的版本没有提供getdents64的声明
+struct Dirent64
+{
+    uint64_t       d_ino;
+    int64_t        d_off;
+    unsigned short d_reclen;
+    unsigned char  d_type;
+    char           d_name[1];
+};
+
+//每次getdents64读取的缓冲区大小，一次系统调用可以返回几百个条目
+constexpr size_t kDirentBufferSize = 32 * 1024;
+
+//只查询类型和大小，网络文件系统上不强制和服务器同步属性
+bool StatAt(int directoryFd, const char* name, bool follow, unsigned char& type, uint64_t& size) noexcept
+{
+    struct statx statxBuf
+    {
+    };
+    const int flags = AT_STATX_DONT_SYNC | (follow ? 0 : AT_SYMLINK_NOFOLLOW);
+    if (statx(directoryFd, name, flags, STATX_TYPE | STATX_SIZE, &statxBuf))
+    {
+        return false;
+    }
+    type = IFTODT(statxBuf.stx_mode);
+    size = statxBuf.stx_size;
+    return true;
+}
+} // namespace
+
+bool IsSkippableDirectoryError(const std::error_code& error) noexcept
+{
+    switch (error.value())
+    {
+    case EACCES:
+    case EPERM:
+    case ENOENT:
+    case ENOTDIR:
+    case ELOOP:
+        return true;
+    default:
+        return false;
+    }
+}
+
+zeus::expected<bool, std::error_code> ListDirectory(
+    const DirectoryTask& task, const DirectoryWalker::Options& options, const DirectoryWalker::Callback& callback, const std::atomic<bool>& stop,
+    std::vector<DirectoryTask>& children
+)
+{
+    LinuxFileDescriptor directory(open(task.path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+    if (directory.Empty())
+    {
+        return zeus::unexpected(GetLastSystemError());
+    }
+    const int                                fd = directory.Fd();
+    std::shared_ptr<const DirectoryAncestor> ancestors;
+    if (options.followSymbolLinkDirectory)
+    {
+        struct stat statBuf
+        {
+        };
+        if (fstat(fd, &statBuf))
+        {
+            return zeus::unexpected(GetLastSystemError());
+        }
+        const DirectoryIdentity identity {static_cast<uint64_t>(statBuf.st_dev), static_cast<uint64_t>(statBuf.st_ino)};
+        if (IsDirectoryCycle(identity, task.ancestors.get()))
+        {
+            return true;
+        }
+        ancestors = std::make_shared<DirectoryAncestor>(DirectoryAncestor {identity, task.ancestors});
+    }
+    const size_t depth         = task.depth + 1;
+    const bool   enterChildren = depth < options.maxDepth;
+    const bool   followLink    = enterChildren && options.followSymbolLinkDirectory;
+    alignas(Dirent64) char   buffer[kDirentBufferSize];
+    DirectoryWalker::Entry entry;
+    while (!stop.load(std::memory_order_relaxed))
+    {
+        const long count = syscall(SYS_getdents64, fd, buffer, sizeof(buffer));
+        if (count < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            return zeus::unexpected(GetLastSystemError());
+        }
+        if (!count)
+        {
+            break;
+        }
+        for (long position = 0; position < count;)
+        {
+            const auto* dirent = reinterpret_cast<const Dirent64*>(buffer + position);
+            position += dirent->d_reclen;
+            const char* name = dirent->d_name;
+            if ('.' == name[0] && (!name[1] || ('.' == name[1] && !name[2])))
+            {
+                continue;
+            }
+            unsigned char type       = dirent->d_type;
+            bool          symbolLink = false;
+            bool          sizeValid  = false;
+            uint64_t      size       = 0;
+            //部分文件系统不提供类型
+            if (DT_UNKNOWN == type)
+            {
+                if (!StatAt(fd, name, false, type, size))
+                {
+                    continue;
+                }
+                sizeValid = DT_LNK != type;
+            }
+            if (DT_LNK == type)
+            {
+                //不需要链接的目标时不stat
+                if (!options.includeSymbolLinkFile && !followLink)
+                {
+                    continue;
+                }
+                //断开的链接直接跳过
+                if (!StatAt(fd, name, true, type, size))
+                {
+                    continue;
+                }
+                symbolLink = true;
+                sizeValid  = true;
+                if ((DT_DIR == type && !followLink) || (DT_REG == type && !options.includeSymbolLinkFile))
+                {
+                    continue;
+                }
+            }
+            if (DT_DIR == type)
+            {
+                if (enterChildren)
+                {
+                    auto path = task.path / name;
+                    if (!options.directoryFilter || options.directoryFilter(path, depth))
+                    {
+                        children.push_back({std::move(path), depth, ancestors});
+                    }
+                }
+                continue;
+            }
+            if (DT_REG != type)
+            {
+                continue;
+            }
+            entry.path = task.path / name;
+            if (options.fileFilter && !options.fileFilter(entry.path))
+            {
+                continue;
+            }
+            if (options.querySize && !sizeValid)
+            {
+                unsigned char ignore = 0;
+                if (!StatAt(fd, name, false, ignore, size))
+                {
+                    continue;
+                }
+            }
+            entry.depth      = depth;
+            entry.symbolLink = symbolLink;
+            entry.size       = size;
+            if (!callback(entry))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+} // namespace zeus
+#endif
@@ -0,0 +1,162 @@
+﻿#ifdef _WIN32
+#include "zeus/foundation/file/directory_walker.h"
+#include <Windows.h>
+#include "zeus/foundation/core/system_error.h"
+#include "zeus/foundation/resource/win/handle.h"
+#include "zeus/foundation/resource/auto_release.h"
+#include "impl/directory_walker_impl.h"
+
+namespace zeus
+{
+namespace
+{
+bool IsSymbolLink(const WIN32_FIND_DATAW& data) noexcept
+{
+    //目录联接和符号链接一样处理，避免不跟随链接时进入循环
+    return (data.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) &&
+           (IO_REPARSE_TAG_SYMLINK == data.dwReserved0 || IO_REPARSE_TAG_MOUNT_POINT == data.dwReserved0);
+}
+
+zeus::expected<DirectoryIdentity, std::error_code> GetDirectoryIdentity(const std::filesystem::path& path)
+{
+    WinHandle directory(CreateFileW(
+        path.c_str(), FILE_READ_ATTRIBUTES, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+        FILE_FLAG_BACKUP_SEMANTICS, nullptr
+    ));
+    if (INVALID_HANDLE_VALUE == directory.Handle())
+    {
+        return zeus::unexpected(GetLastSystemError());
+    }
+    BY_HANDLE_FILE_INFORMATION information = {};
+    if (!GetFileInformationByHandle(directory, &information))
+    {
+        return zeus::unexpected(GetLastSystemError());
+    }
+    return DirectoryIdentity {
+        information.dwVolumeSerialNumber, (static_cast<uint64_t>(information.nFileIndexHigh) << 32) | information.nFileIndexLow
+    };
+}
+} // namespace
+
+bool IsSkippableDirectoryError(const std::error_code& error) noexcept
+{
+    switch (error.value())
+    {
+    case ERROR_ACCESS_DENIED:
+    case ERROR_FILE_NOT_FOUND:
+    case ERROR_PATH_NOT_FOUND:
+    case ERROR_DIRECTORY:
+    case ERROR_CANT_ACCESS_FILE:
+    case ERROR_CANT_RESOLVE_FILENAME:
+        return true;
+    default:
+        return false;
+    }
+}
+
+zeus::expected<bool, std::error_code> ListDirectory(
+    const DirectoryTask& task, const DirectoryWalker::Options& options, const DirectoryWalker::Callback& callback, const std::atomic<bool>& stop,
+    std::vector<DirectoryTask>& children
+)
+{
+    std::shared_ptr<const DirectoryAncestor> ancestors;
+    if (options.followSymbolLinkDirectory)
+    {
+        auto identity = GetDirectoryIdentity(task.path);
+        if (!identity.has_value())
+        {
+            return zeus::unexpected(identity.error());
+        }
+        if (IsDirectoryCycle(identity.value(), task.ancestors.get()))
+        {
+            return true;
+        }
+        ancestors = std::make_shared<DirectoryAncestor>(DirectoryAncestor {identity.value(), task.ancestors});
+    }
+    //FindExInfoBasic不查询短文件名，LARGE_FETCH每次从内核取回更多条目
+    WIN32_FIND_DATAW data = {};
+    HANDLE           find = FindFirstFileExW(
+        (task.path / L"*").c_str(), FindExInfoBasic, &data, FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH
+    );
+    if (INVALID_HANDLE_VALUE == find)
+    {
+        return zeus::unexpected(GetLastSystemError());
+    }
+    ZEUS_DEFER
+    {
+        FindClose(find);
+    };
+    const size_t           depth         = task.depth + 1;
+    const bool             enterChildren = depth < options.maxDepth;
+    const bool             followLink    = enterChildren && options.followSymbolLinkDirectory;
+    DirectoryWalker::Entry entry;
+    do
+    {
+        if (stop.load(std::memory_order_relaxed))
+        {
+            break;
+        }
+        const wchar_t* name = data.cFileName;
+        if (L'.' == name[0] && (!name[1] || (L'.' == name[1] && !name[2])))
+        {
+            continue;
+        }
+        DWORD      attributes = data.dwFileAttributes;
+        uint64_t   size       = (static_cast<uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+        const bool symbolLink = IsSymbolLink(data);
+        if (symbolLink)
+        {
+            if (!options.includeSymbolLinkFile && !followLink)
+            {
+                continue;
+            }
+            //查询链接目标的属性，断开的链接直接跳过
+            WIN32_FILE_ATTRIBUTE_DATA target = {};
+            if (!GetFileAttributesExW((task.path / name).c_str(), GetFileExInfoStandard, &target))
+            {
+                continue;
+            }
+            attributes = target.dwFileAttributes;
+            size       = (static_cast<uint64_t>(target.nFileSizeHigh) << 32) | target.nFileSizeLow;
+            if (attributes & FILE_ATTRIBUTE_DIRECTORY ? !followLink : !options.includeSymbolLinkFile)
+            {
+                continue;
+            }
+        }
+        if (attributes & FILE_ATTRIBUTE_DIRECTORY)
+        {
+            if (enterChildren)
+            {
+                auto path = task.path / name;
+                if (!options.directoryFilter || options.directoryFilter(path, depth))
+                {
+                    children.push_back({std::move(path), depth, ancestors});
+                }
+            }
+            continue;
+        }
+        if (attributes & FILE_ATTRIBUTE_DEVICE)
+        {
+            continue;
+        }
+        entry.path = task.path / name;
+        if (options.fileFilter && !options.fileFilter(entry.path))
+        {
+            continue;
+        }
+        entry.depth      = depth;
+        entry.symbolLink = symbolLink;
+        entry.size       = size;
+        if (!callback(entry))
+        {
+            return false;
+        }
+    } while (FindNextFileW(find, &data));
+    if (!stop.load(std::memory_order_relaxed) && ERROR_NO_MORE_FILES != GetLastError())
+    {
+        return zeus::unexpected(GetLastSystemError());
+    }
+    return true;
+}
+} // namespace zeus
+#endif
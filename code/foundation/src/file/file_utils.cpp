@@ -1,11 +1,18 @@
 ﻿#include "zeus/foundation/file/file_utils.h"
 
 #include <cstring>
+#include <algorithm>
+#include <atomic>
 #include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include <sstream>
 #include <ratio>
 #include "zeus/foundation/string/string_utils.h"
 #include "zeus/foundation/resource/file_mapping.h"
+#include "zeus/foundation/file/line_reader.h"
+#include "zeus/foundation/file/directory_walker.h"
 #include "zeus/foundation/core/system_error.h"
 
 namespace fs = std::filesystem;
@@ -15,63 +22,58 @@ namespace zeus
 
 namespace
 {
-zeus::expected<void, std::error_code> EnumDirectoryRegularFile(
-    const std::filesystem::path& directory, const std::function<bool(const fs::directory_entry& entry)>& handler, bool recursive,
-    bool followSymbolLinkDirectory, bool includeSymbolLinkFile
+//比较文件时每次映射的窗口大小，32位进程地址空间有限，使用较小的窗口
+constexpr uint64_t kCompareWindowSize = sizeof(void*) >= 8 ? 64 * 1024 * 1024 : 8 * 1024 * 1024;
+
+//领取并比较nextWindow指向的窗口，直到比较完或者stop被设置，返回是否相同
+zeus::expected<bool, std::error_code> CompareWindows(
+    const fs::path& path1, const fs::path& path2, uint64_t size, std::atomic<uint64_t>& nextWindow, const std::atomic<bool>& stop
 )
 {
-    std::set<std::filesystem::path> files;
-    std::error_code                 ec;
-    fs::directory_options           options = fs::directory_options::skip_permission_denied;
-    if (followSymbolLinkDirectory)
+    auto mapping1 = FileMapping::Create(path1, false);
+    if (!mapping1)
     {
-        options |= fs::directory_options::follow_directory_symlink;
+        return zeus::unexpected(mapping1.error());
     }
-    if (recursive)
+    auto mapping2 = FileMapping::Create(path2, false);
+    if (!mapping2)
     {
-        auto iterator = fs::recursive_directory_iterator(directory, options, ec);
-        if (ec)
+        return zeus::unexpected(mapping2.error());
+    }
+    //窗口内顺序访问，内核加大预读并尽快回收已经读过的页
+    MemoryMapping::Options options;
+    options.advice = MemoryMapping::Advice::kSequential;
+    while (!stop.load(std::memory_order_relaxed))
+    {
+        const uint64_t offset = nextWindow.fetch_add(1, std::memory_order_relaxed) * kCompareWindowSize;
+        if (offset >= size)
         {
-            return zeus::unexpected {ec};
+            break;
         }
-        for (const auto& entry : iterator)
+        const uint64_t length = std::min(kCompareWindowSize, size - offset);
+        if (const auto ret = mapping1->Map(offset, length, options); !ret.has_value())
         {
-            if (!includeSymbolLinkFile && entry.is_symlink(ec))
-            {
-                continue;
-            }
-            if (entry.is_regular_file(ec))
-            {
-                if (!handler(entry))
-                {
-                    return {};
-                }
-            }
+            return zeus::unexpected(ret.error());
         }
-    }
-    else
-    {
-        auto iterator = fs::directory_iterator(directory, options, ec);
-        if (ec)
+        if (const auto ret = mapping2->Map(offset, length, options); !ret.has_value())
         {
-            return zeus::unexpected {ec};
+            return zeus::unexpected(ret.error());
         }
-        for (const auto& entry : iterator)
+        if (0 != std::memcmp(mapping1->Data(), mapping2->Data(), length))
         {
-            if (!includeSymbolLinkFile && entry.is_symlink(ec))
-            {
-                continue;
-            }
-            if (entry.is_regular_file(ec))
-            {
-                if (!handler(entry))
-                {
-                    return {};
-                }
-            }
+            return false;
         }
     }
-    return {};
+    return true;
+}
+
+DirectoryWalker::Options WalkOptions(bool recursive, bool followSymbolLinkDirectory, bool includeSymbolLinkFile)
+{
+    DirectoryWalker::Options options;
+    options.maxDepth                  = recursive ? options.maxDepth : 1;
+    options.followSymbolLinkDirectory = followSymbolLinkDirectory;
+    options.includeSymbolLinkFile     = includeSymbolLinkFile;
+    return options;
 }
 } // namespace
 
@@ -79,43 +81,22 @@ zeus::expected<void, std::error_code> FileEachLine(
     const std::filesystem::path& path, const std::function<bool(std::string_view line)>& callback, char delim
 )
 {
-    std::ifstream file(path);
-    if (file)
-    {
-        std::string line;
-        while (std::getline(file, line, delim))
-        {
-            if (!callback(line))
-            {
-                break;
-            }
-        }
-        return {};
-    }
-    else
+    LineReader::Options options;
+    options.delimiter = delim;
+#ifdef _WIN32
+    //和文本模式的ifstream一致，CRLF换行时去掉行尾的'\r'
+    options.stripCarriageReturn = '\n' == delim;
+#endif
+    auto reader = LineReader::Open(path, options);
+    if (!reader.has_value())
     {
-        return zeus::unexpected(GetLastSystemError());
+        return zeus::unexpected(reader.error());
     }
+    return reader->ForEach(callback);
 }
 zeus::expected<void, std::error_code> FileEachLine(const std::filesystem::path& path, const std::function<bool(std::string_view line)>& callback)
 {
-    std::ifstream file(path);
-    if (file)
-    {
-        std::string line;
-        while (std::getline(file, line))
-        {
-            if (!callback(line))
-            {
-                break;
-            }
-        }
-        return {};
-    }
-    else
-    {
-        return zeus::unexpected(GetLastSystemError());
-    }
+    return FileEachLine(path, callback, '\n');
 }
 zeus::expected<void, std::error_code> FileEachLineKVData(
     const std::filesystem::path& path, std::string_view delim, const std::function<bool(std::string_view key, std::string_view value)>& callback,
@@ -126,7 +107,7 @@ zeus::expected<void, std::error_code> FileEachLineKVData(
         path,
         [&callback, &delim, &ignorePrefixs](std::string_view line)
         {
-            auto lineData = TrimBegin(line);
+            auto lineData = TrimBeginView(line);
             if (lineData.empty())
             {
                 return true;
@@ -159,7 +140,7 @@ zeus::expected<void, std::error_code> FileEachLineKVData(
         path,
         [&callback, &invalidCallback, &delim, &ignorePrefixs](std::string_view line)
         {
-            auto lineData = TrimBegin(line);
+            auto lineData = TrimBeginView(line);
             if (lineData.empty())
             {
                 return true;
@@ -203,29 +184,7 @@ zeus::expected<uint64_t, std::error_code> GetDirectoryRegularFileSize(
     const std::filesystem::path& directory, bool recursive, bool followSymbolLinkDirectory, bool includeSymbolLinkFile
 )
 {
-    uint64_t totalSize = 0;
-    auto     ret       = EnumDirectoryRegularFile(
-        directory,
-        [&totalSize](const fs::directory_entry& entry)
-        {
-            std::error_code ec;
-            auto            size = entry.file_size(ec);
-            if (!ec)
-            {
-                totalSize += size;
-            }
-            return true;
-        },
-        recursive, followSymbolLinkDirectory, includeSymbolLinkFile
-    );
-    if (ret.has_value())
-    {
-        return totalSize;
-    }
-    else
-    {
-        return zeus::unexpected {ret.error()};
-    }
+    return DirectoryWalker::TotalSize(directory, WalkOptions(recursive, followSymbolLinkDirectory, includeSymbolLinkFile));
 }
 
 zeus::expected<std::set<std::filesystem::path>, std::error_code> GetDirectoryRegularFiles(
@@ -233,18 +192,16 @@ zeus::expected<std::set<std::filesystem::path>, std::error_code> GetDirectoryReg
     bool followSymbolLinkDirectory, bool includeSymbolLinkFile
 )
 {
+    auto options       = WalkOptions(recursive, followSymbolLinkDirectory, includeSymbolLinkFile);
+    options.fileFilter = filter;
     std::set<std::filesystem::path> files;
-    auto                            ret = EnumDirectoryRegularFile(
-        directory,
-        [&files, &filter](const fs::directory_entry& entry)
+    auto                            ret = DirectoryWalker::Walk(
+        directory, options,
+        [&files](const DirectoryWalker::Entry& entry)
         {
-            if (filter(entry.path()))
-            {
-                files.emplace(entry.path());
-            }
+            files.emplace(entry.path);
             return true;
-        },
-        recursive, followSymbolLinkDirectory, includeSymbolLinkFile
+        }
     );
     if (ret.has_value())
     {
@@ -260,24 +217,7 @@ zeus::expected<std::set<std::filesystem::path>, std::error_code> GetDirectoryReg
     const std::filesystem::path& directory, bool recursive, bool followSymbolLinkDirectory, bool includeSymbolLinkFile
 )
 {
-    std::set<std::filesystem::path> files;
-    auto                            ret = EnumDirectoryRegularFile(
-        directory,
-        [&files](const fs::directory_entry& entry)
-        {
-            files.emplace(entry.path());
-            return true;
-        },
-        recursive, followSymbolLinkDirectory, includeSymbolLinkFile
-    );
-    if (ret.has_value())
-    {
-        return files;
-    }
-    else
-    {
-        return zeus::unexpected {ret.error()};
-    }
+    return GetDirectoryRegularFiles(directory, DirectoryWalker::FileFilter {}, recursive, followSymbolLinkDirectory, includeSymbolLinkFile);
 }
 
 zeus::expected<std::set<std::filesystem::path>, std::error_code> GetDirectoryRegularFiles(
@@ -320,20 +260,20 @@ zeus::expected<std::set<std::filesystem::path>, std::error_code> GetDirectoryReg
 
 zeus::expected<bool, std::error_code> FileEqual(std::ifstream& file1, std::ifstream& file2)
 {
-    static const size_t BUFF_SIZE = 1024;
-    char                buffer1[BUFF_SIZE];
-    char                buffer2[BUFF_SIZE];
+    static constexpr size_t kBufferSize = 64 * 1024;
+    std::vector<char>       buffer1(kBufferSize);
+    std::vector<char>       buffer2(kBufferSize);
     while (!file1.eof())
     {
-        file1.read(buffer1, BUFF_SIZE);
-        file2.read(buffer2, BUFF_SIZE);
+        file1.read(buffer1.data(), kBufferSize);
+        file2.read(buffer2.data(), kBufferSize);
         auto count1 = file1.gcount();
         auto count2 = file2.gcount();
         if (count1 != count2)
         {
             return false;
         }
-        if (std::memcmp(buffer1, buffer2, count1))
+        if (std::memcmp(buffer1.data(), buffer2.data(), count1))
         {
             return false;
         }
@@ -347,11 +287,13 @@ zeus::expected<bool, std::error_code> FileEqual(std::ifstream& file1, std::ifstr
 
 zeus::expected<bool, std::error_code> FileEqual(const std::filesystem::path& path1, const std::filesystem::path& path2)
 {
-    static constexpr uint64_t kMappingSize = 2 * 1024 * 1024;
-    std::ifstream             file1;
-    std::ifstream             file2;
-    std::error_code           ec;
-    uint64_t                  size1 = fs::file_size(path1, ec);
+    return FileEqual(path1, path2, 1);
+}
+
+zeus::expected<bool, std::error_code> FileEqual(const std::filesystem::path& path1, const std::filesystem::path& path2, size_t parallelism)
+{
+    std::error_code ec;
+    uint64_t        size1 = fs::file_size(path1, ec);
     if (ec)
     {
         return zeus::unexpected(ec);
@@ -365,64 +307,57 @@ zeus::expected<bool, std::error_code> FileEqual(const std::filesystem::path& pat
     {
         return false;
     }
-    uint64_t size = size1;
+    const uint64_t size = size1;
     if (0 == size)
     {
         return true;
     }
-    if (size <= kMappingSize)
-    {
-        auto mapping1 = FileMapping::Create(path1, false);
-        if (!mapping1)
-        {
-            return zeus::unexpected(mapping1.error());
-        }
-        auto mapping2 = FileMapping::Create(path2, false);
-        if (!mapping2)
-        {
-            return zeus::unexpected(mapping2.error());
-        }
-        if (const auto ret = mapping1->MapAll(); !ret.has_value())
-        {
-            return zeus::unexpected(ret.error());
-        }
-        if (const auto ret = mapping2->MapAll(); !ret.has_value())
-        {
-            return zeus::unexpected(ret.error());
-        }
-        return 0 == std::memcmp(mapping1->Data(), mapping2->Data(), size);
-    }
-    else
+    const uint64_t windowCount = (size + kCompareWindowSize - 1) / kCompareWindowSize;
+    parallelism                = static_cast<size_t>(std::min<uint64_t>(std::max<size_t>(parallelism, 1), windowCount));
+
+    //每个线程使用自己的映射，按顺序领取窗口比较，发现不同或者出错后其他线程尽快停止
+    std::atomic<uint64_t> nextWindow = 0;
+    std::atomic<bool>     stop       = false;
+    std::atomic<bool>     different  = false;
+    std::mutex            errorMutex;
+    std::error_code       error;
+    auto worker = [&]()
     {
-        auto mapping1 = FileMapping::Create(path1, false);
-        if (!mapping1)
+        auto result = CompareWindows(path1, path2, size, nextWindow, stop);
+        if (result.has_value() && result.value())
         {
-            return zeus::unexpected(mapping1.error());
+            return;
         }
-        auto mapping2 = FileMapping::Create(path2, false);
-        if (!mapping2)
+        if (result.has_value())
         {
-            return zeus::unexpected(mapping2.error());
+            different = true;
         }
-        const uint64_t count = size / kMappingSize;
-
-        for (uint64_t index = 0; index <= count; ++index)
+        else
         {
-            if (const auto ret = mapping1->Map(index * kMappingSize, count == index ? (size % kMappingSize) : kMappingSize); !ret.has_value())
-            {
-                return zeus::unexpected(ret.error());
-            }
-            if (const auto ret = mapping2->Map(index * kMappingSize, count == index ? (size % kMappingSize) : kMappingSize); !ret.has_value())
+            std::lock_guard lock(errorMutex);
+            if (!error)
             {
-                return zeus::unexpected(ret.error());
-            }
-            if (0 != std::memcmp(mapping1->Data(), mapping2->Data(), mapping1->Size()))
-            {
-                return false;
+                error = result.error();
             }
         }
-        return true;
+        stop = true;
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(parallelism - 1);
+    for (size_t index = 1; index < parallelism; ++index)
+    {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    if (error)
+    {
+        return zeus::unexpected(error);
     }
+    return !different;
 }
 
 } // namespace zeus
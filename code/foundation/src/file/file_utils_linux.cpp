@@ -1,16 +1,192 @@
 ﻿#ifdef __linux__
 #include "zeus/foundation/file/file_utils.h"
 #include <filesystem>
+#include <cerrno>
 #include <cstring>
+#include <algorithm>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
 #include <sys/stat.h>
+#include <linux/fs.h>
 #include "zeus/foundation/string/charset_utils.h"
 #include "zeus/foundation/string/string_utils.h"
 #include "zeus/foundation/core/system_error.h"
+#include "zeus/foundation/file/file_wrapper.h"
+#include "zeus/foundation/resource/file_mapping.h"
 
 namespace fs = std::filesystem;
 
 namespace zeus
 {
+namespace
+{
+//每次系统调用复制的最大长度，也是进度回调的间隔
+constexpr uint64_t kCopyChunkSize = 64 * 1024 * 1024;
+
+//使用operation从copied继续复制到size，operation参数是偏移和长度，返回值和错误码同copy_file_range
+//这种方式第一次调用就不支持时返回false，由调用者换下一种方式
+template<typename Operation>
+zeus::expected<bool, std::error_code> CopyLoop(uint64_t& copied, uint64_t size, const FileCopyProgress& progress, Operation&& operation)
+{
+    bool first = true;
+    while (copied < size)
+    {
+        const ssize_t done = operation(copied, static_cast<size_t>(std::min(size - copied, kCopyChunkSize)));
+        if (done < 0)
+        {
+            const auto error = errno;
+            if (EINTR == error)
+            {
+                continue;
+            }
+            if (first && (ENOSYS == error || EXDEV == error || EINVAL == error || EOPNOTSUPP == error || ENOTSUP == error))
+            {
+                return false;
+            }
+            return zeus::unexpected(TranslateToSystemError(error));
+        }
+        if (!done)
+        {
+            //部分伪文件系统上copy_file_range直接返回0；否则是源文件被截断
+            if (first)
+            {
+                return false;
+            }
+            break;
+        }
+        first = false;
+        copied += static_cast<size_t>(done);
+        if (progress && !progress(copied, size))
+        {
+            return zeus::unexpected(std::make_error_code(std::errc::operation_canceled));
+        }
+    }
+    return true;
+}
+
+zeus::expected<void, std::error_code> CopyContent(FileWrapper& from, FileWrapper& to, uint64_t size, const FileCopyProgress& progress)
+{
+    //reflink只复制元数据，目标和源共享数据块，写入时再复制
+    if (size && !ioctl(to.Fd(), FICLONE, from.Fd()))
+    {
+        if (progress && !progress(size, size))
+        {
+            return zeus::unexpected(std::make_error_code(std::errc::operation_canceled));
+        }
+        return {};
+    }
+    uint64_t copied = 0;
+    auto     result = CopyLoop(
+        copied, size, progress,
+        [&from, &to](uint64_t offset, size_t length)
+        {
+            auto input  = static_cast<loff_t>(offset);
+            auto output = static_cast<loff_t>(offset);
+            return copy_file_range(from.Fd(), &input, to.Fd(), &output, length, 0);
+        }
+    );
+    if (!result.has_value())
+    {
+        return zeus::unexpected(result.error());
+    }
+    if (result.value())
+    {
+        return {};
+    }
+    //sendfile写入目标的当前偏移
+    if (auto ret = to.Seek(static_cast<int64_t>(copied), FileWrapper::OffsetType::kBegin); !ret.has_value())
+    {
+        return zeus::unexpected(ret.error());
+    }
+    result = CopyLoop(
+        copied, size, progress,
+        [&from, &to](uint64_t offset, size_t length)
+        {
+            auto input = static_cast<off_t>(offset);
+            return sendfile(to.Fd(), from.Fd(), &input, length);
+        }
+    );
+    if (!result.has_value())
+    {
+        return zeus::unexpected(result.error());
+    }
+    if (result.value())
+    {
+        return {};
+    }
+    //最后映射源文件，按窗口写入
+    auto mapping = FileMapping::Create(from.Fd(), false);
+    if (!mapping.has_value())
+    {
+        return zeus::unexpected(mapping.error());
+    }
+    //映射超出文件结尾的部分访问时会触发SIGBUS，按当前长度复制
+    size = std::min(size, mapping->FileSize());
+    while (copied < size)
+    {
+        const uint64_t length = std::min(size - copied, kCopyChunkSize);
+        if (auto ret = mapping->Map(copied, length); !ret.has_value())
+        {
+            return zeus::unexpected(ret.error());
+        }
+        if (auto ret = to.WriteAt(mapping->Data(), static_cast<size_t>(length), copied); !ret.has_value())
+        {
+            return zeus::unexpected(ret.error());
+        }
+        copied += length;
+        if (progress && !progress(copied, size))
+        {
+            return zeus::unexpected(std::make_error_code(std::errc::operation_canceled));
+        }
+    }
+    return {};
+}
+} // namespace
+
+zeus::expected<void, std::error_code> FileCopy(
+    const std::filesystem::path& from, const std::filesystem::path& to, bool overwrite, const FileCopyProgress& progress
+)
+{
+    auto source = FileWrapper::Open(from, FileWrapper::OpenMode::kRead);
+    if (!source.has_value())
+    {
+        return zeus::unexpected(source.error());
+    }
+    struct stat statbuf
+    {
+    };
+    if (-1 == fstat(source->Fd(), &statbuf))
+    {
+        return zeus::unexpected(GetLastSystemError());
+    }
+    if (!S_ISREG(statbuf.st_mode))
+    {
+        return zeus::unexpected(std::make_error_code(std::errc::invalid_argument));
+    }
+    //覆盖自身会先截断源文件
+    if (std::error_code ec; overwrite && fs::equivalent(from, to, ec))
+    {
+        return zeus::unexpected(std::make_error_code(std::errc::file_exists));
+    }
+    auto target = overwrite ? FileWrapper::Truncate(to, FileWrapper::OpenMode::kWrite) : FileWrapper::Create(to, FileWrapper::OpenMode::kWrite);
+    if (!target.has_value())
+    {
+        return zeus::unexpected(target.error());
+    }
+    auto result = CopyContent(*source, *target, static_cast<uint64_t>(statbuf.st_size), progress);
+    if (result.has_value() && -1 == fchmod(target->Fd(), statbuf.st_mode & 07777))
+    {
+        result = zeus::unexpected(GetLastSystemError());
+    }
+    if (!result.has_value())
+    {
+        target->Close();
+        unlink(to.c_str());
+    }
+    return result;
+}
+
 zeus::expected<void, std::error_code> CreateWriteableDirectory(const std::filesystem::path& path)
 {
     std::error_code ec;
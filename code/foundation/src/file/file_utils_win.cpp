@@ -80,5 +80,47 @@ zeus::expected<void, std::error_code> CreateWriteableDirectory(const std::filesy
     }
 }
 
+namespace
+{
+struct CopyContext
+{
+    const FileCopyProgress* progress;
+    bool                    canceled;
+};
+
+DWORD CALLBACK CopyProgressRoutine(
+    LARGE_INTEGER totalFileSize, LARGE_INTEGER totalBytesTransferred, LARGE_INTEGER /*streamSize*/, LARGE_INTEGER /*streamBytesTransferred*/,
+    DWORD /*streamNumber*/, DWORD /*callbackReason*/, HANDLE /*sourceFile*/, HANDLE /*destinationFile*/, LPVOID data
+)
+{
+    auto* context = static_cast<CopyContext*>(data);
+    if (!(*context->progress)(static_cast<uint64_t>(totalBytesTransferred.QuadPart), static_cast<uint64_t>(totalFileSize.QuadPart)))
+    {
+        context->canceled = true;
+        return PROGRESS_CANCEL;
+    }
+    return PROGRESS_CONTINUE;
+}
+} // namespace
+
+zeus::expected<void, std::error_code> FileCopy(
+    const std::filesystem::path& from, const std::filesystem::path& to, bool overwrite, const FileCopyProgress& progress
+)
+{
+    //CopyFileEx在系统内部复制，支持的卷上使用块克隆，取消或者失败时会删除目标文件
+    CopyContext context {&progress, false};
+    if (!CopyFileExW(
+            from.c_str(), to.c_str(), progress ? CopyProgressRoutine : nullptr, &context, nullptr, overwrite ? 0 : COPY_FILE_FAIL_IF_EXISTS
+        ))
+    {
+        if (context.canceled)
+        {
+            return zeus::unexpected(std::make_error_code(std::errc::operation_canceled));
+        }
+        return zeus::unexpected(GetLastSystemError());
+    }
+    return {};
+}
+
 } // namespace zeus
 #endif
@@ -1,10 +1,15 @@
 ﻿#include "zeus/foundation/file/file_wrapper.h"
 #ifdef __linux__
 #include <cassert>
+#include <cerrno>
+#include <climits>
+#include <algorithm>
 #include <unistd.h>
 #include <fcntl.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include "zeus/foundation/core/system_error.h"
+#include "zeus/foundation/container/small_vector.hpp"
 #include "zeus/foundation/time/time_utils.h"
 
 namespace zeus
@@ -44,18 +49,132 @@ int ModeToFlag(FileWrapper::OpenMode mode)
     }
 }
 
-zeus::expected<FileWrapper, std::error_code> OpenWrapper(const std::filesystem::path& path, FileWrapper::OpenMode mode, int flag, bool autoFlush)
+int AdviceToFlag(FileWrapper::Advice advice)
+{
+    switch (advice)
+    {
+    case FileWrapper::Advice::kNormal:
+        return POSIX_FADV_NORMAL;
+    case FileWrapper::Advice::kSequential:
+        return POSIX_FADV_SEQUENTIAL;
+    case FileWrapper::Advice::kRandom:
+        return POSIX_FADV_RANDOM;
+    case FileWrapper::Advice::kWillNeed:
+        return POSIX_FADV_WILLNEED;
+    case FileWrapper::Advice::kDontNeed:
+        return POSIX_FADV_DONTNEED;
+    default:
+        assert(false);
+        return POSIX_FADV_NORMAL;
+    }
+}
+
+bool HasFlag(FileWrapper::OpenFlag flags, FileWrapper::OpenFlag flag)
+{
+    return FileWrapper::OpenFlag::kNone != (flags & flag);
+}
+
+zeus::expected<FileWrapper, std::error_code> OpenWrapper(
+    const std::filesystem::path& path, FileWrapper::OpenMode mode, int flag, bool autoFlush,
+    FileWrapper::OpenFlag openFlags = FileWrapper::OpenFlag::kNone
+)
 {
     if (autoFlush)
     {
         flag |= O_SYNC;
     }
+    if (HasFlag(openFlags, FileWrapper::OpenFlag::kDirect))
+    {
+        flag |= O_DIRECT;
+    }
     int fd = open(path.c_str(), ModeToFlag(mode) | flag, S_IRWXU | S_IRWXG | S_IRWXO);
     if (-1 == fd)
     {
         return zeus::unexpected(GetLastSystemError());
     }
-    return FileWrapper(fd);
+    FileWrapper file(fd);
+    //预读提示失败不影响使用
+    if (HasFlag(openFlags, FileWrapper::OpenFlag::kSequential))
+    {
+        file.Advise(FileWrapper::Advice::kSequential);
+    }
+    else if (HasFlag(openFlags, FileWrapper::OpenFlag::kRandom))
+    {
+        file.Advise(FileWrapper::Advice::kRandom);
+    }
+    return file;
+}
+
+//重复调用直到完成size字节，operation参数是已经完成的字节数，返回0表示到达文件结尾
+template<typename Operation>
+zeus::expected<size_t, std::error_code> TransferFull(size_t size, Operation&& operation)
+{
+    size_t total = 0;
+    while (total < size)
+    {
+        const ssize_t done = operation(total);
+        if (done < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            return zeus::unexpected(GetLastSystemError());
+        }
+        if (!done)
+        {
+            break;
+        }
+        total += static_cast<size_t>(done);
+    }
+    return total;
+}
+
+//每次最多提交IOV_MAX个缓冲区，部分完成时跳过已经完成的部分继续，operation参数是iovec数组、数量和已经完成的字节数
+template<typename Buffer, typename Operation>
+zeus::expected<size_t, std::error_code> TransferVector(const Buffer* buffers, size_t count, Operation&& operation)
+{
+    SmallVector<iovec, 16> vectors;
+    vectors.reserve(count);
+    for (size_t index = 0; index < count; ++index)
+    {
+        if (buffers[index].size)
+        {
+            vectors.push_back(iovec {const_cast<void*>(static_cast<const void*>(buffers[index].data)), buffers[index].size});
+        }
+    }
+    size_t total = 0;
+    size_t first = 0;
+    while (first < vectors.size())
+    {
+        const auto    batch = static_cast<int>(std::min<size_t>(vectors.size() - first, IOV_MAX));
+        const ssize_t done  = operation(vectors.data() + first, batch, total);
+        if (done < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+            return zeus::unexpected(GetLastSystemError());
+        }
+        if (!done)
+        {
+            break;
+        }
+        total += static_cast<size_t>(done);
+        auto remain = static_cast<size_t>(done);
+        while (first < vectors.size() && remain >= vectors[first].iov_len)
+        {
+            remain -= vectors[first].iov_len;
+            ++first;
+        }
+        if (remain)
+        {
+            vectors[first].iov_base = static_cast<uint8_t*>(vectors[first].iov_base) + remain;
+            vectors[first].iov_len -= remain;
+        }
+    }
+    return total;
 }
 
 } // namespace
@@ -218,6 +337,57 @@ zeus::expected<size_t, std::error_code> FileWrapper::Read(void* buffer, size_t s
     }
     return readSize;
 }
+zeus::expected<size_t, std::error_code> FileWrapper::ReadAt(void* buffer, size_t size, uint64_t offset)
+{
+    assert(!Empty());
+    const int fd = _impl->fileDescriptor.FileDescriptor();
+    return TransferFull(
+        size, [fd, buffer, size, offset](size_t done)
+        { return pread(fd, static_cast<uint8_t*>(buffer) + done, size - done, static_cast<off_t>(offset + done)); }
+    );
+}
+
+zeus::expected<size_t, std::error_code> FileWrapper::WriteAt(const void* data, size_t size, uint64_t offset)
+{
+    assert(!Empty());
+    const int fd = _impl->fileDescriptor.FileDescriptor();
+    return TransferFull(
+        size, [fd, data, size, offset](size_t done)
+        { return pwrite(fd, static_cast<const uint8_t*>(data) + done, size - done, static_cast<off_t>(offset + done)); }
+    );
+}
+
+zeus::expected<size_t, std::error_code> FileWrapper::ReadV(const ReadBuffer* buffers, size_t count)
+{
+    assert(!Empty());
+    const int fd = _impl->fileDescriptor.FileDescriptor();
+    return TransferVector(buffers, count, [fd](const iovec* vectors, int size, size_t) { return readv(fd, vectors, size); });
+}
+
+zeus::expected<size_t, std::error_code> FileWrapper::ReadV(const ReadBuffer* buffers, size_t count, uint64_t offset)
+{
+    assert(!Empty());
+    const int fd = _impl->fileDescriptor.FileDescriptor();
+    return TransferVector(
+        buffers, count, [fd, offset](const iovec* vectors, int size, size_t done) { return preadv(fd, vectors, size, static_cast<off_t>(offset + done)); }
+    );
+}
+
+zeus::expected<size_t, std::error_code> FileWrapper::WriteV(const WriteBuffer* buffers, size_t count)
+{
+    assert(!Empty());
+    const int fd = _impl->fileDescriptor.FileDescriptor();
+    return TransferVector(buffers, count, [fd](const iovec* vectors, int size, size_t) { return writev(fd, vectors, size); });
+}
+
+zeus::expected<size_t, std::error_code> FileWrapper::WriteV(const WriteBuffer* buffers, size_t count, uint64_t offset)
+{
+    assert(!Empty());
+    const int fd = _impl->fileDescriptor.FileDescriptor();
+    return TransferVector(
+        buffers, count, [fd, offset](const iovec* vectors, int size, size_t done) { return pwritev(fd, vectors, size, static_cast<off_t>(offset + done)); }
+    );
+}
 zeus::expected<uint64_t, std::error_code> FileWrapper::Seek(int64_t offset, OffsetType type)
 {
     assert(!Empty());
@@ -247,6 +417,84 @@ zeus::expected<void, std::error_code> FileWrapper::Flush()
     }
     return {};
 }
+zeus::expected<void, std::error_code> FileWrapper::FlushData()
+{
+    assert(!Empty());
+    if (-1 == fdatasync(_impl->fileDescriptor.FileDescriptor()))
+    {
+        return zeus::unexpected(GetLastSystemError());
+    }
+    return {};
+}
+
+zeus::expected<void, std::error_code> FileWrapper::Resize(uint64_t size)
+{
+    assert(!Empty());
+    if (-1 == ftruncate(_impl->fileDescriptor.FileDescriptor(), static_cast<off_t>(size)))
+    {
+        return zeus::unexpected(GetLastSystemError());
+    }
+    return {};
+}
+
+zeus::expected<void, std::error_code> FileWrapper::Preallocate(uint64_t offset, uint64_t length, bool keepSize)
+{
+    assert(!Empty());
+    const int fd = _impl->fileDescriptor.FileDescriptor();
+    if (!fallocate(fd, keepSize ? FALLOC_FL_KEEP_SIZE : 0, static_cast<off_t>(offset), static_cast<off_t>(length)))
+    {
+        return {};
+    }
+    //文件系统不支持fallocate时posix_fallocate会写入零来分配空间，只在允许改变文件长度时使用
+    if (EOPNOTSUPP == errno && !keepSize)
+    {
+        if (const int error = posix_fallocate(fd, static_cast<off_t>(offset), static_cast<off_t>(length)); error)
+        {
+            return zeus::unexpected(make_error_code(SystemError {error}));
+        }
+        return {};
+    }
+    return zeus::unexpected(GetLastSystemError());
+}
+
+zeus::expected<void, std::error_code> FileWrapper::Advise(Advice advice, uint64_t offset, uint64_t length)
+{
+    assert(!Empty());
+    //posix_fadvise直接返回错误码，不设置errno
+    if (const int error = posix_fadvise(
+            _impl->fileDescriptor.FileDescriptor(), static_cast<off_t>(offset), static_cast<off_t>(length), AdviceToFlag(advice)
+        );
+        error)
+    {
+        return zeus::unexpected(make_error_code(SystemError {error}));
+    }
+    return {};
+}
+
+zeus::expected<size_t, std::error_code> FileWrapper::DirectIoAlignment() const
+{
+    assert(!Empty());
+    const int fd = _impl->fileDescriptor.FileDescriptor();
+#ifdef STATX_DIOALIGN
+    //6.1以后的内核可以直接查询直接读写的对齐要求
+    struct statx statxBuf
+    {
+    };
+    if (!statx(fd, "", AT_EMPTY_PATH, STATX_DIOALIGN, &statxBuf) && (statxBuf.stx_mask & STATX_DIOALIGN) && statxBuf.stx_dio_offset_align)
+    {
+        return std::max<size_t>(statxBuf.stx_dio_offset_align, statxBuf.stx_dio_mem_align);
+    }
+#endif
+    //更早的内核使用文件系统的块大小，它是设备逻辑块大小的整数倍
+    struct stat statbuf
+    {
+    };
+    if (-1 == fstat(fd, &statbuf))
+    {
+        return zeus::unexpected(GetLastSystemError());
+    }
+    return static_cast<size_t>(statbuf.st_blksize);
+}
 
 zeus::expected<std::chrono::system_clock::time_point, std::error_code> FileWrapper::CreateTime()
 {
@@ -320,6 +568,28 @@ zeus::expected<FileWrapper, std::error_code> FileWrapper::Truncate(const std::fi
     return OpenWrapper(path, mode, O_CREAT | O_TRUNC | O_CLOEXEC, autoFlush);
 }
 
+zeus::expected<FileWrapper, std::error_code> FileWrapper::Open(const std::filesystem::path& path, OpenMode mode, OpenFlag flags)
+{
+    return OpenWrapper(path, mode, O_CLOEXEC, false, flags);
+}
+
+zeus::expected<FileWrapper, std::error_code> FileWrapper::Create(const std::filesystem::path& path, OpenMode mode, OpenFlag flags, bool autoFlush)
+{
+    return OpenWrapper(path, mode, O_CREAT | O_EXCL | O_CLOEXEC, autoFlush, flags);
+}
+
+zeus::expected<FileWrapper, std::error_code> FileWrapper::OpenOrCreate(
+    const std::filesystem::path& path, OpenMode mode, OpenFlag flags, bool autoFlush
+)
+{
+    return OpenWrapper(path, mode, O_CREAT | O_CLOEXEC, autoFlush, flags);
+}
+
+zeus::expected<FileWrapper, std::error_code> FileWrapper::Truncate(const std::filesystem::path& path, OpenMode mode, OpenFlag flags, bool autoFlush)
+{
+    return OpenWrapper(path, mode, O_CREAT | O_TRUNC | O_CLOEXEC, autoFlush, flags);
+}
+
 zeus::expected<FileWrapper, std::error_code> FileWrapper::OpenSymbolLink(const std::filesystem::path& path, OpenMode mode, bool autoFlush)
 {
     return OpenWrapper(path, mode, O_NOFOLLOW | O_PATH | O_CLOEXEC, autoFlush);
@@ -1,6 +1,7 @@
 ﻿#include "zeus/foundation/file/file_wrapper.h"
 #ifdef _WIN32
 #include <cassert>
+#include <algorithm>
 #include <Windows.h>
 #include "zeus/foundation/core/system_error.h"
 #include "zeus/foundation/time/time_utils.h"
@@ -66,6 +67,98 @@ zeus::expected<FileWrapper, std::error_code> CreateFileWrapper(
     }
     return FileWrapper(handle);
 }
+
+DWORD FlagToAttribute(FileWrapper::OpenFlag flags)
+{
+    DWORD attribute = 0;
+    if (FileWrapper::OpenFlag::kNone != (flags & FileWrapper::OpenFlag::kDirect))
+    {
+        attribute |= FILE_FLAG_NO_BUFFERING;
+    }
+    if (FileWrapper::OpenFlag::kNone != (flags & FileWrapper::OpenFlag::kSequential))
+    {
+        attribute |= FILE_FLAG_SEQUENTIAL_SCAN;
+    }
+    else if (FileWrapper::OpenFlag::kNone != (flags & FileWrapper::OpenFlag::kRandom))
+    {
+        attribute |= FILE_FLAG_RANDOM_ACCESS;
+    }
+    return attribute;
+}
+
+//ReadFile/WriteFile单次的长度是DWORD，大块分多次处理
+constexpr size_t kMaxTransferSize = 0x40000000;
+
+//重复调用直到完成size字节，operation参数是已经完成的字节数、本次长度和实际完成的长度
+template<typename Operation>
+zeus::expected<size_t, std::error_code> TransferFull(size_t size, Operation&& operation)
+{
+    size_t total = 0;
+    while (total < size)
+    {
+        DWORD done = 0;
+        if (!operation(total, static_cast<DWORD>(std::min(size - total, kMaxTransferSize)), done))
+        {
+            //带偏移读取超过文件结尾时返回ERROR_HANDLE_EOF
+            if (ERROR_HANDLE_EOF == GetLastError())
+            {
+                break;
+            }
+            return zeus::unexpected(GetLastSystemError());
+        }
+        if (!done)
+        {
+            break;
+        }
+        total += done;
+    }
+    return total;
+}
+
+OVERLAPPED OffsetOverlapped(uint64_t offset)
+{
+    OVERLAPPED overlapped = {};
+    overlapped.Offset     = static_cast<DWORD>(offset);
+    overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+    return overlapped;
+}
+
+//ReadFileScatter/WriteFileGather要求无缓冲并且按页对齐的IO，这里逐个缓冲区完整读写，某个缓冲区没有读满时停止
+template<typename Buffer, typename Transfer>
+zeus::expected<size_t, std::error_code> TransferBuffers(const Buffer* buffers, size_t count, Transfer&& transfer)
+{
+    size_t total = 0;
+    for (size_t index = 0; index < count; ++index)
+    {
+        auto result = transfer(buffers[index], total);
+        if (!result.has_value())
+        {
+            return result;
+        }
+        total += result.value();
+        if (result.value() < buffers[index].size)
+        {
+            break;
+        }
+    }
+    return total;
+}
+
+zeus::expected<size_t, std::error_code> ReadFull(HANDLE handle, void* buffer, size_t size)
+{
+    return TransferFull(
+        size, [handle, buffer](size_t done, DWORD length, DWORD& transferred)
+        { return ReadFile(handle, static_cast<uint8_t*>(buffer) + done, length, &transferred, nullptr); }
+    );
+}
+
+zeus::expected<size_t, std::error_code> WriteFull(HANDLE handle, const void* data, size_t size)
+{
+    return TransferFull(
+        size, [handle, data](size_t done, DWORD length, DWORD& transferred)
+        { return WriteFile(handle, static_cast<const uint8_t*>(data) + done, length, &transferred, nullptr); }
+    );
+}
 } // namespace
 
 struct FileWrapperImpl
@@ -219,6 +312,61 @@ zeus::expected<size_t, std::error_code> FileWrapper::Read(void* buffer, size_t s
     }
     return read;
 }
+zeus::expected<size_t, std::error_code> FileWrapper::ReadAt(void* buffer, size_t size, uint64_t offset)
+{
+    assert(!Empty());
+    HANDLE handle = _impl->handle;
+    return TransferFull(
+        size,
+        [handle, buffer, offset](size_t done, DWORD length, DWORD& transferred)
+        {
+            OVERLAPPED overlapped = OffsetOverlapped(offset + done);
+            return ReadFile(handle, static_cast<uint8_t*>(buffer) + done, length, &transferred, &overlapped);
+        }
+    );
+}
+
+zeus::expected<size_t, std::error_code> FileWrapper::WriteAt(const void* data, size_t size, uint64_t offset)
+{
+    assert(!Empty());
+    HANDLE handle = _impl->handle;
+    return TransferFull(
+        size,
+        [handle, data, offset](size_t done, DWORD length, DWORD& transferred)
+        {
+            OVERLAPPED overlapped = OffsetOverlapped(offset + done);
+            return WriteFile(handle, static_cast<const uint8_t*>(data) + done, length, &transferred, &overlapped);
+        }
+    );
+}
+
+zeus::expected<size_t, std::error_code> FileWrapper::ReadV(const ReadBuffer* buffers, size_t count)
+{
+    assert(!Empty());
+    HANDLE handle = _impl->handle;
+    return TransferBuffers(buffers, count, [handle](const ReadBuffer& buffer, size_t) { return ReadFull(handle, buffer.data, buffer.size); });
+}
+
+zeus::expected<size_t, std::error_code> FileWrapper::ReadV(const ReadBuffer* buffers, size_t count, uint64_t offset)
+{
+    assert(!Empty());
+    return TransferBuffers(buffers, count, [this, offset](const ReadBuffer& buffer, size_t done) { return ReadAt(buffer.data, buffer.size, offset + done); });
+}
+
+zeus::expected<size_t, std::error_code> FileWrapper::WriteV(const WriteBuffer* buffers, size_t count)
+{
+    assert(!Empty());
+    HANDLE handle = _impl->handle;
+    return TransferBuffers(buffers, count, [handle](const WriteBuffer& buffer, size_t) { return WriteFull(handle, buffer.data, buffer.size); });
+}
+
+zeus::expected<size_t, std::error_code> FileWrapper::WriteV(const WriteBuffer* buffers, size_t count, uint64_t offset)
+{
+    assert(!Empty());
+    return TransferBuffers(
+        buffers, count, [this, offset](const WriteBuffer& buffer, size_t done) { return WriteAt(buffer.data, buffer.size, offset + done); }
+    );
+}
 zeus::expected<uint64_t, std::error_code> FileWrapper::Seek(int64_t offset, OffsetType type)
 {
     assert(!Empty());
@@ -250,6 +398,64 @@ zeus::expected<void, std::error_code> FileWrapper::Flush()
     return {};
 }
 
+zeus::expected<void, std::error_code> FileWrapper::FlushData()
+{
+    return Flush();
+}
+
+zeus::expected<void, std::error_code> FileWrapper::Resize(uint64_t size)
+{
+    assert(!Empty());
+    FILE_END_OF_FILE_INFO info {};
+    info.EndOfFile.QuadPart = static_cast<LONGLONG>(size);
+    if (!SetFileInformationByHandle(_impl->handle, FileEndOfFileInfo, &info, sizeof(info)))
+    {
+        return zeus::unexpected(GetLastSystemError());
+    }
+    return {};
+}
+
+zeus::expected<void, std::error_code> FileWrapper::Preallocate(uint64_t offset, uint64_t length, bool keepSize)
+{
+    assert(!Empty());
+    auto size = FileSize();
+    if (!size.has_value())
+    {
+        return zeus::unexpected(size.error());
+    }
+    const uint64_t end = offset + length;
+    //分配大小小于文件长度时会截断文件，只做扩大
+    if (end <= size.value())
+    {
+        return {};
+    }
+    FILE_ALLOCATION_INFO info {};
+    info.AllocationSize.QuadPart = static_cast<LONGLONG>(end);
+    if (!SetFileInformationByHandle(_impl->handle, FileAllocationInfo, &info, sizeof(info)))
+    {
+        return zeus::unexpected(GetLastSystemError());
+    }
+    return keepSize ? zeus::expected<void, std::error_code> {} : Resize(end);
+}
+
+zeus::expected<void, std::error_code> FileWrapper::Advise(Advice /*advice*/, uint64_t /*offset*/, uint64_t /*length*/)
+{
+    assert(!Empty());
+    return {};
+}
+
+zeus::expected<size_t, std::error_code> FileWrapper::DirectIoAlignment() const
+{
+    assert(!Empty());
+    FILE_STORAGE_INFO info {};
+    if (!GetFileInformationByHandleEx(_impl->handle, FileStorageInfo, &info, sizeof(info)))
+    {
+        return zeus::unexpected(GetLastSystemError());
+    }
+    //FILE_FLAG_NO_BUFFERING要求按扇区对齐，物理扇区大于逻辑扇区时按物理扇区对齐避免读改写
+    return std::max<size_t>(info.LogicalBytesPerSector, info.PhysicalBytesPerSectorForPerformance);
+}
+
 zeus::expected<std::chrono::system_clock::time_point, std::error_code> FileWrapper::CreateTime()
 {
     assert(!Empty());
@@ -314,6 +520,28 @@ zeus::expected<FileWrapper, std::error_code> FileWrapper::Truncate(const std::fi
     return CreateFileWrapper(path, mode, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, autoFlush);
 }
 
+zeus::expected<FileWrapper, std::error_code> FileWrapper::Open(const std::filesystem::path& path, OpenMode mode, OpenFlag flags)
+{
+    return CreateFileWrapper(path, mode, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FlagToAttribute(flags), false);
+}
+
+zeus::expected<FileWrapper, std::error_code> FileWrapper::Create(const std::filesystem::path& path, OpenMode mode, OpenFlag flags, bool autoFlush)
+{
+    return CreateFileWrapper(path, mode, CREATE_NEW, FILE_ATTRIBUTE_NORMAL | FlagToAttribute(flags), autoFlush);
+}
+
+zeus::expected<FileWrapper, std::error_code> FileWrapper::OpenOrCreate(
+    const std::filesystem::path& path, OpenMode mode, OpenFlag flags, bool autoFlush
+)
+{
+    return CreateFileWrapper(path, mode, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL | FlagToAttribute(flags), autoFlush);
+}
+
+zeus::expected<FileWrapper, std::error_code> FileWrapper::Truncate(const std::filesystem::path& path, OpenMode mode, OpenFlag flags, bool autoFlush)
+{
+    return CreateFileWrapper(path, mode, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL | FlagToAttribute(flags), autoFlush);
+}
+
 zeus::expected<FileWrapper, std::error_code> FileWrapper::OpenSymbolLink(const std::filesystem::path& path, OpenMode mode, bool autoFlush)
 {
     return CreateFileWrapper(path, mode, OPEN_EXISTING, FILE_FLAG_OPEN_REPARSE_POINT, autoFlush);
@@ -0,0 +1,53 @@
+﻿#pragma once
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "zeus/foundation/file/directory_walker.h"
+
+namespace zeus
+{
+//目录的唯一标识，跟随符号链接时用来发现指回祖先目录的循环
+struct DirectoryIdentity
+{
+    uint64_t device;
+    uint64_t index;
+};
+
+struct DirectoryAncestor
+{
+    DirectoryIdentity                        identity;
+    std::shared_ptr<const DirectoryAncestor> parent;
+};
+
+struct DirectoryTask
+{
+    std::filesystem::path                    path;
+    //目录本身的深度，根目录为0
+    size_t                                   depth = 0;
+    //只有跟随符号链接时才记录
+    std::shared_ptr<const DirectoryAncestor> ancestors;
+};
+
+//identity已经出现在ancestors中时返回true
+inline bool IsDirectoryCycle(const DirectoryIdentity& identity, const DirectoryAncestor* ancestors) noexcept
+{
+    for (; ancestors; ancestors = ancestors->parent.get())
+    {
+        if (ancestors->identity.device == identity.device && ancestors->identity.index == identity.index)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//列出一个目录，文件交给callback，需要进入的子目录追加到children，callback返回false时返回false
+//stop被其他线程设置时尽快返回
+zeus::expected<bool, std::error_code> ListDirectory(
+    const DirectoryTask& task, const DirectoryWalker::Options& options, const DirectoryWalker::Callback& callback, const std::atomic<bool>& stop,
+    std::vector<DirectoryTask>& children
+);
+
+//子目录的这些错误不终止遍历：没有权限、遍历过程中被删除或者替换
+bool IsSkippableDirectoryError(const std::error_code& error) noexcept;
+} // namespace zeus
@@ -0,0 +1,82 @@
+﻿#pragma once
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "zeus/foundation/file/io_ring.h"
+
+namespace zeus
+{
+//单个请求的最大长度，和read/write的限制一致，两种后端都按这个长度截断
+constexpr size_t kMaxIoTransferSize = 0x7ffff000;
+
+struct IoOperation
+{
+    enum class Type
+    {
+        kRead,
+        kWrite,
+        kReadFixed,
+        kWriteFixed,
+        kFsync,
+        kFdatasync,
+    };
+    Type             type;
+    FileWrapper*     file;
+    //Fixed时是注册的缓冲区内的地址
+    void*            buffer;
+    size_t           size;
+    uint64_t         offset;
+    size_t           bufferIndex;
+    bool             linkNext;
+    IoRing::Callback callback;
+};
+using IoOperationList = std::vector<std::unique_ptr<IoOperation>>;
+
+class IoRingBackend
+{
+public:
+    virtual ~IoRingBackend() = default;
+    //链接在一起的请求在列表中相邻，列表最后一个请求的linkNext为false
+    virtual void                                  Submit(IoOperationList&& operations)                                  = 0;
+    virtual zeus::expected<void, std::error_code> RegisterFiles(const std::vector<FileWrapper*>& files)                 = 0;
+    virtual zeus::expected<void, std::error_code> RegisterBuffers(const std::vector<FileWrapper::ReadBuffer>& buffers) = 0;
+    virtual IoRing::Backend                       Type() const noexcept                                                 = 0;
+};
+
+struct IoRingImpl
+{
+    std::mutex                                           mutex;
+    //只包含完整的链接，Submit整体取走，不会把链接拆到两次提交中
+    IoOperationList                                      pending;
+    //各个线程还没有结束的链接
+    std::unordered_map<std::thread::id, IoOperationList> openChains;
+    std::vector<FileWrapper::ReadBuffer>                 buffers;
+    IoRing::Executor                                     executor;
+    std::mutex                                           inflightMutex;
+    std::condition_variable                              inflightCondition;
+    size_t                                               inflight = 0;
+    std::unique_ptr<IoRingBackend>                       backend;
+
+    //后端在请求完成时调用，执行或者投递回调，然后减少进行中的计数
+    void Complete(std::unique_ptr<IoOperation> operation, const IoRing::Result& result);
+    //放入当前线程的链接，链接结束时整体移到pending，调用时需要持有mutex
+    void PushLocked(std::unique_ptr<IoOperation> operation);
+    //在同一次加锁中检查注册的缓冲区并放入队列
+    void PushFixed(
+        IoOperation::Type type, FileWrapper& file, size_t bufferIndex, size_t bufferOffset, size_t size, uint64_t offset, IoRing::Callback&& callback,
+        bool linkNext
+    );
+    //一次加锁放入一个完整的链接，不接在任何线程未结束的链接后面
+    void PushChain(IoOperationList&& chain);
+    //当前线程未结束的链接在最后一个请求处结束并移到pending，调用时需要持有mutex
+    void CloseChainLocked();
+};
+
+#ifdef __linux__
+//内核不支持io_uring或者被禁用时返回空
+std::unique_ptr<IoRingBackend> CreateIoUringBackend(IoRingImpl& ring, uint32_t queueDepth);
+#endif
+} // namespace zeus
@@ -0,0 +1,467 @@
+﻿#include "zeus/foundation/file/io_ring.h"
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <thread>
+#ifdef __linux__
+#include <unistd.h>
+#endif
+#include "zeus/foundation/thread/thread_pool.h"
+#include "zeus/foundation/thread/advanced_thread.h"
+#include "zeus/foundation/core/system_error.h"
+#include "impl/io_ring_impl.h"
+
+namespace zeus
+{
+namespace
+{
+IoRing::Result Canceled()
+{
+    return zeus::unexpected(std::make_error_code(std::errc::operation_canceled));
+}
+
+bool IsFixed(const IoOperation& operation) noexcept
+{
+    return IoOperation::Type::kReadFixed == operation.type || IoOperation::Type::kWriteFixed == operation.type;
+}
+
+size_t TransferSize(const IoOperation& operation) noexcept
+{
+    return std::min(operation.size, kMaxIoTransferSize);
+}
+
+//和io_uring一样，读写的长度少于请求的长度时链接中断，后续请求取消
+bool BreaksLink(const IoOperation& operation, const IoRing::Result& result) noexcept
+{
+    return !result.has_value() || (operation.buffer && result.value() < TransferSize(operation));
+}
+
+IoRing::Result Execute(IoOperation& operation)
+{
+    switch (operation.type)
+    {
+    case IoOperation::Type::kRead:
+    case IoOperation::Type::kReadFixed:
+        return operation.file->ReadAt(operation.buffer, TransferSize(operation), operation.offset);
+    case IoOperation::Type::kWrite:
+    case IoOperation::Type::kWriteFixed:
+        return operation.file->WriteAt(operation.buffer, TransferSize(operation), operation.offset);
+    case IoOperation::Type::kFsync:
+    case IoOperation::Type::kFdatasync:
+    {
+#ifdef __linux__
+        if (IoOperation::Type::kFdatasync == operation.type)
+        {
+            if (-1 == fdatasync(operation.file->Fd()))
+            {
+                return zeus::unexpected(GetLastSystemError());
+            }
+            return 0;
+        }
+#endif
+        auto result = operation.file->Flush();
+        if (!result.has_value())
+        {
+            return zeus::unexpected(result.error());
+        }
+        return 0;
+    }
+    default:
+        assert(false);
+        return zeus::unexpected(std::make_error_code(std::errc::invalid_argument));
+    }
+}
+
+template<typename... Operations>
+IoOperationList MakeChain(Operations&&... operations)
+{
+    IoOperationList chain;
+    chain.reserve(sizeof...(operations));
+    (chain.emplace_back(std::forward<Operations>(operations)), ...);
+    return chain;
+}
+
+//在线程池中执行阻塞的定位读写，链接在一起的请求在同一个任务中顺序执行
+class ThreadPoolBackend : public IoRingBackend
+{
+public:
+    ThreadPoolBackend(IoRingImpl& ring, size_t threads) : _ring(ring), _pool(threads) { _pool.SetName("IoRing"); }
+
+    void Submit(IoOperationList&& operations) override
+    {
+        size_t first = 0;
+        while (first < operations.size())
+        {
+            auto chain = std::make_shared<IoOperationList>();
+            do
+            {
+                chain->emplace_back(std::move(operations[first]));
+            }
+            while (chain->back()->linkNext && ++first < operations.size());
+            ++first;
+            _pool.CommitTask([this, chain]() { Run(*chain); });
+        }
+    }
+    zeus::expected<void, std::error_code> RegisterFiles(const std::vector<FileWrapper*>& /*files*/) override { return {}; }
+    zeus::expected<void, std::error_code> RegisterBuffers(const std::vector<FileWrapper::ReadBuffer>& /*buffers*/) override { return {}; }
+    IoRing::Backend                       Type() const noexcept override { return IoRing::Backend::kThreadPool; }
+private:
+    void Run(IoOperationList& chain)
+    {
+        bool failed = false;
+        for (auto& operation : chain)
+        {
+            auto result = failed ? Canceled() : Execute(*operation);
+            failed      = failed || BreaksLink(*operation, result);
+            _ring.Complete(std::move(operation), result);
+        }
+    }
+private:
+    IoRingImpl& _ring;
+    ThreadPool  _pool;
+};
+} // namespace
+
+void IoRingImpl::Complete(std::unique_ptr<IoOperation> operation, const IoRing::Result& result)
+{
+    if (operation->callback)
+    {
+        if (executor)
+        {
+            executor([callback = std::move(operation->callback), result]() { callback(result); });
+        }
+        else
+        {
+            try
+            {
+                operation->callback(result);
+            }
+            catch (...)
+            {
+            }
+        }
+    }
+    operation.reset();
+    std::lock_guard lock(inflightMutex);
+    if (!--inflight)
+    {
+        inflightCondition.notify_all();
+    }
+}
+
+void IoRingImpl::PushFixed(
+    IoOperation::Type type, FileWrapper& file, size_t bufferIndex, size_t bufferOffset, size_t size, uint64_t offset, IoRing::Callback&& callback,
+    bool linkNext
+)
+{
+    std::lock_guard lock(mutex);
+    //超出注册的缓冲区时保留请求，提交时以invalid_argument完成
+    void* buffer = nullptr;
+    if (bufferIndex < buffers.size() && bufferOffset <= buffers[bufferIndex].size && size <= buffers[bufferIndex].size - bufferOffset)
+    {
+        buffer = static_cast<uint8_t*>(buffers[bufferIndex].data) + bufferOffset;
+    }
+    PushLocked(std::make_unique<IoOperation>(IoOperation {type, &file, buffer, size, offset, bufferIndex, linkNext, std::move(callback)}));
+}
+
+void IoRingImpl::PushLocked(std::unique_ptr<IoOperation> operation)
+{
+    const auto id = std::this_thread::get_id();
+    if (operation->linkNext)
+    {
+        openChains[id].emplace_back(std::move(operation));
+        return;
+    }
+    if (auto iter = openChains.find(id); iter != openChains.end())
+    {
+        std::move(iter->second.begin(), iter->second.end(), std::back_inserter(pending));
+        openChains.erase(iter);
+    }
+    pending.emplace_back(std::move(operation));
+}
+
+void IoRingImpl::PushChain(IoOperationList&& chain)
+{
+    assert(!chain.empty() && !chain.back()->linkNext);
+    std::lock_guard lock(mutex);
+    std::move(chain.begin(), chain.end(), std::back_inserter(pending));
+}
+
+void IoRingImpl::CloseChainLocked()
+{
+    if (auto iter = openChains.find(std::this_thread::get_id()); iter != openChains.end())
+    {
+        iter->second.back()->linkNext = false;
+        std::move(iter->second.begin(), iter->second.end(), std::back_inserter(pending));
+        openChains.erase(iter);
+    }
+}
+
+IoRing::IoRing() : IoRing(Options {})
+{
+}
+
+IoRing::IoRing(const Options& options) : _impl(std::make_unique<IoRingImpl>())
+{
+#ifdef __linux__
+    if (!options.forceFallback)
+    {
+        _impl->backend = CreateIoUringBackend(*_impl, options.queueDepth);
+    }
+#endif
+    if (!_impl->backend)
+    {
+        _impl->backend = std::make_unique<ThreadPoolBackend>(*_impl, options.fallbackThreads);
+    }
+}
+
+IoRing::~IoRing()
+{
+    IoOperationList pending;
+    {
+        std::lock_guard lock(_impl->mutex);
+        pending.swap(_impl->pending);
+        for (auto& [id, chain] : _impl->openChains)
+        {
+            std::move(chain.begin(), chain.end(), std::back_inserter(pending));
+        }
+        _impl->openChains.clear();
+    }
+    {
+        std::lock_guard lock(_impl->inflightMutex);
+        _impl->inflight += pending.size();
+    }
+    for (auto& operation : pending)
+    {
+        _impl->Complete(std::move(operation), Canceled());
+    }
+    Drain();
+    _impl->backend.reset();
+}
+
+IoRing::Backend IoRing::GetBackend() const noexcept
+{
+    return _impl->backend->Type();
+}
+
+void IoRing::SetCallbackExecutor(Executor executor)
+{
+    _impl->executor = std::move(executor);
+}
+
+void IoRing::SetCallbackExecutor(ThreadPool& pool)
+{
+    _impl->executor = [&pool](std::function<void()>&& task) { pool.CommitTask(std::move(task)); };
+}
+
+void IoRing::SetCallbackExecutor(AdvancedThread& thread)
+{
+    _impl->executor = [&thread](std::function<void()>&& task) { thread.Post(task); };
+}
+
+zeus::expected<void, std::error_code> IoRing::RegisterFiles(const std::vector<FileWrapper*>& files)
+{
+    return _impl->backend->RegisterFiles(files);
+}
+
+zeus::expected<void, std::error_code> IoRing::RegisterBuffers(const std::vector<FileWrapper::ReadBuffer>& buffers)
+{
+    auto result = _impl->backend->RegisterBuffers(buffers);
+    if (result.has_value())
+    {
+        std::lock_guard lock(_impl->mutex);
+        _impl->buffers = buffers;
+    }
+    return result;
+}
+
+void IoRing::Read(FileWrapper& file, void* buffer, size_t size, uint64_t offset, Callback callback, bool linkNext)
+{
+    std::lock_guard lock(_impl->mutex);
+    _impl->PushLocked(std::make_unique<IoOperation>(
+        IoOperation {IoOperation::Type::kRead, &file, buffer, size, offset, 0, linkNext, std::move(callback)}
+    ));
+}
+
+void IoRing::Write(FileWrapper& file, const void* data, size_t size, uint64_t offset, Callback callback, bool linkNext)
+{
+    std::lock_guard lock(_impl->mutex);
+    _impl->PushLocked(std::make_unique<IoOperation>(
+        IoOperation {IoOperation::Type::kWrite, &file, const_cast<void*>(data), size, offset, 0, linkNext, std::move(callback)}
+    ));
+}
+
+void IoRing::ReadFixed(FileWrapper& file, size_t bufferIndex, size_t bufferOffset, size_t size, uint64_t offset, Callback callback, bool linkNext)
+{
+    _impl->PushFixed(IoOperation::Type::kReadFixed, file, bufferIndex, bufferOffset, size, offset, std::move(callback), linkNext);
+}
+
+void IoRing::WriteFixed(FileWrapper& file, size_t bufferIndex, size_t bufferOffset, size_t size, uint64_t offset, Callback callback, bool linkNext)
+{
+    _impl->PushFixed(IoOperation::Type::kWriteFixed, file, bufferIndex, bufferOffset, size, offset, std::move(callback), linkNext);
+}
+
+void IoRing::Fsync(FileWrapper& file, Callback callback, bool dataOnly, bool linkNext)
+{
+    std::lock_guard lock(_impl->mutex);
+    _impl->PushLocked(std::make_unique<IoOperation>(IoOperation {
+        dataOnly ? IoOperation::Type::kFdatasync : IoOperation::Type::kFsync, &file, nullptr, 0, 0, 0, linkNext, std::move(callback)}));
+}
+
+size_t IoRing::Submit()
+{
+    IoOperationList operations;
+    {
+        std::lock_guard lock(_impl->mutex);
+        _impl->CloseChainLocked();
+        operations.swap(_impl->pending);
+    }
+    if (operations.empty())
+    {
+        return 0;
+    }
+    assert(!operations.back()->linkNext);
+    const size_t count = operations.size();
+    {
+        std::lock_guard lock(_impl->inflightMutex);
+        _impl->inflight += count;
+    }
+
+    //链接中有无效的注册缓冲区请求时整个链接都不提交，无效的请求以invalid_argument完成，其他请求取消
+    IoOperationList valid;
+    valid.reserve(operations.size());
+    size_t first = 0;
+    while (first < operations.size())
+    {
+        size_t last    = first;
+        bool   invalid = IsFixed(*operations[last]) && !operations[last]->buffer;
+        while (operations[last]->linkNext && last + 1 < operations.size())
+        {
+            ++last;
+            invalid = invalid || (IsFixed(*operations[last]) && !operations[last]->buffer);
+        }
+        for (size_t index = first; index <= last; ++index)
+        {
+            auto& operation = operations[index];
+            if (!invalid)
+            {
+                valid.emplace_back(std::move(operation));
+            }
+            else if (IsFixed(*operation) && !operation->buffer)
+            {
+                _impl->Complete(std::move(operation), zeus::unexpected(std::make_error_code(std::errc::invalid_argument)));
+            }
+            else
+            {
+                _impl->Complete(std::move(operation), Canceled());
+            }
+        }
+        first = last + 1;
+    }
+    if (!valid.empty())
+    {
+        _impl->backend->Submit(std::move(valid));
+    }
+    return count;
+}
+
+void IoRing::Drain()
+{
+    std::unique_lock lock(_impl->inflightMutex);
+    _impl->inflightCondition.wait(lock, [this]() { return !_impl->inflight; });
+}
+
+size_t IoRing::InFlight() const
+{
+    std::lock_guard lock(_impl->inflightMutex);
+    return _impl->inflight;
+}
+
+AsyncFile::AsyncFile(IoRing& ring, FileWrapper&& file) : _ring(ring), _file(std::move(file))
+{
+}
+
+std::future<IoRing::Result> AsyncFile::Read(void* buffer, size_t size, uint64_t offset)
+{
+    auto promise = std::make_shared<std::promise<IoRing::Result>>();
+    auto future  = promise->get_future();
+    _ring._impl->PushChain(MakeChain(std::make_unique<IoOperation>(IoOperation {
+        IoOperation::Type::kRead, &_file, buffer, size, offset, 0, false, [promise](const IoRing::Result& result) { promise->set_value(result); }})));
+    _ring.Submit();
+    return future;
+}
+
+std::future<IoRing::Result> AsyncFile::Write(const void* data, size_t size, uint64_t offset)
+{
+    auto promise = std::make_shared<std::promise<IoRing::Result>>();
+    auto future  = promise->get_future();
+    _ring._impl->PushChain(MakeChain(std::make_unique<IoOperation>(IoOperation {
+        IoOperation::Type::kWrite, &_file, const_cast<void*>(data), size, offset, 0, false,
+        [promise](const IoRing::Result& result) { promise->set_value(result); }})));
+    _ring.Submit();
+    return future;
+}
+
+std::future<IoRing::Result> AsyncFile::Sync(bool dataOnly)
+{
+    auto promise = std::make_shared<std::promise<IoRing::Result>>();
+    auto future  = promise->get_future();
+    _ring._impl->PushChain(MakeChain(std::make_unique<IoOperation>(IoOperation {
+        dataOnly ? IoOperation::Type::kFdatasync : IoOperation::Type::kFsync, &_file, nullptr, 0, 0, 0, false,
+        [promise](const IoRing::Result& result) { promise->set_value(result); }})));
+    _ring.Submit();
+    return future;
+}
+
+std::future<IoRing::Result> AsyncFile::WriteAndSync(const void* data, size_t size, uint64_t offset, bool dataOnly)
+{
+    //回调可能投递到线程池中并发执行，两个都完成后再设置结果
+    struct State
+    {
+        std::mutex                    mutex;
+        std::promise<IoRing::Result>  promise;
+        std::optional<IoRing::Result> write;
+        std::optional<IoRing::Result> sync;
+        void                          TryFinish()
+        {
+            if (!write || !sync)
+            {
+                return;
+            }
+            if (write->has_value() && !sync->has_value())
+            {
+                promise.set_value(*sync);
+            }
+            else
+            {
+                promise.set_value(*write);
+            }
+        }
+    };
+    auto state  = std::make_shared<State>();
+    auto future = state->promise.get_future();
+    //写入和刷新一次放入队列，其他线程的请求不会插入两者之间
+    _ring._impl->PushChain(MakeChain(
+        std::make_unique<IoOperation>(IoOperation {
+            IoOperation::Type::kWrite, &_file, const_cast<void*>(data), size, offset, 0, true,
+            [state](const IoRing::Result& result)
+            {
+                std::lock_guard lock(state->mutex);
+                state->write = result;
+                state->TryFinish();
+            }}),
+        std::make_unique<IoOperation>(IoOperation {
+            dataOnly ? IoOperation::Type::kFdatasync : IoOperation::Type::kFsync, &_file, nullptr, 0, 0, 0, false,
+            [state](const IoRing::Result& result)
+            {
+                std::lock_guard lock(state->mutex);
+                state->sync = result;
+                state->TryFinish();
+            }})
+    ));
+    _ring.Submit();
+    return future;
+}
+} // namespace zeus
@@ -0,0 +1,463 @@
+﻿#include "impl/io_ring_impl.h"
+#ifdef __linux__
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <utility>
+#include <unordered_map>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <linux/io_uring.h>
+#include "zeus/foundation/core/system_error.h"
+#include "zeus/foundation/thread/thread_utils.h"
+
+//NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic) 没有c++20的span，环形队列的访问都是指针运算
+
+namespace zeus
+{
+namespace
+{
+int IoUringSetup(unsigned entries, io_uring_params* params)
+{
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int IoUringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags)
+{
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+int IoUringRegister(int fd, unsigned opcode, const void* arg, unsigned count)
+{
+    return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, count));
+}
+
+//io_uring_enter遇到EINTR/EAGAIN/EBUSY时的重试次数，前面的重试只让出时间片，之后每次等待1毫秒
+constexpr size_t kEnterYieldRetries = 100;
+constexpr size_t kEnterMaxRetries   = 1100;
+
+//不依赖liburing，直接通过系统调用和共享内存的环形队列使用io_uring
+class IoUringBackend : public IoRingBackend
+{
+    using FailedList = std::vector<std::pair<std::unique_ptr<IoOperation>, std::error_code>>;
+public:
+    explicit IoUringBackend(IoRingImpl& ring) : _ring(ring) {}
+    ~IoUringBackend() override
+    {
+        if (_thread.joinable())
+        {
+            _stopping.store(true, std::memory_order_release);
+            {
+                //IoRing析构时已经等待所有请求完成，队列中没有未提交的请求
+                std::lock_guard lock(_submitMutex);
+                auto*           sqe = NextSqe();
+                assert(sqe);
+                sqe->opcode    = IORING_OP_NOP;
+                sqe->user_data = 0;
+                CommitSqe();
+                FailedList failed;
+                Enter(failed);
+            }
+            _thread.join();
+        }
+        Unmap();
+        if (_fd >= 0)
+        {
+            close(_fd);
+        }
+    }
+
+    bool Init(uint32_t queueDepth)
+    {
+        io_uring_params params {};
+        _fd = IoUringSetup(std::max<uint32_t>(queueDepth, 2), &params);
+        if (_fd < 0)
+        {
+            return false;
+        }
+        if (!(params.features & IORING_FEAT_SINGLE_MMAP) || !Probe())
+        {
+            return false;
+        }
+        //SINGLE_MMAP时提交和完成队列共用一次映射
+        _ringSize = std::max(
+            params.sq_off.array + params.sq_entries * sizeof(unsigned), params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe)
+        );
+        _ringMemory = mmap(nullptr, _ringSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQ_RING);
+        if (MAP_FAILED == _ringMemory)
+        {
+            _ringMemory = nullptr;
+            return false;
+        }
+        _sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        auto* sqes = mmap(nullptr, _sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQES);
+        if (MAP_FAILED == sqes)
+        {
+            return false;
+        }
+        _sqes         = static_cast<io_uring_sqe*>(sqes);
+        auto* memory  = static_cast<uint8_t*>(_ringMemory);
+        _sqHead       = reinterpret_cast<unsigned*>(memory + params.sq_off.head);
+        _sqTail       = reinterpret_cast<unsigned*>(memory + params.sq_off.tail);
+        _sqMask       = *reinterpret_cast<unsigned*>(memory + params.sq_off.ring_mask);
+        _sqArray      = reinterpret_cast<unsigned*>(memory + params.sq_off.array);
+        _sqEntries    = params.sq_entries;
+        _cqHead       = reinterpret_cast<unsigned*>(memory + params.cq_off.head);
+        _cqTail       = reinterpret_cast<unsigned*>(memory + params.cq_off.tail);
+        _cqMask       = *reinterpret_cast<unsigned*>(memory + params.cq_off.ring_mask);
+        _cqes         = reinterpret_cast<io_uring_cqe*>(memory + params.cq_off.cqes);
+        _localSqTail  = *_sqTail;
+        _thread       = std::thread([this]() { Reap(); });
+        return true;
+    }
+
+    void Submit(IoOperationList&& operations) override
+    {
+        //失败的请求在释放锁之后完成，回调中可以再次提交
+        FailedList failed;
+        {
+            std::lock_guard lock(_submitMutex);
+            std::error_code error;
+            size_t          first = 0;
+            while (first < operations.size())
+            {
+                size_t last = first;
+                while (operations[last]->linkNext && last + 1 < operations.size())
+                {
+                    ++last;
+                }
+                const size_t count = last - first + 1;
+                //队列空间不足时先提交已经放入的请求，内核取走后空出位置，Enter在有限次重试后返回
+                while (!error && count <= _sqEntries && FreeSqes() < count)
+                {
+                    error = Enter(failed);
+                }
+                if (error || count > _sqEntries)
+                {
+                    //链接的请求必须在同一次提交中进入队列，超过队列长度时以invalid_argument完成；提交出错后剩余的请求以同样的错误完成
+                    for (size_t index = first; index <= last; ++index)
+                    {
+                        failed.emplace_back(std::move(operations[index]), error ? error : std::make_error_code(std::errc::invalid_argument));
+                    }
+                    first = last + 1;
+                    continue;
+                }
+                for (size_t index = first; index <= last; ++index)
+                {
+                    Prepare(std::move(operations[index]));
+                }
+                first = last + 1;
+            }
+            if (!error)
+            {
+                Enter(failed);
+            }
+        }
+        for (auto& [operation, error] : failed)
+        {
+            _ring.Complete(std::move(operation), zeus::unexpected(error));
+        }
+    }
+
+    zeus::expected<void, std::error_code> RegisterFiles(const std::vector<FileWrapper*>& files) override
+    {
+        std::lock_guard lock(_submitMutex);
+        if (!_files.empty())
+        {
+            IoUringRegister(_fd, IORING_UNREGISTER_FILES, nullptr, 0);
+            _files.clear();
+        }
+        if (files.empty())
+        {
+            return {};
+        }
+        std::vector<int> fds;
+        fds.reserve(files.size());
+        for (auto* file : files)
+        {
+            fds.emplace_back(file->Fd());
+        }
+        if (IoUringRegister(_fd, IORING_REGISTER_FILES, fds.data(), static_cast<unsigned>(fds.size())) < 0)
+        {
+            return zeus::unexpected(GetLastSystemError());
+        }
+        for (size_t index = 0; index < fds.size(); ++index)
+        {
+            _files.emplace(fds[index], static_cast<int>(index));
+        }
+        return {};
+    }
+
+    zeus::expected<void, std::error_code> RegisterBuffers(const std::vector<FileWrapper::ReadBuffer>& buffers) override
+    {
+        std::lock_guard lock(_submitMutex);
+        if (_buffersRegistered)
+        {
+            IoUringRegister(_fd, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+            _buffersRegistered = false;
+        }
+        if (buffers.empty())
+        {
+            return {};
+        }
+        std::vector<iovec> iovecs;
+        iovecs.reserve(buffers.size());
+        for (const auto& buffer : buffers)
+        {
+            iovecs.emplace_back(iovec {buffer.data, buffer.size});
+        }
+        if (IoUringRegister(_fd, IORING_REGISTER_BUFFERS, iovecs.data(), static_cast<unsigned>(iovecs.size())) < 0)
+        {
+            return zeus::unexpected(GetLastSystemError());
+        }
+        _buffersRegistered = true;
+        return {};
+    }
+
+    IoRing::Backend Type() const noexcept override { return IoRing::Backend::kIoUring; }
+private:
+    //READ/WRITE操作码从5.6开始支持，更早的内核使用线程池
+    bool Probe()
+    {
+        const size_t count  = 64;
+        const size_t size   = sizeof(io_uring_probe) + count * sizeof(io_uring_probe_op);
+        auto         memory = std::make_unique<uint8_t[]>(size);
+        std::memset(memory.get(), 0, size);
+        auto* probe = reinterpret_cast<io_uring_probe*>(memory.get());
+        if (IoUringRegister(_fd, IORING_REGISTER_PROBE, probe, count) < 0)
+        {
+            return false;
+        }
+        for (auto opcode : {IORING_OP_READ, IORING_OP_WRITE, IORING_OP_READ_FIXED, IORING_OP_WRITE_FIXED, IORING_OP_FSYNC})
+        {
+            if (opcode > probe->last_op || !(probe->ops[opcode].flags & IO_URING_OP_SUPPORTED))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    size_t FreeSqes() const noexcept { return _sqEntries - (_localSqTail - __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE)); }
+
+    io_uring_sqe* NextSqe() noexcept
+    {
+        if (!FreeSqes())
+        {
+            return nullptr;
+        }
+        const unsigned index = _localSqTail & _sqMask;
+        auto*          sqe   = &_sqes[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        _sqArray[index] = index;
+        return sqe;
+    }
+
+    void CommitSqe() noexcept
+    {
+        ++_localSqTail;
+        ++_pendingSqes;
+        __atomic_store_n(_sqTail, _localSqTail, __ATOMIC_RELEASE);
+    }
+
+    void Prepare(std::unique_ptr<IoOperation> operation)
+    {
+        auto* sqe = NextSqe();
+        assert(sqe);
+        switch (operation->type)
+        {
+        case IoOperation::Type::kRead:
+            sqe->opcode = IORING_OP_READ;
+            break;
+        case IoOperation::Type::kWrite:
+            sqe->opcode = IORING_OP_WRITE;
+            break;
+        case IoOperation::Type::kReadFixed:
+            sqe->opcode    = IORING_OP_READ_FIXED;
+            sqe->buf_index = static_cast<uint16_t>(operation->bufferIndex);
+            break;
+        case IoOperation::Type::kWriteFixed:
+            sqe->opcode    = IORING_OP_WRITE_FIXED;
+            sqe->buf_index = static_cast<uint16_t>(operation->bufferIndex);
+            break;
+        case IoOperation::Type::kFsync:
+            sqe->opcode = IORING_OP_FSYNC;
+            break;
+        case IoOperation::Type::kFdatasync:
+            sqe->opcode      = IORING_OP_FSYNC;
+            sqe->fsync_flags = IORING_FSYNC_DATASYNC;
+            break;
+        }
+        if (operation->buffer)
+        {
+            sqe->addr = reinterpret_cast<uint64_t>(operation->buffer);
+            sqe->len  = static_cast<uint32_t>(std::min(operation->size, kMaxIoTransferSize));
+            sqe->off  = operation->offset;
+        }
+        const int fd = operation->file->Fd();
+        if (auto iter = _files.find(fd); iter != _files.end())
+        {
+            sqe->fd = iter->second;
+            sqe->flags |= IOSQE_FIXED_FILE;
+        }
+        else
+        {
+            sqe->fd = fd;
+        }
+        if (operation->linkNext)
+        {
+            sqe->flags |= IOSQE_IO_LINK;
+        }
+        sqe->user_data = reinterpret_cast<uint64_t>(operation.release());
+        CommitSqe();
+    }
+
+    //提交队列中所有未提交的请求，暂时性的错误有限次重试，仍然失败时把内核没有取走的请求从队列中收回，以这个错误放入failed
+    std::error_code Enter(FailedList& failed)
+    {
+        size_t retries = 0;
+        while (_pendingSqes)
+        {
+            const int result = IoUringEnter(_fd, _pendingSqes, 0, 0);
+            if (result > 0)
+            {
+                _pendingSqes -= std::min<unsigned>(_pendingSqes, static_cast<unsigned>(result));
+                retries = 0;
+                continue;
+            }
+            const int error = result < 0 ? errno : EAGAIN;
+            if ((EINTR == error || EAGAIN == error || EBUSY == error) && ++retries < kEnterMaxRetries)
+            {
+                if (retries < kEnterYieldRetries)
+                {
+                    std::this_thread::yield();
+                }
+                else
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                continue;
+            }
+            const auto code = make_error_code(SystemError {error});
+            Reclaim(failed, code);
+            return code;
+        }
+        return {};
+    }
+
+    //没有SQPOLL时内核只在io_uring_enter中取走请求，持有_submitMutex时可以安全地回退队列尾
+    void Reclaim(FailedList& failed, const std::error_code& error)
+    {
+        const unsigned head = __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE);
+        for (unsigned position = head; position != _localSqTail; ++position)
+        {
+            if (auto userData = _sqes[position & _sqMask].user_data; userData)
+            {
+                failed.emplace_back(std::unique_ptr<IoOperation>(reinterpret_cast<IoOperation*>(userData)), error);
+            }
+        }
+        _localSqTail = head;
+        _pendingSqes = 0;
+        __atomic_store_n(_sqTail, _localSqTail, __ATOMIC_RELEASE);
+    }
+
+    void Reap()
+    {
+        SetThreadName("IoRingReaper");
+        for (;;)
+        {
+            unsigned head = *_cqHead;
+            unsigned tail = __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE);
+            if (head == tail)
+            {
+                if (_stopping.load(std::memory_order_acquire) && _stopReaped)
+                {
+                    return;
+                }
+                IoUringEnter(_fd, 0, 1, IORING_ENTER_GETEVENTS);
+                continue;
+            }
+            for (; head != tail; ++head)
+            {
+                const auto& cqe = _cqes[head & _cqMask];
+                if (!cqe.user_data)
+                {
+                    _stopReaped = true;
+                    continue;
+                }
+                std::unique_ptr<IoOperation> operation(reinterpret_cast<IoOperation*>(cqe.user_data));
+                if (cqe.res < 0)
+                {
+                    const auto error = -cqe.res;
+                    const auto code  = ECANCELED == error ? std::make_error_code(std::errc::operation_canceled) : make_error_code(SystemError {error});
+                    _ring.Complete(std::move(operation), zeus::unexpected(code));
+                }
+                else
+                {
+                    _ring.Complete(std::move(operation), static_cast<size_t>(cqe.res));
+                }
+            }
+            __atomic_store_n(_cqHead, head, __ATOMIC_RELEASE);
+        }
+    }
+
+    void Unmap() noexcept
+    {
+        if (_sqes)
+        {
+            munmap(_sqes, _sqesSize);
+            _sqes = nullptr;
+        }
+        if (_ringMemory)
+        {
+            munmap(_ringMemory, _ringSize);
+            _ringMemory = nullptr;
+        }
+    }
+private:
+    IoRingImpl&                  _ring;
+    int                          _fd                = -1;
+    void*                        _ringMemory        = nullptr;
+    size_t                       _ringSize          = 0;
+    io_uring_sqe*                _sqes              = nullptr;
+    size_t                       _sqesSize          = 0;
+    unsigned*                    _sqHead            = nullptr;
+    unsigned*                    _sqTail            = nullptr;
+    unsigned*                    _sqArray           = nullptr;
+    unsigned                     _sqMask            = 0;
+    unsigned                     _sqEntries         = 0;
+    unsigned                     _localSqTail       = 0;
+    unsigned                     _pendingSqes       = 0;
+    unsigned*                    _cqHead            = nullptr;
+    unsigned*                    _cqTail            = nullptr;
+    unsigned                     _cqMask            = 0;
+    io_uring_cqe*                _cqes              = nullptr;
+    std::mutex                   _submitMutex;
+    std::unordered_map<int, int> _files;
+    bool                         _buffersRegistered = false;
+    std::atomic<bool>            _stopping          = false;
+    bool                         _stopReaped        = false;
+    std::thread                  _thread;
+};
+} // namespace
+
+std::unique_ptr<IoRingBackend> CreateIoUringBackend(IoRingImpl& ring, uint32_t queueDepth)
+{
+    auto backend = std::make_unique<IoUringBackend>(ring);
+    if (!backend->Init(queueDepth))
+    {
+        return nullptr;
+    }
+    return backend;
+}
+} // namespace zeus
+
+//NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+#endif
@@ -0,0 +1,331 @@
+﻿#include "zeus/foundation/file/line_reader.h"
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+namespace zeus
+{
+struct LineReaderImpl
+{
+    FileWrapper         file;
+    LineReader::Options options;
+    std::vector<char>   buffer;
+    //[begin, end)是还没有返回的数据，[begin, scan)已经确认没有分隔符
+    size_t              begin     = 0;
+    size_t              scan      = 0;
+    size_t              end       = 0;
+    //读取范围时下一次读取的偏移和范围内剩余的长度
+    bool                ranged    = false;
+    uint64_t            offset    = 0;
+    uint64_t            remain    = std::numeric_limits<uint64_t>::max();
+    bool                eof       = false;
+    uint64_t            lineCount = 0;
+
+    zeus::expected<size_t, std::error_code> Fill()
+    {
+        //不完整的行移动到缓冲区开头，缓冲区已经被一行占满时扩大
+        if (begin)
+        {
+            std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+            scan -= begin;
+            end -= begin;
+            begin = 0;
+        }
+        if (end == buffer.size())
+        {
+            buffer.resize(buffer.size() * 2);
+        }
+        const size_t space = static_cast<size_t>(std::min<uint64_t>(buffer.size() - end, remain));
+        if (!space)
+        {
+            return 0;
+        }
+        //整个文件按顺序读取，/proc等不支持定位读取的文件也可以使用
+        auto result = ranged ? file.ReadAt(buffer.data() + end, space, offset) : file.Read(buffer.data() + end, space);
+        if (result.has_value())
+        {
+            end += result.value();
+            offset += result.value();
+            if (ranged)
+            {
+                remain -= result.value();
+            }
+        }
+        return result;
+    }
+
+    std::string_view Finish(const char* data, size_t size)
+    {
+        if (options.stripCarriageReturn && size && '\r' == data[size - 1])
+        {
+            --size;
+        }
+        ++lineCount;
+        return std::string_view(data, size);
+    }
+};
+
+LineReader::LineReader(FileWrapper&& file) : LineReader(std::move(file), Options {})
+{
+}
+
+LineReader::LineReader(FileWrapper&& file, const Options& options) : _impl(std::make_unique<LineReaderImpl>())
+{
+    _impl->file    = std::move(file);
+    _impl->options = options;
+    if (!_impl->options.blockSize)
+    {
+        _impl->options.blockSize = kDefaultBlockSize;
+    }
+}
+
+LineReader::LineReader(FileWrapper&& file, const Range& range, const Options& options) : LineReader(std::move(file), options)
+{
+    _impl->ranged = true;
+    _impl->offset = range.offset;
+    _impl->remain = range.length;
+}
+
+LineReader::LineReader(LineReader&& other) noexcept : _impl(std::move(other._impl))
+{
+}
+
+LineReader& LineReader::operator=(LineReader&& other) noexcept
+{
+    if (this != &other)
+    {
+        _impl = std::move(other._impl);
+    }
+    return *this;
+}
+
+LineReader::~LineReader()
+{
+}
+
+zeus::expected<bool, std::error_code> LineReader::Next(std::string_view& line)
+{
+    auto& impl = *_impl;
+    if (impl.buffer.empty())
+    {
+        impl.buffer.resize(impl.options.blockSize);
+    }
+    for (;;)
+    {
+        const char* data = impl.buffer.data();
+        if (impl.scan < impl.end)
+        {
+            if (const auto* found = static_cast<const char*>(std::memchr(data + impl.scan, impl.options.delimiter, impl.end - impl.scan)); found)
+            {
+                const auto position = static_cast<size_t>(found - data);
+                line                = impl.Finish(data + impl.begin, position - impl.begin);
+                impl.begin          = position + 1;
+                impl.scan           = impl.begin;
+                return true;
+            }
+            impl.scan = impl.end;
+        }
+        if (impl.eof)
+        {
+            if (impl.begin == impl.end)
+            {
+                return false;
+            }
+            line       = impl.Finish(data + impl.begin, impl.end - impl.begin);
+            impl.begin = impl.end;
+            return true;
+        }
+        auto result = impl.Fill();
+        if (!result.has_value())
+        {
+            return zeus::unexpected(result.error());
+        }
+        impl.eof = !result.value();
+    }
+}
+
+zeus::expected<void, std::error_code> LineReader::ForEach(const Callback& callback)
+{
+    std::string_view line;
+    for (;;)
+    {
+        auto result = Next(line);
+        if (!result.has_value())
+        {
+            return zeus::unexpected(result.error());
+        }
+        if (!result.value() || !callback(line))
+        {
+            return {};
+        }
+    }
+}
+
+uint64_t LineReader::LineCount() const noexcept
+{
+    return _impl->lineCount;
+}
+
+zeus::expected<LineReader, std::error_code> LineReader::Open(const std::filesystem::path& path)
+{
+    return Open(path, Options {});
+}
+
+zeus::expected<LineReader, std::error_code> LineReader::Open(const std::filesystem::path& path, const Options& options)
+{
+    auto file = FileWrapper::Open(path, FileWrapper::OpenMode::kRead, FileWrapper::OpenFlag::kSequential);
+    if (!file.has_value())
+    {
+        return zeus::unexpected(file.error());
+    }
+    return LineReader(std::move(file.value()), options);
+}
+
+zeus::expected<std::vector<LineReader::Range>, std::error_code> LineReader::SplitRanges(FileWrapper& file, size_t count, char delimiter)
+{
+    auto size = file.FileSize();
+    if (!size.has_value())
+    {
+        return zeus::unexpected(size.error());
+    }
+    std::vector<Range> ranges;
+    if (!size.value())
+    {
+        return ranges;
+    }
+    const uint64_t total = size.value();
+    count                = static_cast<size_t>(std::clamp<uint64_t>(count, 1, total));
+    ranges.reserve(count);
+    char     probe[4096];
+    uint64_t begin = 0;
+    for (size_t index = 1; index < count; ++index)
+    {
+        //从理想的切分点前一个字节开始向后找分隔符，新的一段从分隔符之后开始
+        const uint64_t target = total * index / count;
+        if (target <= begin)
+        {
+            continue;
+        }
+        uint64_t position = target - 1;
+        bool     found    = false;
+        while (!found && position < total)
+        {
+            auto result = file.ReadAt(probe, static_cast<size_t>(std::min<uint64_t>(sizeof(probe), total - position)), position);
+            if (!result.has_value())
+            {
+                return zeus::unexpected(result.error());
+            }
+            if (!result.value())
+            {
+                break;
+            }
+            if (const auto* delimiterPosition = static_cast<const char*>(std::memchr(probe, delimiter, result.value())); delimiterPosition)
+            {
+                position += static_cast<uint64_t>(delimiterPosition - probe) + 1;
+                found = true;
+            }
+            else
+            {
+                position += result.value();
+            }
+        }
+        //剩下的数据只有一行
+        if (!found || position >= total)
+        {
+            break;
+        }
+        ranges.push_back({begin, position - begin});
+        begin = position;
+    }
+    ranges.push_back({begin, total - begin});
+    return ranges;
+}
+
+zeus::expected<void, std::error_code> LineReader::ParallelForEach(const std::filesystem::path& path, size_t parallelism, const SegmentCallback& callback)
+{
+    return ParallelForEach(path, parallelism, callback, Options {});
+}
+
+zeus::expected<void, std::error_code> LineReader::ParallelForEach(
+    const std::filesystem::path& path, size_t parallelism, const SegmentCallback& callback, const Options& options
+)
+{
+    std::vector<Range> ranges;
+    {
+        auto file = FileWrapper::Open(path, FileWrapper::OpenMode::kRead);
+        if (!file.has_value())
+        {
+            return zeus::unexpected(file.error());
+        }
+        auto result = SplitRanges(file.value(), parallelism, options.delimiter);
+        if (!result.has_value())
+        {
+            return zeus::unexpected(result.error());
+        }
+        ranges = std::move(result.value());
+    }
+    std::atomic<bool> stop = false;
+    std::mutex        errorMutex;
+    std::error_code   error;
+    auto              fail = [&](const std::error_code& code)
+    {
+        std::lock_guard lock(errorMutex);
+        if (!error)
+        {
+            error = code;
+        }
+        stop = true;
+    };
+    auto worker = [&](size_t segment)
+    {
+        auto file = FileWrapper::Open(path, FileWrapper::OpenMode::kRead, FileWrapper::OpenFlag::kSequential);
+        if (!file.has_value())
+        {
+            fail(file.error());
+            return;
+        }
+        LineReader       reader(std::move(file.value()), ranges[segment], options);
+        std::string_view line;
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            auto result = reader.Next(line);
+            if (!result.has_value())
+            {
+                fail(result.error());
+                return;
+            }
+            if (!result.value())
+            {
+                return;
+            }
+            if (!callback(segment, line))
+            {
+                stop = true;
+                return;
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(ranges.size());
+    for (size_t segment = 1; segment < ranges.size(); ++segment)
+    {
+        threads.emplace_back(worker, segment);
+    }
+    if (!ranges.empty())
+    {
+        worker(0);
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    if (error)
+    {
+        return zeus::unexpected(error);
+    }
+    return {};
+}
+} // namespace zeus
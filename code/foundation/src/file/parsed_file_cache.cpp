@@ -0,0 +1,330 @@
+﻿#include "zeus/foundation/file/parsed_file_cache.h"
+#include <cstdint>
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <set>
+#include "zeus/foundation/file/file_utils.h"
+#include "zeus/foundation/string/string_utils.h"
+#include "zeus/foundation/core/system_error.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+#ifdef __linux__
+#include <sys/stat.h>
+#include <sys/vfs.h>
+#include <linux/magic.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace zeus
+{
+namespace
+{
+//判断文件是否变化的依据，Windows上没有设备号和inode
+struct FileStamp
+{
+    uint64_t device   = 0;
+    uint64_t inode    = 0;
+    uint64_t size     = 0;
+    int64_t  modified = 0;
+
+    bool operator==(const FileStamp& other) const noexcept
+    {
+        return device == other.device && inode == other.inode && size == other.size && modified == other.modified;
+    }
+};
+
+zeus::expected<FileStamp, std::error_code> GetFileStamp(const fs::path& path)
+{
+    FileStamp stamp;
+#ifdef _WIN32
+    WIN32_FILE_ATTRIBUTE_DATA data = {};
+    if (!GetFileAttributesExW(path.c_str(), GetFileExInfoStandard, &data))
+    {
+        return zeus::unexpected(GetLastSystemError());
+    }
+    stamp.size     = (static_cast<uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+    stamp.modified =
+        static_cast<int64_t>((static_cast<uint64_t>(data.ftLastWriteTime.dwHighDateTime) << 32) | data.ftLastWriteTime.dwLowDateTime);
+#else
+    struct stat statBuf
+    {
+    };
+    if (stat(path.c_str(), &statBuf))
+    {
+        return zeus::unexpected(GetLastSystemError());
+    }
+    stamp.device   = static_cast<uint64_t>(statBuf.st_dev);
+    stamp.inode    = static_cast<uint64_t>(statBuf.st_ino);
+    stamp.size     = static_cast<uint64_t>(statBuf.st_size);
+    stamp.modified = static_cast<int64_t>(statBuf.st_mtim.tv_sec) * 1000000000 + statBuf.st_mtim.tv_nsec;
+#endif
+    return stamp;
+}
+
+//内容由内核生成的文件系统，文件的大小和修改时间不反映内容
+bool IsPseudoFileSystem([[maybe_unused]] const fs::path& path)
+{
+#ifdef __linux__
+    struct statfs statfsBuf
+    {
+    };
+    if (statfs(path.c_str(), &statfsBuf))
+    {
+        return false;
+    }
+    switch (static_cast<unsigned long>(statfsBuf.f_type))
+    {
+    case PROC_SUPER_MAGIC:
+    case SYSFS_MAGIC:
+    case DEBUGFS_MAGIC:
+    case SECURITYFS_MAGIC:
+    case CGROUP_SUPER_MAGIC:
+    case CGROUP2_SUPER_MAGIC:
+        return true;
+    default:
+        return false;
+    }
+#else
+    return false;
+#endif
+}
+
+zeus::expected<std::shared_ptr<const ParsedFileCache::KVTable>, std::error_code> ParseKV(const fs::path& path, std::string_view delim)
+{
+    auto table  = std::make_shared<ParsedFileCache::KVTable>();
+    auto result = FileEachLineKVData(
+        path, delim,
+        [&table](std::string_view key, std::string_view value)
+        {
+            table->emplace_back(key, value);
+            return true;
+        }
+    );
+    if (!result)
+    {
+        return zeus::unexpected(result.error());
+    }
+    return table;
+}
+
+zeus::expected<std::shared_ptr<const ParsedFileCache::IniTable>, std::error_code> ParseIni(const fs::path& path)
+{
+    auto table = std::make_shared<ParsedFileCache::IniTable>();
+    //第一个section之前的键值不属于任何section，忽略
+    size_t current = 0;
+    bool   inside  = false;
+    auto   result  = FileEachLineKVData(
+        path, "=",
+        [&table, &current, &inside](std::string_view key, std::string_view value)
+        {
+            if (inside)
+            {
+                (*table)[current].second.emplace_back(Trim(key), value);
+            }
+            return true;
+        },
+        [&table, &current, &inside](std::string_view line)
+        {
+            if (line.size() >= 2 && '[' == line.front() && ']' == line.back())
+            {
+                line.remove_prefix(1);
+                line.remove_suffix(1);
+                auto iterator = std::find_if(table->begin(), table->end(), [line](const auto& section) { return section.first == line; });
+                if (iterator == table->end())
+                {
+                    iterator = table->emplace(table->end(), std::string(line), ParsedFileCache::KVTable {});
+                }
+                current = static_cast<size_t>(iterator - table->begin());
+                inside  = true;
+            }
+            return true;
+        },
+        {";", "#"}
+    );
+    if (!result)
+    {
+        return zeus::unexpected(result.error());
+    }
+    return table;
+}
+
+void PickValues(const ParsedFileCache::KVTable& table, const std::vector<std::string_view>& keys, ParsedFileCache::Values& values)
+{
+    values.assign(keys.size(), std::nullopt);
+    size_t remain = keys.size();
+    for (const auto& [key, value] : table)
+    {
+        for (size_t index = 0; index < keys.size(); ++index)
+        {
+            if (!values[index].has_value() && keys[index] == key)
+            {
+                values[index] = value;
+                --remain;
+            }
+        }
+        if (!remain)
+        {
+            break;
+        }
+    }
+}
+
+template<typename Table>
+struct CacheEntry
+{
+    FileStamp                    stamp;
+    std::shared_ptr<const Table> table;
+    uint64_t                     lastUse = 0;
+};
+
+//KV文件的分隔符不同时解析结果不同，分隔符也是键的一部分
+using CacheKey = std::pair<fs::path, std::string>;
+} // namespace
+
+struct ParsedFileCacheImpl
+{
+    size_t                                                    capacity = 0;
+    std::mutex                                                mutex;
+    uint64_t                                                  useCounter = 0;
+    std::map<CacheKey, CacheEntry<ParsedFileCache::KVTable>>  kvEntries;
+    std::map<CacheKey, CacheEntry<ParsedFileCache::IniTable>> iniEntries;
+    //已经确认是伪文件系统的设备，不需要再statfs
+    std::set<uint64_t>                                        pseudoDevices;
+
+    template<typename Table, typename Parser>
+    zeus::expected<std::shared_ptr<const Table>, std::error_code> Lookup(
+        std::map<CacheKey, CacheEntry<Table>>& entries, const CacheKey& key, Parser&& parser
+    )
+    {
+        //先stat再读取，读取过程中文件被修改时下一次查询的stat结果会不同
+        auto stamp = GetFileStamp(key.first);
+        if (!stamp.has_value())
+        {
+            std::lock_guard lock(mutex);
+            entries.erase(key);
+            return zeus::unexpected(stamp.error());
+        }
+        bool knownPseudo = false;
+        {
+            std::lock_guard lock(mutex);
+            if (auto iterator = entries.find(key); iterator != entries.end())
+            {
+                if (iterator->second.stamp == stamp.value())
+                {
+                    iterator->second.lastUse = ++useCounter;
+                    return iterator->second.table;
+                }
+                entries.erase(iterator);
+            }
+            knownPseudo = pseudoDevices.count(stamp->device);
+        }
+        //解析时不持有锁，同一个文件被同时解析时以后完成的为准
+        auto table = parser();
+        //大小为0的文件通常也是内核生成的，不缓存
+        if (!table.has_value() || knownPseudo || !stamp->size || !capacity)
+        {
+            return table;
+        }
+        const bool pseudo = IsPseudoFileSystem(key.first);
+        std::lock_guard lock(mutex);
+        if (pseudo)
+        {
+            pseudoDevices.emplace(stamp->device);
+            return table;
+        }
+        if (entries.size() >= capacity && !entries.count(key))
+        {
+            entries.erase(std::min_element(
+                entries.begin(), entries.end(), [](const auto& left, const auto& right) { return left.second.lastUse < right.second.lastUse; }
+            ));
+        }
+        entries[key] = CacheEntry<Table> {stamp.value(), table.value(), ++useCounter};
+        return table;
+    }
+};
+
+ParsedFileCache::ParsedFileCache(size_t capacity) : _impl(std::make_unique<ParsedFileCacheImpl>())
+{
+    _impl->capacity = capacity;
+}
+
+ParsedFileCache::~ParsedFileCache()
+{
+}
+
+zeus::expected<std::shared_ptr<const ParsedFileCache::KVTable>, std::error_code> ParsedFileCache::GetKVTable(
+    const std::filesystem::path& path, std::string_view delim
+)
+{
+    return _impl->Lookup(_impl->kvEntries, CacheKey(path, delim), [&path, delim]() { return ParseKV(path, delim); });
+}
+
+zeus::expected<std::shared_ptr<const ParsedFileCache::IniTable>, std::error_code> ParsedFileCache::GetIniTable(const std::filesystem::path& path)
+{
+    return _impl->Lookup(_impl->iniEntries, CacheKey(path, std::string()), [&path]() { return ParseIni(path); });
+}
+
+zeus::expected<ParsedFileCache::Values, std::error_code> ParsedFileCache::GetKVValues(
+    const std::filesystem::path& path, const std::vector<std::string_view>& keys, std::string_view delim
+)
+{
+    auto table = GetKVTable(path, delim);
+    if (!table.has_value())
+    {
+        return zeus::unexpected(table.error());
+    }
+    Values values;
+    PickValues(*table.value(), keys, values);
+    return values;
+}
+
+zeus::expected<ParsedFileCache::Values, std::error_code> ParsedFileCache::GetIniValues(
+    const std::filesystem::path& path, std::string_view section, const std::vector<std::string_view>& keys
+)
+{
+    auto table = GetIniTable(path);
+    if (!table.has_value())
+    {
+        return zeus::unexpected(table.error());
+    }
+    Values values(keys.size());
+    for (const auto& [name, data] : *table.value())
+    {
+        if (name == section)
+        {
+            PickValues(data, keys, values);
+            break;
+        }
+    }
+    return values;
+}
+
+void ParsedFileCache::Invalidate(const std::filesystem::path& path)
+{
+    std::lock_guard lock(_impl->mutex);
+    //同一个路径不同分隔符的结果相邻
+    auto& kvEntries = _impl->kvEntries;
+    for (auto iterator = kvEntries.lower_bound(CacheKey(path, std::string())); iterator != kvEntries.end() && iterator->first.first == path;)
+    {
+        iterator = kvEntries.erase(iterator);
+    }
+    _impl->iniEntries.erase(CacheKey(path, std::string()));
+}
+
+void ParsedFileCache::Clear()
+{
+    std::lock_guard lock(_impl->mutex);
+    _impl->kvEntries.clear();
+    _impl->iniEntries.clear();
+}
+
+ParsedFileCache& ParsedFileCache::Instance()
+{
+    static ParsedFileCache instance;
+    return instance;
+}
+} // namespace zeus
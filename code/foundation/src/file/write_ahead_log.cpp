@@ -0,0 +1,704 @@
+﻿#include "zeus/foundation/file/write_ahead_log.h"
+#include <algorithm>
+#include <charconv>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <vector>
+#include <fmt/format.h>
+#include "zeus/foundation/file/file_wrapper.h"
+#include "zeus/foundation/crypt/crc32_digest.h"
+#include "zeus/foundation/resource/file_mapping.h"
+#include "zeus/foundation/core/system_error.h"
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include "zeus/foundation/resource/linux/file_descriptor.h"
+#endif
+
+namespace fs = std::filesystem;
+
+namespace zeus
+{
+namespace
+{
+constexpr std::string_view kSegmentExtension = ".wal";
+constexpr std::string_view kCheckpointName   = "checkpoint";
+constexpr std::string_view kCheckpointTemp   = "checkpoint.tmp";
+//"ZWAL"
+constexpr uint32_t         kSegmentMagic     = 0x4C41575A;
+constexpr uint32_t         kSegmentVersion   = 1;
+
+struct SegmentHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t baseSequence;
+};
+
+//crc覆盖length、sequence和记录内容
+struct RecordHeader
+{
+    uint32_t crc;
+    uint32_t length;
+    uint64_t sequence;
+};
+
+struct CheckpointData
+{
+    uint64_t sequence;
+    uint32_t crc;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(SegmentHeader) == 16 && sizeof(RecordHeader) == 16 && sizeof(CheckpointData) == 16);
+
+struct Segment
+{
+    uint64_t baseSequence;
+    fs::path path;
+};
+
+//段中到第一条无效记录为止的部分
+struct SegmentScan
+{
+    uint64_t validSize    = 0;
+    uint64_t nextSequence = 0;
+    bool     complete     = true;
+};
+
+uint32_t RecordCrc(Crc32Digest& digest, const RecordHeader& header, const void* data)
+{
+    digest.Reset();
+    digest.Update(&header.length, sizeof(header) - offsetof(RecordHeader, length));
+    digest.Update(data, header.length);
+    return digest.DigestSum();
+}
+
+std::error_code CorruptedError()
+{
+    return std::make_error_code(std::errc::bad_message);
+}
+
+zeus::expected<void, std::error_code> SyncDirectory([[maybe_unused]] const fs::path& directory)
+{
+#ifdef __linux__
+    //新建、重命名和删除文件后同步目录，目录项才能在断电后保留
+    LinuxFileDescriptor fd(open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+    if (fd.Empty())
+    {
+        return zeus::unexpected(GetLastSystemError());
+    }
+    if (-1 == fsync(fd.FileDescriptor()))
+    {
+        return zeus::unexpected(GetLastSystemError());
+    }
+#endif
+    //Windows上NTFS的元数据日志保证目录项的持久性
+    return {};
+}
+
+zeus::expected<std::deque<Segment>, std::error_code> ListSegments(const fs::path& directory)
+{
+    std::deque<Segment> segments;
+    std::error_code     ec;
+    for (fs::directory_iterator iterator(directory, ec), end; !ec && iterator != end; iterator.increment(ec))
+    {
+        const auto name = iterator->path().filename().string();
+        if (name.size() != 16 + kSegmentExtension.size() || std::string_view(name).substr(16) != kSegmentExtension)
+        {
+            continue;
+        }
+        uint64_t base = 0;
+        if (auto [end, error] = std::from_chars(name.data(), name.data() + 16, base, 16); error != std::errc() || end != name.data() + 16)
+        {
+            continue;
+        }
+        segments.push_back({base, iterator->path()});
+    }
+    if (ec)
+    {
+        return zeus::unexpected(ec);
+    }
+    std::sort(segments.begin(), segments.end(), [](const Segment& left, const Segment& right) { return left.baseSequence < right.baseSequence; });
+    return segments;
+}
+
+fs::path SegmentPath(const fs::path& directory, uint64_t baseSequence)
+{
+    return directory / fmt::format("{:016x}{}", baseSequence, kSegmentExtension);
+}
+
+//依次校验段中的记录，from之后的记录交给callback，callback返回false时停止
+zeus::expected<SegmentScan, std::error_code> ScanSegment(
+    const Segment& segment, uint64_t from, const WriteAheadLog::RecordCallback& callback, bool& stopped
+)
+{
+    SegmentScan scan;
+    scan.nextSequence = segment.baseSequence;
+    auto mapping      = FileMapping::Create(segment.path, false);
+    if (!mapping.has_value())
+    {
+        return zeus::unexpected(mapping.error());
+    }
+    const uint64_t fileSize = mapping->FileSize();
+    if (fileSize < sizeof(SegmentHeader))
+    {
+        scan.complete = false;
+        return scan;
+    }
+    MemoryMapping::Options options;
+    options.advice = MemoryMapping::Advice::kSequential;
+    if (auto ret = mapping->MapAll(0, options); !ret.has_value())
+    {
+        return zeus::unexpected(ret.error());
+    }
+    const auto*   data = static_cast<const uint8_t*>(mapping->Data());
+    SegmentHeader segmentHeader;
+    std::memcpy(&segmentHeader, data, sizeof(segmentHeader));
+    if (kSegmentMagic != segmentHeader.magic || kSegmentVersion != segmentHeader.version || segment.baseSequence != segmentHeader.baseSequence)
+    {
+        scan.complete = false;
+        return scan;
+    }
+    Crc32Digest digest;
+    uint64_t    offset = sizeof(SegmentHeader);
+    while (offset < fileSize)
+    {
+        RecordHeader header;
+        if (fileSize - offset < sizeof(header))
+        {
+            scan.complete = false;
+            break;
+        }
+        std::memcpy(&header, data + offset, sizeof(header));
+        const uint8_t* record = data + offset + sizeof(header);
+        if (header.length > fileSize - offset - sizeof(header) || header.sequence != scan.nextSequence ||
+            header.crc != RecordCrc(digest, header, record))
+        {
+            scan.complete = false;
+            break;
+        }
+        offset += sizeof(header) + header.length;
+        ++scan.nextSequence;
+        if (header.sequence > from && callback && !callback(header.sequence, std::string_view(reinterpret_cast<const char*>(record), header.length)))
+        {
+            stopped = true;
+            break;
+        }
+    }
+    scan.validSize = offset;
+    return scan;
+}
+
+zeus::expected<uint64_t, std::error_code> ReadCheckpoint(const fs::path& directory)
+{
+    auto file = FileWrapper::Open(directory / kCheckpointName, FileWrapper::OpenMode::kRead);
+    if (!file.has_value())
+    {
+        if (file.error() == std::errc::no_such_file_or_directory)
+        {
+            return 0;
+        }
+        return zeus::unexpected(file.error());
+    }
+    CheckpointData checkpoint {};
+    auto           size = file->ReadAt(&checkpoint, sizeof(checkpoint), 0);
+    if (!size.has_value())
+    {
+        return zeus::unexpected(size.error());
+    }
+    if (sizeof(checkpoint) != size.value() || checkpoint.crc != Crc32Digest(&checkpoint.sequence, sizeof(checkpoint.sequence)).DigestSum())
+    {
+        return zeus::unexpected(CorruptedError());
+    }
+    return checkpoint.sequence;
+}
+
+//写入临时文件后重命名，任何时候检查点文件都是完整的
+zeus::expected<void, std::error_code> WriteCheckpoint(const fs::path& directory, uint64_t sequence)
+{
+    const auto     temp       = directory / kCheckpointTemp;
+    CheckpointData checkpoint = {sequence, Crc32Digest(&sequence, sizeof(sequence)).DigestSum(), 0};
+    {
+        auto file = FileWrapper::Truncate(temp, FileWrapper::OpenMode::kWrite);
+        if (!file.has_value())
+        {
+            return zeus::unexpected(file.error());
+        }
+        if (auto ret = file->WriteAt(&checkpoint, sizeof(checkpoint), 0); !ret.has_value())
+        {
+            return zeus::unexpected(ret.error());
+        }
+        if (auto ret = file->Flush(); !ret.has_value())
+        {
+            return zeus::unexpected(ret.error());
+        }
+    }
+    std::error_code ec;
+    fs::rename(temp, directory / kCheckpointName, ec);
+    if (ec)
+    {
+        return zeus::unexpected(ec);
+    }
+    return SyncDirectory(directory);
+}
+} // namespace
+
+struct WriteAheadLogImpl
+{
+    fs::path                              directory;
+    WriteAheadLog::Options                options;
+    mutable std::mutex                    mutex;
+    std::condition_variable               condition;
+    //串行化检查点，检查点文件的写入不持有mutex
+    std::mutex                            checkpointMutex;
+    //以下由mutex保护
+    Crc32Digest                           digest;
+    std::deque<Segment>                   segments;
+    std::vector<uint8_t>                  pending;
+    std::vector<uint8_t>                  spare;
+    uint64_t                              pendingFirst       = 0;
+    uint64_t                              lastSequence       = 0;
+    uint64_t                              durableSequence    = 0;
+    uint64_t                              checkpointSequence = 0;
+    std::chrono::steady_clock::time_point lastSync;
+    //有线程正在写入，其他线程追加的记录由它一起写入
+    bool                                  writing       = false;
+    bool                                  compactionDue = false;
+    std::error_code                       error;
+    //以下只由正在写入的线程访问
+    FileWrapper                           file;
+    uint64_t                              fileOffset = 0;
+
+    zeus::expected<void, std::error_code> Rotate(uint64_t baseSequence)
+    {
+        //新的段创建之后旧的段不再写入，先保证它完整落盘
+        if (file)
+        {
+            if (auto ret = file.FlushData(); !ret.has_value())
+            {
+                return ret;
+            }
+            file.Close();
+        }
+        const auto path    = SegmentPath(directory, baseSequence);
+        auto       segment = FileWrapper::Create(path, FileWrapper::OpenMode::kReadWrite);
+        if (!segment.has_value())
+        {
+            return zeus::unexpected(segment.error());
+        }
+        const SegmentHeader header = {kSegmentMagic, kSegmentVersion, baseSequence};
+        if (auto ret = segment->WriteAt(&header, sizeof(header), 0); !ret.has_value())
+        {
+            return zeus::unexpected(ret.error());
+        }
+        if (options.preallocate)
+        {
+            //预分配只是优化，文件系统不支持时忽略
+            segment->Preallocate(0, options.segmentSize, true);
+        }
+        if (auto ret = SyncDirectory(directory); !ret.has_value())
+        {
+            return ret;
+        }
+        file       = std::move(segment.value());
+        fileOffset = sizeof(header);
+        std::lock_guard lock(mutex);
+        segments.push_back({baseSequence, path});
+        if (options.compactionHook && segments.size() > options.compactionSegments)
+        {
+            compactionDue = true;
+        }
+        return {};
+    }
+
+    zeus::expected<void, std::error_code> WriteBatch(const std::vector<uint8_t>& batch, uint64_t firstSequence, bool sync)
+    {
+        if (!batch.empty())
+        {
+            if (!file || fileOffset >= options.segmentSize)
+            {
+                if (auto ret = Rotate(firstSequence); !ret.has_value())
+                {
+                    return ret;
+                }
+            }
+            if (auto ret = file.WriteAt(batch.data(), batch.size(), fileOffset); !ret.has_value())
+            {
+                return zeus::unexpected(ret.error());
+            }
+            fileOffset += batch.size();
+        }
+        //追加记录只改变数据和文件长度，不需要刷新修改时间等元数据
+        if (sync && file)
+        {
+            return file.FlushData();
+        }
+        return {};
+    }
+
+    //调用前设置writing，把pending中的记录写入文件，forceSync为true时结束前保证所有的记录都已经落盘
+    zeus::expected<void, std::error_code> FlushPending(std::unique_lock<std::mutex>& lock, bool forceSync)
+    {
+        while (!error && (!pending.empty() || (forceSync && durableSequence < lastSequence)))
+        {
+            std::vector<uint8_t> batch;
+            batch.swap(spare);
+            batch.swap(pending);
+            const uint64_t first = pendingFirst;
+            const uint64_t last  = lastSequence;
+            const auto     now   = std::chrono::steady_clock::now();
+            const bool     sync  = forceSync || WriteAheadLog::SyncMode::kAlways == options.syncMode ||
+                              (WriteAheadLog::SyncMode::kInterval == options.syncMode && now - lastSync >= options.syncInterval);
+            lock.unlock();
+            auto result = WriteBatch(batch, first, sync);
+            lock.lock();
+            batch.clear();
+            spare.swap(batch);
+            if (!result.has_value())
+            {
+                error = result.error();
+            }
+            else if (sync)
+            {
+                durableSequence = last;
+                lastSync        = now;
+            }
+            condition.notify_all();
+        }
+        if (error)
+        {
+            return zeus::unexpected(error);
+        }
+        return {};
+    }
+
+    void RunCompaction()
+    {
+        uint64_t last = 0;
+        {
+            std::lock_guard lock(mutex);
+            if (!compactionDue)
+            {
+                return;
+            }
+            compactionDue = false;
+            last          = lastSequence;
+        }
+        if (auto covered = options.compactionHook(last); covered.has_value())
+        {
+            Checkpoint(covered.value());
+        }
+    }
+
+    zeus::expected<void, std::error_code> Checkpoint(uint64_t sequence)
+    {
+        std::lock_guard checkpointLock(checkpointMutex);
+        {
+            std::lock_guard lock(mutex);
+            if (sequence > lastSequence)
+            {
+                return zeus::unexpected(std::make_error_code(std::errc::invalid_argument));
+            }
+            if (sequence <= checkpointSequence)
+            {
+                return {};
+            }
+        }
+        //先持久化检查点再删除段，删除过程中崩溃时剩下的段在下次打开时被跳过
+        if (auto ret = WriteCheckpoint(directory, sequence); !ret.has_value())
+        {
+            return ret;
+        }
+        std::vector<Segment> obsolete;
+        {
+            std::lock_guard lock(mutex);
+            checkpointSequence = sequence;
+            //正在写入的最后一个段总是保留
+            while (segments.size() > 1 && segments[1].baseSequence <= sequence + 1)
+            {
+                obsolete.push_back(std::move(segments.front()));
+                segments.pop_front();
+            }
+        }
+        std::error_code ec;
+        for (const auto& segment : obsolete)
+        {
+            if (!fs::remove(segment.path, ec) && ec)
+            {
+                return zeus::unexpected(ec);
+            }
+        }
+        return {};
+    }
+};
+
+WriteAheadLog::WriteAheadLog() : _impl(std::make_unique<WriteAheadLogImpl>())
+{
+}
+
+WriteAheadLog::WriteAheadLog(WriteAheadLog&& other) noexcept : _impl(std::move(other._impl))
+{
+}
+
+WriteAheadLog& WriteAheadLog::operator=(WriteAheadLog&& other) noexcept
+{
+    if (this != &other)
+    {
+        if (_impl)
+        {
+            Sync();
+        }
+        _impl = std::move(other._impl);
+    }
+    return *this;
+}
+
+WriteAheadLog::~WriteAheadLog()
+{
+    if (_impl)
+    {
+        Sync();
+    }
+}
+
+zeus::expected<uint64_t, std::error_code> WriteAheadLog::Append(std::string_view data)
+{
+    return Append(data.data(), data.size());
+}
+
+zeus::expected<uint64_t, std::error_code> WriteAheadLog::Append(const void* data, size_t size)
+{
+    if (size > std::numeric_limits<uint32_t>::max())
+    {
+        return zeus::unexpected(std::make_error_code(std::errc::invalid_argument));
+    }
+    std::unique_lock lock(_impl->mutex);
+    if (_impl->error)
+    {
+        return zeus::unexpected(_impl->error);
+    }
+    const uint64_t sequence = ++_impl->lastSequence;
+    if (_impl->pending.empty())
+    {
+        _impl->pendingFirst = sequence;
+    }
+    RecordHeader header = {0, static_cast<uint32_t>(size), sequence};
+    header.crc          = RecordCrc(_impl->digest, header, data);
+    auto& pending       = _impl->pending;
+    pending.insert(pending.end(), reinterpret_cast<const uint8_t*>(&header), reinterpret_cast<const uint8_t*>(&header) + sizeof(header));
+    pending.insert(pending.end(), static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size);
+    if (_impl->writing)
+    {
+        //正在写入的线程会在下一批写入这条记录
+        if (SyncMode::kAlways != _impl->options.syncMode)
+        {
+            return sequence;
+        }
+        _impl->condition.wait(lock, [this, sequence]() { return _impl->durableSequence >= sequence || _impl->error || !_impl->writing; });
+        if (_impl->error)
+        {
+            return zeus::unexpected(_impl->error);
+        }
+        if (_impl->durableSequence >= sequence)
+        {
+            return sequence;
+        }
+    }
+    _impl->writing = true;
+    auto result    = _impl->FlushPending(lock, false);
+    _impl->writing = false;
+    _impl->condition.notify_all();
+    lock.unlock();
+    if (!result.has_value())
+    {
+        return zeus::unexpected(result.error());
+    }
+    _impl->RunCompaction();
+    return sequence;
+}
+
+zeus::expected<void, std::error_code> WriteAheadLog::Sync()
+{
+    std::unique_lock lock(_impl->mutex);
+    _impl->condition.wait(lock, [this]() { return !_impl->writing; });
+    _impl->writing = true;
+    auto result    = _impl->FlushPending(lock, true);
+    _impl->writing = false;
+    _impl->condition.notify_all();
+    return result;
+}
+
+zeus::expected<void, std::error_code> WriteAheadLog::Checkpoint(uint64_t sequence)
+{
+    return _impl->Checkpoint(sequence);
+}
+
+uint64_t WriteAheadLog::LastSequence() const
+{
+    std::lock_guard lock(_impl->mutex);
+    return _impl->lastSequence;
+}
+
+uint64_t WriteAheadLog::DurableSequence() const
+{
+    std::lock_guard lock(_impl->mutex);
+    return _impl->durableSequence;
+}
+
+uint64_t WriteAheadLog::CheckpointSequence() const
+{
+    std::lock_guard lock(_impl->mutex);
+    return _impl->checkpointSequence;
+}
+
+size_t WriteAheadLog::SegmentCount() const
+{
+    std::lock_guard lock(_impl->mutex);
+    return _impl->segments.size();
+}
+
+zeus::expected<WriteAheadLog, std::error_code> WriteAheadLog::Open(
+    const std::filesystem::path& directory, const Options& options, const RecordCallback& replay
+)
+{
+    std::error_code ec;
+    fs::create_directories(directory, ec);
+    if (ec)
+    {
+        return zeus::unexpected(ec);
+    }
+    auto checkpoint = ReadCheckpoint(directory);
+    if (!checkpoint.has_value())
+    {
+        return zeus::unexpected(checkpoint.error());
+    }
+    auto segments = ListSegments(directory);
+    if (!segments.has_value())
+    {
+        return zeus::unexpected(segments.error());
+    }
+    //回放停止后继续校验剩下的记录，找到真正的结尾
+    bool       stopped  = false;
+    const auto callback = [&replay, &stopped](uint64_t sequence, std::string_view data)
+    {
+        if (!stopped && replay && !replay(sequence, data))
+        {
+            stopped = true;
+        }
+        return true;
+    };
+    uint64_t    nextSequence = 0;
+    SegmentScan lastScan;
+    bool        unused = false;
+    for (size_t index = 0; index < segments->size(); ++index)
+    {
+        const auto& segment = (*segments)[index];
+        //检查点之前的段可能在删除过程中被中断，只要求检查点之后的记录连续
+        if (nextSequence && segment.baseSequence != nextSequence && segment.baseSequence > checkpoint.value() + 1)
+        {
+            return zeus::unexpected(CorruptedError());
+        }
+        auto scan = ScanSegment(segment, checkpoint.value(), callback, unused);
+        if (!scan.has_value())
+        {
+            return zeus::unexpected(scan.error());
+        }
+        //只有最后一个段的结尾可能在写入时中断
+        if (!scan->complete && index + 1 != segments->size())
+        {
+            return zeus::unexpected(CorruptedError());
+        }
+        nextSequence = scan->nextSequence;
+        lastScan     = scan.value();
+    }
+
+    const uint64_t last     = std::max(nextSequence ? nextSequence - 1 : 0, checkpoint.value());
+    WriteAheadLog  wal;
+    auto&          impl     = *wal._impl;
+    impl.directory          = directory;
+    impl.options            = options;
+    impl.lastSync           = std::chrono::steady_clock::now();
+    impl.lastSequence       = last;
+    impl.durableSequence    = last;
+    impl.checkpointSequence = checkpoint.value();
+    if (!segments->empty())
+    {
+        const auto& segment = segments->back();
+        if (lastScan.validSize < sizeof(SegmentHeader))
+        {
+            //创建段时中断，段头不完整
+            if (!fs::remove(segment.path, ec) && ec)
+            {
+                return zeus::unexpected(ec);
+            }
+            segments->pop_back();
+        }
+        else
+        {
+            auto file = FileWrapper::Open(segment.path, FileWrapper::OpenMode::kReadWrite);
+            if (!file.has_value())
+            {
+                return zeus::unexpected(file.error());
+            }
+            if (!lastScan.complete)
+            {
+                //截掉结尾写了一半的记录
+                if (auto ret = file->Resize(lastScan.validSize); !ret.has_value())
+                {
+                    return zeus::unexpected(ret.error());
+                }
+                if (auto ret = file->Flush(); !ret.has_value())
+                {
+                    return zeus::unexpected(ret.error());
+                }
+            }
+            //检查点超过了实际写入的记录时，之后的记录写入新的段
+            if (lastScan.nextSequence == last + 1)
+            {
+                if (options.preallocate && lastScan.validSize < options.segmentSize)
+                {
+                    file->Preallocate(lastScan.validSize, options.segmentSize - lastScan.validSize, true);
+                }
+                impl.file       = std::move(file.value());
+                impl.fileOffset = lastScan.validSize;
+            }
+        }
+    }
+    impl.segments = std::move(segments.value());
+    return wal;
+}
+
+zeus::expected<void, std::error_code> WriteAheadLog::Read(const std::filesystem::path& directory, uint64_t sequence, const RecordCallback& callback)
+{
+    auto segments = ListSegments(directory);
+    if (!segments.has_value())
+    {
+        return zeus::unexpected(segments.error());
+    }
+    bool stopped = false;
+    for (size_t index = 0; index < segments->size() && !stopped; ++index)
+    {
+        //下一个段之前的记录都不需要
+        if (index + 1 < segments->size() && (*segments)[index + 1].baseSequence <= sequence + 1)
+        {
+            continue;
+        }
+        auto scan = ScanSegment((*segments)[index], sequence, callback, stopped);
+        if (!scan.has_value())
+        {
+            return zeus::unexpected(scan.error());
+        }
+        if (!scan->complete && index + 1 != segments->size())
+        {
+            return zeus::unexpected(CorruptedError());
+        }
+    }
+    return {};
+}
+} // namespace zeus
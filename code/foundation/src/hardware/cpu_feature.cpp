@@ -0,0 +1,114 @@
+﻿#include "zeus/foundation/hardware/cpu_feature.h"
+#include <cstdint>
+#ifdef ZEUS_ARCH_X64
+#ifdef _MSC_VER
+#include <intrin.h>
+#include <immintrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace zeus
+{
+namespace Hardware
+{
+namespace
+{
+#ifdef ZEUS_ARCH_X64
+void CpuId(uint32_t leaf, uint32_t subLeaf, uint32_t (&registers)[4])
+{
+#ifdef _MSC_VER
+    int info[4] = {};
+    __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subLeaf));
+    for (size_t index = 0; index < 4; ++index)
+    {
+        registers[index] = static_cast<uint32_t>(info[index]);
+    }
+#else
+    __cpuid_count(leaf, subLeaf, registers[0], registers[1], registers[2], registers[3]);
+#endif
+}
+
+uint64_t XGetBv()
+{
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
+    uint32_t eax = 0;
+    uint32_t edx = 0;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+}
+
+bool Bit(uint32_t value, uint32_t bit)
+{
+    return 0 != (value & (1U << bit));
+}
+#endif
+
+CpuFeature DetectCpuFeature()
+{
+    CpuFeature feature;
+#ifdef ZEUS_ARCH_X64
+    uint32_t registers[4] = {};
+    CpuId(0, 0, registers);
+    const uint32_t maxLeaf = registers[0];
+    if (maxLeaf < 1)
+    {
+        return feature;
+    }
+    CpuId(1, 0, registers);
+    const uint32_t ecx1 = registers[2];
+    const uint32_t edx1 = registers[3];
+    feature.sse2        = Bit(edx1, 26);
+    feature.ssse3       = Bit(ecx1, 9);
+    feature.sse41       = Bit(ecx1, 19);
+    feature.sse42       = Bit(ecx1, 20);
+    feature.popcnt      = Bit(ecx1, 23);
+    feature.aes         = Bit(ecx1, 25);
+    feature.pclmulqdq   = Bit(ecx1, 1);
+
+    //AVX系列需要操作系统开启了对应寄存器的保存
+    const bool osxsave  = Bit(ecx1, 27);
+    const auto xcr0     = osxsave ? XGetBv() : 0;
+    const bool osAvx    = (xcr0 & 0x06) == 0x06;
+    const bool osAvx512 = (xcr0 & 0xE6) == 0xE6;
+    feature.avx         = osAvx && Bit(ecx1, 28);
+
+    if (maxLeaf >= 7)
+    {
+        CpuId(7, 0, registers);
+        const uint32_t ebx7     = registers[1];
+        const uint32_t ecx7     = registers[2];
+        feature.bmi1            = Bit(ebx7, 3);
+        feature.bmi2            = Bit(ebx7, 8);
+        feature.sha             = Bit(ebx7, 29);
+        feature.avx2            = feature.avx && Bit(ebx7, 5);
+        feature.avx512f         = osAvx512 && Bit(ebx7, 16);
+        feature.avx512bw        = feature.avx512f && Bit(ebx7, 30);
+        feature.avx512vpopcntdq = feature.avx512f && Bit(ecx7, 14);
+    }
+
+    CpuId(0x80000000, 0, registers);
+    if (registers[0] >= 0x80000001)
+    {
+        CpuId(0x80000001, 0, registers);
+        feature.lzcnt = Bit(registers[2], 5);
+    }
+#endif
+#ifdef ZEUS_ARCH_ARM64
+    feature.neon = true;
+#endif
+    return feature;
+}
+} // namespace
+
+const CpuFeature& GetCpuFeature() noexcept
+{
+    static const CpuFeature feature = DetectCpuFeature();
+    return feature;
+}
+} // namespace Hardware
+} // namespace zeus
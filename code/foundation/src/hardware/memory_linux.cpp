@@ -2,7 +2,7 @@
 #ifdef __linux
 #include <fstream>
 #include <string>
-#include "zeus/foundation/file/kv_file_utils.h"
+#include "zeus/foundation/file/parsed_file_cache.h"
 #include "impl/memory_impl.h"
 
 namespace
@@ -19,9 +19,15 @@ namespace zeus::Hardware
 Memory Memory::GetMemory(bool bank)
 {
     Memory result;
-    result._impl->visiblePhysicalCapacity = std::stoul(GetKVFileValue("/proc/meminfo", "MemTotal", ":").value_or("0"));
-    result._impl->totalPageCapacity       = std::stoul(GetKVFileValue("/proc/meminfo", "SwapTotal", ":").value_or("0"));
-    auto available                        = std::stoul(GetKVFileValue("/proc/meminfo", "MemAvailable", ":").value_or("0"));
+    //一次读取取出所有需要的值
+    auto values = ParsedFileCache::Instance().GetKVValues("/proc/meminfo", {"MemTotal", "SwapTotal", "MemAvailable"}, ":");
+    if (!values.has_value())
+    {
+        values = ParsedFileCache::Values(3);
+    }
+    result._impl->visiblePhysicalCapacity = std::stoul(values->at(0).value_or("0"));
+    result._impl->totalPageCapacity       = std::stoul(values->at(1).value_or("0"));
+    auto available                        = std::stoul(values->at(2).value_or("0"));
     if (result._impl->visiblePhysicalCapacity > available)
     {
         result._impl->freePhysicalCapacity = result._impl->visiblePhysicalCapacity - available;
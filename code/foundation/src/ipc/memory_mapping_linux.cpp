@@ -1,12 +1,40 @@
 ﻿#include "zeus/foundation/ipc/memory_mapping.h"
 #ifdef __linux__
 
+#include <algorithm>
 #include <unistd.h>
 #include <sys/mman.h>
 #include "zeus/foundation/core/system_error.h"
 
 namespace zeus
 {
+namespace
+{
+zeus::expected<int, std::error_code> ToMadvise(MemoryMapping::Advice advice)
+{
+    switch (advice)
+    {
+    case MemoryMapping::Advice::kNormal:
+        return MADV_NORMAL;
+    case MemoryMapping::Advice::kSequential:
+        return MADV_SEQUENTIAL;
+    case MemoryMapping::Advice::kRandom:
+        return MADV_RANDOM;
+    case MemoryMapping::Advice::kWillNeed:
+        return MADV_WILLNEED;
+    case MemoryMapping::Advice::kDontNeed:
+        return MADV_DONTNEED;
+    case MemoryMapping::Advice::kHugePage:
+#ifdef MADV_HUGEPAGE
+        return MADV_HUGEPAGE;
+#else
+        return zeus::unexpected(std::make_error_code(std::errc::not_supported));
+#endif
+    default:
+        return zeus::unexpected(std::make_error_code(std::errc::invalid_argument));
+    }
+}
+} // namespace
 
 struct MemoryMappingImpl
 {
@@ -103,8 +131,25 @@ size_t MemoryMapping::SystemMemoryAlign()
 
 zeus::expected<MemoryMapping, std::error_code> MemoryMapping::Map(PlatformMemoryMappingHandle handle, uint64_t size, uint64_t offset, bool readOnly)
 {
+    return Map(handle, size, offset, readOnly, Options {});
+}
+
+zeus::expected<MemoryMapping, std::error_code> MemoryMapping::Map(
+    PlatformMemoryMappingHandle handle, uint64_t size, uint64_t offset, bool readOnly, const Options& options
+)
+{
+    int flags = MAP_SHARED;
+    if (options.populate)
+    {
+        flags |= MAP_POPULATE;
+    }
+    if (options.hugeTlb)
+    {
+        //偏移需要按大页对齐，由调用者保证
+        flags |= MAP_HUGETLB;
+    }
     const auto align = offset % SystemMemoryAlign();
-    void*      data  = mmap(nullptr, size + align, readOnly ? PROT_READ : (PROT_READ | PROT_WRITE), MAP_SHARED, handle, offset - align);
+    void*      data  = mmap(nullptr, size + align, readOnly ? PROT_READ : (PROT_READ | PROT_WRITE), flags, handle, offset - align);
     if (MAP_FAILED == data)
     {
         return zeus::unexpected(GetLastSystemError());
@@ -114,9 +159,67 @@ zeus::expected<MemoryMapping, std::error_code> MemoryMapping::Map(PlatformMemory
     mapping._impl->mapSize     = size + align;
     mapping._impl->data        = static_cast<uint8_t*>(data) + align;
     mapping._impl->size        = size;
+    if (Advice::kNormal != options.advice)
+    {
+        if (auto ret = mapping.Advise(options.advice); !ret.has_value())
+        {
+            return zeus::unexpected(ret.error());
+        }
+    }
+    if (options.lock)
+    {
+        if (auto ret = mapping.Lock(); !ret.has_value())
+        {
+            return zeus::unexpected(ret.error());
+        }
+    }
     return mapping;
 }
 
+zeus::expected<void, std::error_code> MemoryMapping::Advise(Advice advice, uint64_t offset, uint64_t length)
+{
+    if (!_impl->data || offset > _impl->size)
+    {
+        return zeus::unexpected(std::make_error_code(std::errc::invalid_argument));
+    }
+    const auto mode = ToMadvise(advice);
+    if (!mode.has_value())
+    {
+        return zeus::unexpected(mode.error());
+    }
+    //madvise要求起始地址按页对齐
+    const uint64_t end     = length ? std::min(offset + length, _impl->size) : _impl->size;
+    const auto     address = reinterpret_cast<uintptr_t>(_impl->data);
+    const auto     begin   = (address + offset) & ~(static_cast<uintptr_t>(SystemMemoryAlign()) - 1);
+    if (end == offset)
+    {
+        return {};
+    }
+    if (0 == madvise(reinterpret_cast<void*>(begin), address + end - begin, mode.value()))
+    {
+        return {};
+    }
+    return zeus::unexpected(GetLastSystemError());
+}
+
+zeus::expected<void, std::error_code> MemoryMapping::Lock()
+{
+    if (0 == mlock(_impl->baseAddress, _impl->mapSize))
+    {
+        return {};
+    }
+    return zeus::unexpected(GetLastSystemError());
+}
+
+zeus::expected<void, std::error_code> MemoryMapping::Unlock()
+{
+    if (0 == munlock(_impl->baseAddress, _impl->mapSize))
+    {
+        return {};
+    }
+    return zeus::unexpected(GetLastSystemError());
+}
+
 zeus::expected<void, std::error_code> zeus::MemoryMapping::Flush()
 {
     if (0 == msync(_impl->baseAddress, _impl->mapSize, MS_SYNC))
@@ -1,10 +1,22 @@
 ﻿#include "zeus/foundation/ipc/memory_mapping.h"
 #ifdef _WIN32
+#include <algorithm>
 #include <Windows.h>
 #include "zeus/foundation/core/system_error.h"
 
 namespace zeus
 {
+namespace
+{
+//异步地把一段映射读入内存，不支持的系统上什么都不做
+void Prefetch([[maybe_unused]] void* address, [[maybe_unused]] uint64_t size)
+{
+#if _WIN32_WINNT >= 0x0602
+    WIN32_MEMORY_RANGE_ENTRY range = {address, static_cast<SIZE_T>(size)};
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#endif
+}
+} // namespace
 
 struct MemoryMappingImpl
 {
@@ -103,10 +115,26 @@ size_t MemoryMapping::SystemMemoryAlign()
 
 zeus::expected<MemoryMapping, std::error_code> MemoryMapping::Map(PlatformMemoryMappingHandle handle, uint64_t size, uint64_t offset, bool readOnly)
 {
+    return Map(handle, size, offset, readOnly, Options {});
+}
+
+zeus::expected<MemoryMapping, std::error_code> MemoryMapping::Map(
+    PlatformMemoryMappingHandle handle, uint64_t size, uint64_t offset, bool readOnly, const Options& options
+)
+{
+    DWORD access = (readOnly ? 0 : FILE_MAP_WRITE) | FILE_MAP_READ;
+    if (options.hugeTlb)
+    {
+#ifdef FILE_MAP_LARGE_PAGES
+        access |= FILE_MAP_LARGE_PAGES;
+#else
+        return zeus::unexpected(std::make_error_code(std::errc::not_supported));
+#endif
+    }
     const auto    align         = offset % SystemMemoryAlign();
     LARGE_INTEGER offsetInteger = {};
     offsetInteger.QuadPart      = offset - align;
-    void* data = MapViewOfFile(handle, (readOnly ? 0 : FILE_MAP_WRITE) | FILE_MAP_READ, offsetInteger.HighPart, offsetInteger.LowPart, size + align);
+    void* data                  = MapViewOfFile(handle, access, offsetInteger.HighPart, offsetInteger.LowPart, size + align);
     if (!data)
     {
         return zeus::unexpected(GetLastSystemError());
@@ -116,9 +144,59 @@ zeus::expected<MemoryMapping, std::error_code> MemoryMapping::Map(PlatformMemory
     mapping._impl->mapSize     = size + align;
     mapping._impl->data        = static_cast<uint8_t*>(data) + align;
     mapping._impl->size        = size;
+    if (options.populate)
+    {
+        Prefetch(data, size + align);
+    }
+    else if (Advice::kNormal != options.advice)
+    {
+        if (auto ret = mapping.Advise(options.advice); !ret.has_value())
+        {
+            return zeus::unexpected(ret.error());
+        }
+    }
+    if (options.lock)
+    {
+        if (auto ret = mapping.Lock(); !ret.has_value())
+        {
+            return zeus::unexpected(ret.error());
+        }
+    }
     return std::move(mapping);
 }
 
+zeus::expected<void, std::error_code> MemoryMapping::Advise(Advice advice, uint64_t offset, uint64_t length)
+{
+    if (!_impl->data || offset > _impl->size)
+    {
+        return zeus::unexpected(std::make_error_code(std::errc::invalid_argument));
+    }
+    if (Advice::kWillNeed == advice)
+    {
+        const uint64_t end = length ? std::min(offset + length, _impl->size) : _impl->size;
+        Prefetch(static_cast<uint8_t*>(_impl->data) + offset, end - offset);
+    }
+    return {};
+}
+
+zeus::expected<void, std::error_code> MemoryMapping::Lock()
+{
+    if (VirtualLock(_impl->baseAddress, static_cast<SIZE_T>(_impl->mapSize)))
+    {
+        return {};
+    }
+    return zeus::unexpected(GetLastSystemError());
+}
+
+zeus::expected<void, std::error_code> MemoryMapping::Unlock()
+{
+    if (VirtualUnlock(_impl->baseAddress, static_cast<SIZE_T>(_impl->mapSize)))
+    {
+        return {};
+    }
+    return zeus::unexpected(GetLastSystemError());
+}
+
 zeus::expected<void, std::error_code> zeus::MemoryMapping::Flush()
 {
     if (FlushViewOfFile(_impl->baseAddress, _impl->mapSize))
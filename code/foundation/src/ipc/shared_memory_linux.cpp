@@ -2,6 +2,8 @@
 #ifdef __linux__
 #include <tuple>
 #include <filesystem>
+#include <fstream>
+#include <sstream>
 #include <cassert>
 #include <unistd.h>
 #include <pthread.h>
@@ -9,6 +11,7 @@
 #include <sys/stat.h>
 #include <sys/mman.h>
 #include <sys/types.h>
+#include <sys/vfs.h>
 #include "zeus/foundation/core/system_error.h"
 #include "zeus/foundation/crypt/uuid.h"
 #include "zeus/foundation/resource/linux/file_descriptor.h"
@@ -21,38 +24,122 @@ namespace
 {
 const std::string           kMemoryExtension = ".zeus_shared_memory";
 const std::filesystem::path kShmDir("/dev/shm");
+constexpr mode_t            kMemoryMode = S_IRUSR | S_IWUSR | S_IXUSR | S_IRGRP | S_IWGRP | S_IXGRP | S_IROTH | S_IWOTH | S_IXOTH;
 
-zeus::expected<std::tuple<LinuxFileDescriptor, uint64_t>, std::error_code> LoadSharedMemory(const std::string& name, bool readOnly)
+//shm_open的内存位于tmpfs，不能以MAP_HUGETLB映射，大页共享内存需要创建在hugetlbfs中
+zeus::expected<std::filesystem::path, std::error_code> HugeTlbDir()
 {
-    LinuxFileDescriptor shm = shm_open(
-        (name).c_str(), readOnly ? O_RDONLY : O_RDWR, S_IRUSR | S_IWUSR | S_IXUSR | S_IRGRP | S_IWGRP | S_IXGRP | S_IROTH | S_IWOTH | S_IXOTH
-    );
-    if (shm.Empty())
+    static const std::filesystem::path dir = []()
+    {
+        std::ifstream mounts("/proc/mounts");
+        std::string   line;
+        while (std::getline(mounts, line))
+        {
+            std::istringstream stream(line);
+            std::string        device;
+            std::string        mountPoint;
+            std::string        type;
+            if (stream >> device >> mountPoint >> type && type == "hugetlbfs")
+            {
+                return std::filesystem::path(mountPoint);
+            }
+        }
+        return std::filesystem::path();
+    }();
+    if (dir.empty())
+    {
+        return zeus::unexpected(std::make_error_code(std::errc::not_supported));
+    }
+    return dir;
+}
+
+zeus::expected<LinuxFileDescriptor, std::error_code> OpenSharedMemory(const std::string& name, int flags, bool hugeTlb)
+{
+    if (!hugeTlb)
+    {
+        LinuxFileDescriptor shm = shm_open(name.c_str(), flags, kMemoryMode);
+        if (shm.Empty())
+        {
+            return zeus::unexpected(GetLastSystemError());
+        }
+        return shm;
+    }
+    auto dir = HugeTlbDir();
+    if (!dir.has_value())
+    {
+        return zeus::unexpected(dir.error());
+    }
+    LinuxFileDescriptor file = open((dir.value() / name).c_str(), flags | O_CLOEXEC, kMemoryMode);
+    if (file.Empty())
     {
         return zeus::unexpected(GetLastSystemError());
     }
+    return file;
+}
+
+zeus::expected<std::tuple<LinuxFileDescriptor, uint64_t>, std::error_code> LoadSharedMemory(const std::string& name, bool readOnly, bool hugeTlb)
+{
+    auto shm = OpenSharedMemory(name, readOnly ? O_RDONLY : O_RDWR, hugeTlb);
+    if (!shm.has_value())
+    {
+        return zeus::unexpected(shm.error());
+    }
     struct stat shmStat = {};
-    if (fstat(shm.Fd(), &shmStat) != 0)
+    if (fstat(shm->Fd(), &shmStat) != 0)
     {
         return zeus::unexpected(GetLastSystemError());
     }
-    return std::make_tuple(std::move(shm), shmStat.st_size);
+    return std::make_tuple(std::move(shm.value()), shmStat.st_size);
 }
 
-zeus::expected<LinuxFileDescriptor, std::error_code> CreateSharedMemory(const std::string& name, uint64_t size, bool readOnly)
+zeus::expected<std::tuple<LinuxFileDescriptor, uint64_t>, std::error_code> CreateSharedMemory(
+    const std::string& name, uint64_t size, bool readOnly, bool hugeTlb
+)
 {
-    LinuxFileDescriptor shm =
-        shm_open(name.c_str(), O_CREAT | O_RDWR, S_IRUSR | S_IWUSR | S_IXUSR | S_IRGRP | S_IWGRP | S_IXGRP | S_IROTH | S_IWOTH | S_IXOTH);
-    if (shm.Empty())
+    auto shm = OpenSharedMemory(name, O_CREAT | O_RDWR, hugeTlb);
+    if (!shm.has_value())
     {
-        return zeus::unexpected(GetLastSystemError());
+        return zeus::unexpected(shm.error());
     }
-    if (ftruncate(shm.Fd(), size) != 0)
+    if (hugeTlb)
+    {
+        //hugetlbfs的文件长度必须是大页长度的整数倍
+        struct statfs fsStat = {};
+        if (fstatfs(shm->Fd(), &fsStat) != 0)
+        {
+            return zeus::unexpected(GetLastSystemError());
+        }
+        const uint64_t pageSize = fsStat.f_bsize;
+        size                    = (size + pageSize - 1) / pageSize * pageSize;
+    }
+    if (ftruncate(shm->Fd(), size) != 0)
     {
         return zeus::unexpected(GetLastSystemError());
     }
 
-    return shm;
+    return std::make_tuple(std::move(shm.value()), size);
+}
+
+zeus::expected<void, std::error_code> UnlinkSharedMemory(const std::string& name, bool hugeTlb)
+{
+    if (!hugeTlb)
+    {
+        if (0 == shm_unlink(name.c_str()))
+        {
+            return {};
+        }
+        return zeus::unexpected(GetLastSystemError());
+    }
+    auto dir = HugeTlbDir();
+    if (!dir.has_value())
+    {
+        return zeus::unexpected(dir.error());
+    }
+    if (0 == unlink((dir.value() / name).c_str()))
+    {
+        return {};
+    }
+    return zeus::unexpected(GetLastSystemError());
 }
 
 } // namespace
@@ -105,6 +192,12 @@ zeus::expected<MemoryMapping, std::error_code> SharedMemory::Map(uint64_t size,
     return MemoryMapping::Map(_impl->file.FileDescriptor(), size, offset, readOnly);
 }
 
+zeus::expected<MemoryMapping, std::error_code> SharedMemory::Map(uint64_t size, uint64_t offset, bool readOnly, const MemoryMapping::Options& options)
+{
+    assert(!_impl->file.Empty());
+    return MemoryMapping::Map(_impl->file.FileDescriptor(), size, offset, readOnly, options);
+}
+
 int SharedMemory::FileDescriptor() const
 {
     return _impl->file.FileDescriptor();
@@ -112,7 +205,19 @@ int SharedMemory::FileDescriptor() const
 
 zeus::expected<SharedMemory, std::error_code> SharedMemory::OpenOrCreate(const std::string& name, uint64_t size, bool readOnly)
 {
-    if (auto result = LoadSharedMemory(name, readOnly); result.has_value())
+    return OpenOrCreate(name, size, readOnly, Options());
+}
+
+zeus::expected<SharedMemory, std::error_code> SharedMemory::Open(const std::string& name, bool readOnly)
+{
+    return Open(name, readOnly, Options());
+}
+
+zeus::expected<SharedMemory, std::error_code> SharedMemory::OpenOrCreate(
+    const std::string& name, uint64_t size, bool readOnly, const Options& options
+)
+{
+    if (auto result = LoadSharedMemory(name, readOnly, options.hugeTlb); result.has_value())
     {
         SharedMemory memory;
         memory._impl->file = std::move(std::get<LinuxFileDescriptor>(result.value()));
@@ -120,19 +225,30 @@ zeus::expected<SharedMemory, std::error_code> SharedMemory::OpenOrCreate(const s
         memory._impl->name = name;
         return std::move(memory);
     }
+    std::filesystem::path dir = kShmDir;
+    if (options.hugeTlb)
+    {
+        auto hugeTlbDir = HugeTlbDir();
+        if (!hugeTlbDir.has_value())
+        {
+            return zeus::unexpected(hugeTlbDir.error());
+        }
+        dir = hugeTlbDir.value();
+    }
     auto id           = Uuid::GenerateRandom().toString() + kMemoryExtension;
-    auto sharedMemory = CreateSharedMemory(id, size, readOnly);
+    auto sharedMemory = CreateSharedMemory(id, size, readOnly, options.hugeTlb);
     if (!sharedMemory.has_value())
     {
+        UnlinkSharedMemory(id, options.hugeTlb);
         return zeus::unexpected(sharedMemory.error());
     }
-    AutoRelease autoUnlink([&id]() { shm_unlink(id.c_str()); });
-    const auto  result = link((kShmDir / id).c_str(), (kShmDir / name).c_str());
+    AutoRelease autoUnlink([&id, &options]() { UnlinkSharedMemory(id, options.hugeTlb); });
+    const auto  result = link((dir / id).c_str(), (dir / name).c_str());
     if (0 == result)
     {
         SharedMemory memory;
-        memory._impl->file = std::move(sharedMemory.value());
-        memory._impl->size = size;
+        memory._impl->file = std::move(std::get<LinuxFileDescriptor>(sharedMemory.value()));
+        memory._impl->size = std::get<uint64_t>(sharedMemory.value());
         memory._impl->name = name;
         return std::move(memory);
     }
@@ -140,7 +256,7 @@ zeus::expected<SharedMemory, std::error_code> SharedMemory::OpenOrCreate(const s
     {
         return zeus::unexpected(GetLastSystemError());
     }
-    if (auto result = LoadSharedMemory(name, readOnly); result.has_value())
+    if (auto result = LoadSharedMemory(name, readOnly, options.hugeTlb); result.has_value())
     {
         SharedMemory memory;
         memory._impl->file = std::move(std::get<LinuxFileDescriptor>(result.value()));
@@ -154,9 +270,9 @@ zeus::expected<SharedMemory, std::error_code> SharedMemory::OpenOrCreate(const s
     }
 }
 
-zeus::expected<SharedMemory, std::error_code> SharedMemory::Open(const std::string& name, bool readOnly)
+zeus::expected<SharedMemory, std::error_code> SharedMemory::Open(const std::string& name, bool readOnly, const Options& options)
 {
-    if (auto result = LoadSharedMemory(name, readOnly); result.has_value())
+    if (auto result = LoadSharedMemory(name, readOnly, options.hugeTlb); result.has_value())
     {
         SharedMemory memory;
         memory._impl->file = std::move(std::get<LinuxFileDescriptor>(result.value()));
@@ -172,11 +288,12 @@ zeus::expected<SharedMemory, std::error_code> SharedMemory::Open(const std::stri
 
 zeus::expected<void, std::error_code> SharedMemory::Clear(const std::string& name)
 {
-    if (0 == shm_unlink((name).c_str()))
-    {
-        return {};
-    }
-    return zeus::unexpected(GetLastSystemError());
+    return Clear(name, Options());
+}
+
+zeus::expected<void, std::error_code> SharedMemory::Clear(const std::string& name, const Options& options)
+{
+    return UnlinkSharedMemory(name, options.hugeTlb);
 }
 
 } // namespace zeus
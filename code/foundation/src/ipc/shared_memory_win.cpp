@@ -83,6 +83,12 @@ zeus::expected<MemoryMapping, std::error_code> SharedMemory::Map(uint64_t size,
     return MemoryMapping::Map(_impl->handle, size, offset, readOnly);
 }
 
+zeus::expected<MemoryMapping, std::error_code> SharedMemory::Map(uint64_t size, uint64_t offset, bool readOnly, const MemoryMapping::Options& options)
+{
+    assert(_impl->handle);
+    return MemoryMapping::Map(_impl->handle, size, offset, readOnly, options);
+}
+
 HANDLE SharedMemory::Handle() const
 {
     return _impl->handle;
@@ -90,6 +96,30 @@ HANDLE SharedMemory::Handle() const
 
 zeus::expected<SharedMemory, std::error_code> SharedMemory::OpenOrCreate(const std::string& name, uint64_t size, bool readOnly)
 {
+    return OpenOrCreate(name, size, readOnly, Options());
+}
+
+zeus::expected<SharedMemory, std::error_code> SharedMemory::Open(const std::string& name, bool readOnly)
+{
+    return Open(name, readOnly, Options());
+}
+
+zeus::expected<SharedMemory, std::error_code> SharedMemory::OpenOrCreate(
+    const std::string& name, uint64_t size, bool readOnly, const Options& options
+)
+{
+    DWORD protect = readOnly ? PAGE_READONLY : PAGE_READWRITE;
+    if (options.hugeTlb)
+    {
+        //大页的section必须一次提交，长度是GetLargePageMinimum的整数倍
+        const uint64_t pageSize = GetLargePageMinimum();
+        if (0 == pageSize)
+        {
+            return zeus::unexpected(std::make_error_code(std::errc::not_supported));
+        }
+        size     = (size + pageSize - 1) / pageSize * pageSize;
+        protect |= SEC_COMMIT | SEC_LARGE_PAGES;
+    }
     auto                wname         = CharsetUtils::UTF8ToUnicode(name);
     SECURITY_ATTRIBUTES securittyAttr = {};
     securittyAttr.nLength             = sizeof(SECURITY_ATTRIBUTES);
@@ -101,7 +131,8 @@ zeus::expected<SharedMemory, std::error_code> SharedMemory::OpenOrCreate(const s
     SetSecurityDescriptorSacl(&sd, FALSE, nullptr, FALSE);
     securittyAttr.lpSecurityDescriptor = &sd;
     WinHandle handle                   = CreateFileMappingW(
-        INVALID_HANDLE_VALUE, &securittyAttr, readOnly ? PAGE_READONLY : PAGE_READWRITE, 0, size, wname.empty() ? nullptr : wname.c_str()
+        INVALID_HANDLE_VALUE, &securittyAttr, protect, static_cast<DWORD>(size >> 32), static_cast<DWORD>(size),
+        wname.empty() ? nullptr : wname.c_str()
     );
     if (!handle)
     {
@@ -123,7 +154,8 @@ zeus::expected<SharedMemory, std::error_code> SharedMemory::OpenOrCreate(const s
     return std::move(memory);
 }
 
-zeus::expected<SharedMemory, std::error_code> SharedMemory::Open(const std::string& name, bool readOnly)
+//大页属性保存在section中，打开时不需要额外处理
+zeus::expected<SharedMemory, std::error_code> SharedMemory::Open(const std::string& name, bool readOnly, [[maybe_unused]] const Options& options)
 {
     auto      wname  = CharsetUtils::UTF8ToUnicode(name);
     WinHandle handle = OpenFileMappingW((readOnly ? FILE_MAP_READ : FILE_MAP_WRITE) | SECTION_QUERY, FALSE, wname.c_str());
@@ -0,0 +1,98 @@
+﻿#include "zeus/foundation/memory/aligned_buffer_pool.h"
+#include <new>
+#include <utility>
+
+namespace zeus
+{
+AlignedBufferPool::Buffer::Buffer(Buffer&& other) noexcept
+    : _pool(std::exchange(other._pool, nullptr)), _data(std::exchange(other._data, nullptr))
+{
+}
+
+AlignedBufferPool::Buffer& AlignedBufferPool::Buffer::operator=(Buffer&& other) noexcept
+{
+    if (this != &other)
+    {
+        Release();
+        _pool = std::exchange(other._pool, nullptr);
+        _data = std::exchange(other._data, nullptr);
+    }
+    return *this;
+}
+
+AlignedBufferPool::Buffer::~Buffer()
+{
+    Release();
+}
+
+size_t AlignedBufferPool::Buffer::Size() const noexcept
+{
+    return _pool ? _pool->BufferSize() : 0;
+}
+
+void AlignedBufferPool::Buffer::Release() noexcept
+{
+    if (_data)
+    {
+        _pool->Recycle(_data);
+        _data = nullptr;
+        _pool = nullptr;
+    }
+}
+
+AlignedBufferPool::AlignedBufferPool(size_t bufferSize, size_t alignment, size_t maxCached)
+    : _alignment(alignment), _bufferSize(AlignUp(bufferSize ? bufferSize : alignment, alignment)), _maxCached(maxCached)
+{
+    assert(alignment && !(alignment & (alignment - 1)));
+    _free.reserve(maxCached);
+}
+
+AlignedBufferPool::~AlignedBufferPool()
+{
+    Trim();
+}
+
+AlignedBufferPool::Buffer AlignedBufferPool::Acquire()
+{
+    {
+        std::lock_guard lock(_mutex);
+        if (!_free.empty())
+        {
+            void* data = _free.back();
+            _free.pop_back();
+            return Buffer(this, data);
+        }
+    }
+    return Buffer(this, ::operator new(_bufferSize, std::align_val_t(_alignment)));
+}
+
+void AlignedBufferPool::Trim() noexcept
+{
+    std::lock_guard lock(_mutex);
+    for (auto* data : _free)
+    {
+        ::operator delete(data, std::align_val_t(_alignment));
+    }
+    //保留容量，Recycle时不需要再申请
+    _free.clear();
+}
+
+size_t AlignedBufferPool::CachedCount() const
+{
+    std::lock_guard lock(_mutex);
+    return _free.size();
+}
+
+void AlignedBufferPool::Recycle(void* data) noexcept
+{
+    {
+        std::lock_guard lock(_mutex);
+        if (_free.size() < _maxCached)
+        {
+            _free.emplace_back(data);
+            return;
+        }
+    }
+    ::operator delete(data, std::align_val_t(_alignment));
+}
+} // namespace zeus
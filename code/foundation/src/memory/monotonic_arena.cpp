@@ -0,0 +1,149 @@
+﻿#include "zeus/foundation/memory/monotonic_arena.h"
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic) 没有c++20，没有std::span可用
+#include <algorithm>
+#include <limits>
+#include <new>
+
+namespace zeus
+{
+struct MonotonicArena::Chunk
+{
+    Chunk* previous;
+    size_t size;
+};
+
+namespace
+{
+//块头之后的数据按max_align_t对齐
+constexpr size_t kChunkHeaderSize = (sizeof(void*) + sizeof(size_t) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+} // namespace
+
+MonotonicArena::MonotonicArena(size_t chunkSize, std::pmr::memory_resource* upstream) noexcept
+    : _upstream(upstream), _firstSize(std::max<size_t>(chunkSize, 64)), _nextSize(_firstSize)
+{
+}
+
+MonotonicArena::MonotonicArena(void* buffer, size_t size, std::pmr::memory_resource* upstream) noexcept
+    : _upstream(upstream), _initialBuffer(static_cast<uint8_t*>(buffer)), _initialSize(size), _firstSize(std::max(size * 2, kDefaultChunkSize)),
+      _nextSize(_firstSize), _current(_initialBuffer), _end(_initialBuffer + size)
+{
+}
+
+MonotonicArena::~MonotonicArena()
+{
+    Release();
+}
+
+void MonotonicArena::Reset() noexcept
+{
+    //所有块中只保留最大的一个
+    Chunk* keep = _spare;
+    for (Chunk* chunk = _chunks; chunk;)
+    {
+        Chunk* previous = chunk->previous;
+        if (keep && keep->size >= chunk->size)
+        {
+            FreeChunk(chunk);
+        }
+        else
+        {
+            if (keep)
+            {
+                FreeChunk(keep);
+            }
+            keep = chunk;
+        }
+        chunk = previous;
+    }
+    _chunks    = nullptr;
+    _spare     = keep;
+    _allocated = 0;
+    _current   = _initialBuffer;
+    _end       = _initialBuffer + _initialSize;
+}
+
+void MonotonicArena::Release() noexcept
+{
+    Reset();
+    if (_spare)
+    {
+        FreeChunk(_spare);
+        _spare = nullptr;
+    }
+    _nextSize = _firstSize;
+}
+
+size_t MonotonicArena::ChunkCount() const noexcept
+{
+    size_t count = _spare ? 1 : 0;
+    for (const Chunk* chunk = _chunks; chunk; chunk = chunk->previous)
+    {
+        ++count;
+    }
+    return count;
+}
+
+void* MonotonicArena::do_allocate(size_t bytes, size_t alignment)
+{
+    return Allocate(bytes, alignment);
+}
+
+void MonotonicArena::do_deallocate(void* pointer, size_t bytes, size_t /*alignment*/)
+{
+    //只退回最后一次分配，vector扩容等先分配后释放的场景可以复用尾部空间
+    if (static_cast<uint8_t*>(pointer) + bytes == _current)
+    {
+        _current = static_cast<uint8_t*>(pointer);
+        _allocated -= bytes;
+    }
+}
+
+bool MonotonicArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+void* MonotonicArena::AllocateSlow(size_t size, size_t alignment)
+{
+    //加上对齐填充和块头后不能溢出
+    if (size > std::numeric_limits<size_t>::max() - alignment - kChunkHeaderSize)
+    {
+        throw std::bad_alloc();
+    }
+    const size_t required = size + alignment - 1;
+    if (_spare && _spare->size - kChunkHeaderSize >= required)
+    {
+        UseChunk(_spare);
+        _spare = nullptr;
+    }
+    else
+    {
+        //超出常规块大小的请求单独分配一个块，不影响块的增长
+        const size_t chunkSize = std::max(_nextSize, required + kChunkHeaderSize);
+        auto*        chunk     = static_cast<Chunk*>(_upstream->allocate(chunkSize, alignof(std::max_align_t)));
+        chunk->size            = chunkSize;
+        _reserved += chunkSize;
+        if (chunkSize == _nextSize)
+        {
+            _nextSize = std::min(_nextSize * 2, std::max(kMaxChunkSize, _firstSize));
+        }
+        UseChunk(chunk);
+    }
+    return Allocate(size, alignment);
+}
+
+void MonotonicArena::UseChunk(Chunk* chunk) noexcept
+{
+    chunk->previous = _chunks;
+    _chunks         = chunk;
+    _current        = reinterpret_cast<uint8_t*>(chunk) + kChunkHeaderSize;
+    _end            = reinterpret_cast<uint8_t*>(chunk) + chunk->size;
+}
+
+void MonotonicArena::FreeChunk(Chunk* chunk) noexcept
+{
+    _reserved -= chunk->size;
+    _upstream->deallocate(chunk, chunk->size, alignof(std::max_align_t));
+}
+} // namespace zeus
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic) 没有c++20，没有std::span可用
@@ -0,0 +1,348 @@
+﻿#include "zeus/foundation/memory/pool_resource.h"
+#include <thread>
+#include <algorithm>
+#include <unordered_map>
+#include "zeus/foundation/byte/bit_utils.h"
+
+namespace zeus
+{
+struct PoolResource::Node
+{
+    Node* next;
+};
+
+struct PoolResource::ThreadCache
+{
+    //线程退出后owner被清空，缓存可以分配给其他线程
+    std::thread::id                 owner;
+    std::array<Node*, kClassCount>  heads = {};
+    std::array<size_t, kClassCount> count = {};
+};
+
+//每个线程一份，记住最近使用的几个池的缓存，命中时不需要加锁
+struct PoolResource::ThreadCaches
+{
+    struct Entry
+    {
+        uint64_t     id    = 0;
+        ThreadCache* cache = nullptr;
+    };
+    std::array<Entry, 4>  entries;
+    size_t                victim = 0;
+    //当前线程在哪些池中有缓存，包括已经不在entries中的，线程退出时逐个归还
+    std::vector<uint64_t> pools;
+    ~ThreadCaches();
+};
+
+namespace
+{
+constexpr size_t kMinBlockShift = 4;
+static_assert(PoolResource::kMinBlockSize == size_t(1) << kMinBlockShift);
+static_assert(PoolResource::kMaxBlockSize == PoolResource::kMinBlockSize << (PoolResource::kClassCount - 1));
+
+//每个池有唯一的编号，线程缓存按编号查找，池销毁后编号不会被复用，不会找到失效的缓存
+uint64_t NextPoolId()
+{
+    static std::atomic<uint64_t> id = 0;
+    return ++id;
+}
+
+//size需要在(0, kMaxBlockSize]之间
+size_t ClassIndex(size_t size)
+{
+    return size <= PoolResource::kMinBlockSize ? 0 : 64 - CountLeftZero(static_cast<uint64_t>(size - 1)) - kMinBlockShift;
+}
+
+constexpr size_t ClassBlockSize(size_t index)
+{
+    return PoolResource::kMinBlockSize << index;
+}
+
+//线程缓存中的空闲块超过这个数量时归还一半到共享链表
+constexpr size_t SpillLimit(size_t index)
+{
+    return std::max<size_t>(PoolResource::kSlabSize / ClassBlockSize(index) * 2, 32);
+}
+
+//存活的池，线程退出时持有锁归还缓存，池析构前先从这里移除，所以不会归还到已经销毁的池
+struct PoolRegistry
+{
+    std::mutex                                   mutex;
+    std::unordered_map<uint64_t, PoolResource*> pools;
+};
+
+PoolRegistry& Registry()
+{
+    //线程局部对象可能晚于静态对象析构，注册表不释放
+    static auto* registry = new PoolRegistry();
+    return *registry;
+}
+} // namespace
+
+PoolResource::ThreadCaches::~ThreadCaches()
+{
+    const auto      owner    = std::this_thread::get_id();
+    auto&           registry = Registry();
+    std::lock_guard lock(registry.mutex);
+    for (const auto id : pools)
+    {
+        if (auto iter = registry.pools.find(id); iter != registry.pools.end())
+        {
+            iter->second->ReleaseCache(owner);
+        }
+    }
+}
+
+PoolResource::PoolResource(std::pmr::memory_resource* upstream) : _upstream(upstream), _id(NextPoolId())
+{
+    for (auto& head : _shared)
+    {
+        head.store(nullptr, std::memory_order_relaxed);
+    }
+    auto&           registry = Registry();
+    std::lock_guard lock(registry.mutex);
+    registry.pools.emplace(_id, this);
+}
+
+PoolResource::~PoolResource()
+{
+    {
+        auto&           registry = Registry();
+        std::lock_guard lock(registry.mutex);
+        registry.pools.erase(_id);
+    }
+    for (const auto& slab : _slabs)
+    {
+        _upstream->deallocate(slab.data, kSlabSize, slab.alignment);
+    }
+}
+
+size_t PoolResource::BlockSize(size_t size, size_t alignment) noexcept
+{
+    const size_t required = std::max(size, alignment);
+    return required <= kMaxBlockSize ? ClassBlockSize(ClassIndex(required)) : 0;
+}
+
+void* PoolResource::Allocate(size_t size, size_t alignment)
+{
+    const size_t required = std::max(size, alignment);
+    if (required > kMaxBlockSize)
+    {
+        return _upstream->allocate(size, alignment);
+    }
+    const size_t index = ClassIndex(required);
+    auto&        cache = LocalCache();
+    if (!cache.heads[index])
+    {
+        Refill(cache, index);
+    }
+    Node* node         = cache.heads[index];
+    cache.heads[index] = node->next;
+    --cache.count[index];
+    return node;
+}
+
+void PoolResource::Deallocate(void* pointer, size_t size, size_t alignment) noexcept
+{
+    if (!pointer)
+    {
+        return;
+    }
+    const size_t required = std::max(size, alignment);
+    if (required > kMaxBlockSize)
+    {
+        _upstream->deallocate(pointer, size, alignment);
+        return;
+    }
+    //块在同一个池内可以互换，直接放进当前线程的缓存，不管是哪个线程分配的
+    const size_t index = ClassIndex(required);
+    auto*        node  = static_cast<Node*>(pointer);
+    ThreadCache* cache = FindCache();
+    if (!cache)
+    {
+        //创建缓存需要加锁和分配内存，只在分配时进行
+        PushShared(index, node, node);
+        return;
+    }
+
+    node->next          = cache->heads[index];
+    cache->heads[index] = node;
+    if (++cache->count[index] > SpillLimit(index))
+    {
+        Spill(*cache, index);
+    }
+}
+
+void* PoolResource::do_allocate(size_t bytes, size_t alignment)
+{
+    return Allocate(bytes, alignment);
+}
+
+void PoolResource::do_deallocate(void* pointer, size_t bytes, size_t alignment)
+{
+    Deallocate(pointer, bytes, alignment);
+}
+
+bool PoolResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+PoolResource::ThreadCaches& PoolResource::LocalCaches() noexcept
+{
+    //构造时不分配内存
+    thread_local ThreadCaches caches;
+    return caches;
+}
+
+PoolResource::ThreadCache* PoolResource::FindCache() noexcept
+{
+    for (const auto& entry : LocalCaches().entries)
+    {
+        if (entry.id == _id)
+        {
+            return entry.cache;
+        }
+    }
+    return nullptr;
+}
+
+PoolResource::ThreadCache& PoolResource::LocalCache()
+{
+    if (auto* found = FindCache(); found)
+    {
+        return *found;
+    }
+
+    auto&        caches = LocalCaches();
+    ThreadCache* cache  = nullptr;
+    {
+        std::lock_guard lock(_mutex);
+        //先找当前线程被挤出entries的缓存，再找已经退出的线程留下的缓存
+        const auto owner = std::this_thread::get_id();
+        auto       iter  = std::find_if(_caches.begin(), _caches.end(), [&owner](const auto& item) { return item->owner == owner; });
+        if (iter == _caches.end())
+        {
+            iter = std::find_if(_caches.begin(), _caches.end(), [](const auto& item) { return item->owner == std::thread::id(); });
+        }
+        if (iter != _caches.end())
+        {
+            cache = iter->get();
+        }
+        else
+        {
+            cache = _caches.emplace_back(std::make_unique<ThreadCache>()).get();
+        }
+        cache->owner = owner;
+    }
+    if (std::find(caches.pools.begin(), caches.pools.end(), _id) == caches.pools.end())
+    {
+        //顺便去掉已经销毁的池
+        auto&           registry = Registry();
+        std::lock_guard lock(registry.mutex);
+        caches.pools.erase(
+            std::remove_if(caches.pools.begin(), caches.pools.end(), [&registry](uint64_t id) { return registry.pools.count(id) == 0; }),
+            caches.pools.end()
+        );
+        caches.pools.emplace_back(_id);
+    }
+    caches.entries[caches.victim] = {_id, cache};
+    caches.victim                 = (caches.victim + 1) % caches.entries.size();
+    return *cache;
+}
+
+void PoolResource::Refill(ThreadCache& cache, size_t index)
+{
+    //先整批取走其他线程归还的块，整体交换不存在ABA问题
+    Node* nodes = _shared[index].exchange(nullptr, std::memory_order_acquire);
+    if (nodes)
+    {
+        size_t count = 0;
+        for (Node* node = nodes; node; node = node->next)
+        {
+            ++count;
+        }
+        cache.heads[index] = nodes;
+        cache.count[index] += count;
+        return;
+    }
+
+    const size_t blockSize = ClassBlockSize(index);
+    const Slab   slab {_upstream->allocate(kSlabSize, blockSize), blockSize};
+    try
+    {
+        std::lock_guard lock(_mutex);
+        _slabs.emplace_back(slab);
+    }
+    catch (...)
+    {
+        _upstream->deallocate(slab.data, kSlabSize, slab.alignment);
+        throw;
+    }
+    _reserved.fetch_add(kSlabSize, std::memory_order_relaxed);
+
+    //按地址顺序串起来，顺序分配时访问是连续的
+    auto*        data  = static_cast<uint8_t*>(slab.data);
+    const size_t count = kSlabSize / blockSize;
+    Node*        next  = cache.heads[index];
+    for (size_t block = count; block > 0; --block)
+    {
+        auto* node = reinterpret_cast<Node*>(data + (block - 1) * blockSize); // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        node->next = next;
+        next       = node;
+    }
+    cache.heads[index] = next;
+    cache.count[index] += count;
+}
+
+void PoolResource::Spill(ThreadCache& cache, size_t index) noexcept
+{
+    const size_t count = cache.count[index] / 2;
+    Node*        first = cache.heads[index];
+    Node*        last  = first;
+    for (size_t step = 1; step < count; ++step)
+    {
+        last = last->next;
+    }
+    cache.heads[index] = last->next;
+    cache.count[index] -= count;
+    PushShared(index, first, last);
+}
+
+void PoolResource::PushShared(size_t index, Node* first, Node* last) noexcept
+{
+    //只有整批压入和整体取走两种操作，压入的CAS不会受ABA影响
+    Node* head = _shared[index].load(std::memory_order_relaxed);
+    do
+    {
+        last->next = head;
+    }
+    while (!_shared[index].compare_exchange_weak(head, first, std::memory_order_release, std::memory_order_relaxed));
+}
+
+void PoolResource::ReleaseCache(std::thread::id owner) noexcept
+{
+    std::lock_guard lock(_mutex);
+    auto            iter = std::find_if(_caches.begin(), _caches.end(), [&owner](const auto& item) { return item->owner == owner; });
+    if (iter == _caches.end())
+    {
+        return;
+    }
+    auto& cache = **iter;
+    for (size_t index = 0; index < kClassCount; ++index)
+    {
+        if (Node* first = cache.heads[index]; first)
+        {
+            Node* last = first;
+            while (last->next)
+            {
+                last = last->next;
+            }
+            PushShared(index, first, last);
+            cache.heads[index] = nullptr;
+            cache.count[index] = 0;
+        }
+    }
+    cache.owner = std::thread::id();
+}
+} // namespace zeus
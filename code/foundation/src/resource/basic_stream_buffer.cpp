@@ -1,6 +1,8 @@
 ﻿#include "zeus/foundation/resource/basic_stream_buffer.h"
 #include <vector>
+#include <algorithm>
 #include <cassert>
+#include <limits>
 
 namespace zeus
 {
@@ -10,7 +12,7 @@ struct BasicStreamBufferImpl
     std::vector<char>             buffer;
     bool                          eof         = false;
     BasicStreamBuffer::BufferMode mode        = BasicStreamBuffer::BufferMode::Read;
-    static const size_t           putbackSize = 8; //用于准备回退的缓冲空间
+    static constexpr size_t       putbackSize = 8; //用于准备回退的缓冲空间
 };
 
 BasicStreamBuffer::BasicStreamBuffer(BufferMode mode, size_t bufferSize) : _impl(std::make_unique<BasicStreamBufferImpl>())
@@ -96,6 +98,86 @@ int BasicStreamBuffer::sync()
     }
     return 0;
 }
+std::streamsize BasicStreamBuffer::xsgetn(char_type* s, std::streamsize count)
+{
+    if (BasicStreamBuffer::BufferMode::Write == _impl->mode)
+    {
+        return 0;
+    }
+    const auto      readSize = static_cast<std::streamsize>(_impl->bufferSize - _impl->putbackSize);
+    std::streamsize copied   = 0;
+    while (copied < count)
+    {
+        if (const std::streamsize buffered = this->egptr() - this->gptr(); buffered > 0)
+        {
+            const std::streamsize length = std::min(buffered, count - copied);
+            std::char_traits<char>::copy(s + copied, this->gptr(), static_cast<size_t>(length));
+            this->gbump(static_cast<int>(length));
+            copied += length;
+            continue;
+        }
+        if (count - copied < readSize)
+        {
+            if (std::char_traits<char>::eq_int_type(underflow(), std::char_traits<char>::eof()))
+            {
+                break;
+            }
+            continue;
+        }
+        //剩余的长度不小于缓冲区时直接读入调用者的缓冲区
+        const int n = ReadDevice(
+            s + copied, static_cast<size_t>(std::min<std::streamsize>(count - copied, std::numeric_limits<int>::max()))
+        );
+        if (n <= 0)
+        {
+            break;
+        }
+        copied += n;
+        //保留最后读取的数据用于回退
+        const size_t putback = std::min(static_cast<size_t>(n), _impl->putbackSize);
+        char*        begin   = _impl->buffer.data() + _impl->putbackSize;
+        std::char_traits<char>::copy(begin - putback, s + copied - putback, putback);
+        this->setg(begin - putback, begin, begin);
+    }
+    return copied;
+}
+std::streamsize BasicStreamBuffer::xsputn(const char_type* s, std::streamsize count)
+{
+    if (BasicStreamBuffer::BufferMode::Read == _impl->mode)
+    {
+        return 0;
+    }
+    if (count <= this->epptr() - this->pptr())
+    {
+        std::char_traits<char>::copy(this->pptr(), s, static_cast<size_t>(count));
+        this->pbump(static_cast<int>(count));
+        return count;
+    }
+    if (this->pptr() > this->pbase() && FlushDevice() < 0)
+    {
+        return 0;
+    }
+    if (count < static_cast<std::streamsize>(_impl->bufferSize))
+    {
+        std::char_traits<char>::copy(this->pptr(), s, static_cast<size_t>(count));
+        this->pbump(static_cast<int>(count));
+        return count;
+    }
+    //超过缓冲区的数据直接写入设备
+    std::streamsize written = 0;
+    while (written < count)
+    {
+        const int n = WriteDevice(
+            s + written, static_cast<size_t>(std::min<std::streamsize>(count - written, std::numeric_limits<int>::max()))
+        );
+        if (n <= 0)
+        {
+            break;
+        }
+        written += n;
+    }
+    return written;
+}
 int BasicStreamBuffer::WriteDevice(const char_type* /*buffer*/, std::size_t /*length*/)
 {
     return 0;
@@ -0,0 +1,34 @@
+﻿#include "zeus/foundation/resource/file_mapping.h"
+#include <algorithm>
+
+namespace zeus
+{
+zeus::expected<void, std::error_code> FileMapping::ForEachWindow(
+    uint64_t windowSize, uint64_t overlap, const MemoryMapping::Options& options, const WindowCallback& callback
+)
+{
+    if (!windowSize)
+    {
+        windowSize = kDefaultWindowSize;
+    }
+    if (overlap >= windowSize)
+    {
+        return zeus::unexpected(std::make_error_code(std::errc::invalid_argument));
+    }
+    const uint64_t fileSize = FileSize();
+    const uint64_t step     = windowSize - overlap;
+    for (uint64_t offset = 0; offset < fileSize; offset += step)
+    {
+        const uint64_t length = std::min(windowSize, fileSize - offset);
+        if (auto ret = Map(offset, length, options); !ret.has_value())
+        {
+            return zeus::unexpected(ret.error());
+        }
+        if (!callback(offset, Data(), Size()) || offset + length >= fileSize)
+        {
+            break;
+        }
+    }
+    return UnMap();
+}
+} // namespace zeus
@@ -16,6 +16,7 @@ struct FileMappingImpl
     std::unique_ptr<MemoryMapping> mapping;
     bool                           writable = false;
     uint64_t                       fileSize = 0;
+    uint64_t                       offset   = 0;
 };
 
 FileMapping::FileMapping() : _impl(std::make_unique<FileMappingImpl>())
@@ -40,27 +41,45 @@ FileMapping::~FileMapping()
 }
 
 zeus::expected<void, std::error_code> FileMapping::Map(uint64_t offset, uint64_t length)
+{
+    return Map(offset, length, MemoryMapping::Options {});
+}
+
+zeus::expected<void, std::error_code> FileMapping::MapAll(uint64_t offset)
+{
+    return MapAll(offset, MemoryMapping::Options {});
+}
+
+zeus::expected<void, std::error_code> FileMapping::Map(uint64_t offset, uint64_t length, const MemoryMapping::Options& options)
 {
     _impl->mapping.reset();
-    auto mapping = MemoryMapping::Map(_impl->mappingFileDescriptor.FileDescriptor(), length, offset, !_impl->writable);
+    auto mapping = MemoryMapping::Map(_impl->mappingFileDescriptor.FileDescriptor(), length, offset, !_impl->writable, options);
     if (!mapping.has_value())
     {
         return zeus::unexpected(mapping.error());
     }
     _impl->mapping = std::make_unique<MemoryMapping>(std::move(mapping.value()));
+    _impl->offset  = offset;
     return {};
 }
 
-zeus::expected<void, std::error_code> FileMapping::MapAll(uint64_t offset)
+zeus::expected<void, std::error_code> FileMapping::MapAll(uint64_t offset, const MemoryMapping::Options& options)
 {
-    _impl->mapping.reset();
-    auto mapping = MemoryMapping::Map(_impl->mappingFileDescriptor.FileDescriptor(), _impl->fileSize - offset, offset, !_impl->writable);
-    if (!mapping.has_value())
+    return Map(offset, _impl->fileSize - offset, options);
+}
+
+zeus::expected<void, std::error_code> FileMapping::Advise(MemoryMapping::Advice advice, uint64_t offset, uint64_t length)
+{
+    if (!_impl->mapping)
     {
-        return zeus::unexpected(mapping.error());
+        return zeus::unexpected(std::make_error_code(std::errc::invalid_argument));
     }
-    _impl->mapping = std::make_unique<MemoryMapping>(std::move(mapping.value()));
-    return {};
+    return _impl->mapping->Advise(advice, offset, length);
+}
+
+uint64_t FileMapping::Offset() const
+{
+    return _impl->offset;
 }
 
 bool FileMapping::Empty() const
@@ -1,24 +1,166 @@
 ﻿#include "zeus/foundation/resource/pipe_stream_buffer.h"
 
 #ifdef __linux__
+#include <fcntl.h>
 #include <unistd.h>
+#include <limits>
+#include <vector>
+#include "zeus/foundation/core/system_error.h"
 #include "zeus/foundation/core/posix/eintr_wrapper.h"
 
 namespace zeus
 {
+namespace
+{
+//每次splice的最大长度，实际长度受限于管道中的数据
+constexpr size_t kSpliceLength = 1024 * 1024;
+
+size_t AdaptBufferSize(int pipe, size_t bufferSize)
+{
+    if (PipeStreamBuffer::kAutoBufferSize != bufferSize)
+    {
+        return bufferSize;
+    }
+    auto capacity = PipeStreamBuffer::PipeCapacity(pipe);
+    return capacity.has_value() ? capacity.value() : PipeStreamBuffer::kDefaultBufferSize;
+}
+
+zeus::expected<void, std::error_code> WriteAll(int fd, const char* data, size_t length)
+{
+    while (length)
+    {
+        const auto writeLength = HANDLE_EINTR(write(fd, data, length));
+        if (writeLength < 0)
+        {
+            return zeus::unexpected(GetLastSystemError());
+        }
+        data += writeLength;
+        length -= static_cast<size_t>(writeLength);
+    }
+    return {};
+}
+} // namespace
+
 struct PipeStreamBufferImpl
 {
-    int pipe;
+    int                           pipe;
+    BasicStreamBuffer::BufferMode mode;
 };
 PipeStreamBuffer::PipeStreamBuffer(PlatformFileHandle pipe, BasicStreamBuffer::BufferMode mode, size_t bufferSize)
-    : BasicStreamBuffer(mode, bufferSize), _impl(std::make_unique<PipeStreamBufferImpl>())
+    : BasicStreamBuffer(mode, AdaptBufferSize(pipe, bufferSize)), _impl(std::make_unique<PipeStreamBufferImpl>())
 {
     _impl->pipe = pipe;
+    _impl->mode = mode;
 }
 PipeStreamBuffer::~PipeStreamBuffer()
 {
 }
 
+PlatformFileHandle PipeStreamBuffer::Handle() const noexcept
+{
+    return _impl->pipe;
+}
+
+zeus::expected<uint64_t, std::error_code> PipeStreamBuffer::TransferTo(PlatformFileHandle out)
+{
+    if (BasicStreamBuffer::BufferMode::Read != _impl->mode || _impl->pipe <= 0)
+    {
+        return zeus::unexpected(std::make_error_code(std::errc::invalid_argument));
+    }
+    uint64_t total = 0;
+    //先写出已经读入缓冲区的数据
+    if (const auto buffered = this->egptr() - this->gptr(); buffered > 0)
+    {
+        if (auto ret = WriteAll(out, this->gptr(), static_cast<size_t>(buffered)); !ret.has_value())
+        {
+            return zeus::unexpected(ret.error());
+        }
+        this->gbump(static_cast<int>(buffered));
+        total += static_cast<uint64_t>(buffered);
+    }
+    for (;;)
+    {
+        auto length = Splice(_impl->pipe, out, kSpliceLength);
+        if (length.has_value())
+        {
+            if (!length.value())
+            {
+                return total;
+            }
+            total += length.value();
+            continue;
+        }
+        if (length.error() != std::errc::invalid_argument)
+        {
+            return zeus::unexpected(length.error());
+        }
+        break;
+    }
+    std::vector<char> buffer(AdaptBufferSize(_impl->pipe, kAutoBufferSize));
+    for (;;)
+    {
+        const auto readLength = HANDLE_EINTR(read(_impl->pipe, buffer.data(), buffer.size()));
+        if (readLength < 0)
+        {
+            return zeus::unexpected(GetLastSystemError());
+        }
+        if (!readLength)
+        {
+            return total;
+        }
+        if (auto ret = WriteAll(out, buffer.data(), static_cast<size_t>(readLength)); !ret.has_value())
+        {
+            return zeus::unexpected(ret.error());
+        }
+        total += static_cast<uint64_t>(readLength);
+    }
+}
+
+zeus::expected<size_t, std::error_code> PipeStreamBuffer::PipeCapacity(PlatformFileHandle pipe)
+{
+    const int capacity = fcntl(pipe, F_GETPIPE_SZ);
+    if (capacity < 0)
+    {
+        return zeus::unexpected(GetLastSystemError());
+    }
+    return static_cast<size_t>(capacity);
+}
+
+zeus::expected<size_t, std::error_code> PipeStreamBuffer::SetPipeCapacity(int pipe, size_t size)
+{
+    if (size > static_cast<size_t>(std::numeric_limits<int>::max()))
+    {
+        return zeus::unexpected(std::make_error_code(std::errc::invalid_argument));
+    }
+    //内核把容量向上取整到页大小的2的幂
+    const int capacity = fcntl(pipe, F_SETPIPE_SZ, static_cast<int>(size));
+    if (capacity < 0)
+    {
+        return zeus::unexpected(GetLastSystemError());
+    }
+    return static_cast<size_t>(capacity);
+}
+
+zeus::expected<size_t, std::error_code> PipeStreamBuffer::Splice(int in, int out, size_t length)
+{
+    const auto spliceLength = HANDLE_EINTR(splice(in, nullptr, out, nullptr, length, SPLICE_F_MOVE | SPLICE_F_MORE));
+    if (spliceLength < 0)
+    {
+        return zeus::unexpected(GetLastSystemError());
+    }
+    return static_cast<size_t>(spliceLength);
+}
+
+zeus::expected<size_t, std::error_code> PipeStreamBuffer::Tee(int in, int out, size_t length)
+{
+    const auto teeLength = HANDLE_EINTR(tee(in, out, length, 0));
+    if (teeLength < 0)
+    {
+        return zeus::unexpected(GetLastSystemError());
+    }
+    return static_cast<size_t>(teeLength);
+}
+
 int PipeStreamBuffer::WriteDevice(const char_type* buffer, std::size_t length)
 {
     if (_impl->pipe > 0)
@@ -2,23 +2,111 @@
 
 #ifdef _WIN32
 #include <Windows.h>
+#include <algorithm>
+#include <vector>
+#include "zeus/foundation/core/system_error.h"
 
 namespace zeus
 {
+namespace
+{
+size_t AdaptBufferSize(HANDLE pipe, size_t bufferSize)
+{
+    if (PipeStreamBuffer::kAutoBufferSize != bufferSize)
+    {
+        return bufferSize;
+    }
+    auto capacity = PipeStreamBuffer::PipeCapacity(pipe);
+    return capacity.has_value() && capacity.value() ? capacity.value() : PipeStreamBuffer::kDefaultBufferSize;
+}
+
+zeus::expected<void, std::error_code> WriteAll(HANDLE file, const char* data, size_t length)
+{
+    while (length)
+    {
+        DWORD writeLength = 0;
+        if (!WriteFile(file, data, static_cast<DWORD>(std::min<size_t>(length, MAXDWORD)), &writeLength, nullptr))
+        {
+            return zeus::unexpected(GetLastSystemError());
+        }
+        data += writeLength;
+        length -= writeLength;
+    }
+    return {};
+}
+} // namespace
+
 struct PipeStreamBufferImpl
 {
-    HANDLE pipe;
+    HANDLE                        pipe;
+    BasicStreamBuffer::BufferMode mode;
 };
 PipeStreamBuffer::PipeStreamBuffer(PlatformFileHandle pipe, BasicStreamBuffer::BufferMode mode, size_t bufferSize)
-    : BasicStreamBuffer(mode, bufferSize), _impl(std::make_unique<PipeStreamBufferImpl>())
+    : BasicStreamBuffer(mode, AdaptBufferSize(pipe, bufferSize)), _impl(std::make_unique<PipeStreamBufferImpl>())
 {
     _impl->pipe = pipe;
+    _impl->mode = mode;
 }
 
 PipeStreamBuffer::~PipeStreamBuffer()
 {
 }
 
+PlatformFileHandle PipeStreamBuffer::Handle() const noexcept
+{
+    return _impl->pipe;
+}
+
+zeus::expected<uint64_t, std::error_code> PipeStreamBuffer::TransferTo(PlatformFileHandle out)
+{
+    if (BasicStreamBuffer::BufferMode::Read != _impl->mode || !_impl->pipe || INVALID_HANDLE_VALUE == _impl->pipe)
+    {
+        return zeus::unexpected(std::make_error_code(std::errc::invalid_argument));
+    }
+    uint64_t total = 0;
+    //先写出已经读入缓冲区的数据
+    if (const auto buffered = this->egptr() - this->gptr(); buffered > 0)
+    {
+        if (auto ret = WriteAll(out, this->gptr(), static_cast<size_t>(buffered)); !ret.has_value())
+        {
+            return zeus::unexpected(ret.error());
+        }
+        this->gbump(static_cast<int>(buffered));
+        total += static_cast<uint64_t>(buffered);
+    }
+    //Windows没有对应splice的接口，使用和管道容量一样大的缓冲区读写
+    std::vector<char> buffer(AdaptBufferSize(_impl->pipe, kAutoBufferSize));
+    for (;;)
+    {
+        DWORD readLength = 0;
+        if (!ReadFile(_impl->pipe, buffer.data(), static_cast<DWORD>(buffer.size()), &readLength, nullptr))
+        {
+            //写入端全部关闭
+            if (ERROR_BROKEN_PIPE == GetLastError())
+            {
+                return total;
+            }
+            return zeus::unexpected(GetLastSystemError());
+        }
+        if (auto ret = WriteAll(out, buffer.data(), readLength); !ret.has_value())
+        {
+            return zeus::unexpected(ret.error());
+        }
+        total += readLength;
+    }
+}
+
+zeus::expected<size_t, std::error_code> PipeStreamBuffer::PipeCapacity(PlatformFileHandle pipe)
+{
+    DWORD outBufferSize = 0;
+    DWORD inBufferSize  = 0;
+    if (!GetNamedPipeInfo(pipe, nullptr, &outBufferSize, &inBufferSize, nullptr))
+    {
+        return zeus::unexpected(GetLastSystemError());
+    }
+    return static_cast<size_t>(std::max(outBufferSize, inBufferSize));
+}
+
 int PipeStreamBuffer::WriteDevice(const char_type* buffer, std::size_t length)
 {
     if (_impl->pipe && INVALID_HANDLE_VALUE != _impl->pipe)
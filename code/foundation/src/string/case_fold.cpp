@@ -0,0 +1,368 @@
+﻿#include "zeus/foundation/string/string_utils.h"
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic) 没有c++20，没有std::span可用
+#include <algorithm>
+#include <cwctype>
+#include <type_traits>
+#include "zeus/foundation/byte/bit_utils.h"
+#include "zeus/foundation/hardware/cpu_feature.h"
+#ifdef ZEUS_ARCH_X64
+#include <immintrin.h>
+#endif
+
+namespace zeus
+{
+namespace
+{
+using WideUnit = std::make_unsigned_t<wchar_t>;
+
+//宽字符串的SIMD内核遇到非ASCII字符时停下，标量处理这么多个字符后再回到SIMD，避免中文等文本每个字符都调用一次内核
+constexpr size_t kWideScalarRun = 16;
+
+//SIMD内核只处理能完整装入寄存器的部分，返回消耗的输入长度，剩余部分由标量代码处理
+//first为'A'时转小写，为'a'时转大写
+using FoldBlocksFunction = size_t (*)(const char* input, size_t length, char* output, char first);
+//返回转小写后相同的前缀长度
+using EqualPrefixFunction = size_t (*)(const char* first, const char* second, size_t length);
+
+inline char FoldChar(char character, char first)
+{
+    return static_cast<uint8_t>(static_cast<uint8_t>(character) - static_cast<uint8_t>(first)) < 26 ? static_cast<char>(character ^ 0x20) : character;
+}
+
+inline uint8_t LowerByte(char character)
+{
+    return static_cast<uint8_t>(FoldChar(character, 'A'));
+}
+
+//ASCII范围内直接翻转大小写位，其它字符交给当前locale的towlower/towupper
+inline WideUnit FoldWideUnit(wchar_t character, bool lower)
+{
+    const auto value = static_cast<WideUnit>(character);
+    if (value < 0x80)
+    {
+        return static_cast<WideUnit>(value - (lower ? 'A' : 'a')) < 26 ? static_cast<WideUnit>(value ^ 0x20) : value;
+    }
+    return static_cast<WideUnit>(lower ? std::towlower(static_cast<std::wint_t>(character)) : std::towupper(static_cast<std::wint_t>(character)));
+}
+
+size_t FoldBlocksScalar(const char* input, size_t length, char* output, char first)
+{
+    for (size_t index = 0; index < length; ++index)
+    {
+        output[index] = FoldChar(input[index], first);
+    }
+    return length;
+}
+
+size_t EqualPrefixScalar(const char* first, const char* second, size_t length)
+{
+    for (size_t index = 0; index < length; ++index)
+    {
+        if (LowerByte(first[index]) != LowerByte(second[index]))
+        {
+            return index;
+        }
+    }
+    return length;
+}
+
+#ifdef ZEUS_ARCH_X64
+//加上0x80-first后first..first+25刚好落在有符号的-128..-103，一次有符号比较即可判断是否需要翻转
+inline __m128i FoldSse2(__m128i block, __m128i shift, __m128i limit)
+{
+    const __m128i inRange = _mm_cmplt_epi8(_mm_add_epi8(block, shift), limit);
+    return _mm_xor_si128(block, _mm_and_si128(inRange, _mm_set1_epi8(0x20)));
+}
+
+size_t FoldBlocksSse2(const char* input, size_t length, char* output, char first)
+{
+    const __m128i shift    = _mm_set1_epi8(static_cast<char>(0x80 - first));
+    const __m128i limit    = _mm_set1_epi8(static_cast<char>(0x80 + 26));
+    size_t        consumed = 0;
+    for (; consumed + 16 <= length; consumed += 16)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + consumed));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + consumed), FoldSse2(block, shift, limit));
+    }
+    return consumed + FoldBlocksScalar(input + consumed, length - consumed, output + consumed, first);
+}
+
+size_t EqualPrefixSse2(const char* first, const char* second, size_t length)
+{
+    const __m128i shift    = _mm_set1_epi8(static_cast<char>(0x80 - 'A'));
+    const __m128i limit    = _mm_set1_epi8(static_cast<char>(0x80 + 26));
+    size_t        consumed = 0;
+    for (; consumed + 16 <= length; consumed += 16)
+    {
+        const __m128i left  = FoldSse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(first + consumed)), shift, limit);
+        const __m128i right = FoldSse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(second + consumed)), shift, limit);
+        const auto    equal = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(left, right)));
+        if (0xFFFF != equal)
+        {
+            return consumed + CountRightZero(~equal);
+        }
+    }
+    return consumed + EqualPrefixScalar(first + consumed, second + consumed, length - consumed);
+}
+
+ZEUS_TARGET_AVX2 inline __m256i FoldAvx2(__m256i block, __m256i shift, __m256i limit)
+{
+    const __m256i inRange = _mm256_cmpgt_epi8(limit, _mm256_add_epi8(block, shift));
+    return _mm256_xor_si256(block, _mm256_and_si256(inRange, _mm256_set1_epi8(0x20)));
+}
+
+ZEUS_TARGET_AVX2 size_t FoldBlocksAvx2(const char* input, size_t length, char* output, char first)
+{
+    const __m256i shift    = _mm256_set1_epi8(static_cast<char>(0x80 - first));
+    const __m256i limit    = _mm256_set1_epi8(static_cast<char>(0x80 + 26));
+    size_t        consumed = 0;
+    for (; consumed + 32 <= length; consumed += 32)
+    {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + consumed));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + consumed), FoldAvx2(block, shift, limit));
+    }
+    return consumed + FoldBlocksSse2(input + consumed, length - consumed, output + consumed, first);
+}
+
+ZEUS_TARGET_AVX2 size_t EqualPrefixAvx2(const char* first, const char* second, size_t length)
+{
+    const __m256i shift    = _mm256_set1_epi8(static_cast<char>(0x80 - 'A'));
+    const __m256i limit    = _mm256_set1_epi8(static_cast<char>(0x80 + 26));
+    size_t        consumed = 0;
+    for (; consumed + 32 <= length; consumed += 32)
+    {
+        const __m256i left  = FoldAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + consumed)), shift, limit);
+        const __m256i right = FoldAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(second + consumed)), shift, limit);
+        const auto    equal = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(left, right)));
+        if (0xFFFFFFFF != equal)
+        {
+            return consumed + CountRightZero(~equal);
+        }
+    }
+    return consumed + EqualPrefixSse2(first + consumed, second + consumed, length - consumed);
+}
+
+//wchar_t在Windows上是16位，在Linux上是32位，按宽度选择指令
+inline __m128i WideSet1(int value)
+{
+    if constexpr (2 == sizeof(wchar_t))
+    {
+        return _mm_set1_epi16(static_cast<short>(value));
+    }
+    else
+    {
+        return _mm_set1_epi32(value);
+    }
+}
+
+inline __m128i WideCompareGreater(__m128i left, __m128i right)
+{
+    if constexpr (2 == sizeof(wchar_t))
+    {
+        return _mm_cmpgt_epi16(left, right);
+    }
+    else
+    {
+        return _mm_cmpgt_epi32(left, right);
+    }
+}
+
+inline __m128i WideCompareEqual(__m128i left, __m128i right)
+{
+    if constexpr (2 == sizeof(wchar_t))
+    {
+        return _mm_cmpeq_epi16(left, right);
+    }
+    else
+    {
+        return _mm_cmpeq_epi32(left, right);
+    }
+}
+
+inline bool IsAsciiSse2(__m128i block)
+{
+    return 0xFFFF == _mm_movemask_epi8(WideCompareEqual(_mm_and_si128(block, WideSet1(~0x7F)), _mm_setzero_si128()));
+}
+
+//调用前需要确认block全是ASCII，有符号比较对16位的非ASCII字符不成立
+inline __m128i FoldWideSse2(__m128i block, wchar_t first)
+{
+    const __m128i inRange =
+        _mm_and_si128(WideCompareGreater(block, WideSet1(first - 1)), WideCompareGreater(WideSet1(first + 26), block));
+    return _mm_xor_si128(block, _mm_and_si128(inRange, WideSet1(0x20)));
+}
+
+//只处理全是ASCII的块，遇到非ASCII字符的块时停下
+size_t FoldWideBlocks(const wchar_t* input, size_t length, wchar_t* output, wchar_t first)
+{
+    constexpr size_t kLanes   = 16 / sizeof(wchar_t);
+    size_t           consumed = 0;
+    for (; consumed + kLanes <= length; consumed += kLanes)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + consumed));
+        if (!IsAsciiSse2(block))
+        {
+            break;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + consumed), FoldWideSse2(block, first));
+    }
+    return consumed;
+}
+
+size_t EqualPrefixWide(const wchar_t* first, const wchar_t* second, size_t length)
+{
+    constexpr size_t kLanes   = 16 / sizeof(wchar_t);
+    size_t           consumed = 0;
+    for (; consumed + kLanes <= length; consumed += kLanes)
+    {
+        const __m128i left  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + consumed));
+        const __m128i right = _mm_loadu_si128(reinterpret_cast<const __m128i*>(second + consumed));
+        if (!IsAsciiSse2(_mm_or_si128(left, right)))
+        {
+            break;
+        }
+        const auto equal = static_cast<uint32_t>(_mm_movemask_epi8(WideCompareEqual(FoldWideSse2(left, L'A'), FoldWideSse2(right, L'A'))));
+        if (0xFFFF != equal)
+        {
+            return consumed + CountRightZero(~equal) / sizeof(wchar_t);
+        }
+    }
+    return consumed;
+}
+#else
+size_t FoldWideBlocks(const wchar_t* /*input*/, size_t /*length*/, wchar_t* /*output*/, wchar_t /*first*/)
+{
+    return 0;
+}
+
+size_t EqualPrefixWide(const wchar_t* /*first*/, const wchar_t* /*second*/, size_t /*length*/)
+{
+    return 0;
+}
+#endif
+
+FoldBlocksFunction SelectFoldBlocks()
+{
+#ifdef ZEUS_ARCH_X64
+    if (Hardware::GetCpuFeature().avx2)
+    {
+        return FoldBlocksAvx2;
+    }
+    return FoldBlocksSse2;
+#else
+    return FoldBlocksScalar;
+#endif
+}
+
+EqualPrefixFunction SelectEqualPrefix()
+{
+#ifdef ZEUS_ARCH_X64
+    if (Hardware::GetCpuFeature().avx2)
+    {
+        return EqualPrefixAvx2;
+    }
+    return EqualPrefixSse2;
+#else
+    return EqualPrefixScalar;
+#endif
+}
+
+void FoldNarrow(const char* input, size_t size, char* output, char first)
+{
+    static const FoldBlocksFunction foldBlocks = SelectFoldBlocks();
+    foldBlocks(input, size, output, first);
+}
+
+void FoldWide(const wchar_t* input, size_t size, wchar_t* output, bool lower)
+{
+    size_t index = 0;
+    while (index < size)
+    {
+        index += FoldWideBlocks(input + index, size - index, output + index, lower ? L'A' : L'a');
+        const size_t end = std::min(size, index + kWideScalarRun);
+        for (; index < end; ++index)
+        {
+            output[index] = static_cast<wchar_t>(FoldWideUnit(input[index], lower));
+        }
+    }
+}
+
+int CompareSize(size_t size1, size_t size2)
+{
+    if (size1 == size2)
+    {
+        return 0;
+    }
+    return size1 < size2 ? -1 : 1;
+}
+} // namespace
+
+void ToLower(const char* input, size_t size, char* output)
+{
+    FoldNarrow(input, size, output, 'A');
+}
+void ToLower(const wchar_t* input, size_t size, wchar_t* output)
+{
+    FoldWide(input, size, output, true);
+}
+void ToUpper(const char* input, size_t size, char* output)
+{
+    FoldNarrow(input, size, output, 'a');
+}
+void ToUpper(const wchar_t* input, size_t size, wchar_t* output)
+{
+    FoldWide(input, size, output, false);
+}
+
+int Icompare(std::string_view str1, std::string_view str2)
+{
+    static const EqualPrefixFunction equalPrefix = SelectEqualPrefix();
+
+    const size_t length = std::min(str1.size(), str2.size());
+    const size_t index  = equalPrefix(str1.data(), str2.data(), length);
+    if (index == length)
+    {
+        return CompareSize(str1.size(), str2.size());
+    }
+    return LowerByte(str1[index]) < LowerByte(str2[index]) ? -1 : 1;
+}
+
+int Icompare(std::wstring_view str1, std::wstring_view str2)
+{
+    const size_t length = std::min(str1.size(), str2.size());
+    size_t       index  = 0;
+    while (index < length)
+    {
+        index += EqualPrefixWide(str1.data() + index, str2.data() + index, length - index);
+        const size_t end = std::min(length, index + kWideScalarRun);
+        for (; index < end; ++index)
+        {
+            const auto c1 = FoldWideUnit(str1[index], true);
+            const auto c2 = FoldWideUnit(str2[index], true);
+            if (c1 != c2)
+            {
+                return c1 < c2 ? -1 : 1;
+            }
+        }
+    }
+    return CompareSize(str1.size(), str2.size());
+}
+
+bool IEqual(std::string_view str1, std::string_view str2)
+{
+    if (str1.size() != str2.size())
+    {
+        return false;
+    }
+    return 0 == Icompare(str1, str2);
+}
+bool IEqual(std::wstring_view str1, std::wstring_view str2)
+{
+    if (str1.size() != str2.size())
+    {
+        return false;
+    }
+    return 0 == Icompare(str1, str2);
+}
+} // namespace zeus
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic) 没有c++20，没有std::span可用
@@ -1,66 +1,796 @@
 ﻿// Package: Utils
 
 #include "zeus/foundation/string/charset_utils.h"
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic) 没有c++20，没有std::span可用
 #include <string>
-#include <cctype>
-#include <cassert>
-#include <codecvt>
-#include <locale>
-#include <cwchar>
-#include <memory>
-#include "zeus/foundation/byte/byte_utils.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include "zeus/foundation/hardware/cpu_feature.h"
+#ifdef ZEUS_ARCH_X64
+#include <immintrin.h>
+#endif
 
 using namespace std;
 
 namespace zeus
 {
-
-optional<size_t> CharsetUtils::UTF8CharPrintCount(std::string_view data)
+namespace
+{
+//解码一个码点，返回消耗的字节数，非法时返回0
+inline size_t DecodeUTF8(const uint8_t *input, size_t length, char32_t &codePoint)
 {
-    if (data.empty())
+    const uint8_t lead = input[0];
+    if (lead < 0x80)
+    {
+        codePoint = lead;
+        return 1;
+    }
+    if (lead < 0xC2)
     {
         return 0;
     }
-    size_t totalCount = 0;
-    for (size_t offset = 0; offset < data.size();)
+    if (lead < 0xE0)
+    {
+        if (length < 2 || 0x80 != (input[1] & 0xC0))
+        {
+            return 0;
+        }
+        codePoint = (static_cast<char32_t>(lead & 0x1F) << 6) | (input[1] & 0x3F);
+        return 2;
+    }
+    if (lead < 0xF0)
+    {
+        if (length < 3 || 0x80 != (input[1] & 0xC0) || 0x80 != (input[2] & 0xC0))
+        {
+            return 0;
+        }
+        //过长编码和代理区
+        if ((0xE0 == lead && input[1] < 0xA0) || (0xED == lead && input[1] >= 0xA0))
+        {
+            return 0;
+        }
+        codePoint = (static_cast<char32_t>(lead & 0x0F) << 12) | (static_cast<char32_t>(input[1] & 0x3F) << 6) | (input[2] & 0x3F);
+        return 3;
+    }
+    if (lead < 0xF5)
+    {
+        if (length < 4 || 0x80 != (input[1] & 0xC0) || 0x80 != (input[2] & 0xC0) || 0x80 != (input[3] & 0xC0))
+        {
+            return 0;
+        }
+        //过长编码和超过U+10FFFF
+        if ((0xF0 == lead && input[1] < 0x90) || (0xF4 == lead && input[1] >= 0x90))
+        {
+            return 0;
+        }
+        codePoint = (static_cast<char32_t>(lead & 0x07) << 18) | (static_cast<char32_t>(input[1] & 0x3F) << 12) |
+                    (static_cast<char32_t>(input[2] & 0x3F) << 6) | (input[3] & 0x3F);
+        return 4;
+    }
+    return 0;
+}
+
+inline size_t EncodeUTF8(char32_t codePoint, char *output)
+{
+    if (codePoint < 0x80)
+    {
+        output[0] = static_cast<char>(codePoint);
+        return 1;
+    }
+    if (codePoint < 0x800)
+    {
+        output[0] = static_cast<char>(0xC0 | (codePoint >> 6));
+        output[1] = static_cast<char>(0x80 | (codePoint & 0x3F));
+        return 2;
+    }
+    if (codePoint < 0x10000)
+    {
+        output[0] = static_cast<char>(0xE0 | (codePoint >> 12));
+        output[1] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        output[2] = static_cast<char>(0x80 | (codePoint & 0x3F));
+        return 3;
+    }
+    output[0] = static_cast<char>(0xF0 | (codePoint >> 18));
+    output[1] = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+    output[2] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+    output[3] = static_cast<char>(0x80 | (codePoint & 0x3F));
+    return 4;
+}
+
+//返回第一个非法序列的位置，合法时返回length
+size_t FindInvalidUTF8(const uint8_t *data, size_t length)
+{
+    char32_t codePoint = 0;
+    for (size_t offset = 0; offset < length;)
     {
-        auto *begin = data.data() + offset;
-        if (*begin)
+        const size_t size = DecodeUTF8(data + offset, length - offset, codePoint);
+        if (0 == size)
         {
-            const auto count = CountLeftOne(*reinterpret_cast<const uint8_t *>(begin));
-            if (0 == count)
+            return offset;
+        }
+        offset += size;
+    }
+    return length;
+}
+
+bool ValidateScalar(const uint8_t *data, size_t length)
+{
+    return FindInvalidUTF8(data, length) == length;
+}
+
+//统计时每个字节贡献的编码单元数
+struct CodePointCounter
+{
+    //不是续字节(10xxxxxx)的字节对应一个码点
+    static uint8_t Scalar(uint8_t byte) { return static_cast<int8_t>(byte) > -65 ? 1 : 0; }
+#ifdef ZEUS_ARCH_X64
+    static __m128i                  Sse2(__m128i input) { return _mm_cmpgt_epi8(input, _mm_set1_epi8(-65)); }
+    ZEUS_TARGET_AVX2 static __m256i Avx2(__m256i input) { return _mm256_cmpgt_epi8(input, _mm256_set1_epi8(-65)); }
+#endif
+};
+
+struct PrintCharCounter
+{
+    static uint8_t Scalar(uint8_t byte) { return byte && static_cast<int8_t>(byte) > -65 ? 1 : 0; }
+#ifdef ZEUS_ARCH_X64
+    static __m128i Sse2(__m128i input)
+    {
+        return _mm_andnot_si128(_mm_cmpeq_epi8(input, _mm_setzero_si128()), _mm_cmpgt_epi8(input, _mm_set1_epi8(-65)));
+    }
+    ZEUS_TARGET_AVX2 static __m256i Avx2(__m256i input)
+    {
+        return _mm256_andnot_si256(_mm256_cmpeq_epi8(input, _mm256_setzero_si256()), _mm256_cmpgt_epi8(input, _mm256_set1_epi8(-65)));
+    }
+#endif
+};
+
+//4字节序列在UTF-16中是代理对，需要多一个编码单元
+struct UTF16UnitCounter
+{
+    static uint8_t Scalar(uint8_t byte) { return CodePointCounter::Scalar(byte) + (byte >= 0xF0 ? 1 : 0); }
+#ifdef ZEUS_ARCH_X64
+    static __m128i Sse2(__m128i input)
+    {
+        const __m128i fourByteLead = _mm_and_si128(_mm_cmpgt_epi8(input, _mm_set1_epi8(-17)), _mm_cmplt_epi8(input, _mm_setzero_si128()));
+        return _mm_add_epi8(CodePointCounter::Sse2(input), fourByteLead);
+    }
+    ZEUS_TARGET_AVX2 static __m256i Avx2(__m256i input)
+    {
+        const __m256i fourByteLead =
+            _mm256_and_si256(_mm256_cmpgt_epi8(input, _mm256_set1_epi8(-17)), _mm256_cmpgt_epi8(_mm256_setzero_si256(), input));
+        return _mm256_add_epi8(CodePointCounter::Avx2(input), fourByteLead);
+    }
+#endif
+};
+
+template<typename Counter>
+size_t CountScalar(const uint8_t *data, size_t length)
+{
+    size_t count = 0;
+    for (size_t index = 0; index < length; ++index)
+    {
+        count += Counter::Scalar(data[index]);
+    }
+    return count;
+}
+
+#ifdef ZEUS_ARCH_X64
+//SIMD内核按字节累加到8位计数器中(比较结果为-1，所以用减法)，每个字节最多贡献2，127轮之前汇总一次防止溢出
+constexpr size_t kCountFlushRounds = 127;
+
+template<typename Counter>
+size_t CountSse2(const uint8_t *data, size_t length)
+{
+    size_t  offset = 0;
+    __m128i total  = _mm_setzero_si128();
+    while (offset + 16 <= length)
+    {
+        __m128i counters = _mm_setzero_si128();
+        for (size_t round = 0; round < kCountFlushRounds && offset + 16 <= length; ++round, offset += 16)
+        {
+            counters = _mm_sub_epi8(counters, Counter::Sse2(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + offset))));
+        }
+        total = _mm_add_epi64(total, _mm_sad_epu8(counters, _mm_setzero_si128()));
+    }
+    const size_t count = static_cast<size_t>(_mm_cvtsi128_si64(total) + _mm_cvtsi128_si64(_mm_unpackhi_epi64(total, total)));
+    return count + CountScalar<Counter>(data + offset, length - offset);
+}
+
+template<typename Counter>
+ZEUS_TARGET_AVX2 size_t CountAvx2(const uint8_t *data, size_t length)
+{
+    size_t  offset = 0;
+    __m256i total  = _mm256_setzero_si256();
+    while (offset + 32 <= length)
+    {
+        __m256i counters = _mm256_setzero_si256();
+        for (size_t round = 0; round < kCountFlushRounds && offset + 32 <= length; ++round, offset += 32)
+        {
+            counters = _mm256_sub_epi8(counters, Counter::Avx2(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + offset))));
+        }
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(counters, _mm256_setzero_si256()));
+    }
+    const __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(total), _mm256_extracti128_si256(total, 1));
+    return static_cast<size_t>(_mm_cvtsi128_si64(sum) + _mm_extract_epi64(sum, 1)) + CountSse2<Counter>(data + offset, length - offset);
+}
+
+//Keiser和Lemire的查表法(simdjson/simdutf使用的算法)：用前一个字节的高低4位和当前字节的高4位各查一张表，
+//三者按位与的结果非0说明存在非法的两字节组合，再检查3、4字节序列需要的续字节数量
+constexpr uint8_t kTooShort     = 1 << 0; //11______ 0_______ 或 11______ 11______
+constexpr uint8_t kTooLong      = 1 << 1; //0_______ 10______
+constexpr uint8_t kOverlong3    = 1 << 2; //11100000 100_____
+constexpr uint8_t kTooLarge     = 1 << 3; //11110100 1001____ 等
+constexpr uint8_t kSurrogate    = 1 << 4; //11101101 101_____
+constexpr uint8_t kOverlong2    = 1 << 5; //1100000_ 10______
+constexpr uint8_t kTooLarge1000 = 1 << 6; //11110101 1000____ 等
+constexpr uint8_t kOverlong4    = 1 << 6; //11110000 1000____
+constexpr uint8_t kTwoConts     = 1 << 7; //10______ 10______
+constexpr uint8_t kCarry        = kTooShort | kTooLong | kTwoConts;
+
+alignas(16) constexpr uint8_t kByte1High[16] = {
+    kTooLong,
+    kTooLong,
+    kTooLong,
+    kTooLong,
+    kTooLong,
+    kTooLong,
+    kTooLong,
+    kTooLong,
+    kTwoConts,
+    kTwoConts,
+    kTwoConts,
+    kTwoConts,
+    kTooShort | kOverlong2,
+    kTooShort,
+    kTooShort | kOverlong3 | kSurrogate,
+    kTooShort | kTooLarge | kTooLarge1000 | kOverlong4,
+};
+
+alignas(16) constexpr uint8_t kByte1Low[16] = {
+    kCarry | kOverlong3 | kOverlong2 | kOverlong4,
+    kCarry | kOverlong2,
+    kCarry,
+    kCarry,
+    kCarry | kTooLarge,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000 | kSurrogate,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+};
+
+alignas(16) constexpr uint8_t kByte2High[16] = {
+    kTooShort,
+    kTooShort,
+    kTooShort,
+    kTooShort,
+    kTooShort,
+    kTooShort,
+    kTooShort,
+    kTooShort,
+    kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge1000 | kOverlong4,
+    kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge,
+    kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+    kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+    kTooShort,
+    kTooShort,
+    kTooShort,
+    kTooShort,
+};
+
+//块末尾3个字节中还需要续字节的前导字节
+alignas(32) constexpr uint8_t kIncompleteMax[32] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1,
+};
+
+struct ValidateStateSsse3
+{
+    __m128i error;
+    __m128i prevInput;
+    __m128i prevIncomplete;
+};
+
+ZEUS_TARGET_SSSE3 inline __m128i HighNibble(__m128i input)
+{
+    return _mm_and_si128(_mm_srli_epi16(input, 4), _mm_set1_epi8(0x0F));
+}
+
+ZEUS_TARGET_SSSE3 inline void ValidateBlockSsse3(ValidateStateSsse3 &state, __m128i input)
+{
+    if (0 == _mm_movemask_epi8(input))
+    {
+        state.error          = _mm_or_si128(state.error, state.prevIncomplete);
+        state.prevIncomplete = _mm_setzero_si128();
+        state.prevInput      = input;
+        return;
+    }
+    const __m128i prev1     = _mm_alignr_epi8(input, state.prevInput, 15);
+    const __m128i byte1High = _mm_shuffle_epi8(_mm_load_si128(reinterpret_cast<const __m128i *>(kByte1High)), HighNibble(prev1));
+    const __m128i byte1Low =
+        _mm_shuffle_epi8(_mm_load_si128(reinterpret_cast<const __m128i *>(kByte1Low)), _mm_and_si128(prev1, _mm_set1_epi8(0x0F)));
+    const __m128i byte2High = _mm_shuffle_epi8(_mm_load_si128(reinterpret_cast<const __m128i *>(kByte2High)), HighNibble(input));
+    const __m128i special   = _mm_and_si128(_mm_and_si128(byte1High, byte1Low), byte2High);
+
+    const __m128i prev2     = _mm_alignr_epi8(input, state.prevInput, 14);
+    const __m128i prev3     = _mm_alignr_epi8(input, state.prevInput, 13);
+    const __m128i third     = _mm_subs_epu8(prev2, _mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+    const __m128i fourth    = _mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+    const __m128i must23    = _mm_and_si128(_mm_or_si128(third, fourth), _mm_set1_epi8(static_cast<char>(0x80)));
+    state.error             = _mm_or_si128(state.error, _mm_xor_si128(must23, special));
+    state.prevIncomplete    = _mm_subs_epu8(input, _mm_loadu_si128(reinterpret_cast<const __m128i *>(kIncompleteMax + 16)));
+    state.prevInput         = input;
+}
+
+ZEUS_TARGET_SSSE3 bool ValidateSsse3(const uint8_t *data, size_t length)
+{
+    ValidateStateSsse3 state {_mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128()};
+    size_t             offset = 0;
+    for (; offset + 16 <= length; offset += 16)
+    {
+        ValidateBlockSsse3(state, _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + offset)));
+    }
+    if (offset < length)
+    {
+        //补0凑满一个块，0是ASCII，不会掩盖末尾被截断的序列
+        uint8_t tail[16] = {};
+        std::memcpy(tail, data + offset, length - offset);
+        ValidateBlockSsse3(state, _mm_loadu_si128(reinterpret_cast<const __m128i *>(tail)));
+    }
+    const __m128i error = _mm_or_si128(state.error, state.prevIncomplete);
+    return 0xFFFF == _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128()));
+}
+
+struct ValidateStateAvx2
+{
+    __m256i error;
+    __m256i prevInput;
+    __m256i prevIncomplete;
+};
+
+ZEUS_TARGET_AVX2 inline __m256i HighNibble(__m256i input)
+{
+    return _mm256_and_si256(_mm256_srli_epi16(input, 4), _mm256_set1_epi8(0x0F));
+}
+
+ZEUS_TARGET_AVX2 inline __m256i LoadTable(const uint8_t *table)
+{
+    return _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i *>(table)));
+}
+
+ZEUS_TARGET_AVX2 inline void ValidateBlockAvx2(ValidateStateAvx2 &state, __m256i input)
+{
+    if (0 == _mm256_movemask_epi8(input))
+    {
+        state.error          = _mm256_or_si256(state.error, state.prevIncomplete);
+        state.prevIncomplete = _mm256_setzero_si256();
+        state.prevInput      = input;
+        return;
+    }
+    //alignr按128位通道工作，先拼出跨通道的前一个块
+    const __m256i previous  = _mm256_permute2x128_si256(state.prevInput, input, 0x21);
+    const __m256i prev1     = _mm256_alignr_epi8(input, previous, 15);
+    const __m256i byte1High = _mm256_shuffle_epi8(LoadTable(kByte1High), HighNibble(prev1));
+    const __m256i byte1Low  = _mm256_shuffle_epi8(LoadTable(kByte1Low), _mm256_and_si256(prev1, _mm256_set1_epi8(0x0F)));
+    const __m256i byte2High = _mm256_shuffle_epi8(LoadTable(kByte2High), HighNibble(input));
+    const __m256i special   = _mm256_and_si256(_mm256_and_si256(byte1High, byte1Low), byte2High);
+
+    const __m256i prev2  = _mm256_alignr_epi8(input, previous, 14);
+    const __m256i prev3  = _mm256_alignr_epi8(input, previous, 13);
+    const __m256i third  = _mm256_subs_epu8(prev2, _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+    const __m256i fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+    const __m256i must23 = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+    state.error          = _mm256_or_si256(state.error, _mm256_xor_si256(must23, special));
+    state.prevIncomplete = _mm256_subs_epu8(input, _mm256_load_si256(reinterpret_cast<const __m256i *>(kIncompleteMax)));
+    state.prevInput      = input;
+}
+
+ZEUS_TARGET_AVX2 bool ValidateAvx2(const uint8_t *data, size_t length)
+{
+    ValidateStateAvx2 state {_mm256_setzero_si256(), _mm256_setzero_si256(), _mm256_setzero_si256()};
+    size_t            offset = 0;
+    for (; offset + 32 <= length; offset += 32)
+    {
+        ValidateBlockAvx2(state, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + offset)));
+    }
+    if (offset < length)
+    {
+        uint8_t tail[32] = {};
+        std::memcpy(tail, data + offset, length - offset);
+        ValidateBlockAvx2(state, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(tail)));
+    }
+    const __m256i error = _mm256_or_si256(state.error, state.prevIncomplete);
+    return _mm256_testz_si256(error, error);
+}
+
+//ASCII快速路径：SSE2是x64的基础指令集，不需要运行时检测
+inline size_t WidenAsciiSse2(const uint8_t *input, size_t length, char16_t *output)
+{
+    size_t offset = 0;
+    for (; offset + 16 <= length; offset += 16)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input + offset));
+        if (_mm_movemask_epi8(block))
+        {
+            break;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(output + offset), _mm_unpacklo_epi8(block, _mm_setzero_si128()));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(output + offset + 8), _mm_unpackhi_epi8(block, _mm_setzero_si128()));
+    }
+    return offset;
+}
+
+inline size_t WidenAsciiSse2(const uint8_t *input, size_t length, char32_t *output)
+{
+    size_t offset = 0;
+    for (; offset + 16 <= length; offset += 16)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input + offset));
+        if (_mm_movemask_epi8(block))
+        {
+            break;
+        }
+        const __m128i low  = _mm_unpacklo_epi8(block, _mm_setzero_si128());
+        const __m128i high = _mm_unpackhi_epi8(block, _mm_setzero_si128());
+        auto         *out  = reinterpret_cast<__m128i *>(output + offset);
+        _mm_storeu_si128(out, _mm_unpacklo_epi16(low, _mm_setzero_si128()));
+        _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(low, _mm_setzero_si128()));
+        _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(high, _mm_setzero_si128()));
+        _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(high, _mm_setzero_si128()));
+    }
+    return offset;
+}
+
+inline size_t NarrowAsciiSse2(const char16_t *input, size_t length, char *output)
+{
+    const __m128i mask   = _mm_set1_epi16(static_cast<short>(0xFF80));
+    size_t        offset = 0;
+    for (; offset + 16 <= length; offset += 16)
+    {
+        const __m128i first  = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input + offset));
+        const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i *>(input + offset + 8));
+        const __m128i high   = _mm_and_si128(_mm_or_si128(first, second), mask);
+        if (0xFFFF != _mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128())))
+        {
+            break;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(output + offset), _mm_packus_epi16(first, second));
+    }
+    return offset;
+}
+
+inline size_t NarrowAsciiSse2(const char32_t *input, size_t length, char *output)
+{
+    const __m128i mask   = _mm_set1_epi32(static_cast<int>(0xFFFFFF80));
+    size_t        offset = 0;
+    for (; offset + 16 <= length; offset += 16)
+    {
+        const auto   *in     = reinterpret_cast<const __m128i *>(input + offset);
+        const __m128i first  = _mm_loadu_si128(in);
+        const __m128i second = _mm_loadu_si128(in + 1);
+        const __m128i third  = _mm_loadu_si128(in + 2);
+        const __m128i fourth = _mm_loadu_si128(in + 3);
+        const __m128i high   = _mm_and_si128(_mm_or_si128(_mm_or_si128(first, second), _mm_or_si128(third, fourth)), mask);
+        if (0xFFFF != _mm_movemask_epi8(_mm_cmpeq_epi32(high, _mm_setzero_si128())))
+        {
+            break;
+        }
+        const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(first, second), _mm_packs_epi32(third, fourth));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(output + offset), packed);
+    }
+    return offset;
+}
+#endif
+
+template<typename Unit>
+size_t WidenAscii(const uint8_t *input, size_t length, Unit *output)
+{
+#ifdef ZEUS_ARCH_X64
+    return WidenAsciiSse2(input, length, output);
+#else
+    return 0;
+#endif
+}
+
+template<typename Unit>
+size_t NarrowAscii(const Unit *input, size_t length, char *output)
+{
+#ifdef ZEUS_ARCH_X64
+    return NarrowAsciiSse2(input, length, output);
+#else
+    return 0;
+#endif
+}
+
+using ValidateFunction = bool (*)(const uint8_t *data, size_t length);
+template<typename Counter>
+using CountFunction = size_t (*)(const uint8_t *data, size_t length);
+
+ValidateFunction SelectValidate()
+{
+#ifdef ZEUS_ARCH_X64
+    const auto &feature = Hardware::GetCpuFeature();
+    if (feature.avx2)
+    {
+        return ValidateAvx2;
+    }
+    if (feature.ssse3)
+    {
+        return ValidateSsse3;
+    }
+#endif
+    return ValidateScalar;
+}
+
+template<typename Counter>
+CountFunction<Counter> SelectCount()
+{
+#ifdef ZEUS_ARCH_X64
+    if (Hardware::GetCpuFeature().avx2)
+    {
+        return CountAvx2<Counter>;
+    }
+    return CountSse2<Counter>;
+#else
+    return CountScalar<Counter>;
+#endif
+}
+
+bool Validate(std::string_view data)
+{
+    static const ValidateFunction validate = SelectValidate();
+    return validate(reinterpret_cast<const uint8_t *>(data.data()), data.size());
+}
+
+template<typename Counter>
+size_t Count(std::string_view data)
+{
+    static const CountFunction<Counter> count = SelectCount<Counter>();
+    return count(reinterpret_cast<const uint8_t *>(data.data()), data.size());
+}
+
+//UTF-8解码，ASCII块批量展开，遇到非ASCII块时逐个码点解码，处理完这个块再尝试快速路径
+template<typename Unit, typename Store>
+zeus::expected<size_t, CharsetUtils::TranscodeError> DecodeUTF8To(std::string_view source, Unit *output, Store store)
+{
+    const auto  *input   = reinterpret_cast<const uint8_t *>(source.data());
+    const size_t length  = source.size();
+    size_t       offset  = 0;
+    Unit        *current = output;
+    while (offset < length)
+    {
+        const size_t ascii = WidenAscii(input + offset, length - offset, current);
+        offset += ascii;
+        current += ascii;
+        const size_t blockEnd = std::min(offset + 16, length);
+        while (offset < blockEnd)
+        {
+            char32_t     codePoint = 0;
+            const size_t size      = DecodeUTF8(input + offset, length - offset, codePoint);
+            if (0 == size)
+            {
+                return zeus::unexpected(CharsetUtils::TranscodeError {offset});
+            }
+            current = store(current, codePoint);
+            offset += size;
+        }
+    }
+    return static_cast<size_t>(current - output);
+}
+
+template<typename Unit, typename Load>
+zeus::expected<size_t, CharsetUtils::TranscodeError> EncodeUTF8From(const Unit *input, size_t length, char *output, Load load)
+{
+    size_t offset  = 0;
+    char  *current = output;
+    while (offset < length)
+    {
+        const size_t ascii = NarrowAscii(input + offset, length - offset, current);
+        offset += ascii;
+        current += ascii;
+        const size_t blockEnd = std::min(offset + 16, length);
+        while (offset < blockEnd)
+        {
+            char32_t     codePoint = 0;
+            const size_t size      = load(input + offset, length - offset, codePoint);
+            if (0 == size)
             {
-                ++totalCount;
-                offset += 1;
+                return zeus::unexpected(CharsetUtils::TranscodeError {offset});
             }
-            else if (count >= 2)
+            current += EncodeUTF8(codePoint, current);
+            offset += size;
+        }
+    }
+    return static_cast<size_t>(current - output);
+}
+
+template<typename Char, typename Unit, typename Transcode>
+std::basic_string<Char> TranscodeToString(const Unit *input, size_t length, size_t outputLength, Transcode transcode)
+{
+    std::basic_string<Char> result(outputLength, Char());
+    auto                    size = transcode(input, length, result.data());
+    if (!size.has_value())
+    {
+        throw std::range_error("invalid unicode string at " + std::to_string(size.error().offset));
+    }
+    result.resize(*size);
+    return result;
+}
+} // namespace
+
+optional<size_t> CharsetUtils::UTF8CharPrintCount(std::string_view data)
+{
+    if (!Validate(data))
+    {
+        return nullopt;
+    }
+    return Count<PrintCharCounter>(data);
+}
+
+std::string CharsetUtils::UnicodeToUTF8(std::wstring_view source)
+{
+    if constexpr (sizeof(wchar_t) == sizeof(char16_t))
+    {
+        const std::u16string_view view(reinterpret_cast<const char16_t *>(source.data()), source.size());
+        return TranscodeToString<char>(
+            view.data(), view.size(), UTF8LengthFromUTF16(view),
+            [](const char16_t *input, size_t length, char *output) { return UTF16ToUTF8(std::u16string_view(input, length), output); }
+        );
+    }
+    else
+    {
+        const std::u32string_view view(reinterpret_cast<const char32_t *>(source.data()), source.size());
+        return TranscodeToString<char>(
+            view.data(), view.size(), UTF8LengthFromUTF32(view),
+            [](const char32_t *input, size_t length, char *output) { return UTF32ToUTF8(std::u32string_view(input, length), output); }
+        );
+    }
+}
+
+std::wstring CharsetUtils::UTF8ToUnicode(std::string_view source)
+{
+    if constexpr (sizeof(wchar_t) == sizeof(char16_t))
+    {
+        return TranscodeToString<wchar_t>(
+            source.data(), source.size(), UTF16LengthFromUTF8(source),
+            [](const char *input, size_t length, wchar_t *output)
+            { return UTF8ToUTF16(std::string_view(input, length), reinterpret_cast<char16_t *>(output)); }
+        );
+    }
+    else
+    {
+        return TranscodeToString<wchar_t>(
+            source.data(), source.size(), UTF32LengthFromUTF8(source),
+            [](const char *input, size_t length, wchar_t *output)
+            { return UTF8ToUTF32(std::string_view(input, length), reinterpret_cast<char32_t *>(output)); }
+        );
+    }
+}
+
+bool CharsetUtils::IsValidUTF8(std::string_view data) noexcept
+{
+    return Validate(data);
+}
+
+zeus::expected<size_t, CharsetUtils::TranscodeError> CharsetUtils::UTF8CodePointCount(std::string_view data) noexcept
+{
+    if (!Validate(data))
+    {
+        //只在出错时逐字节查找出错位置
+        return zeus::unexpected(TranscodeError {FindInvalidUTF8(reinterpret_cast<const uint8_t *>(data.data()), data.size())});
+    }
+    return Count<CodePointCounter>(data);
+}
+
+size_t CharsetUtils::UTF16LengthFromUTF8(std::string_view data) noexcept
+{
+    return Count<UTF16UnitCounter>(data);
+}
+
+size_t CharsetUtils::UTF32LengthFromUTF8(std::string_view data) noexcept
+{
+    return Count<CodePointCounter>(data);
+}
+
+size_t CharsetUtils::UTF8LengthFromUTF16(std::u16string_view data) noexcept
+{
+    //无分支的写法，编译器可以自动向量化；代理对的两个编码单元各计2字节
+    size_t length = 0;
+    for (const char16_t unit : data)
+    {
+        const bool surrogate = 0xD800 == (unit & 0xF800);
+        length += 1 + (unit >= 0x80) + (unit >= 0x800) - surrogate;
+    }
+    return length;
+}
+
+size_t CharsetUtils::UTF8LengthFromUTF32(std::u32string_view data) noexcept
+{
+    size_t length = 0;
+    for (const char32_t unit : data)
+    {
+        length += 1 + (unit >= 0x80) + (unit >= 0x800) + (unit >= 0x10000);
+    }
+    return length;
+}
+
+zeus::expected<size_t, CharsetUtils::TranscodeError> CharsetUtils::UTF8ToUTF16(std::string_view source, char16_t *output) noexcept
+{
+    return DecodeUTF8To(
+        source, output,
+        [](char16_t *current, char32_t codePoint)
+        {
+            if (codePoint < 0x10000)
             {
-                ++totalCount;
-                offset += count;
+                *current++ = static_cast<char16_t>(codePoint);
             }
             else
             {
-                return nullopt;
+                codePoint -= 0x10000;
+                *current++ = static_cast<char16_t>(0xD800 + (codePoint >> 10));
+                *current++ = static_cast<char16_t>(0xDC00 + (codePoint & 0x3FF));
             }
+            return current;
         }
-        else
+    );
+}
+
+zeus::expected<size_t, CharsetUtils::TranscodeError> CharsetUtils::UTF8ToUTF32(std::string_view source, char32_t *output) noexcept
+{
+    return DecodeUTF8To(
+        source, output,
+        [](char32_t *current, char32_t codePoint)
         {
-            ++offset;
+            *current++ = codePoint;
+            return current;
         }
-    }
-    return totalCount;
+    );
 }
 
-std::string CharsetUtils::UnicodeToUTF8(std::wstring_view source)
+zeus::expected<size_t, CharsetUtils::TranscodeError> CharsetUtils::UTF16ToUTF8(std::u16string_view source, char *output) noexcept
 {
-    wstring_convert<codecvt_utf8<wchar_t>> cv("");
-    return cv.to_bytes(source.data(), source.data() + source.size());
+    return EncodeUTF8From(
+        source.data(), source.size(), output,
+        [](const char16_t *input, size_t length, char32_t &codePoint) -> size_t
+        {
+            const char16_t unit = input[0];
+            if (0xD800 != (unit & 0xF800))
+            {
+                codePoint = unit;
+                return 1;
+            }
+            //必须是高代理后跟低代理
+            if (unit >= 0xDC00 || length < 2 || 0xDC00 != (input[1] & 0xFC00))
+            {
+                return 0;
+            }
+            codePoint = 0x10000 + ((static_cast<char32_t>(unit - 0xD800) << 10) | (input[1] - 0xDC00));
+            return 2;
+        }
+    );
 }
 
-std::wstring CharsetUtils::UTF8ToUnicode(std::string_view source)
+zeus::expected<size_t, CharsetUtils::TranscodeError> CharsetUtils::UTF32ToUTF8(std::u32string_view source, char *output) noexcept
 {
-    wstring_convert<codecvt_utf8<wchar_t>> cv("");
-    return cv.from_bytes(source.data(), source.data() + source.size());
+    return EncodeUTF8From(
+        source.data(), source.size(), output,
+        [](const char32_t *input, size_t /*length*/, char32_t &codePoint) -> size_t
+        {
+            codePoint = input[0];
+            if (codePoint > 0x10FFFF || 0xD800 == (codePoint & 0xFFFFF800))
+            {
+                return 0;
+            }
+            return 1;
+        }
+    );
 }
-
 } // namespace zeus
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic) 没有c++20，没有std::span可用
@@ -0,0 +1,130 @@
+﻿#include "zeus/foundation/string/string_pool.h"
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic) 没有c++20，没有std::span可用
+#include <algorithm>
+#include <cstring>
+
+namespace zeus
+{
+StringPool::StringPool(size_t blockSize) : _blockSize(std::max<size_t>(blockSize, 64))
+{
+}
+
+StringPool::~StringPool() = default;
+
+StringPool::StringPool(StringPool&& other) noexcept
+    : _blocks(std::move(other._blocks)), _interned(std::move(other._interned)), _cursor(other._cursor), _remaining(other._remaining),
+      _blockSize(other._blockSize), _used(other._used), _reserved(other._reserved)
+{
+    other._blocks.clear();
+    other._interned.clear();
+    other._cursor    = nullptr;
+    other._remaining = 0;
+    other._used      = 0;
+    other._reserved  = 0;
+}
+
+StringPool& StringPool::operator=(StringPool&& other) noexcept
+{
+    if (this != &other)
+    {
+        _blocks          = std::move(other._blocks);
+        _interned        = std::move(other._interned);
+        _cursor          = other._cursor;
+        _remaining       = other._remaining;
+        _blockSize       = other._blockSize;
+        _used            = other._used;
+        _reserved        = other._reserved;
+        other._blocks.clear();
+        other._interned.clear();
+        other._cursor    = nullptr;
+        other._remaining = 0;
+        other._used      = 0;
+        other._reserved  = 0;
+    }
+    return *this;
+}
+
+std::string_view StringPool::Store(std::string_view value)
+{
+    char* data = Allocate(value.size() + 1);
+    if (!value.empty())
+    {
+        std::memcpy(data, value.data(), value.size());
+    }
+    data[value.size()] = '\0';
+    return {data, value.size()};
+}
+
+std::string_view StringPool::Intern(std::string_view value)
+{
+    auto iter = _interned.find(value);
+    if (iter != _interned.end())
+    {
+        return *iter;
+    }
+    const auto stored = Store(value);
+    _interned.emplace(stored);
+    return stored;
+}
+
+std::optional<std::string_view> StringPool::Find(std::string_view value) const
+{
+    auto iter = _interned.find(value);
+    if (iter != _interned.end())
+    {
+        return *iter;
+    }
+    return std::nullopt;
+}
+
+void StringPool::Clear() noexcept
+{
+    _interned.clear();
+    _used = 0;
+    //单独分配的大块不留
+    auto iter = std::find_if(_blocks.begin(), _blocks.end(), [this](const Block& block) { return block.size == _blockSize; });
+    if (iter == _blocks.end())
+    {
+        _blocks.clear();
+        _cursor    = nullptr;
+        _remaining = 0;
+        _reserved  = 0;
+        return;
+    }
+    Block block = std::move(*iter);
+    _blocks.clear();
+    _cursor    = block.data.get();
+    _remaining = block.size;
+    _reserved  = block.size;
+    _blocks.emplace_back(std::move(block));
+}
+
+char* StringPool::Allocate(size_t size)
+{
+    _used += size;
+    if (size <= _remaining)
+    {
+        char* data = _cursor;
+        _cursor += size;
+        _remaining -= size;
+        return data;
+    }
+    //大字符串单独分配，不浪费当前块的剩余空间
+    if (size > _blockSize / 4)
+    {
+        Block block {std::make_unique<char[]>(size), size};
+        char* data = block.data.get();
+        _reserved += size;
+        _blocks.emplace_back(std::move(block));
+        return data;
+    }
+    Block block {std::make_unique<char[]>(_blockSize), _blockSize};
+    _cursor    = block.data.get() + size;
+    _remaining = _blockSize - size;
+    _reserved += _blockSize;
+    char* data = block.data.get();
+    _blocks.emplace_back(std::move(block));
+    return data;
+}
+} // namespace zeus
+// NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic) 没有c++20，没有std::span可用
@@ -7,6 +7,9 @@
 #include <cassert>
 #include <fmt/format.h>
 #include "zeus/foundation/byte/byte_utils.h"
+#include "zeus/foundation/byte/byte_searcher.h"
+#include "zeus/foundation/byte/hex.h"
+#include "zeus/foundation/string/split_iterator.hpp"
 
 namespace zeus
 {
@@ -85,92 +88,10 @@ std::wstring Trim(std::wstring_view str)
     return std::wstring(TrimView(str));
 }
 
-int Icompare(std::string_view str1, std::string_view str2)
-{
-    auto begin1(str1.begin());
-    auto end1(str1.end());
-    auto begin2(str2.begin());
-    auto end2(str2.end());
-    while (begin1 != end1 && begin2 != end2)
-    {
-        auto c1 = std::tolower(*begin1);
-        auto c2 = std::tolower(*begin2);
-        if (c1 < c2)
-        {
-            return -1;
-        }
-        else if (c1 > c2)
-        {
-            return 1;
-        }
-        ++begin1;
-        ++begin2;
-    }
-
-    if (begin1 == end1)
-    {
-        return begin2 == end2 ? 0 : -1;
-    }
-    else
-    {
-        return 1;
-    }
-}
-
-int Icompare(std::wstring_view str1, std::wstring_view str2)
-{
-    auto begin1(str1.begin());
-    auto end1(str1.end());
-    auto begin2(str2.begin());
-    auto end2(str2.end());
-    while (begin1 != end1 && begin2 != end2)
-    {
-        auto c1 = std::tolower(*begin1);
-        auto c2 = std::tolower(*begin2);
-        if (c1 < c2)
-        {
-            return -1;
-        }
-        else if (c1 > c2)
-        {
-            return 1;
-        }
-        ++begin1;
-        ++begin2;
-    }
-
-    if (begin1 == end1)
-    {
-        return begin2 == end2 ? 0 : -1;
-    }
-    else
-    {
-        return 1;
-    }
-}
-
-bool IEqual(std::string_view str1, std::string_view str2)
-{
-    if (str1.size() != str2.size())
-    {
-        return false;
-    }
-    return 0 == Icompare(str1, str2);
-}
-bool IEqual(std::wstring_view str1, std::wstring_view str2)
-{
-    if (str1.size() != str2.size())
-    {
-        return false;
-    }
-    return 0 == Icompare(str1, str2);
-}
 std::vector<std::string> Split(std::string_view str, std::string_view delim)
 {
     std::vector<std::string> result;
-    auto                     view = SplitView(str, delim);
-    result.reserve(view.size());
-    for (const auto item : view)
+    for (const auto item : Splitter(str, delim))
     {
         result.emplace_back(item);
     }
@@ -179,9 +100,7 @@ std::vector<std::string> Split(std::string_view str, std::string_view delim)
 std::vector<std::wstring> Split(std::wstring_view str, std::wstring_view delim)
 {
     std::vector<std::wstring> result;
-    auto                      view = SplitView(str, delim);
-    result.reserve(view.size());
-    for (const auto item : view)
+    for (const auto item : WSplitter(str, delim))
     {
         result.emplace_back(item);
     }
@@ -191,20 +110,9 @@ std::vector<std::wstring> Split(std::wstring_view str, std::wstring_view delim)
 std::vector<std::string_view> SplitView(std::string_view str, std::string_view delim)
 {
     std::vector<std::string_view> result;
-    size_t                        offset     = 0;
-    size_t                        findOffset = 0;
-    while ((findOffset = str.find(delim, offset)) != std::string::npos)
+    for (const auto item : Splitter(str, delim))
     {
-        if (findOffset != offset)
-        {
-            std::string_view item = str.substr(offset, findOffset - offset);
-            result.emplace_back(std::move(item));
-        }
-        offset = findOffset + delim.size();
-    }
-    if (offset < str.size())
-    {
-        result.emplace_back(std::move(str.substr(offset, std::string::npos)));
+        result.emplace_back(item);
     }
     return result;
 }
@@ -212,20 +120,9 @@ std::vector<std::string_view> SplitView(std::string_view str, std::string_view d
 std::vector<std::wstring_view> SplitView(std::wstring_view str, std::wstring_view delim)
 {
     std::vector<std::wstring_view> result;
-    size_t                         offset     = 0;
-    size_t                         findOffset = 0;
-    while ((findOffset = str.find(delim, offset)) != std::wstring::npos)
+    for (const auto item : WSplitter(str, delim))
     {
-        if (findOffset != offset)
-        {
-            std::wstring_view item = str.substr(offset, findOffset - offset);
-            result.emplace_back(std::move(item));
-        }
-        offset = findOffset + delim.size();
-    }
-    if (offset < str.size())
-    {
-        result.emplace_back(std::move(str.substr(offset, std::wstring::npos)));
+        result.emplace_back(item);
     }
     return result;
 }
@@ -350,31 +247,59 @@ std::wstring JoinView(const std::vector<std::wstring_view>& strs, std::wstring_v
 
 std::string Replace(std::string_view src, std::string_view substr, std::string_view replacement)
 {
-    std::string                  result(src);
-    std::string::size_type       pos            = 0;
-    const std::string::size_type srcLen         = substr.size();
-    const std::string::size_type replacementLen = replacement.size();
-    pos                                         = result.find(substr, pos);
-    while ((pos != std::string::npos))
+    return Replace(src, ByteSearcher(substr), replacement);
+}
+
+std::wstring Replace(std::wstring_view src, std::wstring_view substr, std::wstring_view replacement)
+{
+    std::wstring result;
+    if (substr.empty())
+    {
+        return std::wstring(src);
+    }
+    result.reserve(src.size());
+    size_t offset = 0;
+    for (auto pos = src.find(substr); std::wstring_view::npos != pos; pos = src.find(substr, offset))
     {
-        result.replace(pos, srcLen, replacement);
-        pos = result.find(substr, (pos + replacementLen));
+        result.append(src.substr(offset, pos - offset));
+        result.append(replacement);
+        offset = pos + substr.size();
     }
+    result.append(src.substr(offset));
     return result;
 }
 
-std::wstring Replace(std::wstring_view src, std::wstring_view substr, std::wstring_view replacement)
+std::string Replace(std::string_view src, const ByteSearcher& substr, std::string_view replacement)
 {
-    std::wstring                  result(src);
-    std::wstring::size_type       pos            = 0;
-    const std::wstring::size_type srcLen         = substr.size();
-    const std::wstring::size_type replacementLen = replacement.size();
-    pos                                          = result.find(substr, pos);
-    while ((pos != std::wstring::npos))
+    std::string result;
+    if (!substr.Size())
     {
-        result.replace(pos, srcLen, replacement);
-        pos = result.find(substr, (pos + replacementLen));
+        return std::string(src);
     }
+    result.reserve(src.size());
+    size_t offset = 0;
+    for (auto pos = substr.Find(src); ByteSearcher::npos != pos; pos = substr.Find(src, offset))
+    {
+        result.append(src.substr(offset, pos - offset));
+        result.append(replacement);
+        offset = pos + substr.Size();
+    }
+    result.append(src.substr(offset));
+    return result;
+}
+
+std::string Replace(std::string_view src, const ByteMultiSearcher& patterns, const std::vector<std::string_view>& replacements)
+{
+    assert(replacements.size() == patterns.PatternCount());
+    std::string result;
+    size_t      offset = 0;
+    for (const auto& match : patterns.FindAll(src))
+    {
+        result.append(src.substr(offset, match.offset - offset));
+        result.append(replacements[match.pattern]);
+        offset = match.offset + match.length;
+    }
+    result.append(src.substr(offset));
     return result;
 }
 
@@ -432,61 +357,47 @@ bool StartWith(std::wstring_view str, std::wstring_view start)
 }
 std::string ToLowerCopy(std::string_view str)
 {
-    std::string result(str);
-    std::transform(str.begin(), str.end(), result.begin(), [](unsigned char c) { return std::tolower(c); });
+    std::string result(str.size(), '\0');
+    ToLower(str.data(), str.size(), result.data());
     return result;
 }
 std::wstring ToLowerCopy(std::wstring_view str)
 {
-    std::wstring result(str);
-    std::transform(str.begin(), str.end(), result.begin(), [](wchar_t c) { return std::tolower(c); });
+    std::wstring result(str.size(), L'\0');
+    ToLower(str.data(), str.size(), result.data());
     return result;
 }
 std::string ToUpperCopy(std::string_view str)
 {
-    std::string result(str);
-    std::transform(str.begin(), str.end(), result.begin(), [](unsigned char c) { return std::toupper(c); });
+    std::string result(str.size(), '\0');
+    ToUpper(str.data(), str.size(), result.data());
     return result;
 }
 std::wstring ToUpperCopy(std::wstring_view str)
 {
-    std::wstring result(str);
-    std::transform(str.begin(), str.end(), result.begin(), [](wchar_t c) { return std::toupper(c); });
+    std::wstring result(str.size(), L'\0');
+    ToUpper(str.data(), str.size(), result.data());
     return result;
 }
 void ToLower(std::string& str)
 {
-    std::transform(str.begin(), str.end(), str.begin(), [](unsigned char c) { return std::tolower(c); });
+    ToLower(str.data(), str.size(), str.data());
 }
 void ToLower(std::wstring& str)
 {
-    std::transform(str.begin(), str.end(), str.begin(), [](wchar_t c) { return std::tolower(c); });
+    ToLower(str.data(), str.size(), str.data());
 }
 void ToUpper(std::string& str)
 {
-    std::transform(str.begin(), str.end(), str.begin(), [](unsigned char c) { return std::toupper(c); });
+    ToUpper(str.data(), str.size(), str.data());
 }
 void ToUpper(std::wstring& str)
 {
-    std::transform(str.begin(), str.end(), str.begin(), [](wchar_t c) { return std::toupper(c); });
+    ToUpper(str.data(), str.size(), str.data());
 }
 std::string BytesToHexString(const void* input, size_t length, bool upCase)
 {
-    static const char UP_HEX[16]  = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'};
-    static const char LOW_HEX[16] = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
-    const char*       hex         = upCase ? UP_HEX : LOW_HEX;
-
-    std::string str;
-    str.reserve(length << 1);
-    for (size_t i = 0; i < length; i++)
-    {
-        int t = reinterpret_cast<const uint8_t*>(input)[i];
-        int a = t / 16;
-        int b = t % 16;
-        str.append(1, hex[a]);
-        str.append(1, hex[b]);
-    }
-    return str;
+    return Hex::Encode(input, length, upCase);
 }
 std::string IntToHexString(uint32_t integer, bool upCase)
 {
@@ -363,6 +363,16 @@ std::ostream& ChildProcess::GetStdin()
     return *_impl->stdinWriteStream;
 }
 
+PipeStreamBuffer& ChildProcess::GetStdoutBuffer()
+{
+    return *_impl->stdoutReadBuffer;
+}
+
+PipeStreamBuffer& ChildProcess::GetStderrBuffer()
+{
+    return *_impl->stderrReadBuffer;
+}
+
 zeus::expected<ChildProcess, std::error_code> ChildProcessExecutor::ExecuteScript(std::string_view script, const std::vector<std::string>& args)
 {
     std::vector<std::string> cmdArgs;
@@ -5,11 +5,24 @@
 #include <algorithm>
 #include <sys/utsname.h>
 #include "zeus/foundation/string/string_utils.h"
-#include "zeus/foundation/file/kv_file_utils.h"
+#include "zeus/foundation/file/parsed_file_cache.h"
 #include "zeus/foundation/time/time_utils.h"
 
 namespace zeus::OS
 {
+namespace
+{
+//lsb-release很少变化，多次查询使用缓存的解析结果
+std::string LsbReleaseValue(std::string_view key)
+{
+    auto values = ParsedFileCache::Instance().GetKVValues("/etc/lsb-release", {key});
+    if (values.has_value() && values->front().has_value())
+    {
+        return values->front().value();
+    }
+    return std::string();
+}
+} // namespace
 
 std::string OsKernelName()
 {
@@ -20,7 +33,7 @@ std::string OsKernelName()
 
 std::string OsDisplayName()
 {
-    return GetKVFileValue("/etc/lsb-release", "DISTRIB_ID").value_or("");
+    return LsbReleaseValue("DISTRIB_ID");
 }
 
 std::string OsProductName()
@@ -54,7 +67,7 @@ zeus::Version OsVersion()
 
 std::string OsVersionString()
 {
-    return GetKVFileValue("/etc/lsb-release", "DISTRIB_RELEASE").value_or("");
+    return LsbReleaseValue("DISTRIB_RELEASE");
 }
 
 zeus::Version OsKernelVersion()
@@ -95,23 +108,23 @@ std::string OsProductType()
 {
     do
     {
-        auto type = GetKVFileValue("/etc/lsb-release", "DISTRIB_VERSION_TYPE");
-        if (!type || type->empty())
+        auto type = LsbReleaseValue("DISTRIB_VERSION_TYPE");
+        if (type.empty())
         {
             break;
         }
-        return *type;
+        return type;
     }
     while (false);
 
     do
     {
-        auto desc = GetKVFileValueUnquoted("/etc/lsb-release", "DISTRIB_DESCRIPTION");
-        if (!desc || desc->empty())
+        auto desc = Unquote(LsbReleaseValue("DISTRIB_DESCRIPTION"));
+        if (desc.empty())
         {
             break;
         }
-        auto split = Split(*desc, " ");
+        auto split = Split(desc, " ");
         if (3 != split.size())
         {
             break;
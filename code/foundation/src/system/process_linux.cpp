@@ -8,7 +8,7 @@
 #include "zeus/foundation/file/kv_file_utils.h"
 #include "zeus/foundation/file/file_utils.h"
 #include "zeus/foundation/string/string_utils.h"
-#include "zeus/foundation/byte/byte_utils.h"
+#include "zeus/foundation/string/split_iterator.hpp"
 #include "zeus/foundation/system/os.h"
 #include "zeus/foundation/system/environment_variable.h"
 #include "zeus/foundation/time/time.h"
@@ -157,10 +157,15 @@ std::tuple<unsigned int, unsigned int> GetIds(const std::map<std::string, std::s
     auto iter = status.find(key);
     if (iter != status.end())
     {
-        auto ids = Split(iter->second, "\t");
-        if (ids.size() >= 2)
+        const Splitter ids(iter->second, "\t");
+        auto           id = ids.begin();
+        if (id != ids.end())
         {
-            return {std::stoul(ids.at(0)), std::stoul(ids.at(1))};
+            const auto first = *id;
+            if (++id != ids.end())
+            {
+                return {std::stoul(std::string(first)), std::stoul(std::string(*id))};
+            }
         }
     }
     return {0, 0};
@@ -197,6 +202,25 @@ void FillProcessImpl(ProcessImpl& impl, const fs::path& processDir, Process::PID
     }
 }
 
+//cmdline中的参数以0分隔，跳过空的参数
+void ForEachCmdlineArgument(std::string_view content, const std::function<void(std::string_view argument)>& visitor)
+{
+    while (!content.empty())
+    {
+        const auto end      = content.find('\0');
+        const auto argument = content.substr(0, end);
+        if (!argument.empty())
+        {
+            visitor(argument);
+        }
+        if (std::string_view::npos == end)
+        {
+            break;
+        }
+        content.remove_prefix(end + 1);
+    }
+}
+
 } // namespace
 
 Process::PID Process::GetCurrentId()
@@ -343,27 +367,28 @@ zeus::expected<std::vector<std::string>, std::error_code> Process::GetProcessCmd
         .and_then(
             [](std::string const& content) -> zeus::expected<std::vector<std::string>, std::error_code>
             {
-                if (!content.empty())
-                {
-                    auto split = ByteSplit(
-                        {reinterpret_cast<const uint8_t*>(content.data()), content.size()}, {reinterpret_cast<const uint8_t*>("\0"), sizeof(char)},
-                        sizeof(char)
-                    );
-                    std::vector<std::string> args;
-                    for (const auto& item : split)
-                    {
-                        args.emplace_back(std::string(reinterpret_cast<const char*>(item.Data()), item.Size()));
-                    }
-                    return std::move(args);
-                }
-                else
-                {
-                    return {};
-                }
+                std::vector<std::string> args;
+                ForEachCmdlineArgument(content, [&args](std::string_view argument) { args.emplace_back(argument); });
+                return std::move(args);
             }
         );
 }
 
+zeus::expected<void, std::error_code> Process::ForEachProcessCmdlineArgument(
+    const PID& pid, StringPool& pool, const std::function<void(std::string_view argument)>& visitor
+)
+{
+    using namespace std::literals;
+    auto content = FileContent(std::string_view("/proc/"s + std::to_string(pid) + "/cmdline"), true);
+    if (!content.has_value())
+    {
+        return zeus::unexpected(content.error());
+    }
+    //整块保存一次，参数直接引用池中的数据
+    ForEachCmdlineArgument(pool.Store(content.value()), visitor);
+    return {};
+}
+
 zeus::expected<bool, std::error_code> Process::IsProcessZombie(const PID& pid)
 {
     return IsZombie(fs::path("/proc") / std::to_string(pid));
@@ -165,6 +165,59 @@ void FillProcessImpl(ProcessImpl &impl, SYSTEM_PROCESS_INFORMATION *info)
     impl.exePath   = fs::u8path(impl.exePathString);
     impl.sessionId = info->SessionId;
 }
+//逐个访问CommandLineToArgvW拆分后的参数
+zeus::expected<void, std::error_code> VisitCmdlineArguments(const Process::PID &pid, const std::function<void(const wchar_t *argument)> &visitor)
+{
+    static auto *pfnNtQueryProcessInfo =
+        reinterpret_cast<PFNNtQueryProcessInformation>(GetProcAddress(LoadLibraryW(L"ntdll.dll"), "NtQueryInformationProcess"));
+
+    if (!pfnNtQueryProcessInfo)
+    {
+        return zeus::unexpected(SystemError {ERROR_PROC_NOT_FOUND});
+    }
+    PROCESS_BASIC_INFORMATION info   = {};
+    WinHandle                 handle = OpenProcess(PROCESS_QUERY_INFORMATION | PROCESS_VM_READ, FALSE, pid);
+    if (!handle)
+    {
+        return zeus::unexpected(GetLastSystemError());
+    }
+    const NTSTATUS result = pfnNtQueryProcessInfo(handle, ProcessBasicInformation, &info, sizeof(info), nullptr);
+    if (result != 0)
+    {
+        return zeus::unexpected(SystemError {RtlNtStatusToDosError(result)});
+    }
+    PEB                         peb   = {};
+    RTL_USER_PROCESS_PARAMETERS param = {};
+    if (!ReadProcessMemory(handle, info.PebBaseAddress, &peb, sizeof(PEB), nullptr))
+    {
+        return zeus::unexpected(GetLastSystemError());
+    }
+    if (!ReadProcessMemory(handle, peb.ProcessParameters, &param, sizeof(param), nullptr))
+    {
+        return zeus::unexpected(GetLastSystemError());
+    }
+    if (0 == param.CommandLine.Length)
+    {
+        return {};
+    }
+    std::wstring cmdline(param.CommandLine.Length / sizeof(wchar_t), L'\0');
+    if (!ReadProcessMemory(handle, param.CommandLine.Buffer, cmdline.data(), param.CommandLine.Length, nullptr))
+    {
+        return zeus::unexpected(GetLastSystemError());
+    }
+    int     count   = 0;
+    LPWSTR *arglist = CommandLineToArgvW(cmdline.c_str(), &count);
+    if (arglist == nullptr)
+    {
+        return zeus::unexpected(GetLastSystemError());
+    }
+    for (int i = 0; i < count; ++i)
+    {
+        visitor(arglist[i]);
+    }
+    LocalFree(arglist);
+    return {};
+}
 } // namespace
 
 Process::PID Process::GetCurrentId()
@@ -324,60 +377,20 @@ zeus::expected<std::string, std::error_code> Process::GetProcessExePathString(co
 
 zeus::expected<std::vector<std::string>, std::error_code> Process::GetProcessCmdlineArguments(const PID &pid)
 {
-    static auto *pfnNtQueryProcessInfo =
-        reinterpret_cast<PFNNtQueryProcessInformation>(GetProcAddress(LoadLibraryW(L"ntdll.dll"), "NtQueryInformationProcess"));
-
-    if (!pfnNtQueryProcessInfo)
-    {
-        return zeus::unexpected(SystemError {ERROR_PROC_NOT_FOUND});
-    }
-    PROCESS_BASIC_INFORMATION info   = {};
-    WinHandle                 handle = OpenProcess(PROCESS_QUERY_INFORMATION | PROCESS_VM_READ, FALSE, pid);
-    if (!handle)
-    {
-        return zeus::unexpected(GetLastSystemError());
-    }
-    const NTSTATUS result = pfnNtQueryProcessInfo(handle, ProcessBasicInformation, &info, sizeof(info), nullptr);
-    if (result != 0)
-    {
-        return zeus::unexpected(SystemError {RtlNtStatusToDosError(result)});
-    }
-    PEB                         peb   = {};
-    RTL_USER_PROCESS_PARAMETERS param = {};
-    if (!ReadProcessMemory(handle, info.PebBaseAddress, &peb, sizeof(PEB), nullptr))
-    {
-        return zeus::unexpected(GetLastSystemError());
-    }
-    if (!ReadProcessMemory(handle, peb.ProcessParameters, &param, sizeof(param), nullptr))
-    {
-        return zeus::unexpected(GetLastSystemError());
-    }
-    if (0 == param.CommandLine.Length)
-    {
-        return {};
-    }
-    auto buffer = std::make_unique<wchar_t[]>(param.CommandLine.Length / sizeof(wchar_t));
-    if (!ReadProcessMemory(handle, param.CommandLine.Buffer, buffer.get(), param.CommandLine.Length, nullptr))
+    std::vector<std::string> args;
+    auto result = VisitCmdlineArguments(pid, [&args](const wchar_t *argument) { args.emplace_back(CharsetUtils::UnicodeToUTF8(argument)); });
+    if (!result.has_value())
     {
-        return zeus::unexpected(GetLastSystemError());
-    }
-    auto    cmdline = std::wstring(buffer.get(), param.CommandLine.Length / sizeof(wchar_t));
-    int     count   = 0;
-    LPWSTR *arglist = CommandLineToArgvW(cmdline.c_str(), &count);
-    if (arglist == nullptr)
-    {
-        return zeus::unexpected(GetLastSystemError());
-    }
-    else
-    {
-        std::vector<std::string> args;
-        for (int i = 0; i < count; ++i)
-        {
-            args.emplace_back(CharsetUtils::UnicodeToUTF8(arglist[i]));
-        }
-        LocalFree(arglist);
-        return std::move(args);
+        return zeus::unexpected(result.error());
     }
+    return std::move(args);
+}
+
+zeus::expected<void, std::error_code> Process::ForEachProcessCmdlineArgument(
+    const PID &pid, StringPool &pool, const std::function<void(std::string_view argument)> &visitor
+)
+{
+    return VisitCmdlineArguments(pid, [&pool, &visitor](const wchar_t *argument) { visitor(pool.Store(CharsetUtils::UnicodeToUTF8(argument))); });
 }
 } // namespace zeus
 #endif